@@ -0,0 +1,138 @@
+#include "benchdata.h"
+#include "benchmarkresults.h"
+#include "datagenerator.h"
+#include "qtcsv/numberconverter.h"
+#include "qtcsv/stringdata.h"
+#include "qtcsv/variantdata.h"
+
+// Add rows of test data with all profiles and sizes that could be held in
+// memory
+void BenchData::addSizes() {
+    QTest::addColumn<int>("profile");
+    QTest::addColumn<qint64>("size");
+
+    const auto& options = BenchmarkOptions::instance();
+    for (const auto size : options.sizes) {
+        if (options.maxInMemorySize < size) { continue; }
+
+        for (const auto profile : {DataGenerator::Profile::NARROW,
+                                   DataGenerator::Profile::WIDE,
+                                   DataGenerator::Profile::NUMERIC})
+        {
+            const auto name = QString("%1_%2mb")
+                .arg(DataGenerator::profileName(profile)).arg(size);
+            QTest::newRow(qPrintable(name)) << static_cast<int>(profile) <<
+                size * 1024 * 1024;
+        }
+    }
+}
+
+// Generate rows of the profile
+// @input:
+// - profile - profile of the data
+// - size - approximate size of the data in symbols
+// - bytes - variable for the size of the data in symbols
+// @output:
+// - QList<QList<QString>> - rows
+QList<QList<QString>> BenchData::generateRows(
+    const int profile, const qint64 size, qint64& bytes)
+{
+    DataGenerator generator(static_cast<DataGenerator::Profile>(profile));
+    QList<QList<QString>> rows;
+    QList<QString> values;
+    bytes = 0;
+    while (bytes < size) {
+        bytes += generator.nextRow(values);
+        rows << values;
+    }
+
+    return rows;
+}
+
+void BenchData::benchStringDataAddRow_data() {
+    addSizes();
+}
+
+void BenchData::benchStringDataAddRow() {
+    QFETCH(int, profile);
+    QFETCH(qint64, size);
+
+    qint64 bytes = 0;
+    const auto rows = generateRows(profile, size, bytes);
+    measure(bytes, rows.size(), [&rows]() {
+        QtCSV::StringData data;
+        for (const auto& row : rows) { data.addRow(row); }
+    });
+}
+
+void BenchData::benchStringDataRowValues_data() {
+    addSizes();
+}
+
+void BenchData::benchStringDataRowValues() {
+    QFETCH(int, profile);
+    QFETCH(qint64, size);
+
+    QtCSV::StringData data;
+    const auto bytes = size;
+    const auto rows = DataGenerator::fillData(
+        data, static_cast<DataGenerator::Profile>(profile), size);
+    measure(bytes, rows, [&data]() {
+        qsizetype values = 0;
+        for (qsizetype i = 0; i < data.rowCount(); ++i) {
+            values += data.rowValues(i).size();
+        }
+
+        QVERIFY2(0 < values, "No values");
+    });
+}
+
+void BenchData::benchVariantDataRowValues_data() {
+    addSizes();
+}
+
+// Numeric values are converted to strings on each call of rowValues()
+void BenchData::benchVariantDataRowValues() {
+    QFETCH(int, profile);
+    QFETCH(qint64, size);
+
+    qint64 bytes = 0;
+    const auto rows = generateRows(profile, size, bytes);
+
+    QtCSV::VariantData data;
+    for (const auto& row : rows) {
+        QList<QVariant> values;
+        for (const auto& value : row) {
+            const auto number = QtCSV::NumberConverter::toNumber(value);
+            values << (number.isValid() ? number : QVariant(value));
+        }
+
+        data.addRow(values);
+    }
+
+    measure(bytes, rows.size(), [&data]() {
+        qsizetype values = 0;
+        for (qsizetype i = 0; i < data.rowCount(); ++i) {
+            values += data.rowValues(i).size();
+        }
+
+        QVERIFY2(0 < values, "No values");
+    });
+}
+
+void BenchData::benchVariantDataParseNumbers_data() {
+    addSizes();
+}
+
+void BenchData::benchVariantDataParseNumbers() {
+    QFETCH(int, profile);
+    QFETCH(qint64, size);
+
+    qint64 bytes = 0;
+    const auto rows = generateRows(profile, size, bytes);
+    measure(bytes, rows.size(), [&rows]() {
+        QtCSV::VariantData data;
+        data.setParseNumbers(true);
+        for (const auto& row : rows) { data.addRow(row); }
+    });
+}
@@ -0,0 +1,29 @@
+#ifndef BENCHDATA_H
+#define BENCHDATA_H
+
+#include <QObject>
+#include <QtTest>
+
+class BenchData : public QObject {
+    Q_OBJECT
+
+public:
+    BenchData() = default;
+
+private Q_SLOTS:
+    void benchStringDataAddRow_data();
+    void benchStringDataAddRow();
+    void benchStringDataRowValues_data();
+    void benchStringDataRowValues();
+    void benchVariantDataRowValues_data();
+    void benchVariantDataRowValues();
+    void benchVariantDataParseNumbers_data();
+    void benchVariantDataParseNumbers();
+
+private:
+    static void addSizes();
+    static QList<QList<QString>> generateRows(
+        int profile, qint64 size, qint64& bytes);
+};
+
+#endif // BENCHDATA_H
@@ -0,0 +1,107 @@
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QtTest>
+#include <cstdio>
+
+#include "benchdata.h"
+#include "benchmarkresults.h"
+#include "benchreader.h"
+#ifdef QTCSV_SQL
+#include "benchsqlimporter.h"
+#endif
+#include "benchwriter.h"
+
+// Usage: qtcsv_benchmarks [options] [QtTest arguments]
+// Options:
+// --sizes <list> - comma-separated sizes of generated data in megabytes
+// (default is "1,16"). Sizes up to several gigabytes are supported.
+// --max-in-memory <size> - max size of data in megabytes for benchmarks that
+// hold all data in memory (default is 256)
+// --data-dir <path> - directory for generated csv-files. Files are reused
+// between runs (default is "qtcsv-benchmarks" in temporary directory).
+// --save-baseline <path> - save results to csv-file
+// --baseline <path> - compare results with the saved ones. Program fails if
+// throughput of some benchmark dropped more than by threshold.
+// --threshold <percents> - allowed drop of throughput (default is 10)
+//
+// Example of regression check:
+// qtcsv_benchmarks --save-baseline base.csv -iterations 5
+// (apply changes and rebuild)
+// qtcsv_benchmarks --baseline base.csv -iterations 5
+
+int RunBenchmark(QObject* obj, const QStringList& arguments) {
+    int status = QTest::qExec(obj, arguments);
+    delete obj;
+
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    auto& options = BenchmarkOptions::instance();
+    options.dataDir = QDir::temp().filePath("qtcsv-benchmarks");
+
+    QString baselinePath, saveBaselinePath;
+    auto threshold = 10.0;
+    QStringList testArguments;
+    const auto arguments = QCoreApplication::arguments();
+    for (qsizetype i = 0; i < arguments.size(); ++i) {
+        const auto& argument = arguments.at(i);
+        const auto hasValue = i + 1 < arguments.size();
+        if (argument == "--sizes" && hasValue) {
+            options.sizes.clear();
+            for (const auto& size : arguments.at(++i).split(',')) {
+                options.sizes << size.toLongLong();
+            }
+        }
+        else if (argument == "--max-in-memory" && hasValue) {
+            options.maxInMemorySize = arguments.at(++i).toLongLong();
+        }
+        else if (argument == "--data-dir" && hasValue) {
+            options.dataDir = arguments.at(++i);
+        }
+        else if (argument == "--baseline" && hasValue) {
+            baselinePath = QFileInfo(arguments.at(++i)).absoluteFilePath();
+        }
+        else if (argument == "--save-baseline" && hasValue) {
+            saveBaselinePath =
+                QFileInfo(arguments.at(++i)).absoluteFilePath();
+        }
+        else if (argument == "--threshold" && hasValue) {
+            threshold = arguments.at(++i).toDouble();
+        }
+        else {
+            testArguments << argument;
+        }
+    }
+
+    if (!QDir().mkpath(options.dataDir)) {
+        std::printf("Failed to create directory %s\n",
+                    qPrintable(options.dataDir));
+        return 1;
+    }
+
+    auto status = 0;
+    status |= RunBenchmark(new BenchReader(), testArguments);
+    status |= RunBenchmark(new BenchWriter(), testArguments);
+    status |= RunBenchmark(new BenchData(), testArguments);
+#ifdef QTCSV_SQL
+    status |= RunBenchmark(new BenchSqlImporter(), testArguments);
+#endif
+
+    const auto& results = BenchmarkResults::instance();
+    results.print();
+    if (!saveBaselinePath.isEmpty() && !results.save(saveBaselinePath)) {
+        std::printf("Failed to save baseline %s\n",
+                    qPrintable(saveBaselinePath));
+        status |= 1;
+    }
+
+    if (!baselinePath.isEmpty() && !results.compare(baselinePath, threshold)) {
+        status |= 1;
+    }
+
+    return status;
+}
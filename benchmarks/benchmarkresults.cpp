@@ -0,0 +1,152 @@
+#include "benchmarkresults.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/stringdata.h"
+#include "qtcsv/writer.h"
+#include <QElapsedTimer>
+#include <QtTest>
+#include <cstdio>
+
+BenchmarkOptions& BenchmarkOptions::instance() {
+    static BenchmarkOptions options;
+    return options;
+}
+
+double BenchmarkResult::megabytesPerSecond() const {
+    return msecs <= 0 ? 0 : bytes / (1024.0 * 1024.0) / (msecs / 1000.0);
+}
+
+double BenchmarkResult::rowsPerSecond() const {
+    return msecs <= 0 ? 0 : rows / (msecs / 1000.0);
+}
+
+BenchmarkResults& BenchmarkResults::instance() {
+    static BenchmarkResults results;
+    return results;
+}
+
+// Add time of one iteration of the benchmark
+// @input:
+// - name - name of the benchmark
+// - bytes - size of processed data
+// - rows - number of processed rows
+// - msecs - time of the iteration
+void BenchmarkResults::add(
+    const QString& name,
+    const qint64 bytes,
+    const qint64 rows,
+    const double msecs)
+{
+    auto& result = m_results[name];
+    if (result.msecs <= 0 || msecs < result.msecs) {
+        result.bytes = bytes;
+        result.rows = rows;
+        result.msecs = msecs;
+    }
+}
+
+// Print table with the results
+void BenchmarkResults::print() const {
+    std::printf("\n%-60s %12s %12s %14s\n",
+                "Benchmark", "ms", "MB/s", "rows/s");
+    for (auto it = m_results.constBegin(); it != m_results.constEnd(); ++it) {
+        std::printf("%-60s %12.2f %12.2f %14.0f\n",
+                    qPrintable(it.key()), it.value().msecs,
+                    it.value().megabytesPerSecond(),
+                    it.value().rowsPerSecond());
+    }
+
+    std::fflush(stdout);
+}
+
+// Save results as csv-file
+// @input:
+// - filePath - path to the file
+// @output:
+// - bool - True if file was written, False otherwise
+bool BenchmarkResults::save(const QString& filePath) const {
+    QtCSV::StringData data;
+    for (auto it = m_results.constBegin(); it != m_results.constEnd(); ++it) {
+        data.addRow(QList<QString>{
+            it.key(),
+            QString::number(it.value().bytes),
+            QString::number(it.value().rows),
+            QString::number(it.value().msecs, 'f', 3)});
+    }
+
+    return QtCSV::Writer::write(filePath, data, ",", "\"",
+        QtCSV::Writer::WriteMode::REWRITE, {"name", "bytes", "rows", "msecs"});
+}
+
+// Compare results with the baseline
+// @input:
+// - baselinePath - path to the file with results of a previous run
+// - threshold - allowed drop of throughput in percents
+// @output:
+// - bool - True if there are no regressions, False otherwise
+bool BenchmarkResults::compare(
+    const QString& baselinePath, const double threshold) const
+{
+    const auto rows = QtCSV::Reader::readToList(baselinePath);
+    if (rows.isEmpty()) {
+        std::printf("Failed to read baseline: %s\n", qPrintable(baselinePath));
+        return false;
+    }
+
+    auto result = true;
+    std::printf("\n%-60s %12s %12s %9s\n",
+                "Benchmark", "base MB/s", "MB/s", "change");
+    for (qsizetype i = 1; i < rows.size(); ++i) {
+        const auto& values = rows.at(i);
+        if (values.size() < 4 || !m_results.contains(values.at(0))) {
+            continue;
+        }
+
+        BenchmarkResult baseline;
+        baseline.bytes = values.at(1).toLongLong();
+        baseline.rows = values.at(2).toLongLong();
+        baseline.msecs = values.at(3).toDouble();
+
+        // Compare time of processing of the same amount of data, so
+        // results of different sizes of data could not be mixed up
+        const auto& current = m_results.value(values.at(0));
+        if (baseline.msecs <= 0 || current.msecs <= 0 ||
+            baseline.bytes != current.bytes)
+        {
+            continue;
+        }
+
+        const auto change = (baseline.msecs / current.msecs - 1.0) * 100.0;
+        const auto isRegression = change < -threshold;
+        std::printf("%-60s %12.2f %12.2f %+8.1f%%%s\n",
+                    qPrintable(values.at(0)), baseline.megabytesPerSecond(),
+                    current.megabytesPerSecond(), change,
+                    isRegression ? " REGRESSION" : "");
+        result = result && !isRegression;
+    }
+
+    std::fflush(stdout);
+    return result;
+}
+
+// Run operation in QBENCHMARK loop and save its throughput
+// @input:
+// - bytes - size of data that is processed by the operation
+// - rows - number of rows that are processed by the operation
+// - operation - function to measure
+void measure(
+    const qint64 bytes,
+    const qint64 rows,
+    const std::function<void()>& operation)
+{
+    auto name = QString::fromLatin1(QTest::currentTestFunction());
+    const auto tag = QString::fromLatin1(QTest::currentDataTag());
+    if (!tag.isEmpty()) { name += "/" + tag; }
+
+    QElapsedTimer timer;
+    QBENCHMARK {
+        timer.start();
+        operation();
+        BenchmarkResults::instance().add(
+            name, bytes, rows, timer.nsecsElapsed() / 1000000.0);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef BENCHMARKRESULTS_H
+#define BENCHMARKRESULTS_H
+
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <functional>
+
+// BenchmarkOptions holds settings of the benchmarks run
+struct BenchmarkOptions {
+    // Sizes of generated data in megabytes
+    QList<qint64> sizes = {1, 16};
+    // Max size of data (in megabytes) for benchmarks that hold all data
+    // in memory
+    qint64 maxInMemorySize = 256;
+    // Directory for generated csv-files. Files are reused between runs.
+    QString dataDir;
+
+    static BenchmarkOptions& instance();
+};
+
+// BenchmarkResult holds the best time of one benchmark
+struct BenchmarkResult {
+    qint64 bytes = 0;
+    qint64 rows = 0;
+    double msecs = 0;
+
+    double megabytesPerSecond() const;
+    double rowsPerSecond() const;
+};
+
+// BenchmarkResults collects throughput of benchmarks, prints it and
+// compares it with results of a previous run (baseline)
+class BenchmarkResults {
+    QMap<QString, BenchmarkResult> m_results;
+
+public:
+    static BenchmarkResults& instance();
+
+    // Add time of one iteration of the benchmark. Only the best time is
+    // kept.
+    void add(const QString& name, qint64 bytes, qint64 rows, double msecs);
+    // Print table with the results
+    void print() const;
+    // Save results as csv-file
+    bool save(const QString& filePath) const;
+    // Compare results with the baseline. Returns False if throughput of
+    // some benchmark dropped more than by 'threshold' percents.
+    bool compare(const QString& baselinePath, double threshold) const;
+};
+
+// Run operation in QBENCHMARK loop and save its throughput. Name of the
+// benchmark is composed of names of the current test function and data tag.
+void measure(qint64 bytes, qint64 rows, const std::function<void()>& operation);
+
+#endif // BENCHMARKRESULTS_H
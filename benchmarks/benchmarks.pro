@@ -0,0 +1,56 @@
+QT += testlib
+QT -= gui
+
+TARGET = qtcsv_benchmarks
+CONFIG += console
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+!msvc {
+    # flags for gcc-like compiler
+    CONFIG += warn_on
+    QMAKE_CXXFLAGS_WARN_ON += -Werror -Wformat=2 -Wuninitialized -Winit-self \
+            -Wmissing-include-dirs -Wswitch-enum -Wundef -Wpointer-arith \
+            -Wdisabled-optimization -Wcast-align -Wcast-qual
+}
+
+# set where linker could find qtcsv library. By default we expect
+# that library is located in the same directory as the qtcsv_benchmarks binary.
+QTCSV_LOCATION = $$OUT_PWD
+LIBS += -L$$QTCSV_LOCATION -lqtcsv
+
+INCLUDEPATH += $$PWD/../include
+
+SOURCES += \
+    benchmain.cpp \
+    benchmarkresults.cpp \
+    datagenerator.cpp \
+    benchreader.cpp \
+    benchwriter.cpp \
+    benchdata.cpp
+
+HEADERS += \
+    benchmarkresults.h \
+    datagenerator.h \
+    benchreader.h \
+    benchwriter.h \
+    benchdata.h
+
+# Benchmarks of SqlImporter are built if library is built with it:
+# qmake CONFIG+=qtcsv_sql
+qtcsv_sql {
+    QT += sql
+    DEFINES += QTCSV_SQL
+
+    SOURCES += benchsqlimporter.cpp
+    HEADERS += benchsqlimporter.h
+}
+
+DISTFILES += \
+    CMakeLists.txt
+
+message(=== Configuration of qtcsv_benchmarks ===)
+message(Qt version: $$[QT_VERSION])
+message(qtcsv_benchmarks binary will be created in folder: $$OUT_PWD)
+message(Expected location of qtcsv library: $$QTCSV_LOCATION)
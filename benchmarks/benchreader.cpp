@@ -0,0 +1,191 @@
+#include "benchreader.h"
+#include "benchmarkresults.h"
+#include "datagenerator.h"
+#include "qtcsv/query.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/stringdata.h"
+#include <QDir>
+#include <QFileInfo>
+
+namespace {
+    // CountProcessor counts rows without saving them
+    class CountProcessor : public QtCSV::Reader::AbstractProcessor {
+    public:
+        qint64 rows = 0;
+
+        bool processRowElements(const QList<QString>& /*elements*/) override {
+            ++rows;
+            return true;
+        }
+    };
+
+    QString codecName(const QStringConverter::Encoding codec) {
+        return QString::fromLatin1(QStringConverter::nameForEncoding(codec));
+    }
+
+    // Add row of test data with generated csv-file
+    void addFile(
+        const DataGenerator::Profile profile,
+        const qint64 sizeMb,
+        const QStringConverter::Encoding codec)
+    {
+        const auto name = QString("%1_%2mb_%3")
+            .arg(DataGenerator::profileName(profile)).arg(sizeMb)
+            .arg(codecName(codec));
+        const auto path = QDir(BenchmarkOptions::instance().dataDir)
+            .filePath(name + ".csv");
+
+        qint64 rows = 0;
+        if (!DataGenerator::writeFile(
+                path, profile, sizeMb * 1024 * 1024, codec, &rows))
+        {
+            qWarning() << "Failed to generate file" << path;
+            return;
+        }
+
+        QTest::newRow(qPrintable(name)) << path <<
+            QFileInfo(path).size() << rows << static_cast<int>(codec);
+    }
+}
+
+// Add rows of test data with files of all profiles and sizes
+// @input:
+// - inMemoryOnly - if True, only files that could be loaded into memory
+// will be added
+void BenchReader::addFiles(const bool inMemoryOnly) {
+    QTest::addColumn<QString>("filePath");
+    QTest::addColumn<qint64>("bytes");
+    QTest::addColumn<qint64>("rows");
+    QTest::addColumn<int>("codec");
+
+    const auto& options = BenchmarkOptions::instance();
+    for (const auto size : options.sizes) {
+        if (inMemoryOnly && options.maxInMemorySize < size) { continue; }
+
+        for (const auto profile : DataGenerator::profiles()) {
+            addFile(profile, size, QStringConverter::Utf8);
+        }
+    }
+}
+
+void BenchReader::benchReadToProcessor_data() {
+    addFiles(false);
+}
+
+void BenchReader::benchReadToProcessor() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+
+    measure(bytes, rows, [&filePath, rows]() {
+        CountProcessor processor;
+        QtCSV::Reader::readToProcessor(filePath, processor);
+        QVERIFY2(rows == processor.rows, "Wrong number of rows");
+    });
+}
+
+void BenchReader::benchReadToList_data() {
+    addFiles(true);
+}
+
+void BenchReader::benchReadToList() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+
+    measure(bytes, rows, [&filePath]() {
+        const auto data = QtCSV::Reader::readToList(filePath);
+        QVERIFY2(!data.isEmpty(), "Failed to read file");
+    });
+}
+
+void BenchReader::benchReadToStringData_data() {
+    addFiles(true);
+}
+
+void BenchReader::benchReadToStringData() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+
+    measure(bytes, rows, [&filePath]() {
+        QtCSV::StringData data;
+        QVERIFY2(QtCSV::Reader::readToData(filePath, data),
+                 "Failed to read file");
+    });
+}
+
+void BenchReader::benchReadEncodings_data() {
+    QTest::addColumn<QString>("filePath");
+    QTest::addColumn<qint64>("bytes");
+    QTest::addColumn<qint64>("rows");
+    QTest::addColumn<int>("codec");
+
+    for (const auto size : BenchmarkOptions::instance().sizes) {
+        for (const auto codec : {QStringConverter::Utf8,
+                                 QStringConverter::Utf16LE,
+                                 QStringConverter::Latin1})
+        {
+            addFile(DataGenerator::Profile::NARROW, size, codec);
+        }
+    }
+}
+
+void BenchReader::benchReadEncodings() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+    QFETCH(int, codec);
+
+    measure(bytes, rows, [&filePath, codec]() {
+        CountProcessor processor;
+        QtCSV::Reader::readToProcessor(filePath, processor, ",", "\"",
+            static_cast<QStringConverter::Encoding>(codec));
+    });
+}
+
+void BenchReader::benchReadWithProgress_data() {
+    addFiles(false);
+}
+
+// Compare with benchReadToProcessor to get the overhead of progress
+// reporting and cancellation checks
+void BenchReader::benchReadWithProgress() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+
+    measure(bytes, rows, [&filePath, rows]() {
+        qint64 reported = 0;
+        QtCSV::Progress progress(
+            [&reported](const QtCSV::Progress::State& state) {
+                reported = state.rows;
+            });
+
+        CountProcessor processor;
+        QtCSV::Reader::readToProcessor(filePath, processor, ",", "\"",
+            QStringConverter::Utf8, nullptr, &progress);
+        QVERIFY2(rows == reported, "Wrong number of reported rows");
+    });
+}
+
+void BenchReader::benchQueryCount_data() {
+    addFiles(false);
+}
+
+// Compare with benchReadToProcessor to get the speedup of parallel
+// processing of batches
+void BenchReader::benchQueryCount() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+
+    measure(bytes, rows, [&filePath, rows]() {
+        QtCSV::Query query;
+        query.aggregate(QtCSV::Query::Aggregate::COUNT);
+        const auto result = query.runToList(filePath);
+        QVERIFY2(1 == result.size() &&
+                     QString::number(rows) == result.first().first(),
+                 "Wrong number of rows");
+    });
+}
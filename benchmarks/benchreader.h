@@ -0,0 +1,31 @@
+#ifndef BENCHREADER_H
+#define BENCHREADER_H
+
+#include <QObject>
+#include <QtTest>
+
+class BenchReader : public QObject {
+    Q_OBJECT
+
+public:
+    BenchReader() = default;
+
+private Q_SLOTS:
+    void benchReadToProcessor_data();
+    void benchReadToProcessor();
+    void benchReadToList_data();
+    void benchReadToList();
+    void benchReadToStringData_data();
+    void benchReadToStringData();
+    void benchReadEncodings_data();
+    void benchReadEncodings();
+    void benchReadWithProgress_data();
+    void benchReadWithProgress();
+    void benchQueryCount_data();
+    void benchQueryCount();
+
+private:
+    static void addFiles(bool inMemoryOnly);
+};
+
+#endif // BENCHREADER_H
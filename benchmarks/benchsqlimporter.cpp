@@ -0,0 +1,154 @@
+#include "benchsqlimporter.h"
+#include "benchmarkresults.h"
+#include "datagenerator.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/sqlimporter.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSqlError>
+#include <QSqlQuery>
+
+namespace {
+    const QString CONNECTION_NAME("qtcsv_benchmarks");
+
+    // InsertProcessor inserts each row by a separate statement. It is the
+    // usual way of import without SqlImporter.
+    class InsertProcessor : public QtCSV::Reader::AbstractProcessor {
+        QSqlQuery& m_query;
+
+    public:
+        qint64 rows = 0;
+
+        explicit InsertProcessor(QSqlQuery& query) : m_query(query) {}
+
+        bool processRowElements(const QList<QString>& elements) override {
+            for (const auto& value : elements) { m_query.addBindValue(value); }
+
+            ++rows;
+            return m_query.exec();
+        }
+    };
+
+    // Get names of columns of the rows
+    QList<QString> columnNames(const qsizetype count) {
+        QList<QString> names;
+        for (qsizetype i = 0; i < count; ++i) {
+            names << QString("c%1").arg(i);
+        }
+
+        return names;
+    }
+}
+
+void BenchSqlImporter::initTestCase() {
+    m_database = QSqlDatabase::addDatabase("QSQLITE", CONNECTION_NAME);
+    m_database.setDatabaseName(
+        QDir(BenchmarkOptions::instance().dataDir).filePath("bench.sqlite"));
+    QVERIFY2(m_database.open(), "Failed to open database");
+
+    // Benchmarks measure import, not the durability of disk writes
+    QSqlQuery query(m_database);
+    QVERIFY2(query.exec("PRAGMA journal_mode = OFF") &&
+                 query.exec("PRAGMA synchronous = OFF"),
+             "Failed to set pragmas");
+}
+
+void BenchSqlImporter::cleanupTestCase() {
+    const auto path = m_database.databaseName();
+    m_database.close();
+    m_database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(CONNECTION_NAME);
+    QFile::remove(path);
+}
+
+// Add rows of test data with generated csv-files
+void BenchSqlImporter::addFiles() {
+    QTest::addColumn<QString>("filePath");
+    QTest::addColumn<qint64>("bytes");
+    QTest::addColumn<qint64>("rows");
+    QTest::addColumn<int>("columns");
+
+    for (const auto size : BenchmarkOptions::instance().sizes) {
+        for (const auto profile : {DataGenerator::Profile::NARROW,
+                                   DataGenerator::Profile::WIDE,
+                                   DataGenerator::Profile::NUMERIC})
+        {
+            // Files are shared with benchmarks of Reader
+            const auto name = QString("%1_%2mb")
+                .arg(DataGenerator::profileName(profile)).arg(size);
+            const auto path = QDir(BenchmarkOptions::instance().dataDir)
+                .filePath(QString("%1_%2.csv").arg(name, QString::fromLatin1(
+                    QStringConverter::nameForEncoding(
+                        QStringConverter::Utf8))));
+
+            qint64 rows = 0;
+            if (!DataGenerator::writeFile(
+                    path, profile, size * 1024 * 1024,
+                    QStringConverter::Utf8, &rows))
+            {
+                qWarning() << "Failed to generate file" << path;
+                continue;
+            }
+
+            QList<QString> values;
+            DataGenerator(profile).nextRow(values);
+            QTest::newRow(qPrintable(name)) << path <<
+                QFileInfo(path).size() << rows <<
+                static_cast<int>(values.size());
+        }
+    }
+}
+
+void BenchSqlImporter::benchInsertPerRow_data() {
+    addFiles();
+}
+
+// Compare with benchImport to get the speedup of batched inserts
+void BenchSqlImporter::benchInsertPerRow() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+    QFETCH(int, columns);
+
+    const auto names = columnNames(columns);
+    measure(bytes, rows, [this, &filePath, &names, rows]() {
+        QSqlQuery query(m_database);
+        QVERIFY2(query.exec("DROP TABLE IF EXISTS data") &&
+                     query.exec(QString("CREATE TABLE data (%1)")
+                                    .arg(names.join(", "))),
+                 "Failed to create table");
+
+        QVERIFY2(m_database.transaction(), "Failed to start transaction");
+        QVERIFY2(query.prepare(
+                     QString("INSERT INTO data VALUES (%1)")
+                         .arg(QList<QString>(names.size(), "?").join(", "))),
+                 "Failed to prepare insert");
+
+        InsertProcessor processor(query);
+        QVERIFY2(QtCSV::Reader::readToProcessor(filePath, processor),
+                 "Failed to insert rows");
+        QVERIFY2(m_database.commit(), "Failed to commit transaction");
+        QVERIFY2(rows == processor.rows, "Wrong number of rows");
+    });
+}
+
+void BenchSqlImporter::benchImport_data() {
+    addFiles();
+}
+
+void BenchSqlImporter::benchImport() {
+    QFETCH(QString, filePath);
+    QFETCH(qint64, bytes);
+    QFETCH(qint64, rows);
+    QFETCH(int, columns);
+
+    const auto names = columnNames(columns);
+    measure(bytes, rows, [this, &filePath, &names, rows]() {
+        QtCSV::SqlImporter importer(m_database, "data");
+        importer.setMode(QtCSV::SqlImporter::Mode::REPLACE);
+        importer.setColumns(names);
+        QVERIFY2(importer.import(filePath), "Failed to import rows");
+        QVERIFY2(rows == importer.importedRows(), "Wrong number of rows");
+    });
+}
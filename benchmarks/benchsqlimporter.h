@@ -0,0 +1,28 @@
+#ifndef BENCHSQLIMPORTER_H
+#define BENCHSQLIMPORTER_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QtTest>
+
+class BenchSqlImporter : public QObject {
+    Q_OBJECT
+
+public:
+    BenchSqlImporter() = default;
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void benchInsertPerRow_data();
+    void benchInsertPerRow();
+    void benchImport_data();
+    void benchImport();
+
+private:
+    static void addFiles();
+
+    QSqlDatabase m_database;
+};
+
+#endif // BENCHSQLIMPORTER_H
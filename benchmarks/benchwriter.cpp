@@ -0,0 +1,131 @@
+#include "benchwriter.h"
+#include "benchmarkresults.h"
+#include "datagenerator.h"
+#include "qtcsv/rowsource.h"
+#include "qtcsv/stringdata.h"
+#include "qtcsv/writer.h"
+#include <QDir>
+#include <QFile>
+
+// Add rows of test data with all profiles and sizes
+// @input:
+// - inMemoryOnly - if True, only sizes of data that could be held in memory
+// will be added
+void BenchWriter::addProfiles(const bool inMemoryOnly) {
+    QTest::addColumn<int>("profile");
+    QTest::addColumn<qint64>("size");
+
+    const auto& options = BenchmarkOptions::instance();
+    for (const auto size : options.sizes) {
+        if (inMemoryOnly && options.maxInMemorySize < size) { continue; }
+
+        for (const auto profile : DataGenerator::profiles()) {
+            const auto name = QString("%1_%2mb")
+                .arg(DataGenerator::profileName(profile)).arg(size);
+            QTest::newRow(qPrintable(name)) << static_cast<int>(profile) <<
+                size * 1024 * 1024;
+        }
+    }
+}
+
+QString BenchWriter::outputPath() {
+    return QDir(BenchmarkOptions::instance().dataDir).filePath("output.csv");
+}
+
+void BenchWriter::benchWriteStringData_data() {
+    addProfiles(true);
+}
+
+void BenchWriter::benchWriteStringData() {
+    QFETCH(int, profile);
+    QFETCH(qint64, size);
+
+    QtCSV::StringData data;
+    const auto rows = DataGenerator::fillData(
+        data, static_cast<DataGenerator::Profile>(profile), size);
+
+    QFile file(outputPath());
+    const auto write = [&file, &data]() {
+        QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate),
+                 "Failed to open file");
+        QVERIFY2(QtCSV::Writer::write(file, data), "Failed to write data");
+        file.close();
+    };
+
+    // The first write gives the size of the output
+    write();
+    measure(file.size(), rows, write);
+    file.remove();
+}
+
+void BenchWriter::benchWriteRowSource_data() {
+    addProfiles(false);
+}
+
+// Data is generated on the fly, so the result includes the time of
+// generation of rows. Compare it only with results of the same benchmark.
+void BenchWriter::benchWriteRowSource() {
+    QFETCH(int, profile);
+    QFETCH(qint64, size);
+
+    QFile file(outputPath());
+    qint64 rows = 0;
+    const auto write = [&file, &rows, profile, size]() {
+        DataGenerator generator(static_cast<DataGenerator::Profile>(profile));
+        qint64 written = 0;
+        rows = 0;
+        QtCSV::FunctionRowSource source(
+            [&generator, &written, &rows, size](QList<QString>& values) {
+                if (size <= written) { return false; }
+
+                written += generator.nextRow(values);
+                ++rows;
+                return true;
+            });
+
+        QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate),
+                 "Failed to open file");
+        QVERIFY2(QtCSV::Writer::write(file, source), "Failed to write data");
+        file.close();
+    };
+
+    write();
+    measure(file.size(), rows, write);
+    file.remove();
+}
+
+void BenchWriter::benchWriteWithProgress_data() {
+    addProfiles(true);
+}
+
+// Compare with benchWriteStringData to get the overhead of progress
+// reporting and cancellation checks
+void BenchWriter::benchWriteWithProgress() {
+    QFETCH(int, profile);
+    QFETCH(qint64, size);
+
+    QtCSV::StringData data;
+    const auto rows = DataGenerator::fillData(
+        data, static_cast<DataGenerator::Profile>(profile), size);
+
+    QFile file(outputPath());
+    const auto write = [&file, &data]() {
+        qint64 reported = 0;
+        QtCSV::Progress progress(
+            [&reported](const QtCSV::Progress::State& state) {
+                reported = state.rows;
+            });
+
+        QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate),
+                 "Failed to open file");
+        QVERIFY2(QtCSV::Writer::write(file, data, ",", "\"", {}, {},
+                     QStringConverter::Utf8, nullptr, &progress),
+                 "Failed to write data");
+        file.close();
+        QVERIFY2(data.rowCount() == reported, "Wrong number of reported rows");
+    };
+
+    write();
+    measure(file.size(), rows, write);
+    file.remove();
+}
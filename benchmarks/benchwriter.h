@@ -0,0 +1,26 @@
+#ifndef BENCHWRITER_H
+#define BENCHWRITER_H
+
+#include <QObject>
+#include <QtTest>
+
+class BenchWriter : public QObject {
+    Q_OBJECT
+
+public:
+    BenchWriter() = default;
+
+private Q_SLOTS:
+    void benchWriteStringData_data();
+    void benchWriteStringData();
+    void benchWriteRowSource_data();
+    void benchWriteRowSource();
+    void benchWriteWithProgress_data();
+    void benchWriteWithProgress();
+
+private:
+    static void addProfiles(bool inMemoryOnly);
+    static QString outputPath();
+};
+
+#endif // BENCHWRITER_H
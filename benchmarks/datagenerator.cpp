@@ -0,0 +1,172 @@
+#include "datagenerator.h"
+#include "qtcsv/rowsource.h"
+#include "qtcsv/writer.h"
+#include <QFile>
+#include <QFileInfo>
+
+namespace {
+    // Words with non-ASCII symbols make difference between encodings
+    const QList<QString> WORDS = {
+        "alpha", "beta", "gamma", "delta", "café", "Straße", "naïve",
+        "lorem", "ipsum", "dolor", "amet", "élan", "smörgåsbord", "data"};
+}
+
+DataGenerator::DataGenerator(const Profile profile, const quint32 seed) :
+    m_profile(profile), m_random(seed), m_row(0) {}
+
+QString DataGenerator::word() {
+    return WORDS.at(m_random.bounded(static_cast<int>(WORDS.size())));
+}
+
+QString DataGenerator::number() {
+    if (m_random.bounded(2) == 0) {
+        return QString::number(m_random.bounded(-1000000, 1000000));
+    }
+
+    return QString::number(m_random.generateDouble() * 10000.0, 'g', 12);
+}
+
+// Get values of the next row
+// @input:
+// - values - list for the values of the row
+// @output:
+// - qint64 - approximate size of the row in csv-file (in symbols)
+qint64 DataGenerator::nextRow(QList<QString>& values) {
+    values.clear();
+    ++m_row;
+    switch (m_profile) {
+    case Profile::NARROW:
+        values << QString::number(m_row) << word() <<
+            QString::number(m_random.bounded(100000)) <<
+            QString("2024-%1-%2")
+                .arg(m_random.bounded(1, 13), 2, 10, QChar('0'))
+                .arg(m_random.bounded(1, 29), 2, 10, QChar('0')) <<
+            QString("%1%2").arg(QChar('A' + m_random.bounded(26)))
+                .arg(m_random.bounded(1000));
+        break;
+    case Profile::WIDE:
+        for (auto i = 0; i < 100; ++i) {
+            values << (i % 2 == 0 ? word() : number());
+        }
+
+        break;
+    case Profile::QUOTED:
+        for (auto i = 0; i < 8; ++i) {
+            values << QString("%1, \"%2\" and %3").arg(word(), word(), word());
+        }
+
+        break;
+    case Profile::MULTILINE:
+        values << QString::number(m_row) << word() <<
+            QString("%1\n%2\r\n%3").arg(word(), word(), word()) << number();
+        break;
+    case Profile::NUMERIC:
+        for (auto i = 0; i < 10; ++i) { values << number(); }
+        break;
+    }
+
+    qint64 size = values.size() + 1;
+    for (const auto& value : values) { size += value.size(); }
+
+    if (m_profile == Profile::QUOTED || m_profile == Profile::MULTILINE) {
+        // Text delimiters around values and doubled text delimiters
+        size += 4 * values.size();
+    }
+
+    return size;
+}
+
+// Get list of all profiles
+QList<DataGenerator::Profile> DataGenerator::profiles() {
+    return {Profile::NARROW, Profile::WIDE, Profile::QUOTED,
+            Profile::MULTILINE, Profile::NUMERIC};
+}
+
+// Get name of the profile
+QString DataGenerator::profileName(const Profile profile) {
+    switch (profile) {
+    case Profile::NARROW:
+        return "narrow";
+    case Profile::WIDE:
+        return "wide";
+    case Profile::QUOTED:
+        return "quoted";
+    case Profile::MULTILINE:
+        return "multiline";
+    case Profile::NUMERIC:
+        return "numeric";
+    }
+
+    return QString();
+}
+
+// Write csv-file of approximately 'bytes' symbols
+// @input:
+// - filePath - path to the file
+// - profile - profile of the data
+// - bytes - approximate size of the data in symbols
+// - codec - codec type that will be used to write file
+// - rows - pointer to the variable for the number of rows in the file
+// @output:
+// - bool - True if file exists or was written, False otherwise
+bool DataGenerator::writeFile(
+    const QString& filePath,
+    const Profile profile,
+    const qint64 bytes,
+    const QStringConverter::Encoding codec,
+    qint64* rows)
+{
+    // Rows are generated in any case to get their number
+    DataGenerator generator(profile);
+    qint64 size = 0, count = 0;
+    QtCSV::FunctionRowSource source(
+        [&generator, &size, &count, bytes](QList<QString>& values) {
+            if (bytes <= size) { return false; }
+
+            size += generator.nextRow(values);
+            ++count;
+            return true;
+        });
+
+    auto result = true;
+    if (QFileInfo::exists(filePath)) {
+        QList<QString> values;
+        while (source.nextRow(values)) {}
+    }
+    else {
+        // Write to a temporary file first, so interrupted generation of a
+        // big file doesn't leave a truncated file that would be reused
+        const auto tempPath = filePath + ".part";
+        QFile file(tempPath);
+        result = file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+            QtCSV::Writer::write(file, source, ",", "\"", {}, {}, codec);
+        file.close();
+        result = result && QFile::rename(tempPath, filePath);
+    }
+
+    if (rows != nullptr) { *rows = count; }
+
+    return result;
+}
+
+// Add rows of approximately 'bytes' symbols to the container
+// @input:
+// - data - container
+// - profile - profile of the data
+// - bytes - approximate size of the data in symbols
+// @output:
+// - qint64 - number of added rows
+qint64 DataGenerator::fillData(
+    QtCSV::AbstractData& data, const Profile profile, const qint64 bytes)
+{
+    DataGenerator generator(profile);
+    QList<QString> values;
+    qint64 size = 0, rows = 0;
+    while (size < bytes) {
+        size += generator.nextRow(values);
+        data.addRow(values);
+        ++rows;
+    }
+
+    return rows;
+}
@@ -0,0 +1,61 @@
+#ifndef DATAGENERATOR_H
+#define DATAGENERATOR_H
+
+#include "qtcsv/abstractdata.h"
+#include <QList>
+#include <QRandomGenerator>
+#include <QString>
+#include <QStringConverter>
+
+// DataGenerator produces deterministic synthetic csv-data. The same profile
+// and seed always give the same rows, so results of different runs of
+// benchmarks could be compared.
+class DataGenerator {
+public:
+    enum class Profile {
+        // 5 short values: id, word, integer, date, code
+        NARROW = 0,
+        // 100 short values
+        WIDE,
+        // Text values with separators and text delimiters
+        QUOTED,
+        // Text values that last on several lines
+        MULTILINE,
+        // 10 integers and floating point numbers
+        NUMERIC
+    };
+
+    explicit DataGenerator(Profile profile, quint32 seed = 42);
+
+    // Get values of the next row. Returns approximate size of the row in
+    // csv-file (in symbols).
+    qint64 nextRow(QList<QString>& values);
+
+    // Get list of all profiles
+    static QList<Profile> profiles();
+    // Get name of the profile
+    static QString profileName(Profile profile);
+
+    // Write csv-file of approximately 'bytes' symbols. If file already
+    // exists, it is not rewritten.
+    static bool writeFile(
+        const QString& filePath,
+        Profile profile,
+        qint64 bytes,
+        QStringConverter::Encoding codec = QStringConverter::Utf8,
+        qint64* rows = nullptr);
+
+    // Add rows of approximately 'bytes' symbols to the container
+    static qint64 fillData(
+        QtCSV::AbstractData& data, Profile profile, qint64 bytes);
+
+private:
+    QString word();
+    QString number();
+
+    Profile m_profile;
+    QRandomGenerator m_random;
+    qint64 m_row;
+};
+
+#endif // DATAGENERATOR_H
@@ -0,0 +1,54 @@
+#ifndef QTCSVARROWWRITER_H
+#define QTCSVARROWWRITER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include "qtcsv/schema.h"
+#include "qtcsv/typedprocessor.h"
+#include <QIODevice>
+#include <memory>
+
+namespace QtCSV {
+
+    class ArrowWriterPrivate;
+
+    // ArrowWriter is a TypedProcessor that writes rows of csv-data to IO
+    // Device in Apache Arrow IPC streaming format, so csv-data is converted
+    // to Arrow by one pass of Reader:
+    //
+    // ArrowWriter writer(output, schema);
+    // Reader::readToProcessor(filePath, writer) && writer.finish();
+    //
+    // Columns and their types are taken from the schema (STRING is Arrow
+    // Utf8, INTEGER is Int64, DOUBLE is Float64, BOOL is Bool). Without
+    // schema all columns of the header are Utf8. Null values (see
+    // TypedProcessor) are marked in validity bitmaps.
+    //
+    // Values of each column are appended to its Arrow buffers right away.
+    // When batch has enough rows, buffers are written as a record batch and
+    // reused for the next rows. Format is written by the library itself,
+    // no Arrow library is needed.
+    class QTCSVSHARED_EXPORT ArrowWriter : public TypedProcessor {
+        std::unique_ptr<ArrowWriterPrivate> d;
+
+    public:
+        // IO Device should be open for writing
+        explicit ArrowWriter(QIODevice& output);
+        ArrowWriter(QIODevice& output, const Schema& schema);
+        ~ArrowWriter() override;
+
+        ArrowWriter(const ArrowWriter&) = delete;
+        ArrowWriter& operator=(const ArrowWriter&) = delete;
+
+        // Set max number of rows in one record batch (default is 65536)
+        void setBatchRows(qint64 rows);
+        // Write the last record batch and the end of the stream. Call it
+        // after all rows were read.
+        bool finish();
+        // Get number of written record batches
+        qint64 batchCount() const;
+
+        bool processRow(const TypedRow& row) override;
+    };
+}
+
+#endif // QTCSVARROWWRITER_H
@@ -0,0 +1,97 @@
+#ifndef QTCSVCACHEDDATA_H
+#define QTCSVCACHEDDATA_H
+
+#include "qtcsv/abstractdata.h"
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <QVariant>
+#include <memory>
+
+namespace QtCSV {
+
+    class CachedDataPrivate;
+
+    // CachedData is a container class that holds content of a csv-file in a
+    // binary cache file. Cache is written after the first read of the
+    // csv-file and is memory-mapped on subsequent reads, so data is
+    // available almost instantly without parsing.
+    //
+    // Cache stores values in columns. Columns that contain only integers or
+    // only floating point numbers (empty values are allowed) are stored as
+    // numbers, other columns are stored as indexes in a dictionary of
+    // unique strings. Cache is invalidated if size or modification time of
+    // the csv-file changes or if it is read with a different separator,
+    // text delimiter or codec.
+    //
+    // CachedData implements AbstractData interface, so it could be passed
+    // to Writer. Rows that are added to it are kept in memory and are not
+    // written to the cache.
+    class QTCSVSHARED_EXPORT CachedData : public AbstractData {
+        std::unique_ptr<CachedDataPrivate> d;
+
+    public:
+        // Type of values of a cached column
+        enum class ColumnType {
+            STRING = 0,
+            INTEGER,
+            DOUBLE
+        };
+
+        CachedData();
+        ~CachedData() override;
+
+        CachedData(const CachedData&) = delete;
+        CachedData& operator=(const CachedData&) = delete;
+
+        // Load csv-file using the cache. If cache is missing or out of date,
+        // csv-file is read and the cache is rewritten.
+        bool load(
+            const QString& filePath,
+            const QString& cachePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Open cache only if it is up to date with the csv-file
+        bool openCache(
+            const QString& filePath,
+            const QString& cachePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Read csv-file and write its cache
+        static bool writeCache(
+            const QString& filePath,
+            const QString& cachePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Get number of columns in the cache
+        qsizetype columnCount() const;
+        // Get type of the cached column
+        ColumnType columnType(qsizetype column) const;
+        // Get typed value: qlonglong, double or QString according to the
+        // type of the column. Returns invalid QVariant for missing and
+        // empty numeric values.
+        QVariant value(qsizetype row, qsizetype column) const;
+
+        // Add new empty row
+        void addEmptyRow() override;
+        // Add new row with specified values
+        void addRow(const QList<QString>& values) override;
+        // Clear all data and close the cache
+        void clear() override;
+        // Check if there are any rows
+        bool isEmpty() const override;
+        // Get number of rows
+        qsizetype rowCount() const override;
+        // Get values of specified row as list of strings
+        QList<QString> rowValues(qsizetype row) const override;
+    };
+}
+
+#endif // QTCSVCACHEDDATA_H
@@ -0,0 +1,41 @@
+#ifndef QTCSVCHECKPOINT_H
+#define QTCSVCHECKPOINT_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QByteArray>
+#include <QString>
+#include <QStringConverter>
+
+namespace QtCSV {
+
+    // ReadCheckpoint is a position in csv-data at a row boundary. Get it from
+    // Reader::AbstractProcessor::checkpoint() while rows are processed, save
+    // it with toByteArray() and pass it to Reader::resumeToProcessor() to
+    // continue reading after the last processed row. Checkpoint holds the
+    // dialect of the data, so reading is resumed with the same separator,
+    // text delimiter and codec. Rows never end inside of a quoted value, so
+    // a checkpoint doesn't need any state of the parser.
+    struct QTCSVSHARED_EXPORT ReadCheckpoint {
+        // Position of the next row in bytes from the beginning of the data.
+        // Negative value means invalid checkpoint.
+        qint64 offset = -1;
+        // Number of rows before the position
+        qint64 rows = 0;
+        QString separator = QString(",");
+        QString textDelimiter = QString("\"");
+        // Codec of the data. UTF-16 and UTF-32 codecs have explicit byte
+        // order that was found by the byte order mark or the native one.
+        QStringConverter::Encoding codec = QStringConverter::Utf8;
+
+        // Check if checkpoint points to some position
+        bool isValid() const { return 0 <= offset; }
+
+        // Serialize checkpoint to bytes
+        QByteArray toByteArray() const;
+        // Restore checkpoint from bytes. Returns invalid checkpoint if bytes
+        // are not a serialized checkpoint.
+        static ReadCheckpoint fromByteArray(const QByteArray& data);
+    };
+}
+
+#endif // QTCSVCHECKPOINT_H
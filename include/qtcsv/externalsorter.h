@@ -0,0 +1,92 @@
+#ifndef QTCSVEXTERNALSORTER_H
+#define QTCSVEXTERNALSORTER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QIODevice>
+#include <QList>
+#include <QLocale>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class ExternalSorterPrivate;
+
+    // ExternalSorter sorts csv-data that doesn't fit into memory.
+    //
+    // Rows are read in runs that fit into the memory limit. Each run is
+    // sorted in a separate thread and saved to a temporary file. Then
+    // runs are merged into the resulting csv-file. If there are too many
+    // runs, they are merged in several passes. Data that fits into the
+    // memory limit is sorted without temporary files.
+    //
+    // Rows are sorted by one or several keys. Each key defines a column,
+    // the way its values are compared and the sort order. Sort is stable:
+    // rows with equal keys keep their original order.
+    class QTCSVSHARED_EXPORT ExternalSorter {
+        std::unique_ptr<ExternalSorterPrivate> d;
+
+    public:
+        // Type of comparison of values of a key column
+        enum class KeyType {
+            // Compare strings by Unicode code points
+            LEXICAL = 0,
+            // Compare values as floating point numbers. Values that are not
+            // numbers go after numbers and are compared lexically.
+            NUMERIC,
+            // Compare strings according to the rules of the sorter locale
+            LOCALE
+        };
+
+        struct SortKey {
+            qsizetype column = 0;
+            KeyType type = KeyType::LEXICAL;
+            Qt::SortOrder order = Qt::AscendingOrder;
+        };
+
+        ExternalSorter();
+        ~ExternalSorter();
+
+        ExternalSorter(const ExternalSorter&) = delete;
+        ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+        // Set sort keys in order of priority. By default rows are sorted
+        // lexically by the first column.
+        void setKeys(const QList<SortKey>& keys);
+        // Set approximate amount of memory (in bytes) that could be used
+        // for rows. Default is 256 MB.
+        void setMemoryLimit(qint64 bytes);
+        // Set directory for temporary files. By default system temporary
+        // directory is used.
+        void setTempDir(const QString& dirPath);
+        // Set number of threads that sort runs. By default it is equal to
+        // the number of CPU cores.
+        void setThreadCount(int count);
+        // Set max number of runs that are merged at once (default is 64)
+        void setMaxMergeFanIn(qsizetype number);
+        // Set locale for KeyType::LOCALE keys. Default is system locale.
+        void setLocale(const QLocale& locale);
+        // If set, the first row is treated as a header. It is not sorted and
+        // is written as the first row of the result.
+        void setHasHeader(bool hasHeader);
+
+        // Sort csv-file and write result to another csv-file
+        bool sort(
+            const QString& inputFilePath,
+            const QString& outputFilePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+
+        // Sort csv-data from IO Device and write result to another IO Device
+        bool sort(
+            QIODevice& input,
+            QIODevice& output,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+    };
+}
+
+#endif // QTCSVEXTERNALSORTER_H
@@ -0,0 +1,73 @@
+#ifndef QTCSVFILEFOLLOWER_H
+#define QTCSVFILEFOLLOWER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class FileFollowerPrivate;
+
+    // FileFollower follows a csv-file that is being appended (like
+    // "tail -f") and delivers only new complete rows.
+    //
+    // Follower remembers position of the end of the last delivered row and
+    // keeps bytes of the incomplete last row (for example, a multi-line
+    // quoted value that is still being written) in memory. On each check
+    // it reads only bytes that were appended since the previous check. Row
+    // is complete when its line end is written.
+    //
+    // File is checked when QFileSystemWatcher reports its change and by
+    // timer, because watcher doesn't work on some file systems. If the file
+    // became shorter or bytes before the remembered position were changed
+    // (file was truncated or replaced by log rotation), follower starts to
+    // read the file from the beginning and emits fileReset().
+    class QTCSVSHARED_EXPORT FileFollower : public QObject {
+        Q_OBJECT
+        std::unique_ptr<FileFollowerPrivate> d;
+
+    public:
+        explicit FileFollower(QObject* parent = nullptr);
+        ~FileFollower() override;
+
+        // Start to follow the csv-file. Existing rows are delivered by the
+        // first check unless 'skipExisting' is set.
+        bool start(
+            const QString& filePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            bool skipExisting = false);
+        // Stop following the file
+        void stop();
+        // Check if file is being followed
+        bool isFollowing() const;
+
+        // Set interval of checks by timer in milliseconds (default is 1000).
+        // 0 disables timer, file is checked only on watcher notifications.
+        void setPollInterval(int msecs);
+        // Get position of the end of the last delivered row in bytes
+        qint64 position() const;
+        // Get number of delivered rows since start or last reset
+        qint64 rowCount() const;
+
+    public Q_SLOTS:
+        // Read rows that were appended to the file since the previous check
+        // and emit rowsAppended() if there are any. Returns False if file
+        // could not be read.
+        bool poll();
+
+    Q_SIGNALS:
+        // New complete rows were appended to the file
+        void rowsAppended(const QList<QList<QString>>& rows);
+        // File was truncated or replaced, it will be read from the
+        // beginning
+        void fileReset();
+    };
+}
+
+#endif // QTCSVFILEFOLLOWER_H
@@ -0,0 +1,39 @@
+#ifndef QTCSVFILEMERGER_H
+#define QTCSVFILEMERGER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include "qtcsv/writer.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+
+namespace QtCSV {
+
+    // FileMerger concatenates csv-files with the same format into one file.
+    // It is a faster alternative to reading of each file by Reader and
+    // writing of its rows by Writer in WriteMode::APPEND mode.
+    //
+    // Rows are not parsed: only the first row of each file is found (the
+    // same way as IndexedData does it) and the rest of the file is copied
+    // as a byte range (by the kernel on Linux, see FileSplitter). If files
+    // have a header, headers of all files should be equal, only the header
+    // of the first file is written. Byte order mark is written only once.
+    // If a file doesn't end with a line end, the line end of the first file
+    // is added after its last row. Files should have the same encoding.
+    class QTCSVSHARED_EXPORT FileMerger {
+    public:
+        // Merge csv-files into one file. In WriteMode::APPEND mode files are
+        // appended to the existing file, its header is compared with
+        // headers of files. On error the output file is not changed.
+        static bool merge(
+            const QList<QString>& filePaths,
+            const QString& outputFilePath,
+            bool hasHeader = false,
+            Writer::WriteMode mode = Writer::WriteMode::REWRITE,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+    };
+}
+
+#endif // QTCSVFILEMERGER_H
@@ -0,0 +1,71 @@
+#ifndef QTCSVFILESPLITTER_H
+#define QTCSVFILESPLITTER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class FileSplitterPrivate;
+
+    // FileSplitter cuts a csv-file into several csv-files (parts) in one
+    // directory, for example to process them on different machines. Files
+    // are cut only at row ends, so multi-line quoted values stay whole.
+    //
+    // Row ends are found without parsing of values (the same way as
+    // IndexedData does it) and parts are copied as byte ranges. On Linux
+    // ranges are copied by the kernel (copy_file_range()), on other systems
+    // they are written from the memory-mapped file. Parts are copied by
+    // several threads while the rest of the file is scanned.
+    //
+    // Parts are named "<baseName>_<number>.csv", numbers start from 00001.
+    // Byte order mark and header (if any) of the file are copied to the
+    // beginning of each part. Files that already exist are overwritten.
+    class QTCSVSHARED_EXPORT FileSplitter {
+        std::unique_ptr<FileSplitterPrivate> d;
+
+    public:
+        // How the file is split
+        enum class Split {
+            // Into the given number of parts of about the same size. There
+            // could be fewer parts if rows are big.
+            PARTS = 0,
+            // Into parts that are not bigger than the given number of bytes.
+            // Part that holds only one row could be bigger.
+            BYTES,
+            // Into parts with the given number of rows (without header)
+            ROWS
+        };
+
+        FileSplitter(const QString& dirPath, const QString& baseName);
+        ~FileSplitter();
+
+        FileSplitter(const FileSplitter&) = delete;
+        FileSplitter& operator=(const FileSplitter&) = delete;
+
+        // Set how the file is split. Value must be positive. By default file
+        // is split into 2 parts.
+        void setSplit(Split split, qint64 value);
+        // If set, the first row of the file is a header. It is copied to
+        // each part.
+        void setHasHeader(bool hasHeader);
+        // Set number of threads that copy parts. By default it is equal to
+        // the number of CPU cores.
+        void setThreadCount(int count);
+
+        // Split the csv-file. File without data rows produces no parts.
+        bool split(
+            const QString& filePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Get paths of parts created by the last split
+        QList<QString> files() const;
+    };
+}
+
+#endif // QTCSVFILESPLITTER_H
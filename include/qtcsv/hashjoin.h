@@ -0,0 +1,94 @@
+#ifndef QTCSVHASHJOIN_H
+#define QTCSVHASHJOIN_H
+
+#include "qtcsv/qtcsv_global.h"
+#include "qtcsv/reader.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class HashJoinPrivate;
+
+    // HashJoin joins rows of two csv-files by values of key columns. It is
+    // made for enrichment of a big file (left) with columns of a smaller one
+    // (right).
+    //
+    // Rows of the right file are loaded into a hash table. Then the left
+    // file is memory-mapped and its rows are matched against the table in
+    // batches by several threads. Each joined row contains values of the
+    // left row and then values of the right row without its key columns.
+    // If a left row matches several right rows, a joined row is created for
+    // each of them.
+    //
+    // If the hash table doesn't fit into the memory limit, rows of both
+    // files are split by hash of the key into partitions on disk and
+    // partitions are joined one by one (grace hash join). Without partitions
+    // joined rows have the order of the left file, with partitions they are
+    // grouped by partitions.
+    class QTCSVSHARED_EXPORT HashJoin {
+        std::unique_ptr<HashJoinPrivate> d;
+
+    public:
+        enum class Type {
+            // Only left rows that have matching right rows
+            INNER = 0,
+            // All left rows. Left rows without a match get empty values.
+            LEFT
+        };
+
+        HashJoin();
+        ~HashJoin();
+
+        HashJoin(const HashJoin&) = delete;
+        HashJoin& operator=(const HashJoin&) = delete;
+
+        // Set type of the join (default is Type::INNER)
+        void setType(Type type);
+        // Set key columns of the left and the right files. Lists should have
+        // the same size. By default rows are joined by the first column.
+        void setKeys(
+            const QList<qsizetype>& leftColumns,
+            const QList<qsizetype>& rightColumns);
+        // Set approximate amount of memory (in bytes) for the hash table.
+        // Default is 256 MB.
+        void setMemoryLimit(qint64 bytes);
+        // Set directory for temporary files. By default system temporary
+        // directory is used.
+        void setTempDir(const QString& dirPath);
+        // Set number of partitions of the data that doesn't fit into memory
+        // (default is 16)
+        void setPartitionCount(qsizetype count);
+        // Set number of threads. By default it is equal to the number of CPU
+        // cores.
+        void setThreadCount(int count);
+        // Set approximate size of a batch of left rows in bytes (default is
+        // 1 MB)
+        void setBatchSize(qint64 bytes);
+        // If set, the first rows of both files are headers. Joined header is
+        // the first row of the result.
+        void setHasHeader(bool hasHeader);
+
+        // Join csv-files and write result to another csv-file
+        bool join(
+            const QString& leftFilePath,
+            const QString& rightFilePath,
+            const QString& outputFilePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+
+        // Join csv-files and pass joined rows to the processor
+        bool join(
+            const QString& leftFilePath,
+            const QString& rightFilePath,
+            Reader::AbstractProcessor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+    };
+}
+
+#endif // QTCSVHASHJOIN_H
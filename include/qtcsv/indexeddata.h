@@ -0,0 +1,63 @@
+#ifndef QTCSVINDEXEDDATA_H
+#define QTCSVINDEXEDDATA_H
+
+#include "qtcsv/abstractdata.h"
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class IndexedDataPrivate;
+
+    // IndexedData is a container class that gives access to rows of a
+    // csv-file without reading the whole file.
+    //
+    // On open the file is memory-mapped and one quick pass finds the
+    // positions of rows, taking into account line breaks inside of
+    // quoted values. After that number of rows is known, and rowValues()
+    // parses only the requested row. Recently parsed rows are cached.
+    //
+    // IndexedData implements AbstractData interface, so it could be passed
+    // to Writer. Rows that are added to it are kept in memory and go after
+    // the rows of the file. File should not be changed while it is open.
+    class QTCSVSHARED_EXPORT IndexedData : public AbstractData {
+        std::unique_ptr<IndexedDataPrivate> d;
+
+    public:
+        IndexedData();
+        ~IndexedData() override;
+
+        IndexedData(const IndexedData&) = delete;
+        IndexedData& operator=(const IndexedData&) = delete;
+
+        // Open csv-file and build index of its rows
+        bool open(
+            const QString& filePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Check if csv-file is open
+        bool isOpen() const;
+        // Set max number of parsed rows that are cached (default is 256)
+        void setCacheSize(qsizetype rows);
+
+        // Add new empty row
+        void addEmptyRow() override;
+        // Add new row with specified values
+        void addRow(const QList<QString>& values) override;
+        // Clear all data and close the csv-file
+        void clear() override;
+        // Check if there are any rows
+        bool isEmpty() const override;
+        // Get number of rows
+        qsizetype rowCount() const override;
+        // Get values of specified row as list of strings
+        QList<QString> rowValues(qsizetype row) const override;
+    };
+}
+
+#endif // QTCSVINDEXEDDATA_H
@@ -0,0 +1,52 @@
+#ifndef QTCSVINTERNER_H
+#define QTCSVINTERNER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QSet>
+#include <QString>
+
+namespace QtCSV {
+
+    // Interner replaces equal values of a column with one shared instance
+    // of QString. Columns with a few distinct values (country, status,
+    // currency) then take memory only for their distinct values, and equal
+    // values are compared by pointer.
+    //
+    // Each column has its own table of distinct values. If number of
+    // distinct values of a column exceeds the limit, column is not interned
+    // anymore and its table is freed.
+    class QTCSVSHARED_EXPORT Interner {
+    public:
+        // Default maximum number of distinct values of a column
+        static constexpr qsizetype DEFAULT_MAX_CARDINALITY = 1024;
+
+        explicit Interner(
+            qsizetype maxCardinality = DEFAULT_MAX_CARDINALITY);
+
+        // Replace values of the row with shared instances
+        void intern(QList<QString>& values);
+        // Get shared instance of the value of the column
+        QString intern(qsizetype column, const QString& value);
+
+        // Check if values of the column are interned
+        bool isInterned(qsizetype column) const;
+        // Get number of distinct values of the column in the table
+        qsizetype cardinality(qsizetype column) const;
+        // Get maximum number of distinct values of a column
+        qsizetype maxCardinality() const;
+        // Free tables of all columns and enable interning of them
+        void clear();
+
+    private:
+        struct Column {
+            QSet<QString> values;
+            bool isInterned = true;
+        };
+
+        QList<Column> m_columns;
+        qsizetype m_maxCardinality;
+    };
+}
+
+#endif // QTCSVINTERNER_H
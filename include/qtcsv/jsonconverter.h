@@ -0,0 +1,81 @@
+#ifndef QTCSVJSONCONVERTER_H
+#define QTCSVJSONCONVERTER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QIODevice>
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class JsonConverterPrivate;
+
+    // JsonConverter converts csv-data to JSON objects and writes them to IO
+    // Device as NDJSON (one object per line) or as JSON array. Keys of
+    // objects are values of the header (the first row of data) or keys set
+    // by setKeys(). Missing values of a row are written as null, values
+    // without a key get the number of their column as a key.
+    //
+    // Rows are converted by batches in several threads, each batch writes
+    // JSON (UTF-8) to its own buffer, buffers are written to IO Device in
+    // order of rows and reused. So memory usage doesn't depend on the size
+    // of the data. Csv-file is memory-mapped and parsed by threads too,
+    // other IO Devices are parsed by the calling thread.
+    //
+    // By default all values are JSON strings. With type inference values
+    // that are JSON numbers (like "-1.5e3", but not "007") are written as
+    // numbers, "true" and "false" as booleans and empty values as null.
+    class QTCSVSHARED_EXPORT JsonConverter {
+        std::unique_ptr<JsonConverterPrivate> d;
+
+    public:
+        // Format of JSON output
+        enum class Format {
+            // One object per line
+            NDJSON = 0,
+            // Array of objects
+            ARRAY
+        };
+
+        JsonConverter();
+        ~JsonConverter();
+
+        JsonConverter(const JsonConverter&) = delete;
+        JsonConverter& operator=(const JsonConverter&) = delete;
+
+        // Set format of JSON output (default is Format::NDJSON)
+        void setFormat(Format format);
+        // If set, numbers, booleans and empty values are written as JSON
+        // numbers, booleans and null
+        void setTypeInference(bool infer);
+        // Set keys of objects. If they are set, the first row of data is not
+        // a header. By default keys are taken from the header.
+        void setKeys(const QList<QString>& keys);
+        // Set number of threads. By default it is equal to the number of CPU
+        // cores.
+        void setThreadCount(int count);
+        // Set approximate size of a batch of rows in bytes (default is 1 MB)
+        void setBatchSize(qint64 bytes);
+
+        // Convert csv-file to JSON and write it to IO Device
+        bool convert(
+            const QString& filePath,
+            QIODevice& output,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+
+        // Convert csv-data of IO Device to JSON and write it to another IO
+        // Device
+        bool convert(
+            QIODevice& input,
+            QIODevice& output,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+    };
+}
+
+#endif // QTCSVJSONCONVERTER_H
@@ -0,0 +1,131 @@
+#ifndef QTCSVMULTIREADER_H
+#define QTCSVMULTIREADER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include "qtcsv/reader.h"
+#include <QIODevice>
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class MultiReaderPrivate;
+
+    // MultiReader reads many csv-files (or IO Devices) with the same format
+    // concurrently and passes their rows to one processor. It is made for
+    // directories with thousands of small and medium files.
+    //
+    // Each file is parsed by one thread of the pool, so number of threads is
+    // also the max number of simultaneously open files. Rows of one file are
+    // passed in order, rows of different files are interleaved. Error of
+    // one file (file could not be opened, header doesn't match) doesn't stop
+    // reading of other files, it is reported in FileResult of the file.
+    // Reading of all files stops only if processor returns False.
+    //
+    // AbstractProcessor is called by one thread at a time: threads parse
+    // batches of rows and pass them to the processor under a lock.
+    // ConcurrentProcessor is called by all threads at the same time without
+    // any lock. preProcessRawLine() of processors is not called.
+    class QTCSVSHARED_EXPORT MultiReader {
+        std::unique_ptr<MultiReaderPrivate> d;
+
+    public:
+        // Header of files
+        enum class Header {
+            // Files have no header, all rows are passed to the processor
+            NONE = 0,
+            // The first row of each file is a header, it is skipped
+            SKIP,
+            // The first row of each file is a header, it should be equal to
+            // the expected header. Files with other headers are not read.
+            VERIFY
+        };
+
+        // Result of reading of one file
+        struct FileResult {
+            // Path to the file. Empty for IO Devices.
+            QString filePath;
+            // True if all rows of the file were passed to the processor
+            bool isRead = false;
+            // Number of rows that were passed to the processor
+            qint64 rows = 0;
+            // Description of the error
+            QString error;
+        };
+
+        // Processor that is called from several threads at the same time, so
+        // it should be thread-safe
+        class QTCSVSHARED_EXPORT ConcurrentProcessor {
+        public:
+            virtual ~ConcurrentProcessor() = default;
+
+            // Process row of the file with index 'source' in the list of
+            // files. Return False to stop reading of all files.
+            virtual bool processRowElements(
+                qsizetype source, const QList<QString>& elements) = 0;
+        };
+
+        MultiReader();
+        ~MultiReader();
+
+        MultiReader(const MultiReader&) = delete;
+        MultiReader& operator=(const MultiReader&) = delete;
+
+        // Set number of threads and max number of simultaneously open
+        // files. By default it is equal to the number of CPU cores.
+        void setThreadCount(int count);
+        // Set header of files (default is Header::NONE)
+        void setHeader(Header header);
+        // Set header that files should have in Header::VERIFY mode. If it is
+        // empty (default), header of the first file is expected.
+        void setExpectedHeader(const QList<QString>& header);
+        // Get header of files of the last reading
+        QList<QString> header() const;
+
+        // Get sorted list of absolute paths of files in the directory which
+        // names match the wildcard pattern
+        static QList<QString> findFiles(
+            const QString& dirPath,
+            const QString& pattern = QString("*.csv"));
+
+        // Read csv-files and pass their rows to the processor one by one
+        bool readToProcessor(
+            const QList<QString>& filePaths,
+            Reader::AbstractProcessor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            QList<FileResult>* results = nullptr);
+
+        // Read csv-files and pass their rows to the processor concurrently
+        bool readToProcessor(
+            const QList<QString>& filePaths,
+            ConcurrentProcessor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            QList<FileResult>* results = nullptr);
+
+        // Read IO Devices and pass their rows to the processor one by one
+        bool readToProcessor(
+            const QList<QIODevice*>& devices,
+            Reader::AbstractProcessor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            QList<FileResult>* results = nullptr);
+
+        // Read IO Devices and pass their rows to the processor concurrently
+        bool readToProcessor(
+            const QList<QIODevice*>& devices,
+            ConcurrentProcessor& processor,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            QList<FileResult>* results = nullptr);
+    };
+}
+
+#endif // QTCSVMULTIREADER_H
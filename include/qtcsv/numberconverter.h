@@ -0,0 +1,61 @@
+#ifndef QTCSVNUMBERCONVERTER_H
+#define QTCSVNUMBERCONVERTER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QChar>
+#include <QString>
+#include <QStringView>
+#include <QVariant>
+
+namespace QtCSV {
+
+    // NumberFormat holds settings that are used to convert floating point
+    // numbers to strings and back.
+    struct NumberFormat {
+        // Number of digits after the decimal separator. Negative value means
+        // that the shortest representation that could be converted back to
+        // the same value will be used.
+        int precision = -1;
+        // Symbol that separates integral and fractional parts of a number
+        QChar decimalSeparator = QChar('.');
+    };
+
+    // NumberConverter is a helper class that converts numbers to strings and
+    // strings to numbers. It does not depend on the current locale and is
+    // much faster than QVariant/QString conversion functions, so it is used
+    // by VariantData to prepare numeric values for writing. You can also
+    // use it to convert numeric columns of csv-data that you have read.
+    class QTCSVSHARED_EXPORT NumberConverter {
+    public:
+        // Convert integer to string
+        static QString toString(qint64 value);
+        static QString toString(quint64 value);
+        // Convert floating point number to string
+        static QString toString(
+            double value, const NumberFormat& format = NumberFormat());
+
+        // Convert numeric QVariant (integer or floating point number) to
+        // string. Returns False if value does not hold a number.
+        static bool toString(
+            const QVariant& value,
+            QString& result,
+            const NumberFormat& format = NumberFormat());
+
+        // Convert string to integer
+        static qint64 toLongLong(QStringView str, bool* ok = nullptr);
+        static quint64 toULongLong(QStringView str, bool* ok = nullptr);
+        // Convert string to floating point number
+        static double toDouble(
+            QStringView str,
+            bool* ok = nullptr,
+            QChar decimalSeparator = QChar('.'));
+
+        // Convert string to QVariant that holds integer (qint64) or
+        // floating point number (double). If string is not a number,
+        // returns invalid QVariant.
+        static QVariant toNumber(
+            QStringView str, QChar decimalSeparator = QChar('.'));
+    };
+}
+
+#endif // QTCSVNUMBERCONVERTER_H
@@ -0,0 +1,74 @@
+#ifndef QTCSVPARTITIONEDWRITER_H
+#define QTCSVPARTITIONEDWRITER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include "abstractdata.h"
+#include "rowsource.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class PartitionedWriterPrivate;
+
+    // PartitionedWriter is a writer that distributes rows between several
+    // csv-files in one directory. It could:
+    // - split rows by the value of a key column, so each distinct value gets
+    // its own file (for example, one file per customer);
+    // - rotate files when they reach the limit of rows or bytes.
+    //
+    // Files are named "<baseName>[_<key>][_<number>].csv". Key part is
+    // present only if key column is set. Special symbols of the key are
+    // percent-encoded. Keys that differ only in case get numbers ("a",
+    // "A@2"), so their files differ on case-insensitive file systems too.
+    // Number part is present only if rotation is enabled.
+    //
+    // Writer keeps a bounded pool of open files. If rows of a new partition
+    // arrive when the pool is full, the least recently used file is closed
+    // and will be reopened in append mode if needed. Header (if any) is
+    // written at the beginning of each file. Rows are formatted exactly as
+    // Writer does it. Files that already exist are overwritten.
+    class QTCSVSHARED_EXPORT PartitionedWriter {
+        std::unique_ptr<PartitionedWriterPrivate> d;
+
+    public:
+        PartitionedWriter(
+            const QString& dirPath,
+            const QString& baseName,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            const QList<QString>& header = {},
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+        ~PartitionedWriter();
+
+        PartitionedWriter(const PartitionedWriter&) = delete;
+        PartitionedWriter& operator=(const PartitionedWriter&) = delete;
+
+        // Set index of the key column. Negative value disables
+        // partitioning by key (default).
+        void setKeyColumn(qsizetype column);
+        // Set max number of data rows in one file. 0 means no limit
+        // (default).
+        void setMaxRowsPerFile(qint64 rows);
+        // Set max size of one file in bytes. 0 means no limit (default).
+        void setMaxBytesPerFile(qint64 bytes);
+        // Set max number of simultaneously open files (default is 16)
+        void setMaxOpenFiles(qsizetype number);
+
+        // Write one row
+        bool writeRow(const QList<QString>& values);
+        // Write all rows of the container
+        bool write(const AbstractData& data);
+        // Write all rows of the source
+        bool write(AbstractRowSource& source);
+
+        // Flush and close all open files
+        bool close();
+        // Get paths of all files created by the writer
+        QList<QString> files() const;
+    };
+}
+
+#endif // QTCSVPARTITIONEDWRITER_H
@@ -0,0 +1,62 @@
+#ifndef QTCSVPROGRESS_H
+#define QTCSVPROGRESS_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <atomic>
+#include <functional>
+
+namespace QtCSV {
+
+    // Progress reports progress of long read and write operations and allows
+    // to cancel them. Pass pointer to it to any Reader or Writer function.
+    //
+    // Callback is called from the thread that reads or writes data: every
+    // interval() rows and once more when operation is finished. cancel()
+    // could be called from any thread. Operation checks the flag after each
+    // row and stops as soon as it is set: Reader function returns False (or
+    // empty list) and doesn't transfer data to the container, Writer
+    // function returns False (in WriteMode::REWRITE mode destination file is
+    // not changed).
+    class QTCSVSHARED_EXPORT Progress {
+    public:
+        // State of the operation
+        struct State {
+            // Number of bytes that were read or written
+            qint64 bytes = 0;
+            // Estimated total number of bytes. For reading it is the size of
+            // the rest of the file, -1 if it is not known (sequential IO
+            // Device or writing).
+            qint64 totalBytes = -1;
+            // Number of rows that were read or written
+            qint64 rows = 0;
+        };
+
+        using Callback = std::function<void(const State& state)>;
+
+        explicit Progress(Callback callback = {}, qint64 interval = 1000);
+
+        Progress(const Progress&) = delete;
+        Progress& operator=(const Progress&) = delete;
+
+        // Set function that will receive state of the operation
+        void setCallback(Callback callback);
+        const Callback& callback() const;
+        // Set number of rows between calls of the callback
+        void setInterval(qint64 rows);
+        qint64 interval() const;
+
+        // Ask operation to stop. Thread-safe.
+        void cancel();
+        // Check if operation was asked to stop. Thread-safe.
+        bool isCanceled() const;
+        // Clear cancel flag, so object could be used again
+        void reset();
+
+    private:
+        Callback m_callback;
+        qint64 m_interval;
+        std::atomic<bool> m_canceled;
+    };
+}
+
+#endif // QTCSVPROGRESS_H
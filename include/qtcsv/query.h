@@ -0,0 +1,118 @@
+#ifndef QTCSVQUERY_H
+#define QTCSVQUERY_H
+
+#include "qtcsv/abstractdata.h"
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <functional>
+#include <memory>
+
+namespace QtCSV {
+
+    class QueryPrivate;
+
+    // Query filters rows of a csv-file, selects some of their columns or
+    // aggregates values of groups of rows. It is a faster alternative to
+    // a hand-written AbstractProcessor for such tasks.
+    //
+    // File is memory-mapped and split into batches of rows, batches are
+    // processed by several threads. Parser processes only values of columns
+    // that are used by the query, rows that don't match conditions are not
+    // stored. Processed batches are taken in order of the file: their rows
+    // are passed to the result at once, their groups are merged with
+    // groups of previous batches. Order of rows (and of groups) is the same
+    // as in the file.
+    //
+    // Example - sum of the column 2 grouped by the column 0 for rows where
+    // the column 1 is "paid":
+    //     QtCSV::Query query;
+    //     query.where(1, QtCSV::Query::Op::EQUAL, "paid")
+    //          .groupBy({0})
+    //          .aggregate(QtCSV::Query::Aggregate::SUM, 2);
+    //     const auto rows = query.runToList("/path/to/file.csv");
+    class QTCSVSHARED_EXPORT Query {
+        std::unique_ptr<QueryPrivate> d;
+
+    public:
+        // Comparison of the value of a column with the value of a
+        // condition. LESS and GREATER operations compare numbers if both
+        // values are numbers and compare strings otherwise.
+        enum class Op {
+            EQUAL = 0,
+            NOT_EQUAL,
+            LESS,
+            LESS_OR_EQUAL,
+            GREATER,
+            GREATER_OR_EQUAL,
+            CONTAINS,
+            STARTS_WITH,
+            ENDS_WITH
+        };
+
+        // Aggregate function. COUNT of column -1 counts rows, COUNT of
+        // a column counts its non-empty values. Other functions use only
+        // numeric values of the column.
+        enum class Aggregate {
+            COUNT = 0,
+            SUM,
+            MIN,
+            MAX,
+            AVG
+        };
+
+        // Custom condition. It is called from several threads.
+        using Predicate = std::function<bool(const QString& value)>;
+
+        Query();
+        ~Query();
+
+        Query(const Query&) = delete;
+        Query& operator=(const Query&) = delete;
+
+        // Add condition for the value of the column. Row should match all
+        // conditions.
+        Query& where(qsizetype column, Op op, const QString& value);
+        Query& where(qsizetype column, const Predicate& predicate);
+        // Set columns of the result rows. By default all columns are
+        // returned. Could not be used together with groups and aggregates.
+        Query& select(const QList<qsizetype>& columns);
+        // Set columns which values define groups of rows. Result contains
+        // one row per group: values of these columns and then values of
+        // the aggregates.
+        Query& groupBy(const QList<qsizetype>& columns);
+        // Add aggregate function of the column
+        Query& aggregate(Aggregate function, qsizetype column = -1);
+        // If set, duplicate result rows are removed
+        Query& setDistinct(bool distinct);
+        // Remove all conditions, columns and aggregates
+        void clear();
+
+        // If set, the first row is a header and is not processed
+        void setHasHeader(bool hasHeader);
+        // Set number of threads. By default it is equal to the number of CPU
+        // cores.
+        void setThreadCount(int count);
+        // Set approximate size of a batch of rows in bytes (default is 1 MB)
+        void setBatchSize(qint64 bytes);
+
+        // Run query on the csv-file and add result rows to the container
+        bool run(
+            const QString& filePath,
+            AbstractData& result,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+
+        // Run query on the csv-file and return result rows. On error
+        // returns empty list.
+        QList<QList<QString>> runToList(
+            const QString& filePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8) const;
+    };
+}
+
+#endif // QTCSVQUERY_H
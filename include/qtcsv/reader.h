@@ -3,6 +3,9 @@
 
 #include "qtcsv/qtcsv_global.h"
 #include "abstractdata.h"
+#include "qtcsv/checkpoint.h"
+#include "qtcsv/progress.h"
+#include "qtcsv/stats.h"
 #include <QIODevice>
 #include <QList>
 #include <QString>
@@ -20,13 +23,19 @@ namespace QtCSV {
     // - text delimiter character (or string) that encloses each element in a
     // row. Typical delimiter characters: none (""), quote ("'")
     // and double quotes ("\"");
-    // - text codec.
+    // - text codec;
+    // - ReadStats object that will collect statistics of reading;
+    // - Progress object that will receive progress of reading and could
+    // cancel it.
     //
     // Reader can save (or transfer) information to:
     // - QList<QList<QString>>, where each QList<QString> contains values
     // of one row;
     // - AbstractData-based container class;
     // - AbstractProcessor-based object.
+    //
+    // Reading of big files could be resumed from a checkpoint that was taken
+    // by AbstractProcessor (see ReadCheckpoint).
     class QTCSVSHARED_EXPORT Reader {
     public:
         // AbstractProcessor is a class that could be used to process csv-data
@@ -49,6 +58,15 @@ namespace QtCSV {
             // of error. If process() return False, the csv-file will be stopped
             // reading
             virtual bool processRowElements(const QList<QString>& elements) = 0;
+
+            // Get checkpoint after the row that is being processed. It
+            // could be called only from processRowElements() of the
+            // processor that was passed to readToProcessor() or
+            // resumeToProcessor(), on the thread of that call. Otherwise or
+            // if IO Device is sequential, returns invalid checkpoint. Call
+            // costs about as much as reading of a few kilobytes, so take
+            // checkpoints every N rows.
+            ReadCheckpoint checkpoint() const;
         };
 
         // Read csv-file and save it's data as strings to QList<QList<QString>>
@@ -56,7 +74,9 @@ namespace QtCSV {
             const QString& filePath,
             const QString& separator = QString(","),
             const QString& textDelimiter = QString("\""),
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
 
         // Read csv-formatted data from IO Device and save it
         // as strings to QList<QList<QString>>
@@ -64,7 +84,9 @@ namespace QtCSV {
             QIODevice& ioDevice,
             const QString& separator = QString(","),
             const QString& textDelimiter = QString("\""),
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
 
         // Read csv-file and save it's data to AbstractData-based container
         // class
@@ -73,7 +95,9 @@ namespace QtCSV {
             AbstractData& data,
             const QString& separator = QString(","),
             const QString& textDelimiter = QString("\""),
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
 
         // Read csv-formatted data from IO Device and save it
         // to AbstractData-based container class
@@ -82,7 +106,9 @@ namespace QtCSV {
             AbstractData& data,
             const QString& separator = QString(","),
             const QString& textDelimiter = QString("\""),
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
 
         // Read csv-file and process it line-by-line
         static bool readToProcessor(
@@ -90,7 +116,9 @@ namespace QtCSV {
             AbstractProcessor& processor,
             const QString& separator = QString(","),
             const QString& textDelimiter = QString("\""),
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
 
         // Read csv-formatted data from IO Device and process it line-by-line
         static bool readToProcessor(
@@ -98,7 +126,27 @@ namespace QtCSV {
             AbstractProcessor& processor,
             const QString& separator = QString(","),
             const QString& textDelimiter = QString("\""),
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
+
+        // Resume reading of csv-file from the checkpoint and process rest
+        // of the file line-by-line
+        static bool resumeToProcessor(
+            const QString& filePath,
+            AbstractProcessor& processor,
+            const ReadCheckpoint& checkpoint,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
+
+        // Resume reading of csv-formatted data from IO Device from the
+        // checkpoint and process rest of the data line-by-line
+        static bool resumeToProcessor(
+            QIODevice& ioDevice,
+            AbstractProcessor& processor,
+            const ReadCheckpoint& checkpoint,
+            ReadStats* stats = nullptr,
+            Progress* progress = nullptr);
     };
 }
 
@@ -0,0 +1,78 @@
+#ifndef QTCSVROWSAMPLER_H
+#define QTCSVROWSAMPLER_H
+
+#include "qtcsv/abstractdata.h"
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class RowSamplerPrivate;
+
+    // RowSampler reads random sample of rows of csv-file without reading
+    // of the whole file into memory, for example to look at the data of a
+    // multi-gigabyte file. Sampled rows are added to AbstractData (usually
+    // StringData) in the order of the file.
+    //
+    // Method::RESERVOIR gives exact uniform sample: row ends are found in
+    // one pass over the memory-mapped file (the same way as IndexedData
+    // does it), and only sampled rows are parsed. Method::OFFSETS is much
+    // faster for big files: it reads rows at random byte positions, so it
+    // reads only a small part of the file. Row at a random position is
+    // found by a heuristic: after a line end that is followed by rows with
+    // the same number of values as the first row of the file. It works
+    // with multi-line quoted values, but the sample is approximate: row
+    // that follows a long row is sampled more often.
+    //
+    // Sample depends only on the file and the seed, so it could be
+    // reproduced by setting the same seed.
+    class QTCSVSHARED_EXPORT RowSampler {
+        std::unique_ptr<RowSamplerPrivate> d;
+
+    public:
+        // How rows are sampled
+        enum class Method {
+            // Exact uniform sample in one pass over the file
+            RESERVOIR = 0,
+            // Approximate sample of rows at random byte positions
+            OFFSETS
+        };
+
+        RowSampler();
+        ~RowSampler();
+
+        RowSampler(const RowSampler&) = delete;
+        RowSampler& operator=(const RowSampler&) = delete;
+
+        // Set method of sampling (default is Method::RESERVOIR)
+        void setMethod(Method method);
+        // Set seed of random numbers. By default it is random.
+        void setSeed(quint32 seed);
+        // Get seed of random numbers
+        quint32 seed() const;
+        // If set, the first row of the file is a header. It is not sampled.
+        void setHasHeader(bool hasHeader);
+
+        // Add random sample of rows of the csv-file to the data. If file has
+        // fewer rows than count, all of them are added (Method::OFFSETS
+        // could miss some of them).
+        bool sample(
+            const QString& filePath,
+            qint64 count,
+            AbstractData& data,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Get values of the header read by the last sample
+        QList<QString> header() const;
+        // Get number of rows of the file (without header) that was counted by
+        // the last sample. It is -1 for Method::OFFSETS.
+        qint64 rowCount() const;
+    };
+}
+
+#endif // QTCSVROWSAMPLER_H
@@ -0,0 +1,60 @@
+#ifndef QTCSVROWSOURCE_H
+#define QTCSVROWSOURCE_H
+
+#include "qtcsv/abstractdata.h"
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QString>
+#include <functional>
+
+namespace QtCSV {
+
+    // AbstractRowSource is an interface of a forward-only source of rows.
+    // Unlike AbstractData, it doesn't need to know the number of rows and
+    // doesn't provide random access to them, so rows could be generated on
+    // the fly, fetched from a database cursor or produced by some
+    // transformation pipeline. Writer asks the source for rows one by one
+    // and never holds more than one chunk of rows in memory.
+    class QTCSVSHARED_EXPORT AbstractRowSource {
+    public:
+        virtual ~AbstractRowSource() = default;
+
+        // Get values of the next row
+        // @input:
+        // - values - list that should be filled with values of the next row.
+        // The same list is passed on each call, so its memory could be
+        // reused. It is cleared before each call, so values could be
+        // appended to it.
+        // @output:
+        // bool - True if values of the next row were returned, False if
+        // there are no more rows
+        virtual bool nextRow(QList<QString>& values) = 0;
+    };
+
+    // DataRowSource returns rows of AbstractData-based container one by one
+    class QTCSVSHARED_EXPORT DataRowSource : public AbstractRowSource {
+        const AbstractData& m_data;
+        qsizetype m_row;
+
+    public:
+        explicit DataRowSource(const AbstractData& data);
+        bool nextRow(QList<QString>& values) override;
+    };
+
+    // FunctionRowSource returns rows that are produced by a function (or
+    // any other callable object). Function should fill the list with values
+    // of the next row and return True, or return False if there are no more
+    // rows.
+    class QTCSVSHARED_EXPORT FunctionRowSource : public AbstractRowSource {
+    public:
+        using Function = std::function<bool(QList<QString>&)>;
+
+        explicit FunctionRowSource(Function function);
+        bool nextRow(QList<QString>& values) override;
+
+    private:
+        Function m_function;
+    };
+}
+
+#endif // QTCSVROWSOURCE_H
@@ -0,0 +1,121 @@
+#ifndef QTCSVSCHEMA_H
+#define QTCSVSCHEMA_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QChar>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVariant>
+
+namespace QtCSV {
+
+    class TypedProcessorPrivate;
+
+    // Schema describes columns of csv-data: their names, types of values,
+    // nullability and default values. It is used by TypedProcessor to
+    // convert values of each row while csv-data is read.
+    class QTCSVSHARED_EXPORT Schema {
+    public:
+        // Type of values of a column
+        enum class Type {
+            STRING = 0,
+            INTEGER,
+            DOUBLE,
+            BOOL
+        };
+
+        // Description of a column
+        struct Column {
+            // Name of the column in the header
+            QString name;
+            // Type of values
+            Type type = Type::STRING;
+            // If True, empty values are null, otherwise they are errors
+            bool nullable = true;
+            // Value that replaces empty values and is used if column is
+            // absent in the header. Invalid QVariant means no default value.
+            QVariant defaultValue;
+        };
+
+        Schema() = default;
+
+        // Add column description
+        Schema& addColumn(
+            const QString& name,
+            Type type = Type::STRING,
+            bool nullable = true,
+            const QVariant& defaultValue = QVariant());
+        // Get descriptions of columns
+        const QList<Column>& columns() const;
+        // Get number of columns
+        qsizetype columnCount() const;
+        // Check if schema has no columns
+        bool isEmpty() const;
+
+        // Set symbol that separates integral and fractional parts of numbers
+        void setDecimalSeparator(QChar separator);
+        QChar decimalSeparator() const;
+
+    private:
+        QList<Column> m_columns;
+        QChar m_decimalSeparator = QChar('.');
+    };
+
+    // TypedRow is a row of csv-data which values were converted according
+    // to the Schema. Values are in the order of columns of the schema and
+    // could be accessed by index or by name of the column. Accessing value
+    // of a different type converts it; null and absent values are returned
+    // as zero, False or empty string.
+    class QTCSVSHARED_EXPORT TypedRow {
+        friend class TypedProcessorPrivate;
+
+        struct Value {
+            Schema::Type type = Schema::Type::STRING;
+            bool isNull = true;
+            qint64 integer = 0;
+            double real = 0.0;
+            QString string;
+        };
+
+        QList<Value> m_values;
+        const QHash<QString, qsizetype>* m_indexes = nullptr;
+
+    public:
+        TypedRow() = default;
+
+        // Get number of values
+        qsizetype size() const;
+        // Get index of the column by its name. Returns -1 if there is no
+        // such column.
+        qsizetype indexOf(const QString& name) const;
+
+        // Get type of the value
+        Schema::Type type(qsizetype column) const;
+        // Check if value is null (empty or absent)
+        bool isNull(qsizetype column) const;
+        bool isNull(const QString& name) const;
+
+        // Get value as integer
+        qint64 toLongLong(qsizetype column) const;
+        qint64 toLongLong(const QString& name) const;
+        // Get value as floating point number
+        double toDouble(qsizetype column) const;
+        double toDouble(const QString& name) const;
+        // Get value as boolean
+        bool toBool(qsizetype column) const;
+        bool toBool(const QString& name) const;
+        // Get value as string
+        QString toString(qsizetype column) const;
+        QString toString(const QString& name) const;
+        // Get value as QVariant of the type of the column. Null values
+        // are returned as invalid QVariant.
+        QVariant value(qsizetype column) const;
+        QVariant value(const QString& name) const;
+
+    private:
+        const Value* at(qsizetype column) const;
+    };
+}
+
+#endif // QTCSVSCHEMA_H
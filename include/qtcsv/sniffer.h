@@ -0,0 +1,71 @@
+#ifndef QTCSVSNIFFER_H
+#define QTCSVSNIFFER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QIODevice>
+#include <QString>
+#include <QStringConverter>
+
+namespace QtCSV {
+
+    // Dialect holds format parameters of csv-data. Its fields could be
+    // passed directly to Reader functions:
+    //
+    // Reader::readToList(path, dialect.separator, dialect.textDelimiter,
+    //                    dialect.codec);
+    struct Dialect {
+        // String that separates values in a row
+        QString separator = QString(",");
+        // String that encloses values. Empty if values are not enclosed.
+        QString textDelimiter = QString("\"");
+        // Encoding of the data
+        QStringConverter::Encoding codec = QStringConverter::Utf8;
+        // True if data starts with byte order mark
+        bool hasBom = false;
+        // The most frequent line ending: "\n" or "\r\n". Line ending "\r"
+        // is not supported by Reader, so sniff() returns False for data with
+        // it (lineEnding is set to "\r").
+        QString lineEnding = QString("\n");
+        // True if the first row looks like a header with names of columns
+        bool hasHeader = false;
+    };
+
+    // Sniffer detects dialect of csv-data by a sample from the beginning
+    // of the data. Encoding is detected by byte order mark or, if there is
+    // no mark, by the content of the sample (UTF-16 without mark, UTF-8 or
+    // Latin-1). Separator (one of ',', ';', '\t', '|') and text delimiter
+    // ('"', '\'' or none) are chosen so that rows of the sample have the most
+    // consistent number of values. Header is detected by comparing values
+    // of the first row with values of other rows. Rows end at "\n" or
+    // "\r\n", the same as for Reader.
+    //
+    // Sample is peeked from IO Device, so data is not consumed and could be
+    // read after sniffing even from sequential devices.
+    class QTCSVSHARED_EXPORT Sniffer {
+    public:
+        // Default size (in bytes) of the sample
+        static constexpr qint64 DEFAULT_SAMPLE_SIZE = 64 * 1024;
+
+        // Detect dialect of csv-file
+        static bool sniff(
+            const QString& filePath,
+            Dialect& dialect,
+            qint64 sampleSize = DEFAULT_SAMPLE_SIZE);
+
+        // Detect dialect of csv-data in IO Device
+        static bool sniff(
+            QIODevice& ioDevice,
+            Dialect& dialect,
+            qint64 sampleSize = DEFAULT_SAMPLE_SIZE);
+
+        // Detect dialect of the sample of csv-data
+        // @input:
+        // - sample - bytes from the beginning of csv-data
+        // - isComplete - True if sample contains all data, False if the last
+        // line of the sample could be incomplete
+        static bool sniff(
+            const QByteArray& sample, Dialect& dialect, bool isComplete);
+    };
+}
+
+#endif // QTCSVSNIFFER_H
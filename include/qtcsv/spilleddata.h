@@ -0,0 +1,67 @@
+#ifndef QTCSVSPILLEDDATA_H
+#define QTCSVSPILLEDDATA_H
+
+#include "qtcsv/abstractdata.h"
+#include "qtcsv/qtcsv_global.h"
+#include <QList>
+#include <QString>
+#include <memory>
+
+namespace QtCSV {
+
+    class SpilledDataPrivate;
+
+    // SpilledData is a container class for csv-data that doesn't fit into
+    // memory.
+    //
+    // Rows are stored in blocks. While rows fit into the memory limit, all
+    // blocks are kept in memory. When the limit is exceeded, least recently
+    // used blocks are written to a temporary file in a compact binary form
+    // and are removed from memory. Block is read back when one of its rows
+    // is requested. Sequential access (for example, by Writer) reads each
+    // block only once.
+    //
+    // SpilledData implements AbstractData interface, so it could be filled
+    // by Reader::readToData() and passed to Writer. Container is not
+    // thread-safe even for reading, because rowValues() loads blocks.
+    class QTCSVSHARED_EXPORT SpilledData : public AbstractData {
+        std::unique_ptr<SpilledDataPrivate> d;
+
+    public:
+        SpilledData();
+        ~SpilledData() override;
+
+        SpilledData(const SpilledData&) = delete;
+        SpilledData& operator=(const SpilledData&) = delete;
+
+        // Set approximate amount of memory (in bytes) that could be used
+        // for rows. Default is 256 MB.
+        void setMemoryLimit(qint64 bytes);
+        // Set number of rows in a block (default is 1024). Could be changed
+        // only while container is empty.
+        bool setBlockSize(qsizetype rows);
+        // Set directory for the temporary file. By default system temporary
+        // directory is used.
+        void setTempDir(const QString& dirPath);
+
+        // Get approximate amount of memory (in bytes) used by rows
+        qint64 memoryUsage() const;
+        // Check if some blocks were written to the temporary file
+        bool isSpilled() const;
+
+        // Add new empty row
+        void addEmptyRow() override;
+        // Add new row with specified values
+        void addRow(const QList<QString>& values) override;
+        // Clear all data and remove the temporary file
+        void clear() override;
+        // Check if there are any rows
+        bool isEmpty() const override;
+        // Get number of rows
+        qsizetype rowCount() const override;
+        // Get values of specified row as list of strings
+        QList<QString> rowValues(qsizetype row) const override;
+    };
+}
+
+#endif // QTCSVSPILLEDDATA_H
@@ -0,0 +1,91 @@
+#ifndef QTCSVSQLIMPORTER_H
+#define QTCSVSQLIMPORTER_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QIODevice>
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class SqlImporterPrivate;
+
+    // SqlImporter imports rows of csv-data into a table of SQL database
+    // (made for SQLite, but works with any QtSql driver that supports
+    // transactions and multi-row inserts). It is built only if the library
+    // is configured with Qt Sql module (BUILD_SQL option of CMake or
+    // CONFIG+=qtcsv_sql of qmake).
+    //
+    // Names of columns are values of the header (the first row of data) or
+    // names set by setColumns(). New table is created with TEXT columns. If
+    // table exists, it should have all columns of the header, values are
+    // converted according to the types of its columns. Missing values of a
+    // row are inserted as NULL, row with extra values is an error.
+    //
+    // Rows are inserted by multi-row prepared statements inside of large
+    // transactions by the calling thread, so database connection is used
+    // only by the thread that owns it. Csv-file is parsed by another thread
+    // while rows are inserted. By default all rows are imported in one
+    // transaction, so on error nothing is imported.
+    class QTCSVSHARED_EXPORT SqlImporter {
+        std::unique_ptr<SqlImporterPrivate> d;
+
+    public:
+        // What to do with the table
+        enum class Mode {
+            // Create table if it doesn't exist, otherwise append rows to it
+            APPEND = 0,
+            // Drop existing table and create a new one
+            REPLACE
+        };
+
+        // Database should be open
+        SqlImporter(const QSqlDatabase& database, const QString& table);
+        ~SqlImporter();
+
+        SqlImporter(const SqlImporter&) = delete;
+        SqlImporter& operator=(const SqlImporter&) = delete;
+
+        // Set mode of the table (default is Mode::APPEND)
+        void setMode(Mode mode);
+        // Set names of columns. If they are set, the first row of data is
+        // not a header. By default names are taken from the header.
+        void setColumns(const QList<QString>& columns);
+        // Set max number of rows in one insert statement (default is 500).
+        // It is reduced if statement would have more than 999 parameters.
+        void setStatementRows(int rows);
+        // Set number of rows in one transaction. 0 means all rows (default).
+        void setTransactionRows(qint64 rows);
+        // Set SQLite journal mode ("WAL", "MEMORY", "OFF"...). Empty string
+        // means that it is not changed (default).
+        void setJournalMode(const QString& mode);
+        // Set SQLite synchronous mode ("OFF", "NORMAL", "FULL"...). Empty
+        // string means that it is not changed (default).
+        void setSynchronous(const QString& mode);
+        // If set, empty values are inserted as NULL
+        void setEmptyAsNull(bool emptyAsNull);
+
+        // Import rows of csv-file
+        bool import(
+            const QString& filePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Import rows of IO Device. QFile is parsed by another thread, other
+        // IO Devices are read only by the calling thread.
+        bool import(
+            QIODevice& ioDevice,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8);
+
+        // Get number of rows that were imported by the last import
+        qint64 importedRows() const;
+    };
+}
+
+#endif // QTCSVSQLIMPORTER_H
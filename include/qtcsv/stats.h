@@ -0,0 +1,80 @@
+#ifndef QTCSVSTATS_H
+#define QTCSVSTATS_H
+
+#include "qtcsv/qtcsv_global.h"
+
+namespace QtCSV {
+
+    // ReadStats collects statistics of reading of csv-data. Pass pointer to
+    // it to any Reader function. If pointer is null (default), statistics
+    // are not collected and reading is not slowed down at all.
+    //
+    // Values are added to the current values of the fields, so one object
+    // could collect statistics of several read operations.
+    struct ReadStats {
+        // If False, only counters are collected. Measuring of time of stages
+        // costs a few system calls per line.
+        bool timings = true;
+
+        // Number of bytes read from IO Device
+        qint64 bytesRead = 0;
+        // Number of symbols decoded from the bytes
+        qint64 symbolsDecoded = 0;
+        // Number of lines
+        qint64 lines = 0;
+        // Number of rows (rows could last on several lines)
+        qint64 rows = 0;
+        // Number of rows that last on several lines
+        qint64 multiLineRows = 0;
+        // Number of values in all rows
+        qint64 fields = 0;
+        // Number of strings that were created for lines and values
+        qint64 stringAllocations = 0;
+
+        // Time (in nanoseconds) of reading bytes from IO Device
+        qint64 ioNsecs = 0;
+        // Time of decoding bytes to lines of symbols
+        qint64 decodeNsecs = 0;
+        // Time of splitting lines to values
+        qint64 splitNsecs = 0;
+        // Time of removing spaces and text delimiters from values
+        qint64 unescapeNsecs = 0;
+        // Time spent in AbstractProcessor::processRowElements()
+        qint64 processNsecs = 0;
+        // Total time of read operation
+        qint64 totalNsecs = 0;
+    };
+
+    // WriteStats collects statistics of writing of csv-data. Pass pointer to
+    // it to any Writer function. If pointer is null (default), statistics
+    // are not collected.
+    //
+    // Values are added to the current values of the fields.
+    struct WriteStats {
+        // If False, only counters are collected
+        bool timings = true;
+
+        // Number of bytes written to IO Device
+        qint64 bytesWritten = 0;
+        // Number of symbols encoded to bytes
+        qint64 symbolsEncoded = 0;
+        // Number of rows including header and footer
+        qint64 rows = 0;
+        // Number of values in all rows
+        qint64 fields = 0;
+
+        // Time (in nanoseconds) of getting rows from the source
+        qint64 sourceNsecs = 0;
+        // Time of composing csv-formatted lines from values
+        qint64 composeNsecs = 0;
+        // Time of encoding symbols to bytes
+        qint64 encodeNsecs = 0;
+        // Time of writing bytes to IO Device
+        qint64 ioNsecs = 0;
+        // Total time of write operation. In WriteMode::REWRITE mode time of
+        // copying of the temporary file to the destination is not included.
+        qint64 totalNsecs = 0;
+    };
+}
+
+#endif // QTCSVSTATS_H
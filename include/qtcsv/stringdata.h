@@ -2,6 +2,7 @@
 #define QTCSVSTRINGDATA_H
 
 #include "qtcsv/abstractdata.h"
+#include "qtcsv/interner.h"
 #include "qtcsv/qtcsv_global.h"
 #include <QList>
 #include <QString>
@@ -11,8 +12,13 @@ namespace QtCSV {
     // StringData is a simple container class. It implements interface of
     // AbstractData class and uses strings to store information. Also it
     // provides basic functions for working with rows.
+    //
+    // If interning is enabled, equal values of a column share one QString
+    // (see Interner), which saves a lot of memory for categorical data.
     class QTCSVSHARED_EXPORT StringData : public AbstractData {
         QList<QList<QString>> m_values;
+        Interner m_interner;
+        bool m_interning = false;
 
     public:
         StringData() = default;
@@ -49,6 +55,16 @@ namespace QtCSV {
         // Get values (as list of strings) of specified row
         QList<QString> rowValues(qsizetype row) const override;
 
+        // Enable interning of values of columns that have no more than
+        // maxCardinality distinct values. Affects only new rows.
+        void setInterning(
+            bool enable,
+            qsizetype maxCardinality = Interner::DEFAULT_MAX_CARDINALITY);
+        // Check if interning of values is enabled
+        bool isInterning() const;
+        // Get interner of values
+        const Interner& interner() const;
+
         // Add new row that would contain one value
         StringData& operator<<(const QString& value);
         // Add new row with specified values
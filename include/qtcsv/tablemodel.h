@@ -0,0 +1,99 @@
+#ifndef QTCSVTABLEMODEL_H
+#define QTCSVTABLEMODEL_H
+
+#include "qtcsv/qtcsv_global.h"
+#include <QAbstractTableModel>
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <memory>
+
+namespace QtCSV {
+
+    class TableModelPrivate;
+
+    // TableModel is a read-only item model that shows content of a csv-file
+    // in Qt views without reading the whole file.
+    //
+    // File is memory-mapped and positions of its rows are found by a
+    // background thread, so open() returns at once. Found rows are added
+    // to the model by parts through canFetchMore() / fetchMore(). Values of
+    // a row are parsed when the view requests them, recently parsed rows
+    // are cached.
+    //
+    // While rows are indexed, the background thread also parses first rows
+    // of the file to collect statistics of columns (for example, width of
+    // the longest value to size view columns). Statistics are updated
+    // together with the progress of indexing.
+    class QTCSVSHARED_EXPORT TableModel : public QAbstractTableModel {
+        Q_OBJECT
+        std::unique_ptr<TableModelPrivate> d;
+        friend class TableModelPrivate;
+
+    public:
+        // Statistics of the values of a column
+        struct ColumnStats {
+            // Number of symbols in the longest value
+            qsizetype maxWidth = 0;
+            // Number of non-empty values
+            qsizetype values = 0;
+            // Number of values that are numbers
+            qsizetype numbers = 0;
+        };
+
+        explicit TableModel(QObject* parent = nullptr);
+        ~TableModel() override;
+
+        // Open csv-file and start indexing of its rows. If 'hasHeader' is
+        // set, the first row is used as a horizontal header.
+        bool open(
+            const QString& filePath,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            bool hasHeader = false);
+        // Stop indexing, close csv-file and remove all rows from the model
+        void close();
+        // Check if rows of the file are still being indexed
+        bool isIndexing() const;
+        // Block until indexing is finished. Returns False on timeout.
+        bool waitForIndexing(int msecs = -1);
+        // Get number of rows that were found so far
+        qsizetype indexedRowCount() const;
+
+        // Set max number of parsed rows that are cached (default is 1024)
+        void setCacheSize(qsizetype rows);
+        // Set number of rows that are added by fetchMore() (default is 1000)
+        void setFetchSize(int rows);
+        // Set number of rows that are parsed to collect statistics of
+        // columns (default is 10000). Negative value means all rows.
+        // Should be called before open().
+        void setStatsRowLimit(qsizetype rows);
+        // Get statistics of the column collected so far
+        ColumnStats columnStats(int column) const;
+        // Get values of the row
+        QList<QString> rowValues(int row) const;
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex())
+            const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole)
+            const override;
+        QVariant headerData(
+            int section,
+            Qt::Orientation orientation,
+            int role = Qt::DisplayRole) const override;
+        bool canFetchMore(const QModelIndex& parent) const override;
+        void fetchMore(const QModelIndex& parent) override;
+
+    Q_SIGNALS:
+        // Rows of the file are being indexed
+        void indexingProgress(qint64 bytes, qint64 totalBytes, qsizetype rows);
+        // All rows of the file were indexed
+        void indexingFinished(qsizetype rows);
+        // Statistics of columns were updated
+        void columnStatsChanged();
+    };
+}
+
+#endif // QTCSVTABLEMODEL_H
@@ -0,0 +1,67 @@
+#ifndef QTCSVTYPEDPROCESSOR_H
+#define QTCSVTYPEDPROCESSOR_H
+
+#include "qtcsv/qtcsv_global.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/schema.h"
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <memory>
+
+namespace QtCSV {
+
+    class TypedProcessorPrivate;
+
+    // TypedProcessor is an AbstractProcessor that treats the first row of
+    // csv-data as a header with names of columns. Other rows are converted
+    // to TypedRow objects and passed to processRow() function.
+    //
+    // Without schema all columns of the header are strings. With schema
+    // rows contain only columns of the schema (in the order of the schema),
+    // and values are converted to the types of the columns. Columns are
+    // matched by name, so order of columns in csv-data doesn't matter.
+    // Reading stops with error if:
+    // - column of the schema without default value is absent in the header;
+    // - value could not be converted to the type of the column;
+    // - value of not nullable column without default value is empty.
+    //
+    // Empty rows are skipped. Call reset() before reading the next file.
+    class QTCSVSHARED_EXPORT TypedProcessor : public Reader::AbstractProcessor {
+        std::unique_ptr<TypedProcessorPrivate> d;
+
+    public:
+        TypedProcessor();
+        explicit TypedProcessor(const Schema& schema);
+        ~TypedProcessor() override;
+
+        TypedProcessor(const TypedProcessor&) = delete;
+        TypedProcessor& operator=(const TypedProcessor&) = delete;
+
+        // Get names of columns from the header of csv-data. List is empty
+        // until the header is read.
+        const QList<QString>& header() const;
+        // Get map of names of columns to their indexes in typed rows
+        const QHash<QString, qsizetype>& columnIndexes() const;
+        // Get index of the column in typed rows. Returns -1 if there is no
+        // such column.
+        qsizetype columnIndex(const QString& name) const;
+        // Get number of rows that were passed to processRow()
+        qint64 rowCount() const;
+        // Forget the header to read another csv-data
+        void reset();
+
+        bool processRowElements(const QList<QString>& elements) final;
+
+        // Process one row of converted values
+        // @input:
+        // - row - typed row. Object is reused for the next rows, so copy
+        // values that you need to keep.
+        // @output:
+        // bool - True if row was processed successfully, False to stop
+        // reading
+        virtual bool processRow(const TypedRow& row) = 0;
+    };
+}
+
+#endif // QTCSVTYPEDPROCESSOR_H
@@ -2,6 +2,7 @@
 #define QTCSVVARIANTDATA_H
 
 #include "qtcsv/abstractdata.h"
+#include "qtcsv/numberconverter.h"
 #include "qtcsv/qtcsv_global.h"
 #include <QList>
 #include <QString>
@@ -16,8 +17,15 @@ namespace QtCSV {
     // obviously, if we want to save information to CSV file, we would need to
     // convert it to plain-text form). So don't forget to see docs of QVariant
     // before you start using this class.
+    //
+    // Numeric values (integers and floating point numbers) are converted to
+    // strings with NumberConverter according to the number format of the
+    // container. If numbers parsing is enabled, string values that contain
+    // numbers are stored as numbers.
     class QTCSVSHARED_EXPORT VariantData : public AbstractData {
         QList< QList<QVariant> > m_values;
+        NumberFormat m_numberFormat;
+        bool m_parseNumbers = false;
 
     public:
         VariantData() = default;
@@ -58,6 +66,16 @@ namespace QtCSV {
         // Get values (as list of strings) of specified row
         QList<QString> rowValues(qsizetype row) const override;
 
+        // Set format of floating point numbers
+        void setNumberFormat(const NumberFormat& format);
+        // Get format of floating point numbers
+        NumberFormat numberFormat() const;
+        // Enable conversion of numeric strings to numbers. Strings that would
+        // be written differently (like "007" or "+5") are not converted.
+        void setParseNumbers(bool parse);
+        // Check if numeric strings are converted to numbers
+        bool parseNumbers() const;
+
         // Add new row that would contain one value
         VariantData& operator<<(const QVariant& value);
         // Add new row with specified values
@@ -3,6 +3,9 @@
 
 #include "qtcsv/qtcsv_global.h"
 #include "abstractdata.h"
+#include "rowsource.h"
+#include "qtcsv/progress.h"
+#include "qtcsv/stats.h"
 #include <QIODevice>
 #include <QList>
 #include <QString>
@@ -14,14 +17,17 @@ namespace QtCSV {
 
     // Writer is a data-writer class that works with csv-files and IO Devices.
     // As a source of information it requires AbstractData-based container
-    // class object.
+    // class object or AbstractRowSource-based object that returns rows
+    // one by one.
     //
     // It supports different write methods:
     // - WriteMode::REWRITE - if file exist, it will be rewritten
     // - WriteMode::APPEND - if file exist, new information will be appended
     // to the end of the file.
     //
-    // Also you can specify header and footer for your data.
+    // Also you can specify header and footer for your data, WriteStats
+    // object that will collect statistics of writing and Progress object
+    // that will receive progress of writing and could cancel it.
     class QTCSVSHARED_EXPORT Writer {
     public:
         enum class WriteMode {
@@ -38,7 +44,9 @@ namespace QtCSV {
             WriteMode mode = WriteMode::REWRITE,
             const QList<QString>& header = {},
             const QList<QString>& footer = {},
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            WriteStats* stats = nullptr,
+            Progress* progress = nullptr);
 
         // Write data to IO Device
         static bool write(
@@ -48,7 +56,34 @@ namespace QtCSV {
             const QString& textDelimiter = QString("\""),
             const QList<QString>& header = {},
             const QList<QString>& footer = {},
-            QStringConverter::Encoding codec = QStringConverter::Utf8);
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            WriteStats* stats = nullptr,
+            Progress* progress = nullptr);
+
+        // Write rows from the source to csv-file
+        static bool write(
+            const QString& filePath,
+            AbstractRowSource& source,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            WriteMode mode = WriteMode::REWRITE,
+            const QList<QString>& header = {},
+            const QList<QString>& footer = {},
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            WriteStats* stats = nullptr,
+            Progress* progress = nullptr);
+
+        // Write rows from the source to IO Device
+        static bool write(
+            QIODevice& ioDevice,
+            AbstractRowSource& source,
+            const QString& separator = QString(","),
+            const QString& textDelimiter = QString("\""),
+            const QList<QString>& header = {},
+            const QList<QString>& footer = {},
+            QStringConverter::Encoding codec = QStringConverter::Utf8,
+            WriteStats* stats = nullptr,
+            Progress* progress = nullptr);
     };
 }
 
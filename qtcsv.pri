@@ -10,7 +10,33 @@ SOURCES += \
     $$PWD/sources/variantdata.cpp \
     $$PWD/sources/stringdata.cpp \
     $$PWD/sources/reader.cpp \
-    $$PWD/sources/contentiterator.cpp
+    $$PWD/sources/contentiterator.cpp \
+    $$PWD/sources/numberconverter.cpp \
+    $$PWD/sources/rowsource.cpp \
+    $$PWD/sources/partitionedwriter.cpp \
+    $$PWD/sources/rowreader.cpp \
+    $$PWD/sources/externalsorter.cpp \
+    $$PWD/sources/cacheddata.cpp \
+    $$PWD/sources/progress.cpp \
+    $$PWD/sources/schema.cpp \
+    $$PWD/sources/typedprocessor.cpp \
+    $$PWD/sources/sniffer.cpp \
+    $$PWD/sources/interner.cpp \
+    $$PWD/sources/spilleddata.cpp \
+    $$PWD/sources/indexeddata.cpp \
+    $$PWD/sources/rowindexer.cpp \
+    $$PWD/sources/rowbatches.cpp \
+    $$PWD/sources/tablemodel.cpp \
+    $$PWD/sources/query.cpp \
+    $$PWD/sources/hashjoin.cpp \
+    $$PWD/sources/filefollower.cpp \
+    $$PWD/sources/checkpoint.cpp \
+    $$PWD/sources/multireader.cpp \
+    $$PWD/sources/filesplitter.cpp \
+    $$PWD/sources/filemerger.cpp \
+    $$PWD/sources/jsonconverter.cpp \
+    $$PWD/sources/arrowwriter.cpp \
+    $$PWD/sources/rowsampler.cpp
 
 HEADERS += \
     $$PWD/include/qtcsv/qtcsv_global.h \
@@ -19,6 +45,45 @@ HEADERS += \
     $$PWD/include/qtcsv/stringdata.h \
     $$PWD/include/qtcsv/reader.h \
     $$PWD/include/qtcsv/abstractdata.h \
+    $$PWD/include/qtcsv/numberconverter.h \
+    $$PWD/include/qtcsv/rowsource.h \
+    $$PWD/include/qtcsv/partitionedwriter.h \
+    $$PWD/include/qtcsv/externalsorter.h \
+    $$PWD/include/qtcsv/cacheddata.h \
+    $$PWD/include/qtcsv/stats.h \
+    $$PWD/include/qtcsv/progress.h \
+    $$PWD/include/qtcsv/schema.h \
+    $$PWD/include/qtcsv/typedprocessor.h \
+    $$PWD/include/qtcsv/sniffer.h \
+    $$PWD/include/qtcsv/interner.h \
+    $$PWD/include/qtcsv/spilleddata.h \
+    $$PWD/include/qtcsv/indexeddata.h \
+    $$PWD/include/qtcsv/tablemodel.h \
+    $$PWD/include/qtcsv/query.h \
+    $$PWD/include/qtcsv/hashjoin.h \
+    $$PWD/include/qtcsv/filefollower.h \
+    $$PWD/include/qtcsv/checkpoint.h \
+    $$PWD/include/qtcsv/multireader.h \
+    $$PWD/include/qtcsv/filesplitter.h \
+    $$PWD/include/qtcsv/filemerger.h \
+    $$PWD/include/qtcsv/jsonconverter.h \
+    $$PWD/include/qtcsv/arrowwriter.h \
+    $$PWD/include/qtcsv/rowsampler.h \
     $$PWD/sources/filechecker.h \
+    $$PWD/sources/filecopy.h \
     $$PWD/sources/contentiterator.h \
+    $$PWD/sources/rowreader.h \
+    $$PWD/sources/rowindexer.h \
+    $$PWD/sources/rowbatches.h \
+    $$PWD/sources/instrumenteddevice.h \
+    $$PWD/sources/progresstracker.h \
     $$PWD/sources/symbols.h
+
+# SqlImporter is the only part of the library that depends on Qt Sql module
+qtcsv_sql {
+    QT += sql
+    DEFINES += QTCSV_SQL
+
+    SOURCES += $$PWD/sources/sqlimporter.cpp
+    HEADERS += $$PWD/include/qtcsv/sqlimporter.h
+}
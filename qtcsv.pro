@@ -1,7 +1,7 @@
 QT = core
 TARGET = qtcsv
 TEMPLATE = lib
-VERSION = 1.7.0
+VERSION = 2.0.0
 win32:TARGET_EXT = .dll
 
 # Uncomment this setting if you want to build static library
@@ -15,6 +15,10 @@ win32:TARGET_EXT = .dll
             -Wdisabled-optimization -Wcast-align -Wcast-qual
 }
 
+# Uncomment this setting if you want to build SqlImporter (requires Qt Sql
+# module). It could be also set from the command line: qmake CONFIG+=qtcsv_sql
+#CONFIG += qtcsv_sql
+
 CONFIG(staticlib): DEFINES += QTCSV_STATIC_LIB
 DEFINES += QTCSV_LIBRARY
 
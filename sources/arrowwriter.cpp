@@ -0,0 +1,607 @@
+#include "include/qtcsv/arrowwriter.h"
+#include <QDebug>
+#include <QStringEncoder>
+#include <QtEndian>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+using namespace QtCSV;
+
+// Get little-endian bytes of the scalar value
+// @input:
+// - value - value of a field of a table
+// @output:
+// - QByteArray - bytes of the value
+template <typename T>
+QByteArray ArrowScalar(const T value) {
+    QByteArray bytes(sizeof(T), '\0');
+    qToLittleEndian(value, bytes.data());
+    return bytes;
+}
+
+// ArrowFlatBuffer writes FlatBuffers-encoded metadata of Arrow messages.
+// Objects are written front to back: each table is written before the
+// objects it refers to, so all offsets point forward as FlatBuffers
+// requires. Offsets are set when their targets are written.
+class ArrowFlatBuffer {
+    QByteArray m_data;
+
+public:
+    // Size of offset to table, vector or string
+    static const qsizetype OFFSET_SIZE = 4;
+
+    // Buffer starts with offset to the root table
+    ArrowFlatBuffer() : m_data(OFFSET_SIZE, '\0') {}
+
+    // Add table
+    qsizetype addTable(
+        const QList<QByteArray>& fields, QList<qsizetype>* positions);
+    // Add string
+    qsizetype addString(const QString& value);
+    // Add vector of scalars, structs or offsets
+    qsizetype addVector(
+        qsizetype count, qsizetype elementSize, const QByteArray& elements);
+    // Set offset at the position to the target
+    void setOffset(qsizetype position, qsizetype target);
+    // Set offset to the root table and get the buffer
+    QByteArray finish(qsizetype root);
+
+    // Value of offset field that is set later
+    static QByteArray offset() { return QByteArray(OFFSET_SIZE, '\0'); }
+
+private:
+    // Add zero bytes until (size + shift) is a multiple of alignment
+    void align(qsizetype alignment, qsizetype shift = 0);
+};
+
+// Add table. Its vtable is written right before it.
+// @input:
+// - fields - little-endian values of fields by their ids. Empty value
+// means absent field. Offset fields should be set by setOffset() later.
+// - positions - list for positions of the fields in the buffer. It could
+// be nullptr.
+// @output:
+// - qsizetype - position of the table in the buffer
+qsizetype ArrowFlatBuffer::addTable(
+    const QList<QByteArray>& fields, QList<qsizetype>* positions)
+{
+    // Vtable: its size, size of the table and offsets of fields in the
+    // table
+    align(2);
+    const auto vtable = m_data.size();
+    const auto vtableSize = 2 * (2 + fields.size());
+    m_data.append(vtableSize, '\0');
+
+    // Table starts with signed offset to its vtable. Fields are placed from
+    // the biggest to the smallest, so the biggest (8 bytes) are aligned
+    // right after the offset.
+    align(8, OFFSET_SIZE);
+    const auto table = m_data.size();
+    m_data += ArrowScalar<qint32>(static_cast<qint32>(table - vtable));
+
+    QList<qsizetype> order;
+    for (qsizetype i = 0; i < fields.size(); ++i) { order << i; }
+
+    std::stable_sort(order.begin(), order.end(),
+                     [&fields](const qsizetype a, const qsizetype b) {
+                         return fields.at(b).size() < fields.at(a).size();
+                     });
+
+    if (positions != nullptr) { *positions = QList<qsizetype>(fields.size()); }
+
+    for (const auto id : order) {
+        if (fields.at(id).isEmpty()) { continue; }
+
+        if (positions != nullptr) { (*positions)[id] = m_data.size(); }
+
+        qToLittleEndian<quint16>(
+            static_cast<quint16>(m_data.size() - table),
+            m_data.data() + vtable + 2 * (2 + id));
+        m_data += fields.at(id);
+    }
+
+    qToLittleEndian<quint16>(
+        static_cast<quint16>(vtableSize), m_data.data() + vtable);
+    qToLittleEndian<quint16>(
+        static_cast<quint16>(m_data.size() - table),
+        m_data.data() + vtable + 2);
+    return table;
+}
+
+// Add string
+// @input:
+// - value - string
+// @output:
+// - qsizetype - position of the string in the buffer
+qsizetype ArrowFlatBuffer::addString(const QString& value) {
+    const auto utf8 = value.toUtf8();
+    align(OFFSET_SIZE);
+    const auto position = m_data.size();
+    m_data += ArrowScalar<quint32>(static_cast<quint32>(utf8.size()));
+    m_data += utf8;
+    m_data += '\0';
+    return position;
+}
+
+// Add vector of scalars, structs or offsets
+// @input:
+// - count - number of elements
+// - elementSize - size of elements. Elements are aligned to it.
+// - elements - little-endian bytes of elements. Offsets to tables should
+// be set by setOffset() later.
+// @output:
+// - qsizetype - position of the vector in the buffer. Elements follow its
+// size.
+qsizetype ArrowFlatBuffer::addVector(
+    const qsizetype count,
+    const qsizetype elementSize,
+    const QByteArray& elements)
+{
+    align(qMin<qsizetype>(8, qMax(OFFSET_SIZE, elementSize)), OFFSET_SIZE);
+    const auto position = m_data.size();
+    m_data += ArrowScalar<quint32>(static_cast<quint32>(count));
+    m_data += elements;
+    return position;
+}
+
+// Set offset at the position to the target
+// @input:
+// - position - position of the offset field
+// - target - position of the table, vector or string after it
+void ArrowFlatBuffer::setOffset(
+    const qsizetype position, const qsizetype target)
+{
+    qToLittleEndian<quint32>(
+        static_cast<quint32>(target - position), m_data.data() + position);
+}
+
+// Set offset to the root table and get the buffer
+// @input:
+// - root - position of the root table
+// @output:
+// - QByteArray - buffer which size is a multiple of 8
+QByteArray ArrowFlatBuffer::finish(const qsizetype root) {
+    setOffset(0, root);
+    align(8);
+    return m_data;
+}
+
+void ArrowFlatBuffer::align(const qsizetype alignment, const qsizetype shift)
+{
+    const auto remainder = (m_data.size() + shift) % alignment;
+    if (0 < remainder) { m_data.append(alignment - remainder, '\0'); }
+}
+
+// Values of one column of the current record batch in Arrow layout
+struct ArrowColumn {
+    Schema::Type type = Schema::Type::STRING;
+    // Bit of each row is set if its value is not null
+    QByteArray validity;
+    qint64 nullCount = 0;
+    // Offsets of values of strings in data (int32)
+    QByteArray offsets;
+    // Values (bits for booleans, UTF-8 bytes for strings)
+    QByteArray data;
+};
+
+namespace QtCSV {
+
+class ArrowWriterPrivate {
+public:
+    // Constants of Arrow format
+    static const qint16 METADATA_VERSION_V5 = 4;
+    static const quint8 HEADER_SCHEMA = 1;
+    static const quint8 HEADER_RECORD_BATCH = 3;
+    static const quint8 TYPE_INT = 2;
+    static const quint8 TYPE_FLOATING_POINT = 3;
+    static const quint8 TYPE_UTF8 = 5;
+    static const quint8 TYPE_BOOL = 6;
+    static const qint16 PRECISION_DOUBLE = 2;
+    static const quint32 CONTINUATION = 0xFFFFFFFF;
+
+    ArrowWriterPrivate(QIODevice& device, const Schema& columnsSchema) :
+        output(device), schema(columnsSchema) {}
+
+    QIODevice& output;
+    const Schema schema;
+    qint64 batchRows = 65536;
+    qint64 batchCount = 0;
+    // Rows of the current batch
+    qint64 rows = 0;
+    QList<ArrowColumn> columns;
+    QStringEncoder encoder{QStringConverter::Utf8};
+    bool isStarted = false;
+    bool isFinished = false;
+
+    // Write schema message
+    bool start(const QList<QString>& header);
+    // Append values of the row to the columns
+    bool appendRow(const TypedRow& row);
+    // Write columns as record batch and clear them
+    bool writeBatch();
+    // Write message with metadata and body
+    bool writeMessage(
+        const QByteArray& metadata, const QList<const QByteArray*>& body);
+    // Write data to IO Device
+    bool write(const QByteArray& data);
+
+    // Clear columns for the next batch
+    void clearColumns();
+
+    // Get metadata of message
+    static QByteArray message(
+        quint8 headerType,
+        qint64 bodyLength,
+        const std::function<qsizetype(ArrowFlatBuffer&)>& addHeader);
+    // Get size of the buffer with padding to 8 bytes
+    static qint64 paddedSize(const qint64 size) { return (size + 7) / 8 * 8; }
+    // Set bit of the bitmap
+    static void appendBit(QByteArray& bitmap, qint64 index, bool value);
+};
+
+}
+
+// Write schema message. Columns are taken from the schema or from the
+// header.
+// @input:
+// - header - names of columns of csv-data
+// @output:
+// - bool - True if schema was written, False otherwise
+bool ArrowWriterPrivate::start(const QList<QString>& header) {
+    isStarted = true;
+    if (!output.isOpen() && !output.open(QIODevice::WriteOnly)) {
+        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
+        return false;
+    }
+
+    auto fields = schema.columns();
+    if (schema.isEmpty()) {
+        for (const auto& name : header) {
+            Schema::Column column;
+            column.name = name;
+            fields << column;
+        }
+    }
+
+    columns = QList<ArrowColumn>(fields.size());
+    for (qsizetype i = 0; i < fields.size(); ++i) {
+        columns[i].type = fields.at(i).type;
+    }
+
+    clearColumns();
+
+    const auto metadata = message(
+        HEADER_SCHEMA, 0, [&fields](ArrowFlatBuffer& buffer) {
+            // Schema: endianness (little), fields
+            QList<qsizetype> schemaFields;
+            const auto schemaTable = buffer.addTable(
+                {ArrowScalar<qint16>(0), ArrowFlatBuffer::offset()},
+                &schemaFields);
+            const auto fieldsVector = buffer.addVector(
+                fields.size(), ArrowFlatBuffer::OFFSET_SIZE,
+                QByteArray(fields.size() * ArrowFlatBuffer::OFFSET_SIZE,
+                           '\0'));
+            buffer.setOffset(schemaFields.at(1), fieldsVector);
+
+            for (qsizetype i = 0; i < fields.size(); ++i) {
+                const auto& field = fields.at(i);
+                quint8 type = TYPE_UTF8;
+                QList<QByteArray> typeFields;
+                switch (field.type) {
+                    case Schema::Type::STRING:
+                        type = TYPE_UTF8;
+                        break;
+                    case Schema::Type::INTEGER:
+                        // Int: bit width, is signed
+                        type = TYPE_INT;
+                        typeFields = {ArrowScalar<qint32>(64),
+                                      ArrowScalar<quint8>(1)};
+                        break;
+                    case Schema::Type::DOUBLE:
+                        // FloatingPoint: precision
+                        type = TYPE_FLOATING_POINT;
+                        typeFields = {ArrowScalar<qint16>(PRECISION_DOUBLE)};
+                        break;
+                    case Schema::Type::BOOL:
+                        type = TYPE_BOOL;
+                        break;
+                }
+
+                // Field: name, nullable, type of type, type, dictionary,
+                // children. Arrow readers need children even if they are
+                // empty.
+                QList<qsizetype> fieldFields;
+                const auto fieldTable = buffer.addTable(
+                    {ArrowFlatBuffer::offset(),
+                     ArrowScalar<quint8>(field.nullable ? 1 : 0),
+                     ArrowScalar<quint8>(type), ArrowFlatBuffer::offset(),
+                     QByteArray(), ArrowFlatBuffer::offset()},
+                    &fieldFields);
+                buffer.setOffset(
+                    fieldsVector + ArrowFlatBuffer::OFFSET_SIZE * (i + 1),
+                    fieldTable);
+                buffer.setOffset(
+                    fieldFields.at(0), buffer.addString(field.name));
+                buffer.setOffset(
+                    fieldFields.at(3), buffer.addTable(typeFields, nullptr));
+                buffer.setOffset(
+                    fieldFields.at(5),
+                    buffer.addVector(0, ArrowFlatBuffer::OFFSET_SIZE, {}));
+            }
+
+            return schemaTable;
+        });
+
+    return writeMessage(metadata, {});
+}
+
+// Append values of the row to the columns. Values are encoded right into
+// the buffers of the columns.
+// @input:
+// - row - typed row in the order of the columns
+// @output:
+// - bool - True if values were appended, False otherwise
+bool ArrowWriterPrivate::appendRow(const TypedRow& row) {
+    for (qsizetype i = 0; i < columns.size(); ++i) {
+        auto& column = columns[i];
+        const auto isNull = row.isNull(i);
+        appendBit(column.validity, rows, !isNull);
+        if (isNull) { ++column.nullCount; }
+
+        switch (column.type) {
+            case Schema::Type::STRING: {
+                if (!isNull) {
+                    const auto value = row.toString(i);
+                    const auto size = column.data.size();
+                    column.data.resize(size + encoder.requiredSpace(
+                        value.size()));
+                    auto* end = encoder.appendToBuffer(
+                        column.data.data() + size, value);
+                    column.data.resize(end - column.data.constData());
+                }
+
+                // Offsets of Utf8 type are 32-bit
+                if (std::numeric_limits<qint32>::max() < column.data.size())
+                {
+                    qDebug() << __FUNCTION__ <<
+                        "Error - too much string data in batch, reduce "
+                        "number of rows in batch";
+                    return false;
+                }
+
+                column.offsets += ArrowScalar<qint32>(
+                    static_cast<qint32>(column.data.size()));
+                break;
+            }
+            case Schema::Type::INTEGER:
+                column.data += ArrowScalar<qint64>(
+                    isNull ? 0 : row.toLongLong(i));
+                break;
+            case Schema::Type::DOUBLE:
+                column.data += ArrowScalar<double>(
+                    isNull ? 0.0 : row.toDouble(i));
+                break;
+            case Schema::Type::BOOL:
+                appendBit(column.data, rows, !isNull && row.toBool(i));
+                break;
+        }
+    }
+
+    ++rows;
+    return true;
+}
+
+// Write columns as record batch and clear them
+// @output:
+// - bool - True if batch was written, False otherwise
+bool ArrowWriterPrivate::writeBatch() {
+    if (rows == 0) { return true; }
+
+    // Buffers of each column: validity (empty if there are no nulls),
+    // offsets of strings, values
+    const QByteArray noValidity;
+    QList<const QByteArray*> body;
+    QByteArray nodes;
+    for (const auto& column : columns) {
+        nodes += ArrowScalar<qint64>(rows);
+        nodes += ArrowScalar<qint64>(column.nullCount);
+
+        body << (0 < column.nullCount ? &column.validity : &noValidity);
+        if (column.type == Schema::Type::STRING) { body << &column.offsets; }
+
+        body << &column.data;
+    }
+
+    QByteArray buffers;
+    qint64 bodyLength = 0;
+    for (const auto* buffer : body) {
+        buffers += ArrowScalar<qint64>(bodyLength);
+        buffers += ArrowScalar<qint64>(buffer->size());
+        bodyLength += paddedSize(buffer->size());
+    }
+
+    const auto columnCount = columns.size();
+    const auto bufferCount = body.size();
+    const auto batchLength = rows;
+    const auto metadata = message(
+        HEADER_RECORD_BATCH, bodyLength, [&](ArrowFlatBuffer& buffer) {
+            // RecordBatch: length, nodes, buffers. Nodes and buffers are
+            // structs of two 64-bit numbers.
+            QList<qsizetype> batchFields;
+            const auto batchTable = buffer.addTable(
+                {ArrowScalar<qint64>(batchLength), ArrowFlatBuffer::offset(),
+                 ArrowFlatBuffer::offset()},
+                &batchFields);
+            buffer.setOffset(
+                batchFields.at(1), buffer.addVector(columnCount, 16, nodes));
+            buffer.setOffset(
+                batchFields.at(2),
+                buffer.addVector(bufferCount, 16, buffers));
+            return batchTable;
+        });
+
+    const auto result = writeMessage(metadata, body);
+    ++batchCount;
+    clearColumns();
+    return result;
+}
+
+// Write message with metadata and body
+// @input:
+// - metadata - FlatBuffers-encoded message which size is a multiple of 8
+// - body - buffers of the body. Each of them is padded to 8 bytes.
+// @output:
+// - bool - True if message was written, False otherwise
+bool ArrowWriterPrivate::writeMessage(
+    const QByteArray& metadata, const QList<const QByteArray*>& body)
+{
+    if (!write(ArrowScalar<quint32>(CONTINUATION) +
+               ArrowScalar<qint32>(static_cast<qint32>(metadata.size())) +
+               metadata))
+    {
+        return false;
+    }
+
+    const QByteArray padding(8, '\0');
+    for (const auto* buffer : body) {
+        const auto size = buffer->size();
+        if (!write(*buffer) ||
+            !write(QByteArray::fromRawData(
+                padding.constData(), paddedSize(size) - size)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Write data to IO Device
+// @input:
+// - data - data
+// @output:
+// - bool - True if data was written, False otherwise
+bool ArrowWriterPrivate::write(const QByteArray& data) {
+    if (data.isEmpty() || output.write(data) == data.size()) { return true; }
+
+    qDebug() << __FUNCTION__ << "Error - can't write to IO Device";
+    return false;
+}
+
+// Clear columns for the next batch. Buffers keep their memory.
+void ArrowWriterPrivate::clearColumns() {
+    rows = 0;
+    for (auto& column : columns) {
+        column.validity.resize(0);
+        column.nullCount = 0;
+        column.data.resize(0);
+        column.offsets.resize(0);
+        if (column.type == Schema::Type::STRING) {
+            column.offsets += ArrowScalar<qint32>(0);
+        }
+    }
+}
+
+// Get metadata of message
+// @input:
+// - headerType - type of the header of the message
+// - bodyLength - size of the body of the message in bytes
+// - addHeader - function that adds header table and returns its position
+// @output:
+// - QByteArray - FlatBuffers-encoded message
+QByteArray ArrowWriterPrivate::message(
+    const quint8 headerType,
+    const qint64 bodyLength,
+    const std::function<qsizetype(ArrowFlatBuffer&)>& addHeader)
+{
+    // Message: version, type of header, header, body length
+    ArrowFlatBuffer buffer;
+    QList<qsizetype> messageFields;
+    const auto messageTable = buffer.addTable(
+        {ArrowScalar<qint16>(METADATA_VERSION_V5),
+         ArrowScalar<quint8>(headerType), ArrowFlatBuffer::offset(),
+         ArrowScalar<qint64>(bodyLength)},
+        &messageFields);
+    buffer.setOffset(messageFields.at(2), addHeader(buffer));
+    return buffer.finish(messageTable);
+}
+
+// Set bit of the bitmap. Bits are set in order of rows, so the bitmap
+// grows by one byte at a time.
+// @input:
+// - bitmap - bitmap
+// - index - index of the bit
+// - value - value of the bit
+void ArrowWriterPrivate::appendBit(
+    QByteArray& bitmap, const qint64 index, const bool value)
+{
+    if (index % 8 == 0) { bitmap += '\0'; }
+
+    if (value) {
+        bitmap.data()[index / 8] |= static_cast<char>(1 << (index % 8));
+    }
+}
+
+// Create writer without schema. All columns of the header are strings.
+// @input:
+// - output - IO Device for Arrow stream
+ArrowWriter::ArrowWriter(QIODevice& output) :
+    d(std::make_unique<ArrowWriterPrivate>(output, Schema()))
+{}
+
+// Create writer
+// @input:
+// - output - IO Device for Arrow stream
+// - schema - description of columns
+ArrowWriter::ArrowWriter(QIODevice& output, const Schema& schema) :
+    TypedProcessor(schema),
+    d(std::make_unique<ArrowWriterPrivate>(output, schema))
+{}
+
+ArrowWriter::~ArrowWriter() = default;
+
+// Set max number of rows in one record batch
+// @input:
+// - rows - number of rows. Must be positive.
+void ArrowWriter::setBatchRows(const qint64 rows) {
+    d->batchRows = qMax<qint64>(1, rows);
+}
+
+// Write the last record batch and the end of the stream
+// @output:
+// - bool - True if stream was finished, False otherwise
+bool ArrowWriter::finish() {
+    if (d->isFinished) {
+        qDebug() << __FUNCTION__ << "Error - stream is already finished";
+        return false;
+    }
+
+    d->isFinished = true;
+    return (d->isStarted || d->start(header())) && d->writeBatch() &&
+        d->write(ArrowScalar<quint32>(ArrowWriterPrivate::CONTINUATION) +
+                 ArrowScalar<qint32>(0));
+}
+
+// Get number of written record batches
+qint64 ArrowWriter::batchCount() const {
+    return d->batchCount;
+}
+
+// Append row to the current record batch. Batch is written when it has
+// enough rows.
+// @input:
+// - row - typed row
+// @output:
+// - bool - True if row was processed, False otherwise
+bool ArrowWriter::processRow(const TypedRow& row) {
+    if (d->isFinished) {
+        qDebug() << __FUNCTION__ << "Error - stream is already finished";
+        return false;
+    }
+
+    if (!d->isStarted && !d->start(header())) { return false; }
+
+    return d->appendRow(row) &&
+        (d->rows < d->batchRows || d->writeBatch());
+}
@@ -0,0 +1,803 @@
+#include "include/qtcsv/cacheddata.h"
+#include "include/qtcsv/numberconverter.h"
+#include "sources/filechecker.h"
+#include "sources/rowreader.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <cstring>
+#include <vector>
+
+using namespace QtCSV;
+
+// Layout of the cache file. All sections start at offsets that are
+// multiples of 8. Numbers are stored in native byte order; cache with
+// other byte order is treated as out of date.
+//
+// CacheHeader
+// key - UTF-16 string "<absolute path>\0<separator>\0<text delimiter>"
+// row index - quint32 number of values of each row
+// ColumnInfo of each column
+// values of each column - qint64, double or quint32 index in dictionary
+// for each row; numeric columns are followed by bitmap of empty values
+// dictionary offsets - quint64 offsets of strings in dictionary data
+// (one more than number of strings)
+// dictionary data - UTF-16 symbols of all strings
+struct CacheHeader {
+    char magic[8];
+    quint32 version;
+    quint32 byteOrder;
+    qint64 sourceSize;
+    qint64 sourceModified;
+    quint32 codec;
+    quint32 reserved;
+    quint64 fileSize;
+    quint64 keyOffset;
+    quint64 keyLength;
+    quint64 rowCount;
+    quint64 columnCount;
+    quint64 rowIndexOffset;
+    quint64 columnsOffset;
+    quint64 dictionaryOffset;
+    quint64 dictionarySize;
+    quint64 dictionaryDataOffset;
+    quint64 dictionaryDataLength;
+};
+
+struct ColumnInfo {
+    quint32 type;
+    quint32 reserved;
+    quint64 valuesOffset;
+    quint64 emptyOffset;
+};
+
+// CacheKey describes csv-file and the way it was read
+struct CacheKey {
+    QString id;
+    qint64 size = 0;
+    qint64 modified = 0;
+    quint32 codec = 0;
+};
+
+namespace QtCSV {
+
+class CachedDataPrivate {
+public:
+    static const char MAGIC[8];
+    static const quint32 VERSION = 1;
+    static const quint32 BYTE_ORDER_MARK = 0x01020304;
+
+    QFile file;
+    uchar* map = nullptr;
+    const CacheHeader* header = nullptr;
+    const quint32* rowIndex = nullptr;
+    const ColumnInfo* columns = nullptr;
+    const quint64* dictionaryOffsets = nullptr;
+    const QChar* dictionaryData = nullptr;
+    qsizetype cachedRows = 0;
+    // Rows that were added to the container or rows of the csv-file if
+    // cache could not be written
+    QList<QList<QString>> rows;
+
+    // Get key of the csv-file
+    static bool cacheKey(
+        const QString& filePath,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec,
+        CacheKey& key);
+
+    // Read all rows of the csv-file
+    static bool readFile(
+        const QString& filePath,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec,
+        QList<QList<QString>>& rows);
+
+    // Write cache file
+    static bool write(
+        const QString& cachePath,
+        const CacheKey& key,
+        const QList<QList<QString>>& rows);
+
+    // Detect type of values of the column
+    static CachedData::ColumnType columnType(
+        const QList<QList<QString>>& rows, qsizetype column);
+
+    // Map cache file and check that it is valid and up to date
+    bool open(const QString& cachePath, const CacheKey& key);
+    // Unmap and close cache file
+    void close();
+    // Check that section of the cache is inside the file
+    bool isInside(quint64 offset, quint64 count, quint64 itemSize) const;
+    // Get string value of the cached cell
+    QString stringValue(qsizetype row, qsizetype column) const;
+    // Get typed value of the cached cell
+    QVariant value(qsizetype row, qsizetype column) const;
+};
+
+const char CachedDataPrivate::MAGIC[8] =
+    {'Q', 'T', 'C', 'S', 'V', 'B', 'I', 'N'};
+
+}
+
+// Get key of the csv-file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - key - key of the csv-file
+// @output:
+// - bool - True if file exists, False otherwise
+bool CachedDataPrivate::cacheKey(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    CacheKey& key)
+{
+    const QFileInfo info(filePath);
+    if (!info.exists()) { return false; }
+
+    key.id = info.absoluteFilePath() + QChar(0) + separator + QChar(0) +
+        textDelimiter;
+    key.size = info.size();
+    key.modified = info.lastModified().toMSecsSinceEpoch();
+    key.codec = static_cast<quint32>(codec);
+    return true;
+}
+
+// Read all rows of the csv-file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - rows - list for the rows of the file
+// @output:
+// - bool - True if file was read, False otherwise
+bool CachedDataPrivate::readFile(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    QList<QList<QString>>& rows)
+{
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!CheckFile(filePath, true) || !file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    RowReader reader(file, separator, textDelimiter, codec);
+    QList<QString> row;
+    while (reader.readRow(row)) { rows << row; }
+
+    return true;
+}
+
+// Detect type of values of the column
+// @input:
+// - rows - rows of the csv-file
+// - column - index of the column
+// @output:
+// - CachedData::ColumnType - numeric type if all non-empty values of the
+// column are numbers that could be converted back to exactly the same
+// strings, STRING type otherwise
+CachedData::ColumnType CachedDataPrivate::columnType(
+    const QList<QList<QString>>& rows, const qsizetype column)
+{
+    auto isInteger = true, isDouble = true, hasValues = false;
+    for (const auto& row : rows) {
+        if (row.size() <= column || row.at(column).isEmpty()) { continue; }
+
+        const auto& str = row.at(column);
+        hasValues = true;
+        auto ok = false;
+        if (isInteger) {
+            const auto number = NumberConverter::toLongLong(str, &ok);
+            isInteger = ok && NumberConverter::toString(number) == str;
+        }
+
+        if (isDouble) {
+            const auto number = NumberConverter::toDouble(str, &ok);
+            isDouble = ok && NumberConverter::toString(number) == str;
+        }
+
+        if (!isInteger && !isDouble) { break; }
+    }
+
+    if (!hasValues) { return CachedData::ColumnType::STRING; }
+    if (isInteger) { return CachedData::ColumnType::INTEGER; }
+    if (isDouble) { return CachedData::ColumnType::DOUBLE; }
+
+    return CachedData::ColumnType::STRING;
+}
+
+// Write cache file. File is replaced atomically, so readers never see
+// a partially written cache.
+// @input:
+// - cachePath - path to the cache file
+// - key - key of the csv-file
+// - rows - rows of the csv-file
+// @output:
+// - bool - True if cache was written, False otherwise
+bool CachedDataPrivate::write(
+    const QString& cachePath,
+    const CacheKey& key,
+    const QList<QList<QString>>& rows)
+{
+    const auto align = [](const quint64 value) {
+        return (value + 7) / 8 * 8;
+    };
+
+    qsizetype columnCount = 0;
+    for (const auto& row : rows) {
+        columnCount = qMax(columnCount, row.size());
+    }
+
+    std::vector<CachedData::ColumnType> types;
+    for (qsizetype column = 0; column < columnCount; ++column) {
+        types.push_back(columnType(rows, column));
+    }
+
+    // Dictionary of unique strings of string columns
+    QHash<QString, quint32> ids;
+    QList<QString> strings;
+    quint64 dictionaryDataLength = 0;
+    for (const auto& row : rows) {
+        for (qsizetype column = 0; column < row.size(); ++column) {
+            if (types[column] != CachedData::ColumnType::STRING ||
+                ids.contains(row.at(column)))
+            {
+                continue;
+            }
+
+            ids.insert(row.at(column), static_cast<quint32>(strings.size()));
+            strings << row.at(column);
+            dictionaryDataLength += row.at(column).size();
+        }
+    }
+
+    // Calculate layout of the file
+    const quint64 rowCount = rows.size();
+    const quint64 emptyLength = (rowCount + 7) / 8;
+    CacheHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.sourceSize = key.size;
+    header.sourceModified = key.modified;
+    header.codec = key.codec;
+    header.keyOffset = sizeof(CacheHeader);
+    header.keyLength = key.id.size();
+    header.rowCount = rowCount;
+    header.columnCount = columnCount;
+    header.rowIndexOffset =
+        align(header.keyOffset + header.keyLength * sizeof(QChar));
+    header.columnsOffset =
+        align(header.rowIndexOffset + rowCount * sizeof(quint32));
+
+    std::vector<ColumnInfo> columns(columnCount);
+    auto offset = header.columnsOffset + columnCount * sizeof(ColumnInfo);
+    for (qsizetype column = 0; column < columnCount; ++column) {
+        auto& info = columns[column];
+        info.type = static_cast<quint32>(types[column]);
+        info.valuesOffset = offset;
+        if (types[column] == CachedData::ColumnType::STRING) {
+            offset = align(offset + rowCount * sizeof(quint32));
+        }
+        else {
+            info.emptyOffset = offset + rowCount * sizeof(qint64);
+            offset = align(info.emptyOffset + emptyLength);
+        }
+    }
+
+    header.dictionaryOffset = offset;
+    header.dictionarySize = strings.size();
+    header.dictionaryDataOffset = header.dictionaryOffset +
+        (strings.size() + 1) * sizeof(quint64);
+    header.dictionaryDataLength = dictionaryDataLength;
+    header.fileSize = align(header.dictionaryDataOffset +
+        dictionaryDataLength * sizeof(QChar));
+
+    // Write sections in the same order
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << cachePath;
+        return false;
+    }
+
+    quint64 position = 0;
+    auto result = true;
+    const auto write = [&file, &position, &result](
+        const void* data, const quint64 size)
+    {
+        if (result && 0 < size) {
+            result = file.write(static_cast<const char*>(data), size) ==
+                static_cast<qint64>(size);
+        }
+
+        position += size;
+    };
+
+    const auto pad = [&write, &position, &align]() {
+        const char zeros[8] = {};
+        write(zeros, align(position) - position);
+    };
+
+    write(&header, sizeof(header));
+    write(key.id.constData(), key.id.size() * sizeof(QChar));
+    pad();
+
+    std::vector<quint32> rowIndex;
+    rowIndex.reserve(rowCount);
+    for (const auto& row : rows) {
+        rowIndex.push_back(static_cast<quint32>(row.size()));
+    }
+
+    write(rowIndex.data(), rowIndex.size() * sizeof(quint32));
+    pad();
+    write(columns.data(), columns.size() * sizeof(ColumnInfo));
+
+    for (qsizetype column = 0; column < columnCount; ++column) {
+        if (types[column] == CachedData::ColumnType::STRING) {
+            std::vector<quint32> values(rowCount, 0);
+            for (quint64 row = 0; row < rowCount; ++row) {
+                const auto& rowValues = rows.at(row);
+                if (column < rowValues.size()) {
+                    values[row] = ids.value(rowValues.at(column));
+                }
+            }
+
+            write(values.data(), values.size() * sizeof(quint32));
+        }
+        else {
+            std::vector<qint64> values(rowCount, 0);
+            std::vector<quint8> empty(emptyLength, 0);
+            for (quint64 row = 0; row < rowCount; ++row) {
+                const auto& rowValues = rows.at(row);
+                if (rowValues.size() <= column ||
+                    rowValues.at(column).isEmpty())
+                {
+                    empty[row / 8] |= static_cast<quint8>(1 << (row % 8));
+                    continue;
+                }
+
+                if (types[column] == CachedData::ColumnType::INTEGER) {
+                    values[row] =
+                        NumberConverter::toLongLong(rowValues.at(column));
+                }
+                else {
+                    const auto number =
+                        NumberConverter::toDouble(rowValues.at(column));
+                    std::memcpy(&values[row], &number, sizeof(number));
+                }
+            }
+
+            write(values.data(), values.size() * sizeof(qint64));
+            write(empty.data(), empty.size());
+        }
+
+        pad();
+    }
+
+    std::vector<quint64> dictionaryOffsets;
+    dictionaryOffsets.reserve(strings.size() + 1);
+    quint64 stringOffset = 0;
+    for (const auto& str : strings) {
+        dictionaryOffsets.push_back(stringOffset);
+        stringOffset += str.size();
+    }
+
+    dictionaryOffsets.push_back(stringOffset);
+    write(dictionaryOffsets.data(),
+          dictionaryOffsets.size() * sizeof(quint64));
+    for (const auto& str : strings) {
+        write(str.constData(), str.size() * sizeof(QChar));
+    }
+
+    pad();
+
+    if (!result || position != header.fileSize || !file.commit()) {
+        qDebug() << __FUNCTION__ << "Error - failed to write file:" <<
+            cachePath;
+        return false;
+    }
+
+    return true;
+}
+
+// Map cache file and check that it is valid and up to date
+// @input:
+// - cachePath - path to the cache file
+// - key - key of the csv-file
+// @output:
+// - bool - True if cache was opened, False otherwise
+bool CachedDataPrivate::open(const QString& cachePath, const CacheKey& key) {
+    close();
+
+    file.setFileName(cachePath);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) { return false; }
+
+    const auto size = file.size();
+    if (size < static_cast<qint64>(sizeof(CacheHeader)) ||
+        (map = file.map(0, size)) == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    header = reinterpret_cast<const CacheHeader*>(map);
+    const auto isValid =
+        std::memcmp(header->magic, MAGIC, sizeof(header->magic)) == 0 &&
+        header->version == VERSION &&
+        header->byteOrder == BYTE_ORDER_MARK &&
+        header->fileSize == static_cast<quint64>(size) &&
+        isInside(header->keyOffset, header->keyLength, sizeof(QChar)) &&
+        isInside(header->rowIndexOffset, header->rowCount, sizeof(quint32)) &&
+        isInside(header->columnsOffset,
+                 header->columnCount, sizeof(ColumnInfo)) &&
+        header->dictionarySize < header->fileSize &&
+        isInside(header->dictionaryOffset,
+                 header->dictionarySize + 1, sizeof(quint64)) &&
+        isInside(header->dictionaryDataOffset,
+                 header->dictionaryDataLength, sizeof(QChar));
+    if (!isValid) {
+        qDebug() << __FUNCTION__ << "Warning - invalid cache file:" <<
+            cachePath;
+        close();
+        return false;
+    }
+
+    const auto id = QStringView(
+        reinterpret_cast<const QChar*>(map + header->keyOffset),
+        static_cast<qsizetype>(header->keyLength));
+    if (header->sourceSize != key.size ||
+        header->sourceModified != key.modified ||
+        header->codec != key.codec ||
+        id != key.id)
+    {
+        close();
+        return false;
+    }
+
+    rowIndex = reinterpret_cast<const quint32*>(map + header->rowIndexOffset);
+    columns = reinterpret_cast<const ColumnInfo*>(map + header->columnsOffset);
+    dictionaryOffsets =
+        reinterpret_cast<const quint64*>(map + header->dictionaryOffset);
+    dictionaryData =
+        reinterpret_cast<const QChar*>(map + header->dictionaryDataOffset);
+
+    const auto emptyLength = (header->rowCount + 7) / 8;
+    for (quint64 column = 0; column < header->columnCount; ++column) {
+        const auto& info = columns[column];
+        const auto isString =
+            info.type == static_cast<quint32>(CachedData::ColumnType::STRING);
+        const auto isColumnValid = isString ?
+            isInside(info.valuesOffset, header->rowCount, sizeof(quint32)) :
+            isInside(info.valuesOffset, header->rowCount, sizeof(qint64)) &&
+            isInside(info.emptyOffset, emptyLength, 1);
+        if (!isColumnValid) {
+            qDebug() << __FUNCTION__ << "Warning - invalid cache file:" <<
+                cachePath;
+            close();
+            return false;
+        }
+    }
+
+    cachedRows = static_cast<qsizetype>(header->rowCount);
+    return true;
+}
+
+// Unmap and close cache file
+void CachedDataPrivate::close() {
+    if (map != nullptr) { file.unmap(map); }
+    if (file.isOpen()) { file.close(); }
+
+    map = nullptr;
+    header = nullptr;
+    rowIndex = nullptr;
+    columns = nullptr;
+    dictionaryOffsets = nullptr;
+    dictionaryData = nullptr;
+    cachedRows = 0;
+}
+
+// Check that section of the cache is inside the file. Values of the header
+// are not trusted, so length of the section is not calculated: it could
+// overflow.
+// @input:
+// - offset - offset of the section
+// - count - number of items in the section
+// - itemSize - size of one item in bytes
+// @output:
+// - bool - True if section is inside the file, False otherwise
+bool CachedDataPrivate::isInside(
+    const quint64 offset, const quint64 count, const quint64 itemSize) const
+{
+    const auto size = static_cast<quint64>(file.size());
+    return offset % 8 == 0 && offset <= size &&
+        count <= (size - offset) / itemSize;
+}
+
+// Get string value of the cached cell
+// @input:
+// - row - index of the row
+// - column - index of the column
+// @output:
+// - QString - value of the cell
+QString CachedDataPrivate::stringValue(
+    const qsizetype row, const qsizetype column) const
+{
+    const auto& info = columns[column];
+    const auto values = map + info.valuesOffset;
+    switch (static_cast<CachedData::ColumnType>(info.type)) {
+    case CachedData::ColumnType::INTEGER:
+    case CachedData::ColumnType::DOUBLE: {
+        const auto variant = value(row, column);
+        if (!variant.isValid()) { return QString(); }
+
+        QString result;
+        NumberConverter::toString(variant, result);
+        return result;
+    }
+    case CachedData::ColumnType::STRING:
+    default: {
+        const auto id = reinterpret_cast<const quint32*>(values)[row];
+        if (header->dictionarySize <= id) { return QString(); }
+
+        const auto begin = dictionaryOffsets[id];
+        const auto end = dictionaryOffsets[id + 1];
+        if (end < begin || header->dictionaryDataLength < end) {
+            return QString();
+        }
+
+        return QString(dictionaryData + begin,
+                       static_cast<qsizetype>(end - begin));
+    }
+    }
+}
+
+// Get typed value of the cached cell
+// @input:
+// - row - index of the row
+// - column - index of the column
+// @output:
+// - QVariant - value of the cell or invalid QVariant if the numeric
+// cell is empty
+QVariant CachedDataPrivate::value(
+    const qsizetype row, const qsizetype column) const
+{
+    const auto& info = columns[column];
+    const auto type = static_cast<CachedData::ColumnType>(info.type);
+    if (type == CachedData::ColumnType::STRING) {
+        return stringValue(row, column);
+    }
+
+    const auto empty = map + info.emptyOffset;
+    if (empty[row / 8] & (1 << (row % 8))) { return QVariant(); }
+
+    qint64 number = 0;
+    std::memcpy(&number, map + info.valuesOffset + row * sizeof(qint64),
+                sizeof(number));
+    if (type == CachedData::ColumnType::INTEGER) {
+        return QVariant(static_cast<qlonglong>(number));
+    }
+
+    double result = 0;
+    std::memcpy(&result, &number, sizeof(result));
+    return QVariant(result);
+}
+
+CachedData::CachedData() : d(std::make_unique<CachedDataPrivate>()) {}
+
+CachedData::~CachedData() {
+    d->close();
+}
+
+// Load csv-file using the cache
+// @input:
+// - filePath - string with absolute path to csv-file
+// - cachePath - string with path to the cache file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if data was loaded, False otherwise. If cache could not be
+// written, rows of the csv-file are kept in memory and True is returned.
+bool CachedData::load(
+    const QString& filePath,
+    const QString& cachePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    clear();
+
+    CacheKey key;
+    if (!CachedDataPrivate::cacheKey(
+            filePath, separator, textDelimiter, codec, key))
+    {
+        qDebug() << __FUNCTION__ << "Error - wrong file path:" << filePath;
+        return false;
+    }
+
+    if (d->open(cachePath, key)) { return true; }
+
+    QList<QList<QString>> rows;
+    if (!CachedDataPrivate::readFile(
+            filePath, separator, textDelimiter, codec, rows))
+    {
+        return false;
+    }
+
+    if (CachedDataPrivate::write(cachePath, key, rows) &&
+        d->open(cachePath, key))
+    {
+        return true;
+    }
+
+    qDebug() << __FUNCTION__ << "Warning - cache is not used for" << filePath;
+    d->rows = rows;
+    return true;
+}
+
+// Open cache only if it is up to date with the csv-file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - cachePath - string with path to the cache file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if cache was opened, False if it is missing or out of date
+bool CachedData::openCache(
+    const QString& filePath,
+    const QString& cachePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    clear();
+
+    CacheKey key;
+    return CachedDataPrivate::cacheKey(
+               filePath, separator, textDelimiter, codec, key) &&
+        d->open(cachePath, key);
+}
+
+// Read csv-file and write its cache
+// @input:
+// - filePath - string with absolute path to csv-file
+// - cachePath - string with path to the cache file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if cache was written, False otherwise
+bool CachedData::writeCache(
+    const QString& filePath,
+    const QString& cachePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    // Key is taken before reading, so changes made during reading
+    // invalidate the cache
+    CacheKey key;
+    QList<QList<QString>> rows;
+    return CachedDataPrivate::cacheKey(
+               filePath, separator, textDelimiter, codec, key) &&
+        CachedDataPrivate::readFile(
+            filePath, separator, textDelimiter, codec, rows) &&
+        CachedDataPrivate::write(cachePath, key, rows);
+}
+
+// Get number of columns in the cache
+// @output:
+// - qsizetype - max number of values in the cached rows
+qsizetype CachedData::columnCount() const {
+    return d->header == nullptr ?
+        0 : static_cast<qsizetype>(d->header->columnCount);
+}
+
+// Get type of the cached column
+// @input:
+// - column - index of the column
+// @output:
+// - ColumnType - type of values of the column. STRING for columns that are
+// not cached.
+CachedData::ColumnType CachedData::columnType(const qsizetype column) const {
+    if (column < 0 || columnCount() <= column) { return ColumnType::STRING; }
+
+    return static_cast<ColumnType>(d->columns[column].type);
+}
+
+// Get typed value of the cell
+// @input:
+// - row - index of the row
+// - column - index of the column
+// @output:
+// - QVariant - value of the cell
+QVariant CachedData::value(const qsizetype row, const qsizetype column) const
+{
+    if (row < 0 || rowCount() <= row || column < 0) { return QVariant(); }
+
+    if (d->cachedRows <= row) {
+        const auto& values = d->rows.at(row - d->cachedRows);
+        return column < values.size() ? QVariant(values.at(column)) :
+                                        QVariant();
+    }
+
+    if (static_cast<qsizetype>(d->rowIndex[row]) <= column) {
+        return QVariant();
+    }
+
+    return d->value(row, column);
+}
+
+// Add new empty row
+void CachedData::addEmptyRow() {
+    d->rows << QList<QString>();
+}
+
+// Add new row with specified values
+// @input:
+// - values - list of strings
+void CachedData::addRow(const QList<QString>& values) {
+    d->rows << values;
+}
+
+// Clear all data and close the cache
+void CachedData::clear() {
+    d->close();
+    d->rows.clear();
+}
+
+// Check if there are any rows
+// @output:
+// - bool - True if there are any rows, else False
+bool CachedData::isEmpty() const {
+    return rowCount() == 0;
+}
+
+// Get number of rows
+// @output:
+// - qsizetype - number of rows
+qsizetype CachedData::rowCount() const {
+    return d->cachedRows + d->rows.size();
+}
+
+// Get values of specified row as list of strings
+// @input:
+// - row - valid number of the row
+// @output:
+// - QList<QString> - values of the row. If row is invalid number, function
+// will return empty QList<QString>.
+QList<QString> CachedData::rowValues(const qsizetype row) const {
+    if (row < 0 || rowCount() <= row) { return QList<QString>(); }
+
+    if (d->cachedRows <= row) { return d->rows.at(row - d->cachedRows); }
+
+    const auto size = static_cast<qsizetype>(d->rowIndex[row]);
+    QList<QString> values;
+    values.reserve(size);
+    for (qsizetype column = 0;
+         column < size && column < columnCount(); ++column)
+    {
+        values << d->stringValue(row, column);
+    }
+
+    return values;
+}
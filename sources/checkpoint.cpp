@@ -0,0 +1,54 @@
+#include "include/qtcsv/checkpoint.h"
+#include <QDataStream>
+#include <QIODevice>
+
+using namespace QtCSV;
+
+// Signature and version of serialized checkpoint
+struct CheckpointFormat {
+    static const quint32 MAGIC = 0x51435350;
+    static const quint16 VERSION = 1;
+};
+
+// Serialize checkpoint to bytes
+// @output:
+// - QByteArray - serialized checkpoint
+QByteArray ReadCheckpoint::toByteArray() const {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << CheckpointFormat::MAGIC << CheckpointFormat::VERSION <<
+        offset << rows << separator << textDelimiter <<
+        static_cast<qint32>(codec);
+    return data;
+}
+
+// Restore checkpoint from bytes
+// @input:
+// - data - bytes that were returned by toByteArray()
+// @output:
+// - ReadCheckpoint - restored checkpoint. If data is not a serialized
+// checkpoint, returned checkpoint is invalid.
+ReadCheckpoint ReadCheckpoint::fromByteArray(const QByteArray& data) {
+    QDataStream stream(data);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != CheckpointFormat::MAGIC ||
+        version != CheckpointFormat::VERSION)
+    {
+        return ReadCheckpoint();
+    }
+
+    ReadCheckpoint checkpoint;
+    qint32 codec = 0;
+    stream >> checkpoint.offset >> checkpoint.rows >> checkpoint.separator >>
+        checkpoint.textDelimiter >> codec;
+    if (stream.status() != QDataStream::Ok || codec < 0 ||
+        QStringConverter::System < codec)
+    {
+        return ReadCheckpoint();
+    }
+
+    checkpoint.codec = static_cast<QStringConverter::Encoding>(codec);
+    return checkpoint;
+}
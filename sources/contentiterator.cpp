@@ -1,33 +1,44 @@
 #include "sources/contentiterator.h"
+#include "sources/instrumenteddevice.h"
 #include "sources/symbols.h"
 
 using namespace QtCSV;
 
 // Constructor of ContentIterator
 // @input:
-// - data - AbstractData object
+// - source - source of rows of data
 // - separator - string or character that would separate values in a row (line)
 // - textDelimiter - string or character that enclose each element in a row
 // - header - strings that will be placed on the first line
 // - footer - strings that will be placed on the last line
+// - stats - optional object for statistics of writing
+// - progress - optional object for progress reporting and cancellation. It
+// requires stats object.
 // - chunkSize - size (in rows) of chunk of data
 ContentIterator::ContentIterator(
-    const AbstractData& data,
+    AbstractRowSource& source,
     const QString& separator,
     const QString& textDelimiter,
     const QList<QString>& header,
     const QList<QString>& footer,
+    WriteStats* stats,
+    Progress* progress,
     const qsizetype chunkSize) :
-    m_data(data), m_separator(separator), m_textDelimiter(textDelimiter),
-    m_header(header), m_footer(footer), m_chunkSize(chunkSize), m_dataRow(-1),
-    m_atEnd(false)
-{}
+    m_source(source), m_separator(separator), m_textDelimiter(textDelimiter),
+    m_header(header), m_footer(footer), m_stats(stats),
+    m_tracker(progress, stats), m_chunkSize(chunkSize),
+    m_hasRow(false), m_headerAdded(false), m_atEnd(false), m_canceled(false)
+{
+    // Fetch the first row in advance to know if there is any data
+    m_hasRow = fetchRow();
+}
 
 // Check if content contains information
 // @output:
 // - bool - True if content is empty, False otherwise
 bool ContentIterator::isEmpty() const {
-    return m_data.isEmpty() && m_header.isEmpty() && m_footer.isEmpty();
+    return !m_hasRow && !m_headerAdded && m_header.isEmpty() &&
+        m_footer.isEmpty();
 }
 
 // Check if content still has chunks of information to return
@@ -48,34 +59,35 @@ QString ContentIterator::getNext() {
     QString content;
     qsizetype rowsNumber = 0;
 
-    // Initially m_dataRow have negative value. Negative value indicates that
-    // client have called this function first time. In this case at the
-    // beginning of the chunk we should place header information. And then
-    // set m_dataRow to the index of the first row in main data container.
-    if (m_dataRow < 0) {
+    // If client have called this function first time, at the beginning of
+    // the chunk we should place header information.
+    if (!m_headerAdded) {
         if (!m_header.isEmpty()) {
-            content.append(composeRow(m_header));
+            appendRow(content, m_header);
             ++rowsNumber;
         }
 
-        m_dataRow = 0;
+        m_headerAdded = true;
     }
 
-    // Check if m_dataRow is less than number of rows in m_data. If this is
-    // true, add information from the m_data to the chunk. Otherwise, this means
-    // that we already have passed all information from the m_data.
-    if (m_dataRow < m_data.rowCount()) {
-        const auto endRow =
-            qMin(m_dataRow + m_chunkSize - rowsNumber, m_data.rowCount());
-        for (auto i = m_dataRow; i < endRow; ++i, ++m_dataRow, ++rowsNumber) {
-            content.append(composeRow(m_data.rowValues(i)));
+    // Add rows from the source to the chunk while there is a place for them.
+    // m_row always holds the row that was fetched but not yet added.
+    while (m_hasRow && rowsNumber < m_chunkSize) {
+        appendRow(content, m_row);
+        ++rowsNumber;
+        if (!m_tracker.update()) {
+            m_canceled = true;
+            m_atEnd = true;
+            return content;
         }
+
+        m_hasRow = fetchRow();
     }
 
     // If we still have place in chunk, try to add footer information to it.
     if (rowsNumber < m_chunkSize) {
         if (!m_footer.isEmpty()) {
-            content.append(composeRow(m_footer));
+            appendRow(content, m_footer);
             ++rowsNumber;
         }
 
@@ -87,20 +99,63 @@ QString ContentIterator::getNext() {
     return content;
 }
 
+// Check if iteration was canceled by Progress object
+// @output:
+// - bool - True if iteration was stopped before the end of the content
+bool ContentIterator::isCanceled() const {
+    return m_canceled;
+}
+
+// Report the final progress. Should be called after all chunks were
+// written.
+void ContentIterator::finish() {
+    if (!m_canceled) { m_tracker.finish(); }
+}
+
+// Get next row from the source
+// @output:
+// - bool - True if row was fetched to m_row, False if source is exhausted
+bool ContentIterator::fetchRow() {
+    StageTimer stageTimer(timer(&WriteStats::sourceNsecs));
+    m_row.clear();
+    return m_source.nextRow(m_row);
+}
+
+// Compose row string from values and append it to the chunk
+// @input:
+// - content - chunk of information
+// - values - list of values in rows
+void ContentIterator::appendRow(
+    QString& content, const QList<QString>& values)
+{
+    StageTimer stageTimer(timer(&WriteStats::composeNsecs));
+    content.append(composeRow(values, m_separator, m_textDelimiter));
+    if (m_stats != nullptr) {
+        ++m_stats->rows;
+        m_stats->fields += values.size();
+    }
+}
+
 // Compose row string from values
 // @input:
 // - values - list of values in rows
+// - separator - string or character that would separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
 // @output:
 // - QString - result row string
-QString ContentIterator::composeRow(const QList<QString>& values) const {
+QString ContentIterator::composeRow(
+    const QList<QString>& values,
+    const QString& separator,
+    const QString& textDelimiter)
+{
     QList<QString> rowValues = values;
-    const QString twoDelimiters = m_textDelimiter + m_textDelimiter;
+    const QString twoDelimiters = textDelimiter + textDelimiter;
     for (auto i = 0; i < rowValues.size(); ++i) {
-        rowValues[i].replace(m_textDelimiter, twoDelimiters);
+        rowValues[i].replace(textDelimiter, twoDelimiters);
 
-        QString delimiter = m_textDelimiter;
+        QString delimiter = textDelimiter;
         if (delimiter.isEmpty() &&
-            (rowValues.at(i).contains(m_separator) ||
+            (rowValues.at(i).contains(separator) ||
              rowValues.at(i).contains(CR) || rowValues.at(i).contains(LF)))
         {
             delimiter = DOUBLE_QUOTE;
@@ -110,7 +165,7 @@ QString ContentIterator::composeRow(const QList<QString>& values) const {
         rowValues[i].append(delimiter);
     }
 
-    QString result = rowValues.join(m_separator);
+    QString result = rowValues.join(separator);
     result.append(LF);
     return result;
 }
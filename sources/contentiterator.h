@@ -1,13 +1,15 @@
 #ifndef QTCSVCONTENTITERATOR_H
 #define QTCSVCONTENTITERATOR_H
 
-#include "include/qtcsv/abstractdata.h"
+#include "include/qtcsv/rowsource.h"
+#include "include/qtcsv/stats.h"
+#include "sources/progresstracker.h"
 #include <QList>
 #include <QString>
 
 namespace QtCSV {
 
-    // ContentIterator is a class that holds references to containers with
+    // ContentIterator is a class that holds references to sources of
     // information. Its main purpose:
     // - to separate information into a chunks and
     // - to return these chunks one by one to the client.
@@ -16,26 +18,35 @@ namespace QtCSV {
     // You can use this class with csv-writer class. ContentIterator will join
     // elements of one row with separator symbol and then join rows with
     // new line symbol.
+    // Rows of data are requested from the source one by one, so only one
+    // chunk of information is held in memory at a time.
+    // If WriteStats object is passed, ContentIterator counts rows and values
+    // and measures time of getting and composing of rows. If Progress object
+    // is passed, it should be passed together with WriteStats object.
     class ContentIterator {
-        const AbstractData& m_data;
+        AbstractRowSource& m_source;
         const QString& m_separator;
         const QString& m_textDelimiter;
         const QList<QString>& m_header;
         const QList<QString>& m_footer;
+        WriteStats* m_stats;
+        ProgressTracker m_tracker;
         const qsizetype m_chunkSize;
-        qsizetype m_dataRow;
+        QList<QString> m_row;
+        bool m_hasRow;
+        bool m_headerAdded;
         bool m_atEnd;
-
-        // Compose row string from values
-        QString composeRow(const QList<QString>& values) const;
+        bool m_canceled;
 
     public:
         ContentIterator(
-            const AbstractData& data,
+            AbstractRowSource& source,
             const QString& separator,
             const QString& textDelimiter,
             const QList<QString>& header,
             const QList<QString>& footer,
+            WriteStats* stats = nullptr,
+            Progress* progress = nullptr,
             qsizetype chunkSize = 1000);
 
         // Check if content contains information
@@ -44,6 +55,27 @@ namespace QtCSV {
         bool hasNext() const;
         // Get next chunk of information
         QString getNext();
+        // Check if iteration was canceled by Progress object
+        bool isCanceled() const;
+        // Report the final progress
+        void finish();
+
+        // Compose row string from values
+        static QString composeRow(
+            const QList<QString>& values,
+            const QString& separator,
+            const QString& textDelimiter);
+
+    private:
+        // Get next row from the source
+        bool fetchRow();
+        // Compose row string from values and append it to the chunk
+        void appendRow(QString& content, const QList<QString>& values);
+        // Get pointer to the timer of the stage if timings are collected
+        qint64* timer(qint64 WriteStats::* stage) const {
+            return m_stats != nullptr && m_stats->timings ?
+                &(m_stats->*stage) : nullptr;
+        }
     };
 }
 
@@ -0,0 +1,658 @@
+#include "include/qtcsv/externalsorter.h"
+#include "include/qtcsv/numberconverter.h"
+#include "include/qtcsv/writer.h"
+#include "sources/filechecker.h"
+#include "sources/rowreader.h"
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSemaphore>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace QtCSV;
+
+// SortRow holds values of a row and precomputed values of its keys
+struct SortRow {
+    QList<QString> values;
+    // Values of NUMERIC keys. NaN if value is not a number.
+    std::vector<double> numbers;
+    // Sort keys of LOCALE keys
+    std::vector<QCollatorSortKey> collationKeys;
+};
+
+// RowComparator extracts values of keys from rows and compares rows.
+// It holds its own QCollator, so each thread should use its own comparator.
+class RowComparator {
+    const QList<ExternalSorter::SortKey> m_keys;
+    QCollator m_collator;
+    // Index of the key value in SortRow::numbers or SortRow::collationKeys
+    std::vector<size_t> m_slots;
+
+public:
+    RowComparator(
+        const QList<ExternalSorter::SortKey>& keys, const QLocale& locale);
+
+    // Compute values of the keys of the row
+    void prepare(SortRow& row) const;
+    // Compare two prepared rows
+    int compare(const SortRow& first, const SortRow& second) const;
+    // Check if first row should go before the second one
+    bool operator()(const SortRow& first, const SortRow& second) const {
+        return compare(first, second) < 0;
+    }
+
+private:
+    static QStringView value(const SortRow& row, qsizetype column) {
+        return column < row.values.size() ?
+            QStringView(row.values.at(column)) : QStringView();
+    }
+};
+
+RowComparator::RowComparator(
+    const QList<ExternalSorter::SortKey>& keys, const QLocale& locale) :
+    m_keys(keys), m_collator(locale)
+{
+    size_t numbers = 0, collationKeys = 0;
+    for (const auto& key : m_keys) {
+        switch (key.type) {
+        case ExternalSorter::KeyType::NUMERIC:
+            m_slots.push_back(numbers++);
+            break;
+        case ExternalSorter::KeyType::LOCALE:
+            m_slots.push_back(collationKeys++);
+            break;
+        case ExternalSorter::KeyType::LEXICAL:
+            m_slots.push_back(0);
+            break;
+        }
+    }
+}
+
+// Compute values of the keys of the row
+// @input:
+// - row - row with values
+void RowComparator::prepare(SortRow& row) const {
+    row.numbers.clear();
+    row.collationKeys.clear();
+    for (const auto& key : m_keys) {
+        const auto str = value(row, key.column);
+        switch (key.type) {
+        case ExternalSorter::KeyType::NUMERIC: {
+            auto ok = false;
+            const auto number = NumberConverter::toDouble(str, &ok);
+            row.numbers.push_back(ok ? number : std::nan(""));
+            break;
+        }
+        case ExternalSorter::KeyType::LOCALE:
+            row.collationKeys.push_back(
+                m_collator.sortKey(str.toString()));
+            break;
+        case ExternalSorter::KeyType::LEXICAL:
+            break;
+        }
+    }
+}
+
+// Compare two prepared rows
+// @input:
+// - first - first row
+// - second - second row
+// @output:
+// - int - negative value if first row goes before the second one, positive
+// value if it goes after the second one and 0 if rows have equal keys
+int RowComparator::compare(
+    const SortRow& first, const SortRow& second) const
+{
+    for (qsizetype i = 0; i < m_keys.size(); ++i) {
+        const auto& key = m_keys.at(i);
+        const auto slot = m_slots.at(i);
+        auto result = 0;
+        switch (key.type) {
+        case ExternalSorter::KeyType::NUMERIC: {
+            const auto a = first.numbers.at(slot);
+            const auto b = second.numbers.at(slot);
+            const auto isNumberA = !std::isnan(a);
+            const auto isNumberB = !std::isnan(b);
+            if (isNumberA && isNumberB) {
+                result = a < b ? -1 : (b < a ? 1 : 0);
+            }
+            else if (isNumberA != isNumberB) {
+                result = isNumberA ? -1 : 1;
+            }
+            else {
+                result = value(first, key.column).compare(
+                    value(second, key.column));
+            }
+
+            break;
+        }
+        case ExternalSorter::KeyType::LOCALE:
+            result = first.collationKeys.at(slot).compare(
+                second.collationKeys.at(slot));
+            break;
+        case ExternalSorter::KeyType::LEXICAL:
+            result = value(first, key.column).compare(
+                value(second, key.column));
+            break;
+        }
+
+        if (result != 0) {
+            return key.order == Qt::AscendingOrder ? result : -result;
+        }
+    }
+
+    return 0;
+}
+
+// RunReader reads rows from the file of a sorted run
+class RunReader {
+    QFile m_file;
+    QDataStream m_stream;
+    bool m_failed = false;
+
+public:
+    explicit RunReader(const QString& filePath) : m_file(filePath) {}
+
+    bool open() {
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+                m_file.fileName();
+            return false;
+        }
+
+        m_stream.setDevice(&m_file);
+        return true;
+    }
+
+    // Read next row. Returns False at the end of file or in case of error.
+    bool readRow(QList<QString>& values) {
+        if (m_failed || m_stream.atEnd()) { return false; }
+
+        m_stream >> values;
+        if (m_stream.status() != QDataStream::Ok) {
+            qDebug() << __FUNCTION__ << "Error - failed to read file:" <<
+                m_file.fileName();
+            m_failed = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool failed() const { return m_failed; }
+};
+
+// RunMerger merges sorted runs and returns rows in sorted order. Rows with
+// equal keys are returned in order of runs, so merge is stable.
+class RunMerger : public AbstractRowSource {
+    const RowComparator& m_comparator;
+    std::vector<std::unique_ptr<RunReader>> m_runs;
+    // Current row of each run
+    std::vector<SortRow> m_rows;
+    // Heap of indexes of runs that have rows
+    std::vector<size_t> m_heap;
+    bool m_failed = false;
+
+public:
+    explicit RunMerger(const RowComparator& comparator) :
+        m_comparator(comparator) {}
+
+    // Open files of runs and read their first rows
+    bool open(const QList<QString>& filePaths);
+    bool nextRow(QList<QString>& values) override;
+    // Check if some run failed to be read
+    bool failed() const { return m_failed; }
+
+private:
+    // Read next row of the run and push it to the heap
+    void advance(size_t run);
+    // Check if current row of the first run should go after the current row
+    // of the second run
+    bool isAfter(size_t first, size_t second) const {
+        const auto result = m_comparator.compare(m_rows[first], m_rows[second]);
+        return 0 < result || (result == 0 && second < first);
+    }
+};
+
+// Open files of runs and read their first rows
+// @input:
+// - filePaths - paths to files of runs in order of rows in the input data
+// @output:
+// - bool - True if all files were opened, False otherwise
+bool RunMerger::open(const QList<QString>& filePaths) {
+    m_rows.resize(filePaths.size());
+    for (const auto& path : filePaths) {
+        m_runs.push_back(std::make_unique<RunReader>(path));
+        if (!m_runs.back()->open()) { return false; }
+    }
+
+    for (size_t i = 0; i < m_runs.size(); ++i) { advance(i); }
+
+    return !m_failed;
+}
+
+// Read next row of the run and push it to the heap
+// @input:
+// - run - index of the run
+void RunMerger::advance(const size_t run) {
+    if (!m_runs[run]->readRow(m_rows[run].values)) {
+        m_failed = m_failed || m_runs[run]->failed();
+        return;
+    }
+
+    m_comparator.prepare(m_rows[run]);
+    m_heap.push_back(run);
+    std::push_heap(m_heap.begin(), m_heap.end(),
+        [this](size_t first, size_t second) { return isAfter(first, second); });
+}
+
+bool RunMerger::nextRow(QList<QString>& values) {
+    if (m_failed || m_heap.empty()) { return false; }
+
+    std::pop_heap(m_heap.begin(), m_heap.end(),
+        [this](size_t first, size_t second) { return isAfter(first, second); });
+    const auto run = m_heap.back();
+    m_heap.pop_back();
+
+    values = std::move(m_rows[run].values);
+    m_rows[run].values.clear();
+    advance(run);
+    return true;
+}
+
+namespace QtCSV {
+
+class ExternalSorterPrivate {
+public:
+    using WriteFunction = std::function<bool(
+        AbstractRowSource& source, const QList<QString>& header)>;
+
+    QList<ExternalSorter::SortKey> keys = {ExternalSorter::SortKey()};
+    qint64 memoryLimit = 256 * 1024 * 1024;
+    QString tempDir;
+    int threadCount = QThread::idealThreadCount();
+    qsizetype maxFanIn = 64;
+    QLocale locale;
+    bool hasHeader = false;
+
+    // Sort csv-data and pass sorted rows to the write function
+    bool sort(
+        QIODevice& input,
+        const WriteFunction& write,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec) const;
+
+    // Get approximate size of the row in memory
+    qint64 rowSize(const SortRow& row) const;
+
+    // Sort rows of the run and write them to the file
+    bool writeSortedRun(std::vector<SortRow>& rows, const QString& filePath)
+        const;
+
+    // Write rows to the file of a run
+    static bool writeRun(AbstractRowSource& source, const QString& filePath);
+
+    // Merge runs in several passes until there are no more than maxFanIn runs
+    bool reduceRuns(QList<QString>& runs, const QDir& dir) const;
+};
+
+}
+
+// Sort csv-data and pass sorted rows to the write function
+// @input:
+// - input - IO Device with csv-data
+// - write - function that writes sorted rows and header
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose row elements
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if data was sorted and written, False otherwise
+bool ExternalSorterPrivate::sort(
+    QIODevice& input,
+    const WriteFunction& write,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (!input.isOpen() && !input.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
+        return false;
+    }
+
+    RowReader reader(input, separator, textDelimiter, codec);
+    QList<QString> header, values;
+    if (hasHeader && reader.readRow(values)) { header = values; }
+
+    // While one run is being filled, others could be sorted and written
+    // by threads, so memory is shared between them
+    const auto threads = qMax(1, threadCount);
+    const auto runLimit = qMax<qint64>(1, memoryLimit / (threads + 1));
+
+    std::unique_ptr<QTemporaryDir> dir;
+    QList<QString> runs;
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    QSemaphore freeThreads(threads);
+    std::atomic<bool> failed(false);
+
+    std::vector<SortRow> rows;
+    qint64 size = 0;
+    auto spill = [&]() {
+        if (!dir) {
+            dir = std::make_unique<QTemporaryDir>(
+                QDir(tempDir.isEmpty() ? QDir::tempPath() : tempDir)
+                    .filePath("qtcsv-sort-XXXXXX"));
+            if (!dir->isValid()) {
+                qDebug() << __FUNCTION__ <<
+                    "Error - can't create temporary directory in" <<
+                    tempDir;
+                return false;
+            }
+        }
+
+        const auto path = dir->filePath(QString("run_%1").arg(runs.size()));
+        runs << path;
+
+        auto chunk = std::make_shared<std::vector<SortRow>>(std::move(rows));
+        rows = std::vector<SortRow>();
+        size = 0;
+
+        freeThreads.acquire();
+        pool.start([this, chunk, path, &freeThreads, &failed]() {
+            if (!writeSortedRun(*chunk, path)) { failed = true; }
+            chunk->clear();
+            freeThreads.release();
+        });
+
+        return true;
+    };
+
+    while (!failed && reader.readRow(values)) {
+        SortRow row;
+        row.values = std::move(values);
+        size += rowSize(row);
+        rows.push_back(std::move(row));
+        if (runLimit <= size && !spill()) {
+            failed = true;
+            break;
+        }
+    }
+
+    if (runs.isEmpty() && !failed) {
+        // All rows fit into memory
+        const RowComparator comparator(keys, locale);
+        for (auto& row : rows) { comparator.prepare(row); }
+        std::stable_sort(rows.begin(), rows.end(), comparator);
+
+        size_t index = 0;
+        FunctionRowSource source([&rows, &index](QList<QString>& row) {
+            if (rows.size() <= index) { return false; }
+
+            row = std::move(rows[index++].values);
+            return true;
+        });
+
+        return write(source, header);
+    }
+
+    if (!rows.empty() && !failed && !spill()) { failed = true; }
+
+    pool.waitForDone();
+    if (failed || !reduceRuns(runs, QDir(dir->path()))) { return false; }
+
+    const RowComparator comparator(keys, locale);
+    RunMerger merger(comparator);
+    if (!merger.open(runs)) { return false; }
+
+    return write(merger, header) && !merger.failed();
+}
+
+// Get approximate size of the row in memory
+// @input:
+// - row - row with values
+// @output:
+// - qint64 - size of the row in bytes including size of its keys
+qint64 ExternalSorterPrivate::rowSize(const SortRow& row) const {
+    // Size of QString data header and of allocation overhead
+    const qint64 overhead = 32;
+    qint64 result = sizeof(SortRow) + overhead +
+        row.values.size() * (sizeof(QString) + overhead);
+    for (const auto& value : row.values) {
+        result += value.size() * sizeof(QChar);
+    }
+
+    for (const auto& key : keys) {
+        if (key.type == ExternalSorter::KeyType::NUMERIC) {
+            result += sizeof(double);
+        }
+        else if (key.type == ExternalSorter::KeyType::LOCALE) {
+            // Collation key is usually about twice as long as the string
+            const auto column = key.column;
+            result += sizeof(QCollatorSortKey) + overhead +
+                (column < row.values.size() ?
+                    2 * row.values.at(column).size() : 0);
+        }
+    }
+
+    return result;
+}
+
+// Sort rows of the run and write them to the file. This function is called
+// from threads of the pool.
+// @input:
+// - rows - rows of the run
+// - filePath - path to the file of the run
+// @output:
+// - bool - True if run was written, False otherwise
+bool ExternalSorterPrivate::writeSortedRun(
+    std::vector<SortRow>& rows, const QString& filePath) const
+{
+    const RowComparator comparator(keys, locale);
+    for (auto& row : rows) { comparator.prepare(row); }
+    std::stable_sort(rows.begin(), rows.end(), comparator);
+
+    size_t index = 0;
+    FunctionRowSource source([&rows, &index](QList<QString>& values) {
+        if (rows.size() <= index) { return false; }
+
+        values = std::move(rows[index++].values);
+        return true;
+    });
+
+    return writeRun(source, filePath);
+}
+
+// Write rows to the file of a run. Runs are saved in binary form, so values
+// are read back exactly as they were, regardless of separators and spaces.
+// @input:
+// - source - source of rows
+// - filePath - path to the file of the run
+// @output:
+// - bool - True if all rows were written, False otherwise
+bool ExternalSorterPrivate::writeRun(
+    AbstractRowSource& source, const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    QList<QString> values;
+    // Source gets empty list for each row
+    for (values.clear(); source.nextRow(values); values.clear()) {
+        stream << values;
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.flush()) {
+        qDebug() << __FUNCTION__ << "Error - failed to write file:" <<
+            filePath;
+        return false;
+    }
+
+    return true;
+}
+
+// Merge runs in several passes until there are no more than maxFanIn runs
+// @input:
+// - runs - paths to files of runs. It will contain paths to new runs.
+// - dir - directory for the files of new runs
+// @output:
+// - bool - True if runs were merged, False otherwise
+bool ExternalSorterPrivate::reduceRuns(
+    QList<QString>& runs, const QDir& dir) const
+{
+    const RowComparator comparator(keys, locale);
+    const auto fanIn = qMax<qsizetype>(2, maxFanIn);
+    auto pass = 0;
+    while (fanIn < runs.size()) {
+        QList<QString> merged;
+        for (qsizetype i = 0; i < runs.size(); i += fanIn) {
+            const auto group = runs.mid(i, fanIn);
+            const auto path = dir.filePath(
+                QString("merge_%1_%2").arg(pass).arg(merged.size()));
+
+            {
+                RunMerger merger(comparator);
+                if (!merger.open(group) || !writeRun(merger, path) ||
+                    merger.failed())
+                {
+                    return false;
+                }
+            }
+
+            merged << path;
+            for (const auto& run : group) { QFile::remove(run); }
+        }
+
+        runs = merged;
+        ++pass;
+    }
+
+    return true;
+}
+
+ExternalSorter::ExternalSorter() :
+    d(std::make_unique<ExternalSorterPrivate>()) {}
+
+ExternalSorter::~ExternalSorter() = default;
+
+// Set sort keys
+// @input:
+// - keys - list of keys in order of priority. Rows are compared by the
+// first key, then by the second one and so on. Empty list is ignored.
+void ExternalSorter::setKeys(const QList<SortKey>& keys) {
+    if (!keys.isEmpty()) { d->keys = keys; }
+}
+
+// Set approximate amount of memory that could be used for rows
+// @input:
+// - bytes - memory limit in bytes
+void ExternalSorter::setMemoryLimit(const qint64 bytes) {
+    d->memoryLimit = qMax<qint64>(1, bytes);
+}
+
+// Set directory for temporary files
+// @input:
+// - dirPath - path to existing directory. Empty string means system
+// temporary directory.
+void ExternalSorter::setTempDir(const QString& dirPath) {
+    d->tempDir = dirPath;
+}
+
+// Set number of threads that sort runs
+// @input:
+// - count - number of threads. Must be positive.
+void ExternalSorter::setThreadCount(const int count) {
+    d->threadCount = qMax(1, count);
+}
+
+// Set max number of runs that are merged at once
+// @input:
+// - number - max number of runs. Must be 2 or more.
+void ExternalSorter::setMaxMergeFanIn(const qsizetype number) {
+    d->maxFanIn = qMax<qsizetype>(2, number);
+}
+
+// Set locale that is used to compare values of KeyType::LOCALE keys
+void ExternalSorter::setLocale(const QLocale& locale) {
+    d->locale = locale;
+}
+
+// Set if the first row is a header
+void ExternalSorter::setHasHeader(const bool hasHeader) {
+    d->hasHeader = hasHeader;
+}
+
+// Sort csv-file and write result to another csv-file
+// @input:
+// - inputFilePath - string with absolute path to csv-file that should be
+// sorted
+// - outputFilePath - string with absolute path to csv-file for the result.
+// It could be the same as inputFilePath.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading and writing
+// @output:
+// - bool - True if data was sorted and written, False otherwise
+bool ExternalSorter::sort(
+    const QString& inputFilePath,
+    const QString& outputFilePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    if (!CheckFile(inputFilePath, true)) {
+        qDebug() << __FUNCTION__ << "Error - wrong file path:" <<
+            inputFilePath;
+        return false;
+    }
+
+    QFile input(inputFilePath);
+    if (!input.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+            inputFilePath;
+        return false;
+    }
+
+    return d->sort(input,
+        [&](AbstractRowSource& source, const QList<QString>& header) {
+            return Writer::write(outputFilePath, source, separator,
+                textDelimiter, Writer::WriteMode::REWRITE, header, {}, codec);
+        },
+        separator, textDelimiter, codec);
+}
+
+// Sort csv-data from IO Device and write result to another IO Device
+bool ExternalSorter::sort(
+    QIODevice& input,
+    QIODevice& output,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    return d->sort(input,
+        [&](AbstractRowSource& source, const QList<QString>& header) {
+            return Writer::write(output, source, separator, textDelimiter,
+                header, {}, codec);
+        },
+        separator, textDelimiter, codec);
+}
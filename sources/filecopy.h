@@ -0,0 +1,57 @@
+#ifndef QTCSVFILECOPY_H
+#define QTCSVFILECOPY_H
+
+#include <QFileDevice>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+namespace QtCSV {
+    // Copy range of the source file to the current position of the
+    // destination file. On Linux the kernel copies data between files
+    // without passing it through the user space. If it is not supported by
+    // the file systems, data is written from the memory-mapped source file.
+    // @input:
+    // - source - opened source file
+    // - data - memory-mapped data of the source file
+    // - begin - position of the beginning of the range
+    // - end - position of the end of the range
+    // - destination - file opened for writing (not in append mode)
+    // @output:
+    // - bool - True if range was copied, False otherwise
+    inline bool CopyFileRange(
+        QFileDevice& source,
+        const char* data,
+        qint64 begin,
+        const qint64 end,
+        QFileDevice& destination)
+    {
+#if defined(Q_OS_LINUX) && defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+        if (destination.flush()) {
+            const auto start = destination.pos();
+            loff_t offset = begin;
+            while (offset < end) {
+                const auto copied = copy_file_range(
+                    source.handle(), &offset, destination.handle(), nullptr,
+                    static_cast<size_t>(end - offset), 0);
+                if (copied <= 0) { break; }
+            }
+
+            // Position of QFileDevice is not changed by the copy
+            if (!destination.seek(start + offset - begin)) { return false; }
+
+            if (offset == end) { return true; }
+
+            begin = offset;
+        }
+#else
+        Q_UNUSED(source);
+#endif
+
+        return destination.write(data + begin, end - begin) == end - begin;
+    }
+}
+
+#endif // QTCSVFILECOPY_H
@@ -0,0 +1,277 @@
+#include "include/qtcsv/filefollower.h"
+#include "sources/filechecker.h"
+#include "sources/rowindexer.h"
+#include "sources/rowreader.h"
+#include <QBuffer>
+#include <QDebug>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QStringEncoder>
+#include <QTimer>
+
+using namespace QtCSV;
+
+namespace QtCSV {
+
+class FileFollowerPrivate {
+public:
+    // Number of bytes before the position that are compared to detect
+    // replaced files
+    static const qsizetype FINGERPRINT_SIZE = 64;
+
+    QFileSystemWatcher watcher;
+    QTimer timer;
+    QString filePath;
+    QString separator;
+    QString textDelimiter;
+    QStringConverter::Encoding codec = QStringConverter::Utf8;
+    // Codec with explicit byte order. It is resolved at the beginning of
+    // the file.
+    QStringConverter::Encoding rowCodec = QStringConverter::Utf8;
+    bool following = false;
+
+    // Position of the end of the last delivered row
+    qint64 position = 0;
+    qint64 rows = 0;
+    // Bytes after the position: incomplete last row
+    QByteArray pending;
+    // Last bytes before the position
+    QByteArray fingerprint;
+
+    // Read new complete rows of the file
+    bool readRows(QList<QList<QString>>& newRows, bool& isReset);
+    // Check if the file was truncated or replaced
+    bool isReplaced(QFile& file) const;
+    // Forget the position in the file
+    void reset();
+};
+
+}
+
+// Read new complete rows of the file
+// @input:
+// - newRows - list for new rows
+// - isReset - set to True if file was truncated or replaced
+// @output:
+// - bool - True if file was read, False otherwise
+bool FileFollowerPrivate::readRows(
+    QList<QList<QString>>& newRows, bool& isReset)
+{
+    QFile file(filePath);
+    // File could be absent for a while during rotation
+    if (!file.exists()) { return true; }
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    isReset = isReplaced(file);
+    if (isReset) { reset(); }
+
+    const auto readPosition = position + pending.size();
+    if (file.size() <= readPosition) { return true; }
+
+    if (!file.seek(readPosition)) {
+        qDebug() << __FUNCTION__ << "Error - can't read file:" << filePath;
+        return false;
+    }
+
+    pending += file.read(file.size() - readPosition);
+
+    qsizetype bomSize = 0;
+    if (position == 0) {
+        rowCodec = RowIndexer::resolveCodec(
+            codec, QByteArrayView(pending).first(qMin<qsizetype>(
+                pending.size(), 4)), bomSize);
+    }
+
+    RowIndexer indexer(pending.constData(), pending.size(), bomSize,
+                       rowCodec, separator, textDelimiter);
+    QList<qint64> rowEnds;
+    indexer.scan(pending.size(), rowEnds);
+
+    // End of data is the end of a row only if it is a line end that is not
+    // inside of a quoted value. Single CR could be the beginning of CRLF.
+    QStringEncoder encoder(rowCodec);
+    const QByteArray lf = encoder.encode(QString("\n"));
+    if (!rowEnds.isEmpty() && rowEnds.last() == pending.size() &&
+        (indexer.isQuoted() || !pending.endsWith(lf)))
+    {
+        rowEnds.removeLast();
+    }
+
+    if (rowEnds.isEmpty()) { return true; }
+
+    const auto end = rowEnds.last();
+    auto bytes = QByteArray::fromRawData(
+        pending.constData() + bomSize, static_cast<qsizetype>(end - bomSize));
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    RowReader reader(buffer, separator, textDelimiter, rowCodec);
+    QList<QString> values;
+    while (reader.readRow(values)) { newRows << values; }
+
+    fingerprint = (fingerprint + pending.first(end)).right(FINGERPRINT_SIZE);
+    pending.remove(0, end);
+    position += end;
+    rows += newRows.size();
+    return true;
+}
+
+// Check if the file was truncated or replaced
+// @input:
+// - file - opened file
+// @output:
+// - bool - True if the file is shorter than read data or bytes before the
+// position were changed
+bool FileFollowerPrivate::isReplaced(QFile& file) const {
+    if (file.size() < position + pending.size()) { return true; }
+
+    if (position == 0) { return false; }
+
+    const auto start = position - fingerprint.size();
+    return !file.seek(start) || file.read(fingerprint.size()) != fingerprint;
+}
+
+// Forget the position in the file
+void FileFollowerPrivate::reset() {
+    position = 0;
+    rows = 0;
+    pending.clear();
+    fingerprint.clear();
+}
+
+FileFollower::FileFollower(QObject* parent) :
+    QObject(parent), d(std::make_unique<FileFollowerPrivate>())
+{
+    d->timer.setInterval(1000);
+    connect(&d->watcher, &QFileSystemWatcher::fileChanged,
+            this, &FileFollower::poll);
+    connect(&d->timer, &QTimer::timeout, this, &FileFollower::poll);
+}
+
+FileFollower::~FileFollower() = default;
+
+// Start to follow the csv-file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading. Byte order mark at
+// the beginning of the file overrides it.
+// - skipExisting - if True, rows that are already in the file are not
+// delivered
+// @output:
+// - bool - True if following was started, False otherwise
+bool FileFollower::start(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    const bool skipExisting)
+{
+    stop();
+
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (!CheckFile(filePath, true)) {
+        qDebug() << __FUNCTION__ << "Error - wrong file path:" << filePath;
+        return false;
+    }
+
+    d->filePath = filePath;
+    d->separator = separator;
+    d->textDelimiter = textDelimiter;
+    d->codec = codec;
+    d->reset();
+
+    if (skipExisting) {
+        QList<QList<QString>> rows;
+        auto isReset = false;
+        if (!d->readRows(rows, isReset)) { return false; }
+
+        d->rows = 0;
+    }
+
+    d->following = true;
+    d->watcher.addPath(filePath);
+    if (0 < d->timer.interval()) { d->timer.start(); }
+
+    // Existing rows are delivered when the event loop starts
+    QTimer::singleShot(0, this, [this]() {
+        if (d->following) { poll(); }
+    });
+
+    return true;
+}
+
+// Stop following the file
+void FileFollower::stop() {
+    d->following = false;
+    d->timer.stop();
+    if (!d->watcher.files().isEmpty()) {
+        d->watcher.removePaths(d->watcher.files());
+    }
+}
+
+// Check if file is being followed
+// @output:
+// - bool - True if file is being followed
+bool FileFollower::isFollowing() const {
+    return d->following;
+}
+
+// Set interval of checks by timer
+// @input:
+// - msecs - interval in milliseconds. 0 disables timer.
+void FileFollower::setPollInterval(const int msecs) {
+    d->timer.setInterval(qMax(0, msecs));
+    if (d->timer.interval() == 0) {
+        d->timer.stop();
+    }
+    else if (d->following) {
+        d->timer.start();
+    }
+}
+
+// Get position of the end of the last delivered row
+// @output:
+// - qint64 - position in bytes
+qint64 FileFollower::position() const {
+    return d->position;
+}
+
+// Get number of delivered rows since start or last reset
+// @output:
+// - qint64 - number of rows
+qint64 FileFollower::rowCount() const {
+    return d->rows;
+}
+
+// Read rows that were appended to the file since the previous check
+// @output:
+// - bool - True if file was read, False otherwise
+bool FileFollower::poll() {
+    if (!d->following) { return false; }
+
+    // Watcher stops watching the file when it is removed or renamed
+    if (!d->watcher.files().contains(d->filePath) &&
+        QFile::exists(d->filePath))
+    {
+        d->watcher.addPath(d->filePath);
+    }
+
+    QList<QList<QString>> rows;
+    auto isReset = false;
+    const auto result = d->readRows(rows, isReset);
+    if (isReset) { emit fileReset(); }
+
+    if (!rows.isEmpty()) { emit rowsAppended(rows); }
+
+    return result;
+}
@@ -0,0 +1,290 @@
+#include "include/qtcsv/filemerger.h"
+#include "sources/filechecker.h"
+#include "sources/filecopy.h"
+#include "sources/rowindexer.h"
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringEncoder>
+
+using namespace QtCSV;
+
+// Format of a csv-file that is merged
+struct MergeFormat {
+    // Codec with explicit byte order
+    QStringConverter::Encoding codec = QStringConverter::Utf8;
+    // Position of the first data row (after byte order mark and header)
+    qint64 dataStart = 0;
+    QList<QString> header;
+    // Line end of the first row
+    QByteArray lineEnd;
+    // True if file ends with a line end
+    bool isTerminated = true;
+};
+
+namespace QtCSV {
+
+class FileMergerPrivate {
+public:
+    // Size of data that is scanned for the end of the first row at once
+    static const qint64 SCAN_SIZE = 64 * 1024;
+
+    QString separator;
+    QString textDelimiter;
+    QStringConverter::Encoding codec = QStringConverter::Utf8;
+    bool hasHeader = false;
+
+    // Format of the output file. It is set by the first non-empty file.
+    MergeFormat output;
+    bool hasOutput = false;
+
+    // Get format of the file
+    MergeFormat format(const char* data, qint64 size) const;
+    // Set format of the existing output file
+    bool setOutput(QFile& file);
+    // Append file to the output file
+    bool append(const QString& filePath, QFileDevice& outputFile);
+    // Add line end if the output file doesn't end with it
+    bool terminate(QFileDevice& outputFile);
+};
+
+}
+
+// Get format of the file
+// @input:
+// - data - memory-mapped data of the file
+// - size - size of the file in bytes. Must be positive.
+// @output:
+// - MergeFormat - format of the file
+MergeFormat FileMergerPrivate::format(
+    const char* data, const qint64 size) const
+{
+    MergeFormat result;
+    qsizetype bomSize = 0;
+    result.codec = RowIndexer::resolveCodec(
+        codec, QByteArrayView(data, qMin<qint64>(size, 4)), bomSize);
+
+    // Only the first row is scanned
+    RowIndexer indexer(
+        data, size, bomSize, result.codec, separator, textDelimiter);
+    QList<qint64> rowEnds;
+    while (rowEnds.isEmpty() && !indexer.atEnd()) {
+        indexer.scan(SCAN_SIZE, rowEnds);
+    }
+
+    const auto firstRowEnd = rowEnds.isEmpty() ? size : rowEnds.first();
+    const auto firstRow = QByteArray::fromRawData(
+        data, static_cast<qsizetype>(firstRowEnd));
+    const auto bytes = QByteArray::fromRawData(
+        data, static_cast<qsizetype>(size));
+    QStringEncoder encoder(result.codec);
+    const QByteArray crlf = encoder.encode(QString("\r\n"));
+    const QByteArray lf = encoder.encode(QString("\n"));
+    result.lineEnd = firstRow.endsWith(crlf) ? crlf : lf;
+    // Lone CR is not a line end for the library, so the next row must not
+    // be appended after it
+    result.isTerminated = bytes.endsWith(lf);
+
+    result.dataStart = bomSize;
+    if (hasHeader) {
+        result.header = RowIndexer::parseRow(
+            data, bomSize, firstRowEnd, separator, textDelimiter,
+            result.codec);
+        result.dataStart = firstRowEnd;
+    }
+
+    return result;
+}
+
+// Set format of the existing output file
+// @input:
+// - file - output file opened for reading and writing
+// @output:
+// - bool - True if format was read, False otherwise
+bool FileMergerPrivate::setOutput(QFile& file) {
+    const auto size = file.size();
+    if (size == 0) { return true; }
+
+    auto* map = file.map(0, size);
+    if (map == nullptr) {
+        qDebug() << __FUNCTION__ << "Error - can't map file:" <<
+            file.fileName();
+        return false;
+    }
+
+    output = format(reinterpret_cast<const char*>(map), size);
+    hasOutput = true;
+    file.unmap(map);
+    return file.seek(size);
+}
+
+// Append file to the output file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - outputFile - output file opened for writing
+// @output:
+// - bool - True if file was appended, False otherwise
+bool FileMergerPrivate::append(
+    const QString& filePath, QFileDevice& outputFile)
+{
+    QFile file(filePath);
+    if (!CheckFile(filePath, true) || !file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    const auto size = file.size();
+    if (size == 0) { return true; }
+
+    auto* map = file.map(0, size);
+    if (map == nullptr) {
+        qDebug() << __FUNCTION__ << "Error - can't map file:" << filePath;
+        return false;
+    }
+
+    const auto* data = reinterpret_cast<const char*>(map);
+    const auto fileFormat = format(data, size);
+
+    // The first file is copied with its byte order mark and header
+    qint64 begin = 0;
+    auto result = true;
+    if (!hasOutput) {
+        output = fileFormat;
+        output.isTerminated = true;
+        hasOutput = true;
+    }
+    else if (fileFormat.codec != output.codec) {
+        qDebug() << __FUNCTION__ << "Error - codec doesn't match:" <<
+            filePath;
+        result = false;
+    }
+    else if (fileFormat.header != output.header) {
+        qDebug() << __FUNCTION__ << "Error - header doesn't match:" <<
+            filePath;
+        result = false;
+    }
+    else {
+        begin = fileFormat.dataStart;
+    }
+
+    if (result && begin < size) {
+        result = terminate(outputFile) &&
+            CopyFileRange(file, data, begin, size, outputFile);
+        output.isTerminated = fileFormat.isTerminated;
+        if (!result) {
+            qDebug() << __FUNCTION__ << "Error - can't write file:" <<
+                outputFile.fileName();
+        }
+    }
+
+    file.unmap(map);
+    return result;
+}
+
+// Add line end if the output file doesn't end with it
+// @input:
+// - outputFile - output file opened for writing
+// @output:
+// - bool - True if output file ends with line end, False otherwise
+bool FileMergerPrivate::terminate(QFileDevice& outputFile) {
+    if (output.isTerminated) { return true; }
+
+    output.isTerminated =
+        outputFile.write(output.lineEnd) == output.lineEnd.size();
+    return output.isTerminated;
+}
+
+// Merge csv-files into one file
+// @input:
+// - filePaths - strings with absolute paths to csv-files
+// - outputFilePath - string with absolute path to the result csv-file. It
+// should not be one of the merged files.
+// - hasHeader - if True, the first rows of files are headers
+// - mode - write mode of the result file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of the files. Byte order mark at the beginning of a
+// file overrides it.
+// @output:
+// - bool - True if files were merged, False otherwise
+bool FileMerger::merge(
+    const QList<QString>& filePaths,
+    const QString& outputFilePath,
+    const bool hasHeader,
+    const Writer::WriteMode mode,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (!CheckFile(outputFilePath)) {
+        qDebug() << __FUNCTION__ << "Error - wrong file path:" <<
+            outputFilePath;
+        return false;
+    }
+
+    const auto outputPath = QFileInfo(outputFilePath).canonicalFilePath();
+    for (const auto& path : filePaths) {
+        if (!outputPath.isEmpty() &&
+            QFileInfo(path).canonicalFilePath() == outputPath)
+        {
+            qDebug() << __FUNCTION__ <<
+                "Error - output file is one of the merged files:" << path;
+            return false;
+        }
+    }
+
+    FileMergerPrivate merger;
+    merger.separator = separator;
+    merger.textDelimiter = textDelimiter;
+    merger.codec = codec;
+    merger.hasHeader = hasHeader;
+
+    switch (mode) {
+        case Writer::WriteMode::REWRITE: {
+            // Existing file is replaced only if all files were merged
+            QSaveFile file(outputFilePath);
+            if (!file.open(QIODevice::WriteOnly)) {
+                qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+                    outputFilePath;
+                return false;
+            }
+
+            for (const auto& path : filePaths) {
+                if (!merger.append(path, file)) { return false; }
+            }
+
+            return merger.terminate(file) && file.commit();
+        }
+        case Writer::WriteMode::APPEND: {
+            // File is opened without append mode, so the kernel could copy
+            // data to it
+            QFile file(outputFilePath);
+            if (!file.open(QIODevice::ReadWrite)) {
+                qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+                    outputFilePath;
+                return false;
+            }
+
+            const auto size = file.size();
+            auto result = merger.setOutput(file);
+            for (const auto& path : filePaths) {
+                result = result && merger.append(path, file);
+            }
+
+            result = result && merger.terminate(file) && file.flush();
+
+            // Appended data is removed on error
+            if (!result) { file.resize(size); }
+
+            return result;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,271 @@
+#include "include/qtcsv/filesplitter.h"
+#include "sources/filecopy.h"
+#include "sources/rowbatches.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+
+using namespace QtCSV;
+
+namespace QtCSV {
+
+class FileSplitterPrivate {
+public:
+    // Size of data that is scanned for row ends at once
+    static const qint64 SCAN_SIZE = 4 * 1024 * 1024;
+
+    QString dirPath;
+    QString baseName;
+    FileSplitter::Split split = FileSplitter::Split::PARTS;
+    qint64 value = 2;
+    bool hasHeader = false;
+    int threadCount = QThread::idealThreadCount();
+    QList<QString> files;
+
+    // Find ends of parts and copy parts to files
+    bool splitFile(
+        const QString& filePath,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec);
+    // Get path to the part file
+    QString partPath(qsizetype number) const;
+    // Write part file: prefix and then range of the source file
+    static bool writePart(
+        const QString& path,
+        QFile& source,
+        const char* data,
+        qint64 prefixSize,
+        qint64 begin,
+        qint64 end);
+};
+
+}
+
+// Find ends of parts and copy parts to files
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of the file
+// @output:
+// - bool - True if file was split, False otherwise
+bool FileSplitterPrivate::splitFile(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    MappedCsvFile csvFile(filePath);
+    if (!csvFile.open(codec, separator, textDelimiter, SCAN_SIZE)) {
+        return false;
+    }
+
+    const auto size = csvFile.size();
+    if (size == 0) { return true; }
+
+    auto& file = csvFile.file();
+    const auto* data = csvFile.data();
+    // Get end of the next row or -1 at the end of data
+    auto nextRowEnd = [&csvFile]() -> qint64 {
+        qint64 begin = 0, end = 0;
+        return csvFile.nextRow(begin, end) ? end : -1;
+    };
+
+    // Byte order mark and header are the prefix of each part
+    qint64 dataStart = csvFile.bomSize();
+    if (hasHeader) {
+        dataStart = nextRowEnd();
+        if (dataStart < 0) { return true; }
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threadCount));
+    std::atomic<bool> failed(false);
+    auto addPart = [this, &pool, &failed, &file, data, dataStart](
+        const qint64 begin, const qint64 end)
+    {
+        const auto path = partPath(files.size() + 1);
+        files << path;
+        pool.start([path, &failed, &file, data, dataStart, begin, end]() {
+            if (!failed && !writePart(path, file, data, dataStart, begin,
+                                      end))
+            {
+                failed = true;
+            }
+        });
+    };
+
+    qint64 partStart = dataStart;
+    qint64 previousEnd = dataStart;
+    qint64 partRows = 0;
+    for (auto end = nextRowEnd(); 0 <= end && !failed; end = nextRowEnd()) {
+        ++partRows;
+        switch (split) {
+            case FileSplitter::Split::PARTS: {
+                // Part ends at the first row end after its share of the
+                // rest of data. The last part takes all remaining rows.
+                const auto parts = value - files.size();
+                if (1 < parts &&
+                    partStart + (size - partStart) / parts <= end)
+                {
+                    addPart(partStart, end);
+                    partStart = end;
+                }
+
+                break;
+            }
+            case FileSplitter::Split::BYTES:
+                // Current row starts the next part if it doesn't fit
+                if (value < dataStart + end - partStart &&
+                    partStart < previousEnd)
+                {
+                    addPart(partStart, previousEnd);
+                    partStart = previousEnd;
+                }
+
+                break;
+            case FileSplitter::Split::ROWS:
+                if (value <= partRows) {
+                    addPart(partStart, end);
+                    partStart = end;
+                    partRows = 0;
+                }
+
+                break;
+        }
+
+        previousEnd = end;
+    }
+
+    if (!failed && partStart < previousEnd) {
+        addPart(partStart, previousEnd);
+    }
+
+    pool.waitForDone();
+    return !failed;
+}
+
+// Get path to the part file
+// @input:
+// - number - number of the part starting from 1
+// @output:
+// - QString - absolute path to the file
+QString FileSplitterPrivate::partPath(const qsizetype number) const {
+    return QDir(dirPath).absoluteFilePath(
+        baseName + "_" + QString::number(number).rightJustified(
+            5, QChar('0')) + ".csv");
+}
+
+// Write part file: prefix and then range of the source file
+// @input:
+// - path - path to the part file
+// - source - opened source file
+// - data - memory-mapped data of the source file
+// - prefixSize - size of byte order mark and header at the beginning of
+// the source file
+// - begin - position of the first row of the part
+// - end - position of the end of the last row of the part
+// @output:
+// - bool - True if part was written, False otherwise
+bool FileSplitterPrivate::writePart(
+    const QString& path,
+    QFile& source,
+    const char* data,
+    const qint64 prefixSize,
+    const qint64 begin,
+    const qint64 end)
+{
+    QFile part(path);
+    if (!part.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << path;
+        return false;
+    }
+
+    if (part.write(data, prefixSize) != prefixSize ||
+        !CopyFileRange(source, data, begin, end, part))
+    {
+        qDebug() << __FUNCTION__ << "Error - can't write file:" << path;
+        return false;
+    }
+
+    return true;
+}
+
+FileSplitter::FileSplitter(const QString& dirPath, const QString& baseName) :
+    d(std::make_unique<FileSplitterPrivate>())
+{
+    d->dirPath = dirPath;
+    d->baseName = baseName;
+}
+
+FileSplitter::~FileSplitter() = default;
+
+// Set how the file is split
+// @input:
+// - split - type of the split
+// - value - number of parts, bytes or rows. Must be positive.
+void FileSplitter::setSplit(const Split split, const qint64 value) {
+    d->split = split;
+    d->value = qMax<qint64>(1, value);
+}
+
+// Set if the first row of the file is a header
+void FileSplitter::setHasHeader(const bool hasHeader) {
+    d->hasHeader = hasHeader;
+}
+
+// Set number of threads that copy parts
+// @input:
+// - count - number of threads. Must be positive.
+void FileSplitter::setThreadCount(const int count) {
+    d->threadCount = qMax(1, count);
+}
+
+// Split the csv-file into parts
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of the file. Byte order mark at the beginning of the
+// file overrides it.
+// @output:
+// - bool - True if file was split, False otherwise. On error created parts
+// are removed.
+bool FileSplitter::split(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    d->files.clear();
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (!QDir(d->dirPath).exists()) {
+        qDebug() << __FUNCTION__ << "Error - directory doesn't exist:" <<
+            d->dirPath;
+        return false;
+    }
+
+    if (!d->splitFile(filePath, separator, textDelimiter, codec)) {
+        for (const auto& path : d->files) { QFile::remove(path); }
+
+        d->files.clear();
+        return false;
+    }
+
+    return true;
+}
+
+// Get paths of parts created by the last split
+// @output:
+// - QList<QString> - absolute paths of part files in order
+QList<QString> FileSplitter::files() const {
+    return d->files;
+}
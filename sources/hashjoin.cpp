@@ -0,0 +1,814 @@
+#include "include/qtcsv/hashjoin.h"
+#include "include/qtcsv/writer.h"
+#include "sources/filechecker.h"
+#include "sources/rowbatches.h"
+#include "sources/rowreader.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QTemporaryDir>
+#include <QThread>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace QtCSV;
+
+// JoinTable is a hash table of the right rows. Values of all rows are
+// stored in one string, so the table doesn't need an allocation per value.
+class JoinTable {
+    // First and last rows with the key
+    struct KeyRows {
+        qsizetype first = 0;
+        qsizetype last = 0;
+    };
+
+    QHash<QString, KeyRows> m_keys;
+    // Index of the next row with the same key or -1
+    std::vector<qsizetype> m_nextRows;
+    // Index of the first value of each row in m_valueEnds
+    std::vector<qsizetype> m_rowStarts;
+    // Position of the end of each value in m_text
+    std::vector<qsizetype> m_valueEnds;
+    QString m_text;
+    qint64 m_keysMemory = 0;
+
+public:
+    // Add row with the key
+    void add(const QString& key, const QList<QString>& values);
+    // Get values of the row
+    QList<QString> rowValues(qsizetype row) const;
+    // Get approximate size of the table in memory
+    qint64 memory() const;
+    // Remove all rows
+    void clear();
+
+    // Call function for each row with the key in order of adding
+    template <typename Function>
+    void forEachRow(const QString& key, Function function) const {
+        const auto it = m_keys.constFind(key);
+        if (it == m_keys.cend()) { return; }
+
+        for (auto row = it->first; 0 <= row;
+             row = m_nextRows[static_cast<size_t>(row)])
+        {
+            function(row);
+        }
+    }
+
+    // Call function for each key and row
+    template <typename Function>
+    void forEachKeyRow(Function function) const {
+        for (auto it = m_keys.cbegin(); it != m_keys.cend(); ++it) {
+            forEachRow(it.key(), [&](const qsizetype row) {
+                function(it.key(), row);
+            });
+        }
+    }
+};
+
+// Add row with the key
+// @input:
+// - key - key of the row
+// - values - values of the row without key values
+void JoinTable::add(const QString& key, const QList<QString>& values) {
+    const auto row = static_cast<qsizetype>(m_rowStarts.size());
+    m_rowStarts.push_back(static_cast<qsizetype>(m_valueEnds.size()));
+    m_nextRows.push_back(-1);
+    for (const auto& value : values) {
+        m_text += value;
+        m_valueEnds.push_back(m_text.size());
+    }
+
+    auto it = m_keys.find(key);
+    if (it == m_keys.end()) {
+        // Size of the hash node and of the key
+        m_keysMemory += 64 + key.size() * sizeof(QChar);
+        m_keys.insert(key, KeyRows{row, row});
+        return;
+    }
+
+    m_nextRows[static_cast<size_t>(it->last)] = row;
+    it->last = row;
+}
+
+// Get values of the row
+// @input:
+// - row - valid index of the row
+// @output:
+// - QList<QString> - values of the row without key values
+QList<QString> JoinTable::rowValues(const qsizetype row) const {
+    const auto index = static_cast<size_t>(row);
+    const auto first = m_rowStarts[index];
+    const auto last = index + 1 < m_rowStarts.size() ?
+        m_rowStarts[index + 1] : static_cast<qsizetype>(m_valueEnds.size());
+
+    QList<QString> values;
+    values.reserve(last - first);
+    auto start = first == 0 ?
+        0 : m_valueEnds[static_cast<size_t>(first - 1)];
+    for (auto i = first; i < last; ++i) {
+        const auto end = m_valueEnds[static_cast<size_t>(i)];
+        values << m_text.mid(start, end - start);
+        start = end;
+    }
+
+    return values;
+}
+
+// Get approximate size of the table in memory
+// @output:
+// - qint64 - size in bytes
+qint64 JoinTable::memory() const {
+    return m_keysMemory +
+        static_cast<qint64>(m_text.capacity() * sizeof(QChar)) +
+        static_cast<qint64>(sizeof(qsizetype) * (m_nextRows.capacity() +
+            m_rowStarts.capacity() + m_valueEnds.capacity()));
+}
+
+// Remove all rows
+void JoinTable::clear() {
+    m_keys.clear();
+    m_nextRows = std::vector<qsizetype>();
+    m_rowStarts = std::vector<qsizetype>();
+    m_valueEnds = std::vector<qsizetype>();
+    m_text = QString();
+    m_keysMemory = 0;
+}
+
+// JoinBatch is a batch of left rows that is processed by a thread
+struct JoinBatch {
+    // Csv-data of the rows. If it is not set, rows and keys are already
+    // filled.
+    const char* data = nullptr;
+    qint64 size = 0;
+    QList<QString> keys;
+    QList<QList<QString>> rows;
+    // Joined rows
+    QList<QList<QString>> output;
+
+    // Remove rows of the batch
+    void clear() {
+        data = nullptr;
+        size = 0;
+        keys.clear();
+        rows.clear();
+        output.clear();
+    }
+};
+
+// JoinPartitions writes rows with keys to the files of partitions
+class JoinPartitions {
+    std::vector<std::unique_ptr<QFile>> m_files;
+    std::vector<std::unique_ptr<QDataStream>> m_streams;
+    size_t m_seed = 0;
+
+public:
+    // Create files of partitions
+    bool open(const QString& pathPrefix, qsizetype count, size_t seed);
+    // Write row to the partition of its key
+    void write(const QString& key, const QList<QString>& values) {
+        const auto index = qHash(key, m_seed) % m_streams.size();
+        *m_streams[index] << key << values;
+    }
+
+    // Flush and close files
+    bool close();
+    // Get number of partitions
+    qsizetype count() const { return static_cast<qsizetype>(m_files.size()); }
+    // Get path to the file of the partition
+    QString filePath(qsizetype index) const {
+        return m_files[static_cast<size_t>(index)]->fileName();
+    }
+};
+
+// Create files of partitions
+// @input:
+// - pathPrefix - path to the files without the number of partition
+// - count - number of partitions
+// - seed - seed of the hash of keys
+// @output:
+// - bool - True if files were created, False otherwise
+bool JoinPartitions::open(
+    const QString& pathPrefix, const qsizetype count, const size_t seed)
+{
+    m_seed = seed;
+    for (qsizetype i = 0; i < count; ++i) {
+        m_files.push_back(std::make_unique<QFile>(pathPrefix +
+                                                  QString::number(i)));
+        if (!m_files.back()->open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+                m_files.back()->fileName();
+            return false;
+        }
+
+        m_streams.push_back(
+            std::make_unique<QDataStream>(m_files.back().get()));
+    }
+
+    return true;
+}
+
+// Flush and close files
+// @output:
+// - bool - True if all rows were written, False otherwise
+bool JoinPartitions::close() {
+    auto result = true;
+    for (size_t i = 0; i < m_files.size(); ++i) {
+        if (m_streams[i]->status() != QDataStream::Ok ||
+            !m_files[i]->flush())
+        {
+            qDebug() << __FUNCTION__ << "Error - failed to write file:" <<
+                m_files[i]->fileName();
+            result = false;
+        }
+
+        m_files[i]->close();
+    }
+
+    return result;
+}
+
+// JoinRecordReader reads rows with keys from the file of a partition
+class JoinRecordReader {
+    QFile m_file;
+    QDataStream m_stream;
+    bool m_failed = false;
+
+public:
+    explicit JoinRecordReader(const QString& filePath) : m_file(filePath) {}
+
+    bool open() {
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+                m_file.fileName();
+            return false;
+        }
+
+        m_stream.setDevice(&m_file);
+        return true;
+    }
+
+    // Read next row. Returns False at the end of file or in case of error.
+    bool read(QString& key, QList<QString>& values) {
+        if (m_failed || m_stream.atEnd()) { return false; }
+
+        m_stream >> key >> values;
+        if (m_stream.status() != QDataStream::Ok) {
+            qDebug() << __FUNCTION__ << "Error - failed to read file:" <<
+                m_file.fileName();
+            m_failed = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool failed() const { return m_failed; }
+};
+
+namespace QtCSV {
+
+class HashJoinPrivate {
+public:
+    // Functions that return the next right row and the next batch of left
+    // rows. They return False if there are no more rows.
+    using RightSource = std::function<bool(QString&, QList<QString>&)>;
+    using LeftSource = std::function<bool(JoinBatch&)>;
+    // Function that receives joined rows
+    using EmitFunction = std::function<bool(const QList<QList<QString>>&)>;
+
+    // Partitions that don't fit into memory are split again with another
+    // hash seed. Partitions of the last level are loaded as is, because
+    // they could consist of rows with the same key.
+    static const int MAX_LEVEL = 3;
+
+    HashJoin::Type type = HashJoin::Type::INNER;
+    QList<qsizetype> leftColumns = {0};
+    QList<qsizetype> rightColumns = {0};
+    qint64 memoryLimit = 256 * 1024 * 1024;
+    QString tempDir;
+    qsizetype partitionCount = 16;
+    int threadCount = QThread::idealThreadCount();
+    qint64 batchSize = 1024 * 1024;
+    bool hasHeader = false;
+
+    // Join csv-files and pass joined rows to the function
+    bool join(
+        const QString& leftFilePath,
+        const QString& rightFilePath,
+        const EmitFunction& emitRows,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec) const;
+
+    // Get key of the row
+    static QString rowKey(
+        const QList<QString>& values, const QList<qsizetype>& columns);
+};
+
+}
+
+// JoinRun holds the state of one join
+class JoinRun {
+    const HashJoinPrivate& m_join;
+    const QString& m_separator;
+    const QString& m_textDelimiter;
+    // Codec of the left file with explicit byte order
+    const QStringConverter::Encoding m_codec;
+    const HashJoinPrivate::EmitFunction& m_emit;
+    std::unique_ptr<QTemporaryDir> m_dir;
+    qsizetype m_partitionSets = 0;
+
+public:
+    // Max number of values of the right rows without keys
+    qsizetype rightWidth = 0;
+
+    JoinRun(
+        const HashJoinPrivate& join,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec,
+        const HashJoinPrivate::EmitFunction& emitRows) :
+        m_join(join), m_separator(separator), m_textDelimiter(textDelimiter),
+        m_codec(codec), m_emit(emitRows) {}
+
+    // Join rows of the sources
+    bool join(
+        const HashJoinPrivate::RightSource& right,
+        const HashJoinPrivate::LeftSource& left,
+        int level);
+
+private:
+    // Create files of partitions
+    std::unique_ptr<JoinPartitions> createPartitions(
+        const QString& name, int level);
+    // Process batches of left rows by threads and pass processed batches
+    // to the function in order of rows
+    bool processBatches(
+        const HashJoinPrivate::LeftSource& left,
+        const JoinTable* table,
+        const std::function<bool(JoinBatch&)>& consume) const;
+    // Parse rows of the batch and join them with the right rows
+    void processBatch(JoinBatch& batch, const JoinTable* table) const;
+};
+
+// Join rows of the sources
+// @input:
+// - right - source of the right rows
+// - left - source of the batches of left rows
+// - level - level of partitioning of the rows
+// @output:
+// - bool - True if rows were joined, False otherwise
+bool JoinRun::join(
+    const HashJoinPrivate::RightSource& right,
+    const HashJoinPrivate::LeftSource& left,
+    const int level)
+{
+    JoinTable table;
+    std::unique_ptr<JoinPartitions> rightPartitions;
+    QString key;
+    QList<QString> values;
+    while (right(key, values)) {
+        if (rightPartitions) {
+            rightPartitions->write(key, values);
+            continue;
+        }
+
+        table.add(key, values);
+        if (level < HashJoinPrivate::MAX_LEVEL &&
+            m_join.memoryLimit < table.memory())
+        {
+            rightPartitions = createPartitions("right", level);
+            if (!rightPartitions) { return false; }
+
+            table.forEachKeyRow([&](const QString& rowKey, qsizetype row) {
+                rightPartitions->write(rowKey, table.rowValues(row));
+            });
+
+            table.clear();
+        }
+    }
+
+    if (!rightPartitions) {
+        return processBatches(left, &table, [this](JoinBatch& batch) {
+            return batch.output.isEmpty() || m_emit(batch.output);
+        });
+    }
+
+    auto leftPartitions = createPartitions("left", level);
+    if (!leftPartitions) { return false; }
+
+    const auto isSplit = processBatches(
+        left, nullptr, [&leftPartitions](JoinBatch& batch) {
+            for (qsizetype i = 0; i < batch.rows.size(); ++i) {
+                leftPartitions->write(batch.keys.at(i), batch.rows.at(i));
+            }
+
+            return true;
+        });
+
+    if (!rightPartitions->close() || !leftPartitions->close() || !isSplit) {
+        return false;
+    }
+
+    for (qsizetype i = 0; i < rightPartitions->count(); ++i) {
+        const auto rightPath = rightPartitions->filePath(i);
+        const auto leftPath = leftPartitions->filePath(i);
+        auto isJoined = false;
+        {
+            JoinRecordReader rightReader(rightPath), leftReader(leftPath);
+            const auto batchSize = m_join.batchSize;
+            isJoined = rightReader.open() && leftReader.open() && join(
+                [&rightReader](QString& rowKey, QList<QString>& rowValues) {
+                    return rightReader.read(rowKey, rowValues);
+                },
+                [&leftReader, batchSize](JoinBatch& batch) {
+                    QString rowKey;
+                    QList<QString> rowValues;
+                    qint64 size = 0;
+                    while (size < batchSize &&
+                           leftReader.read(rowKey, rowValues))
+                    {
+                        size += rowKey.size() * sizeof(QChar);
+                        for (const auto& value : rowValues) {
+                            size += value.size() * sizeof(QChar);
+                        }
+
+                        batch.keys << rowKey;
+                        batch.rows << rowValues;
+                    }
+
+                    return !batch.rows.isEmpty();
+                },
+                level + 1);
+            isJoined = isJoined && !rightReader.failed() &&
+                !leftReader.failed();
+        }
+
+        QFile::remove(rightPath);
+        QFile::remove(leftPath);
+        if (!isJoined) { return false; }
+    }
+
+    return true;
+}
+
+// Create files of partitions
+// @input:
+// - name - name of the side of the join
+// - level - level of partitioning of the rows
+// @output:
+// - std::unique_ptr<JoinPartitions> - partitions or nullptr in case of error
+std::unique_ptr<JoinPartitions> JoinRun::createPartitions(
+    const QString& name, const int level)
+{
+    if (!m_dir) {
+        const auto& dirPath = m_join.tempDir;
+        m_dir = std::make_unique<QTemporaryDir>(
+            QDir(dirPath.isEmpty() ? QDir::tempPath() : dirPath)
+                .filePath("qtcsv-join-XXXXXX"));
+        if (!m_dir->isValid()) {
+            qDebug() << __FUNCTION__ <<
+                "Error - can't create temporary directory in" << dirPath;
+            return nullptr;
+        }
+    }
+
+    auto partitions = std::make_unique<JoinPartitions>();
+    const auto prefix = m_dir->filePath(
+        QString("%1_%2_").arg(name).arg(m_partitionSets++));
+    if (!partitions->open(prefix, m_join.partitionCount,
+                          static_cast<size_t>(level)))
+    {
+        return nullptr;
+    }
+
+    return partitions;
+}
+
+// Process batches of left rows by threads and pass processed batches to the
+// function in order of rows
+// @input:
+// - left - source of the batches of left rows
+// - table - hash table of the right rows. If it is not set, rows of
+// batches are only parsed.
+// - consume - function that receives processed batches
+// @output:
+// - bool - True if all batches were processed, False otherwise
+bool JoinRun::processBatches(
+    const HashJoinPrivate::LeftSource& left,
+    const JoinTable* table,
+    const std::function<bool(JoinBatch&)>& consume) const
+{
+    return ProcessBatchesInOrder<JoinBatch>(
+        m_join.threadCount,
+        left,
+        [this, table](JoinBatch& batch) { processBatch(batch, table); },
+        consume);
+}
+
+// Parse rows of the batch and join them with the right rows. This function
+// is called from threads of the pool.
+// @input:
+// - batch - batch of left rows
+// - table - hash table of the right rows. If it is not set, rows are only
+// parsed.
+void JoinRun::processBatch(JoinBatch& batch, const JoinTable* table) const {
+    if (batch.data != nullptr) {
+        auto bytes = QByteArray::fromRawData(
+            batch.data, static_cast<qsizetype>(batch.size));
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::ReadOnly);
+
+        RowReader reader(buffer, m_separator, m_textDelimiter, m_codec);
+        QList<QString> values;
+        while (reader.readRow(values)) {
+            batch.keys << HashJoinPrivate::rowKey(values, m_join.leftColumns);
+            batch.rows << values;
+        }
+    }
+
+    if (table == nullptr) { return; }
+
+    const auto isLeftJoin = m_join.type == HashJoin::Type::LEFT;
+    for (qsizetype i = 0; i < batch.rows.size(); ++i) {
+        const auto& values = batch.rows.at(i);
+        auto isMatched = false;
+        table->forEachRow(batch.keys.at(i), [&](const qsizetype row) {
+            batch.output << values + table->rowValues(row);
+            isMatched = true;
+        });
+
+        if (!isMatched && isLeftJoin) {
+            batch.output << values + QList<QString>(rightWidth);
+        }
+    }
+
+    batch.keys.clear();
+    batch.rows.clear();
+}
+
+// Join csv-files and pass joined rows to the function
+// @input:
+// - leftFilePath - string with absolute path to the left csv-file
+// - rightFilePath - string with absolute path to the right csv-file
+// - emitRows - function that receives joined rows
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if files were joined, False otherwise
+bool HashJoinPrivate::join(
+    const QString& leftFilePath,
+    const QString& rightFilePath,
+    const EmitFunction& emitRows,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    auto isNegative = [](const qsizetype column) { return column < 0; };
+    if (leftColumns.isEmpty() || leftColumns.size() != rightColumns.size() ||
+        std::any_of(leftColumns.cbegin(), leftColumns.cend(), isNegative) ||
+        std::any_of(rightColumns.cbegin(), rightColumns.cend(), isNegative))
+    {
+        qDebug() << __FUNCTION__ << "Error - invalid key columns";
+        return false;
+    }
+
+    QFile rightFile(rightFilePath);
+    if (!CheckFile(rightFilePath, true) ||
+        !rightFile.open(QIODevice::ReadOnly))
+    {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+            rightFilePath;
+        return false;
+    }
+
+    MappedCsvFile leftFile(leftFilePath);
+    if (!leftFile.open(codec, separator, textDelimiter, batchSize)) {
+        return false;
+    }
+
+    // Values of the right row without key values
+    auto rightValues = [this](const QList<QString>& values) {
+        QList<QString> result;
+        for (qsizetype i = 0; i < values.size(); ++i) {
+            if (!rightColumns.contains(i)) { result << values.at(i); }
+        }
+
+        return result;
+    };
+
+    JoinRun run(*this, separator, textDelimiter, leftFile.codec(), emitRows);
+    RowReader rightReader(rightFile, separator, textDelimiter, codec);
+    if (hasHeader) {
+        QList<QString> leftHeader, rightHeader;
+        qint64 headerBegin = 0, headerEnd = 0;
+        if (leftFile.nextRow(headerBegin, headerEnd)) {
+            leftHeader = leftFile.parseRow(headerBegin, headerEnd);
+        }
+
+        rightReader.readRow(rightHeader);
+        const auto header = leftHeader + rightValues(rightHeader);
+        run.rightWidth = header.size() - leftHeader.size();
+        if (!emitRows({header})) { return false; }
+    }
+
+    return run.join(
+        [&](QString& key, QList<QString>& values) {
+            if (!rightReader.readRow(values)) { return false; }
+
+            key = rowKey(values, rightColumns);
+            values = rightValues(values);
+            run.rightWidth = qMax(run.rightWidth, values.size());
+            return true;
+        },
+        [&leftFile](JoinBatch& batch) {
+            qint64 begin = 0, end = 0;
+            if (!leftFile.nextBatch(begin, end)) { return false; }
+
+            batch.data = leftFile.data() + begin;
+            batch.size = end - begin;
+            return true;
+        },
+        0);
+}
+
+// Get key of the row
+// @input:
+// - values - values of the row
+// - columns - key columns
+// @output:
+// - QString - value of the key column. Values of several key columns are
+// joined together with their sizes, so different keys never match.
+QString HashJoinPrivate::rowKey(
+    const QList<QString>& values, const QList<qsizetype>& columns)
+{
+    if (columns.size() == 1) { return values.value(columns.first()); }
+
+    QString key;
+    for (const auto column : columns) {
+        const auto value = values.value(column);
+        const auto size = static_cast<quint32>(value.size());
+        key += QChar(static_cast<char16_t>(size >> 16));
+        key += QChar(static_cast<char16_t>(size & 0xFFFF));
+        key += value;
+    }
+
+    return key;
+}
+
+HashJoin::HashJoin() : d(std::make_unique<HashJoinPrivate>()) {}
+
+HashJoin::~HashJoin() = default;
+
+// Set type of the join
+void HashJoin::setType(const Type type) {
+    d->type = type;
+}
+
+// Set key columns of the left and the right files
+// @input:
+// - leftColumns - numbers of key columns of the left file
+// - rightColumns - numbers of key columns of the right file in the same
+// order. Missing values of rows are treated as empty strings.
+void HashJoin::setKeys(
+    const QList<qsizetype>& leftColumns,
+    const QList<qsizetype>& rightColumns)
+{
+    d->leftColumns = leftColumns;
+    d->rightColumns = rightColumns;
+}
+
+// Set approximate amount of memory for the hash table of the right rows
+// @input:
+// - bytes - memory limit in bytes
+void HashJoin::setMemoryLimit(const qint64 bytes) {
+    d->memoryLimit = qMax<qint64>(1, bytes);
+}
+
+// Set directory for temporary files
+// @input:
+// - dirPath - path to existing directory. Empty string means system
+// temporary directory.
+void HashJoin::setTempDir(const QString& dirPath) {
+    d->tempDir = dirPath;
+}
+
+// Set number of partitions of the data that doesn't fit into memory
+// @input:
+// - count - number of partitions. Must be 2 or more.
+void HashJoin::setPartitionCount(const qsizetype count) {
+    d->partitionCount = qMax<qsizetype>(2, count);
+}
+
+// Set number of threads
+// @input:
+// - count - number of threads. Must be positive.
+void HashJoin::setThreadCount(const int count) {
+    d->threadCount = qMax(1, count);
+}
+
+// Set approximate size of a batch of left rows
+// @input:
+// - bytes - size of the batch in bytes. Must be positive.
+void HashJoin::setBatchSize(const qint64 bytes) {
+    d->batchSize = qMax<qint64>(1, bytes);
+}
+
+// Set if the first rows of the files are headers
+void HashJoin::setHasHeader(const bool hasHeader) {
+    d->hasHeader = hasHeader;
+}
+
+// Join csv-files and write result to another csv-file
+// @input:
+// - leftFilePath - string with absolute path to the left csv-file
+// - rightFilePath - string with absolute path to the right csv-file
+// - outputFilePath - string with absolute path to the result csv-file. If
+// file exists, it will be overwritten.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading and writing
+// @output:
+// - bool - True if files were joined, False otherwise
+bool HashJoin::join(
+    const QString& leftFilePath,
+    const QString& rightFilePath,
+    const QString& outputFilePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    QFile file(outputFilePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate |
+                   QIODevice::Text))
+    {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" <<
+            outputFilePath;
+        return false;
+    }
+
+    const auto result = d->join(
+        leftFilePath, rightFilePath,
+        [&](const QList<QList<QString>>& rows) {
+            qsizetype index = 0;
+            FunctionRowSource source([&rows, &index](QList<QString>& row) {
+                if (rows.size() <= index) { return false; }
+
+                row = rows.at(index++);
+                return true;
+            });
+
+            return Writer::write(
+                file, source, separator, textDelimiter, {}, {}, codec);
+        },
+        separator, textDelimiter, codec);
+
+    file.close();
+    if (!result) { file.remove(); }
+
+    return result;
+}
+
+// Join csv-files and pass joined rows to the processor
+// @input:
+// - leftFilePath - string with absolute path to the left csv-file
+// - rightFilePath - string with absolute path to the right csv-file
+// - processor - processor of joined rows. If it returns False, join will
+// be stopped.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if files were joined, False otherwise
+bool HashJoin::join(
+    const QString& leftFilePath,
+    const QString& rightFilePath,
+    Reader::AbstractProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    return d->join(
+        leftFilePath, rightFilePath,
+        [&processor](const QList<QList<QString>>& rows) {
+            for (const auto& row : rows) {
+                if (!processor.processRowElements(row)) { return false; }
+            }
+
+            return true;
+        },
+        separator, textDelimiter, codec);
+}
@@ -0,0 +1,203 @@
+#include "include/qtcsv/indexeddata.h"
+#include "sources/filechecker.h"
+#include "sources/rowindexer.h"
+#include <QCache>
+#include <QDebug>
+#include <QFile>
+
+using namespace QtCSV;
+
+namespace QtCSV {
+
+class IndexedDataPrivate {
+public:
+    QFile file;
+    uchar* map = nullptr;
+    QString separator;
+    QString textDelimiter;
+    // Codec with explicit byte order
+    QStringConverter::Encoding codec = QStringConverter::Utf8;
+    // Positions of rows in the file. The last position is the end of the
+    // last row.
+    QList<qint64> offsets;
+    QCache<qsizetype, QList<QString>> cache{256};
+    // Rows that were added to the container
+    QList<QList<QString>> rows;
+
+    // Get number of rows of the file
+    qsizetype fileRows() const {
+        return offsets.isEmpty() ? 0 : offsets.size() - 1;
+    }
+
+    // Map the file and find positions of its rows
+    bool open(const QString& filePath);
+    // Parse row of the file
+    QList<QString> parseRow(qsizetype row) const;
+    // Unmap and close the file
+    void close();
+};
+
+}
+
+// Map the file and find positions of its rows
+// @input:
+// - filePath - string with absolute path to csv-file
+// @output:
+// - bool - True if file was opened, False otherwise
+bool IndexedDataPrivate::open(const QString& filePath) {
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    const auto size = file.size();
+    if (size == 0) { return true; }
+
+    map = file.map(0, size);
+    if (map == nullptr) {
+        qDebug() << __FUNCTION__ << "Error - can't map file:" << filePath;
+        close();
+        return false;
+    }
+
+    const auto* data = reinterpret_cast<const char*>(map);
+    qsizetype bomSize = 0;
+    codec = RowIndexer::resolveCodec(
+        codec, QByteArrayView(data, qMin<qint64>(size, 4)), bomSize);
+
+    RowIndexer indexer(data, size, bomSize, codec, separator, textDelimiter);
+    offsets << bomSize;
+    indexer.scan(size, offsets);
+    return true;
+}
+
+// Parse row of the file
+// @input:
+// - row - valid number of the row of the file
+// @output:
+// - QList<QString> - values of the row
+QList<QString> IndexedDataPrivate::parseRow(const qsizetype row) const {
+    return RowIndexer::parseRow(
+        reinterpret_cast<const char*>(map), offsets.at(row),
+        offsets.at(row + 1), separator, textDelimiter, codec);
+}
+
+// Unmap and close the file
+void IndexedDataPrivate::close() {
+    if (map != nullptr) { file.unmap(map); }
+    if (file.isOpen()) { file.close(); }
+
+    map = nullptr;
+    offsets.clear();
+    cache.clear();
+}
+
+IndexedData::IndexedData() : d(std::make_unique<IndexedDataPrivate>()) {}
+
+IndexedData::~IndexedData() {
+    d->close();
+}
+
+// Open csv-file and build index of its rows
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading. Byte order mark at
+// the beginning of the file overrides it.
+// @output:
+// - bool - True if file was opened, False otherwise
+bool IndexedData::open(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    clear();
+
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (!CheckFile(filePath, true)) {
+        qDebug() << __FUNCTION__ << "Error - wrong file path:" << filePath;
+        return false;
+    }
+
+    d->separator = separator;
+    d->textDelimiter = textDelimiter;
+    d->codec = codec;
+    return d->open(filePath);
+}
+
+// Check if csv-file is open
+// @output:
+// - bool - True if csv-file is open
+bool IndexedData::isOpen() const {
+    return d->file.isOpen();
+}
+
+// Set max number of parsed rows that are cached
+// @input:
+// - rows - number of rows. Zero disables cache.
+void IndexedData::setCacheSize(const qsizetype rows) {
+    d->cache.setMaxCost(qMax<qsizetype>(0, rows));
+}
+
+// Add new empty row
+void IndexedData::addEmptyRow() {
+    d->rows << QList<QString>();
+}
+
+// Add new row with specified values (as strings)
+// @input:
+// - values - list of strings. If list is empty, it will be interpreted
+// as empty line
+void IndexedData::addRow(const QList<QString>& values) {
+    d->rows << values;
+}
+
+// Clear all data and close the csv-file
+void IndexedData::clear() {
+    d->close();
+    d->rows.clear();
+}
+
+// Check if there are any rows
+// @output:
+// - bool - True if there are any rows, else False
+bool IndexedData::isEmpty() const {
+    return rowCount() == 0;
+}
+
+// Get number of rows
+// @output:
+// - qsizetype - number of rows of the file and added rows
+qsizetype IndexedData::rowCount() const {
+    return d->fileRows() + d->rows.size();
+}
+
+// Get values of specified row as list of strings. Row of the file is
+// parsed on the first request and is kept in cache.
+// @input:
+// - row - valid number of the row
+// @output:
+// - QList<QString> - values of the row. If row is invalid number, function
+// will return empty QList<QString>.
+QList<QString> IndexedData::rowValues(const qsizetype row) const {
+    if (row < 0 || rowCount() <= row) { return QList<QString>(); }
+
+    const auto fileRows = d->fileRows();
+    if (fileRows <= row) { return d->rows.at(row - fileRows); }
+
+    if (const auto* values = d->cache.object(row)) { return *values; }
+
+    auto values = d->parseRow(row);
+    if (0 < d->cache.maxCost()) {
+        d->cache.insert(row, new QList<QString>(values));
+    }
+
+    return values;
+}
@@ -0,0 +1,90 @@
+#ifndef QTCSVINSTRUMENTEDDEVICE_H
+#define QTCSVINSTRUMENTEDDEVICE_H
+
+#include <QElapsedTimer>
+#include <QIODevice>
+
+namespace QtCSV {
+
+    // StageTimer adds time of its life to the counter. If pointer to the
+    // counter is null, it does nothing.
+    class StageTimer {
+        qint64* m_nsecs;
+        QElapsedTimer m_timer;
+
+    public:
+        explicit StageTimer(qint64* nsecs) : m_nsecs(nsecs) {
+            if (m_nsecs != nullptr) { m_timer.start(); }
+        }
+
+        ~StageTimer() {
+            if (m_nsecs != nullptr) { *m_nsecs += m_timer.nsecsElapsed(); }
+        }
+
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+    };
+
+    // InstrumentedDevice is an IO Device that passes all reads and writes to
+    // another IO Device, counts bytes and measures time of these operations.
+    // It is used to separate time of I/O from time of decoding and encoding
+    // that are done by QTextStream. If another device is not sequential,
+    // positions of InstrumentedDevice start from the position of another
+    // device at the moment of creation.
+    class InstrumentedDevice : public QIODevice {
+        QIODevice& m_device;
+        qint64& m_bytes;
+        qint64* m_nsecs;
+        const qint64 m_start;
+        bool m_counting = true;
+
+    public:
+        // Device should be open. Time is not measured if nsecs is null.
+        InstrumentedDevice(QIODevice& device, qint64& bytes, qint64* nsecs) :
+            m_device(device), m_bytes(bytes), m_nsecs(nsecs),
+            m_start(device.isSequential() ? 0 : device.pos())
+        {
+            // Text mode translation and buffering are done by the device
+            open((device.openMode() & QIODevice::ReadWrite) |
+                 QIODevice::Unbuffered);
+        }
+
+        // Enable or disable counting of bytes and time of operations
+        void setCounting(bool counting) { m_counting = counting; }
+
+        bool isSequential() const override {
+            return m_device.isSequential();
+        }
+
+        bool seek(qint64 pos) override {
+            return QIODevice::seek(pos) && m_device.seek(m_start + pos);
+        }
+
+        qint64 bytesAvailable() const override {
+            return m_device.bytesAvailable() + QIODevice::bytesAvailable();
+        }
+
+        bool waitForReadyRead(int msecs) override {
+            return m_device.waitForReadyRead(msecs);
+        }
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize) override {
+            StageTimer timer(m_counting ? m_nsecs : nullptr);
+            const auto result = m_device.read(data, maxSize);
+            if (0 < result && m_counting) { m_bytes += result; }
+
+            return result;
+        }
+
+        qint64 writeData(const char* data, qint64 maxSize) override {
+            StageTimer timer(m_counting ? m_nsecs : nullptr);
+            const auto result = m_device.write(data, maxSize);
+            if (0 < result && m_counting) { m_bytes += result; }
+
+            return result;
+        }
+    };
+}
+
+#endif // QTCSVINSTRUMENTEDDEVICE_H
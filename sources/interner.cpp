@@ -0,0 +1,82 @@
+#include "include/qtcsv/interner.h"
+
+using namespace QtCSV;
+
+// Constructor of Interner
+// @input:
+// - maxCardinality - maximum number of distinct values of a column
+Interner::Interner(const qsizetype maxCardinality) :
+    m_maxCardinality(maxCardinality)
+{}
+
+// Replace values of the row with shared instances
+// @input:
+// - values - values of the row. Index of value is index of its column.
+void Interner::intern(QList<QString>& values) {
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        values[i] = intern(i, values.at(i));
+    }
+}
+
+// Get shared instance of the value of the column
+// @input:
+// - column - index of the column
+// - value - value of the column
+// @output:
+// - QString - equal value that shares data with other equal values of the
+// column. If column is not interned anymore, value is returned as it is.
+QString Interner::intern(const qsizetype column, const QString& value) {
+    if (column < 0) { return value; }
+
+    if (m_columns.size() <= column) { m_columns.resize(column + 1); }
+
+    auto& info = m_columns[column];
+    if (!info.isInterned) { return value; }
+
+    const auto it = info.values.constFind(value);
+    if (it != info.values.constEnd()) { return *it; }
+
+    // Column has too many distinct values to benefit from interning
+    if (m_maxCardinality <= info.values.size()) {
+        info.isInterned = false;
+        info.values = QSet<QString>();
+        return value;
+    }
+
+    info.values.insert(value);
+    return value;
+}
+
+// Check if values of the column are interned
+// @input:
+// - column - index of the column
+// @output:
+// - bool - True if column has not exceeded the limit of distinct values
+bool Interner::isInterned(const qsizetype column) const {
+    if (column < 0) { return false; }
+
+    return m_columns.size() <= column || m_columns.at(column).isInterned;
+}
+
+// Get number of distinct values of the column in the table
+// @input:
+// - column - index of the column
+// @output:
+// - qsizetype - number of distinct values. 0 if column is not interned.
+qsizetype Interner::cardinality(const qsizetype column) const {
+    if (column < 0 || m_columns.size() <= column) { return 0; }
+
+    return m_columns.at(column).values.size();
+}
+
+// Get maximum number of distinct values of a column
+// @output:
+// - qsizetype - maximum number of distinct values
+qsizetype Interner::maxCardinality() const {
+    return m_maxCardinality;
+}
+
+// Free tables of all columns and enable interning of them
+void Interner::clear() {
+    m_columns.clear();
+}
@@ -0,0 +1,475 @@
+#include "include/qtcsv/jsonconverter.h"
+#include "sources/rowbatches.h"
+#include "sources/rowreader.h"
+#include <QBuffer>
+#include <QDebug>
+#include <QThread>
+#include <functional>
+#include <memory>
+
+using namespace QtCSV;
+
+// JsonBatch is a batch of rows that is converted to JSON by a thread
+struct JsonBatch {
+    // Csv-data of the rows. If it is not set, rows are already parsed.
+    const char* data = nullptr;
+    qint64 size = 0;
+    QList<QList<QString>> rows;
+    // JSON of the rows. Batches are reused, so the buffer keeps its memory.
+    QByteArray output;
+
+    // Remove rows and JSON of the batch
+    void clear() {
+        data = nullptr;
+        size = 0;
+        rows.clear();
+        output.resize(0);
+    }
+};
+
+namespace QtCSV {
+
+class JsonConverterPrivate {
+public:
+    // Function that fills the next batch. It returns False if there are no
+    // more rows.
+    using BatchSource = std::function<bool(JsonBatch&)>;
+
+    JsonConverter::Format format = JsonConverter::Format::NDJSON;
+    bool inferTypes = false;
+    QList<QString> keys;
+    int threadCount = QThread::idealThreadCount();
+    qint64 batchSize = 1024 * 1024;
+
+    // Convert batches of rows and write JSON to IO Device in order of rows
+    bool convert(
+        const BatchSource& source,
+        const QList<QString>& header,
+        QIODevice& output,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec) const;
+    // Parse rows of the batch and convert them to JSON
+    void convertBatch(
+        JsonBatch& batch,
+        const QList<QByteArray>& encodedKeys,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec) const;
+    // Append row as JSON object to the buffer
+    void appendObject(
+        const QList<QString>& values,
+        const QList<QByteArray>& encodedKeys,
+        QByteArray& buffer) const;
+    // Append value to the buffer as JSON number, boolean, null or string
+    void appendValue(const QString& value, QByteArray& buffer) const;
+
+    // Append string to the buffer as JSON string
+    static void appendString(const QString& value, QByteArray& buffer);
+    // Check if string is a number in JSON notation
+    static bool isNumber(QStringView value);
+};
+
+}
+
+// Convert batches of rows and write JSON to IO Device in order of rows.
+// Each batch is converted by a thread of the pool.
+// @input:
+// - source - function that fills the next batch
+// - header - keys of objects
+// - output - IO Device for JSON
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of unparsed csv-data of batches
+// @output:
+// - bool - True if all rows were written, False otherwise
+bool JsonConverterPrivate::convert(
+    const BatchSource& source,
+    const QList<QString>& header,
+    QIODevice& output,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    // Keys are escaped only once
+    QList<QByteArray> encodedKeys;
+    for (const auto& key : header) {
+        QByteArray encodedKey;
+        appendString(key, encodedKey);
+        encodedKey += ':';
+        encodedKeys << encodedKey;
+    }
+
+    const auto isArray = format == JsonConverter::Format::ARRAY;
+    auto isFirst = true;
+    auto write = [&output](const char* data, const qint64 size) {
+        if (output.write(data, size) == size) { return true; }
+
+        qDebug() << __FUNCTION__ << "Error - can't write to IO Device";
+        return false;
+    };
+
+    auto isOk = (!isArray || write("[", 1)) &&
+        ProcessBatchesInOrder<JsonBatch>(
+            threadCount,
+            source,
+            [&](JsonBatch& batch) {
+                convertBatch(
+                    batch, encodedKeys, separator, textDelimiter, codec);
+            },
+            [&](JsonBatch& batch) {
+                // Objects of array are preceded by a comma, the first one
+                // is not
+                const auto skip = isArray && isFirst ? 1 : 0;
+                const auto size = batch.output.size() - skip;
+                if (size <= 0) { return true; }
+
+                isFirst = false;
+                return write(batch.output.constData() + skip, size);
+            });
+
+    if (isOk && isArray) {
+        isOk = isFirst ? write("]\n", 2) : write("\n]\n", 3);
+    }
+
+    return isOk;
+}
+
+// Parse rows of the batch and convert them to JSON. This function is called
+// from threads of the pool.
+// @input:
+// - batch - batch of rows
+// - encodedKeys - escaped keys of objects with colons
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of unparsed csv-data of the batch
+void JsonConverterPrivate::convertBatch(
+    JsonBatch& batch,
+    const QList<QByteArray>& encodedKeys,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    const auto isArray = format == JsonConverter::Format::ARRAY;
+    auto appendRow = [&](const QList<QString>& values) {
+        if (isArray) { batch.output += ",\n"; }
+
+        appendObject(values, encodedKeys, batch.output);
+        if (!isArray) { batch.output += '\n'; }
+    };
+
+    if (batch.data == nullptr) {
+        for (const auto& values : batch.rows) {
+            appendRow(values);
+        }
+
+        return;
+    }
+
+    batch.output.reserve(static_cast<qsizetype>(2 * batch.size));
+    auto bytes = QByteArray::fromRawData(
+        batch.data, static_cast<qsizetype>(batch.size));
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    RowReader reader(buffer, separator, textDelimiter, codec);
+    QList<QString> values;
+    while (reader.readRow(values)) {
+        appendRow(values);
+    }
+}
+
+// Append row as JSON object to the buffer
+// @input:
+// - values - values of the row
+// - encodedKeys - escaped keys of objects with colons. Missing values are
+// written as null, values without a key get the number of their column as
+// a key.
+// - buffer - buffer for JSON
+void JsonConverterPrivate::appendObject(
+    const QList<QString>& values,
+    const QList<QByteArray>& encodedKeys,
+    QByteArray& buffer) const
+{
+    buffer += '{';
+    const auto count = qMax(values.size(), encodedKeys.size());
+    for (qsizetype i = 0; i < count; ++i) {
+        if (0 < i) { buffer += ','; }
+
+        if (i < encodedKeys.size()) {
+            buffer += encodedKeys.at(i);
+        }
+        else {
+            buffer += '"';
+            buffer += QByteArray::number(static_cast<qint64>(i));
+            buffer += "\":";
+        }
+
+        if (i < values.size()) {
+            appendValue(values.at(i), buffer);
+        }
+        else {
+            buffer += "null";
+        }
+    }
+
+    buffer += '}';
+}
+
+// Append value to the buffer. If type inference is on, numbers, booleans
+// and empty values are written as JSON numbers, booleans and null.
+// @input:
+// - value - value of the row
+// - buffer - buffer for JSON
+void JsonConverterPrivate::appendValue(
+    const QString& value, QByteArray& buffer) const
+{
+    if (!inferTypes) {
+        appendString(value, buffer);
+    }
+    else if (value.isEmpty()) {
+        buffer += "null";
+    }
+    else if (value == QLatin1String("true") ||
+             value == QLatin1String("false"))
+    {
+        buffer += value.toLatin1();
+    }
+    else if (isNumber(value)) {
+        // Number is written as is, so it doesn't lose precision
+        buffer += value.toLatin1();
+    }
+    else {
+        appendString(value, buffer);
+    }
+}
+
+// Append string to the buffer as JSON string
+// @input:
+// - value - string
+// - buffer - buffer for JSON (UTF-8)
+void JsonConverterPrivate::appendString(
+    const QString& value, QByteArray& buffer)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    // Bytes of multi-byte UTF-8 symbols never need escaping, so the string
+    // is escaped after encoding. Runs of bytes without escaping are copied
+    // at once.
+    const auto utf8 = value.toUtf8();
+    const auto* data = utf8.constData();
+    const auto size = utf8.size();
+    buffer += '"';
+    qsizetype runStart = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        const auto symbol = static_cast<unsigned char>(data[i]);
+        if (0x20 <= symbol && symbol != '"' && symbol != '\\') { continue; }
+
+        buffer.append(data + runStart, i - runStart);
+        runStart = i + 1;
+        switch (symbol) {
+            case '"': buffer += "\\\""; break;
+            case '\\': buffer += "\\\\"; break;
+            case '\b': buffer += "\\b"; break;
+            case '\f': buffer += "\\f"; break;
+            case '\n': buffer += "\\n"; break;
+            case '\r': buffer += "\\r"; break;
+            case '\t': buffer += "\\t"; break;
+            default:
+                buffer += "\\u00";
+                buffer += HEX_DIGITS[symbol >> 4];
+                buffer += HEX_DIGITS[symbol & 0xF];
+                break;
+        }
+    }
+
+    buffer.append(data + runStart, size - runStart);
+    buffer += '"';
+}
+
+// Check if string is a number in JSON notation
+// @input:
+// - value - string
+// @output:
+// - bool - True if value is like "-12", "0.5" or "1e+10". Values like
+// "007", "+1", ".5" or "NaN" are not JSON numbers.
+bool JsonConverterPrivate::isNumber(const QStringView value) {
+    const auto size = value.size();
+    qsizetype pos = 0;
+    auto isDigit = [&value](const qsizetype index) {
+        const auto symbol = value.at(index).unicode();
+        return '0' <= symbol && symbol <= '9';
+    };
+
+    auto skipDigits = [&]() {
+        const auto start = pos;
+        while (pos < size && isDigit(pos)) { ++pos; }
+        return start < pos;
+    };
+
+    if (pos < size && value.at(pos) == '-') { ++pos; }
+
+    if (size <= pos || !isDigit(pos)) { return false; }
+
+    // Leading zeros are not allowed
+    if (value.at(pos) == '0') { ++pos; }
+    else { skipDigits(); }
+
+    if (pos < size && value.at(pos) == '.') {
+        ++pos;
+        if (!skipDigits()) { return false; }
+    }
+
+    if (pos < size && (value.at(pos) == 'e' || value.at(pos) == 'E')) {
+        ++pos;
+        if (pos < size && (value.at(pos) == '+' || value.at(pos) == '-')) {
+            ++pos;
+        }
+
+        if (!skipDigits()) { return false; }
+    }
+
+    return pos == size;
+}
+
+JsonConverter::JsonConverter() : d(std::make_unique<JsonConverterPrivate>())
+{}
+
+JsonConverter::~JsonConverter() = default;
+
+// Set format of JSON output
+void JsonConverter::setFormat(const Format format) {
+    d->format = format;
+}
+
+// Set if numbers, booleans and empty values are written as JSON numbers,
+// booleans and null
+void JsonConverter::setTypeInference(const bool infer) {
+    d->inferTypes = infer;
+}
+
+// Set keys of objects
+// @input:
+// - keys - keys of objects. Empty list means that keys are taken from the
+// first row of data.
+void JsonConverter::setKeys(const QList<QString>& keys) {
+    d->keys = keys;
+}
+
+// Set number of threads
+// @input:
+// - count - number of threads. Must be positive.
+void JsonConverter::setThreadCount(const int count) {
+    d->threadCount = qMax(1, count);
+}
+
+// Set approximate size of a batch of rows
+// @input:
+// - bytes - size of the batch in bytes. Must be positive.
+void JsonConverter::setBatchSize(const qint64 bytes) {
+    d->batchSize = qMax<qint64>(1, bytes);
+}
+
+// Convert csv-file to JSON and write it to IO Device
+// @input:
+// - filePath - string with absolute path to csv-file
+// - output - IO Device for JSON. If it is not open, it will be opened for
+// writing.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of the file. Byte order mark at the beginning of the
+// file overrides it.
+// @output:
+// - bool - True if file was converted, False otherwise
+bool JsonConverter::convert(
+    const QString& filePath,
+    QIODevice& output,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    MappedCsvFile file(filePath);
+    if (!file.open(codec, separator, textDelimiter, d->batchSize)) {
+        return false;
+    }
+
+    if (!output.isOpen() && !output.open(QIODevice::WriteOnly)) {
+        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
+        return false;
+    }
+
+    qint64 headerBegin = 0, headerEnd = 0;
+    auto header = d->keys;
+    if (header.isEmpty() && file.nextRow(headerBegin, headerEnd)) {
+        header = file.parseRow(headerBegin, headerEnd);
+    }
+
+    return d->convert(
+        [&file](JsonBatch& batch) {
+            qint64 begin = 0, end = 0;
+            if (!file.nextBatch(begin, end)) { return false; }
+
+            batch.data = file.data() + begin;
+            batch.size = end - begin;
+            return true;
+        },
+        header, output, separator, textDelimiter, file.codec());
+}
+
+// Convert csv-data of IO Device to JSON and write it to another IO Device
+// @input:
+// - input - IO Device with csv-data. If it is not open, it will be opened
+// for reading.
+// - output - IO Device for JSON. If it is not open, it will be opened for
+// writing.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of csv-data
+// @output:
+// - bool - True if data was converted, False otherwise
+bool JsonConverter::convert(
+    QIODevice& input,
+    QIODevice& output,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if ((!input.isOpen() && !input.open(QIODevice::ReadOnly)) ||
+        (!output.isOpen() && !output.open(QIODevice::WriteOnly)))
+    {
+        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
+        return false;
+    }
+
+    RowReader reader(input, separator, textDelimiter, codec);
+    QList<QString> values;
+    auto header = d->keys;
+    if (header.isEmpty() && reader.readRow(values)) { header = values; }
+
+    const auto batchSize = d->batchSize;
+    return d->convert(
+        [&reader, &values, batchSize](JsonBatch& batch) {
+            qint64 size = 0;
+            while (size < batchSize && reader.readRow(values)) {
+                size += values.size();
+                for (const auto& value : values) {
+                    size += value.size() * sizeof(QChar);
+                }
+
+                batch.rows << values;
+            }
+
+            return !batch.rows.isEmpty();
+        },
+        header, output, separator, textDelimiter, codec);
+}
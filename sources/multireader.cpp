@@ -0,0 +1,511 @@
+#include "include/qtcsv/multireader.h"
+#include "sources/filechecker.h"
+#include "sources/rowreader.h"
+#include <QBuffer>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+#include <functional>
+
+using namespace QtCSV;
+
+// Source of csv-data: file or IO Device
+struct MultiReaderSource {
+    QString filePath;
+    QIODevice* device = nullptr;
+};
+
+namespace QtCSV {
+
+class MultiReaderPrivate {
+public:
+    // Number of rows that are parsed before they are passed to the
+    // processor
+    static const qsizetype ROWS_PER_BATCH = 256;
+    // Max size of the header of IO Device
+    static const qint64 HEADER_SAMPLE_SIZE = 64 * 1024;
+
+    // Function that passes rows of the source to the processor. It returns
+    // False if processor stopped reading.
+    using Deliver = std::function<bool(
+        qsizetype source, const QList<QList<QString>>& rows, qint64& passed)>;
+
+    int threadCount = QThread::idealThreadCount();
+    MultiReader::Header headerMode = MultiReader::Header::NONE;
+    QList<QString> expectedHeader;
+    QList<QString> header;
+
+    // Read sources concurrently
+    bool read(
+        const QList<MultiReaderSource>& sources,
+        const Deliver& deliver,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec,
+        QList<MultiReader::FileResult>* results);
+    // Read rows of one source
+    void readSource(
+        const MultiReaderSource& source,
+        qsizetype index,
+        const Deliver& deliver,
+        std::atomic<bool>& stop,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec,
+        MultiReader::FileResult& result) const;
+    // Find header of the first source that has it
+    static QList<QString> findHeader(
+        const QList<MultiReaderSource>& sources,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec);
+    // Open source for reading
+    static QIODevice* open(
+        const MultiReaderSource& source, QFile& file, QString& error);
+};
+
+}
+
+// Read sources concurrently
+// @input:
+// - sources - files or IO Devices
+// - deliver - function that passes rows to the processor
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - results - optional list for results of sources
+// @output:
+// - bool - True if all sources were read, False otherwise
+bool MultiReaderPrivate::read(
+    const QList<MultiReaderSource>& sources,
+    const Deliver& deliver,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    QList<MultiReader::FileResult>* results)
+{
+    if (results != nullptr) { results->clear(); }
+
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    header = expectedHeader;
+    if (headerMode != MultiReader::Header::NONE && header.isEmpty()) {
+        header = findHeader(sources, separator, textDelimiter, codec);
+    }
+
+    QList<MultiReader::FileResult> fileResults(sources.size());
+    std::atomic<bool> stop(false);
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threadCount));
+    for (qsizetype i = 0; i < sources.size(); ++i) {
+        auto* result = &fileResults[i];
+        result->filePath = sources.at(i).filePath;
+
+        const auto* source = &sources.at(i);
+        pool.start([this, source, i, &deliver, &stop, &separator,
+                    &textDelimiter, codec, result]() {
+            readSource(*source, i, deliver, stop, separator, textDelimiter,
+                       codec, *result);
+        });
+    }
+
+    pool.waitForDone();
+
+    auto isRead = !stop;
+    for (const auto& result : fileResults) {
+        isRead = isRead && result.isRead;
+    }
+
+    if (results != nullptr) { *results = fileResults; }
+
+    return isRead;
+}
+
+// Read rows of one source and pass them to the processor
+// @input:
+// - source - file or IO Device
+// - index - index of the source in the list of sources
+// - deliver - function that passes rows to the processor
+// - stop - flag that is set when processor stops reading
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - result - result of the source
+void MultiReaderPrivate::readSource(
+    const MultiReaderSource& source,
+    const qsizetype index,
+    const Deliver& deliver,
+    std::atomic<bool>& stop,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    MultiReader::FileResult& result) const
+{
+    if (stop) {
+        result.error = "reading was stopped";
+        return;
+    }
+
+    QFile file;
+    auto* device = open(source, file, result.error);
+    if (device == nullptr) {
+        qDebug() << __FUNCTION__ << "Error -" << result.error <<
+            source.filePath;
+        return;
+    }
+
+    RowReader reader(*device, separator, textDelimiter, codec);
+    QList<QString> row;
+    if (headerMode != MultiReader::Header::NONE) {
+        // Empty source has no rows and no header
+        if (!reader.readRow(row)) {
+            result.isRead = true;
+            return;
+        }
+
+        if (headerMode == MultiReader::Header::VERIFY && row != header) {
+            result.error = "header doesn't match the expected header";
+            qDebug() << __FUNCTION__ << "Error -" << result.error <<
+                source.filePath;
+            return;
+        }
+    }
+
+    QList<QList<QString>> rows;
+    rows.reserve(ROWS_PER_BATCH);
+    auto hasRows = true;
+    while (hasRows) {
+        hasRows = reader.readRow(row);
+        if (hasRows) {
+            rows << row;
+            if (rows.size() < ROWS_PER_BATCH) { continue; }
+        }
+
+        if (rows.isEmpty()) { break; }
+
+        if (stop || !deliver(index, rows, result.rows)) {
+            stop = true;
+            result.error = "reading was stopped";
+            return;
+        }
+
+        rows.clear();
+    }
+
+    result.isRead = true;
+}
+
+// Find header of the first source that has it. Files are read from the
+// beginning, IO Devices are peeked, so their data is not consumed.
+// @input:
+// - sources - files or IO Devices
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - QList<QString> - values of the header or empty list
+QList<QString> MultiReaderPrivate::findHeader(
+    const QList<MultiReaderSource>& sources,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    QList<QString> row;
+    for (const auto& source : sources) {
+        QFile file;
+        QString error;
+        auto* device = open(source, file, error);
+        if (device == nullptr) { continue; }
+
+        QByteArray sample;
+        QBuffer buffer(&sample);
+        if (device != &file) {
+            sample = device->peek(HEADER_SAMPLE_SIZE);
+            buffer.open(QIODevice::ReadOnly);
+            device = &buffer;
+        }
+
+        RowReader reader(*device, separator, textDelimiter, codec);
+        if (reader.readRow(row)) { return row; }
+    }
+
+    return {};
+}
+
+// Open source for reading
+// @input:
+// - source - file or IO Device
+// - file - file object for the file source
+// - error - description of the error
+// @output:
+// - QIODevice* - opened IO Device or nullptr if it could not be opened
+QIODevice* MultiReaderPrivate::open(
+    const MultiReaderSource& source, QFile& file, QString& error)
+{
+    if (source.device != nullptr) {
+        if (!source.device->isOpen() &&
+            !source.device->open(QIODevice::ReadOnly))
+        {
+            error = "can't open IO Device";
+            return nullptr;
+        }
+
+        return source.device;
+    }
+
+    if (source.filePath.isEmpty()) {
+        error = "IO Device is null";
+        return nullptr;
+    }
+
+    if (!CheckFile(source.filePath, true)) {
+        error = "wrong file path";
+        return nullptr;
+    }
+
+    file.setFileName(source.filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = "can't open file";
+        return nullptr;
+    }
+
+    return &file;
+}
+
+// Processor that is not thread-safe and its lock
+struct MultiReaderSerialized {
+    Reader::AbstractProcessor& processor;
+    QMutex mutex;
+    // Processor stopped reading. Rows of other threads are not passed to
+    // it after that.
+    bool isStopped = false;
+
+    explicit MultiReaderSerialized(Reader::AbstractProcessor& p) :
+        processor(p)
+    {}
+};
+
+// Get function that passes rows to the processor under the lock
+// @input:
+// - serialized - processor that is not thread-safe and its lock
+// @output:
+// - Deliver - function that passes rows to the processor
+MultiReaderPrivate::Deliver SerializedDeliver(
+    MultiReaderSerialized& serialized)
+{
+    return [&serialized](const qsizetype /*source*/,
+                         const QList<QList<QString>>& rows,
+                         qint64& passed)
+    {
+        QMutexLocker locker(&serialized.mutex);
+        for (const auto& row : rows) {
+            if (serialized.isStopped) { return false; }
+
+            ++passed;
+            serialized.isStopped =
+                !serialized.processor.processRowElements(row);
+        }
+
+        return !serialized.isStopped;
+    };
+}
+
+// Get function that passes rows to the thread-safe processor
+// @input:
+// - processor - thread-safe processor
+// @output:
+// - Deliver - function that passes rows to the processor
+MultiReaderPrivate::Deliver ConcurrentDeliver(
+    MultiReader::ConcurrentProcessor& processor)
+{
+    return [&processor](const qsizetype source,
+                        const QList<QList<QString>>& rows,
+                        qint64& passed)
+    {
+        for (const auto& row : rows) {
+            ++passed;
+            if (!processor.processRowElements(source, row)) { return false; }
+        }
+
+        return true;
+    };
+}
+
+// Create list of sources from list of file paths
+QList<MultiReaderSource> FileSources(const QList<QString>& filePaths) {
+    QList<MultiReaderSource> sources;
+    sources.reserve(filePaths.size());
+    for (const auto& path : filePaths) {
+        sources << MultiReaderSource{path, nullptr};
+    }
+
+    return sources;
+}
+
+// Create list of sources from list of IO Devices
+QList<MultiReaderSource> DeviceSources(const QList<QIODevice*>& devices) {
+    QList<MultiReaderSource> sources;
+    sources.reserve(devices.size());
+    for (auto* device : devices) {
+        sources << MultiReaderSource{QString(), device};
+    }
+
+    return sources;
+}
+
+MultiReader::MultiReader() : d(std::make_unique<MultiReaderPrivate>()) {}
+
+MultiReader::~MultiReader() = default;
+
+// Set number of threads and max number of simultaneously open files
+// @input:
+// - count - number of threads. Must be positive.
+void MultiReader::setThreadCount(const int count) {
+    d->threadCount = qMax(1, count);
+}
+
+// Set header of files
+void MultiReader::setHeader(const Header header) {
+    d->headerMode = header;
+}
+
+// Set header that files should have in Header::VERIFY mode
+// @input:
+// - header - values of the header. Empty list means header of the first
+// file.
+void MultiReader::setExpectedHeader(const QList<QString>& header) {
+    d->expectedHeader = header;
+}
+
+// Get header of files of the last reading
+// @output:
+// - QList<QString> - values of the header. Empty if files have no header.
+QList<QString> MultiReader::header() const {
+    return d->header;
+}
+
+// Get sorted list of files in the directory which names match the pattern
+// @input:
+// - dirPath - path to the directory
+// - pattern - wildcard pattern of file names, for example "*.csv"
+// @output:
+// - QList<QString> - absolute paths of files sorted by name
+QList<QString> MultiReader::findFiles(
+    const QString& dirPath, const QString& pattern)
+{
+    const QDir dir(dirPath);
+    if (!dir.exists()) {
+        qDebug() << __FUNCTION__ << "Error - directory doesn't exist:" <<
+            dirPath;
+        return {};
+    }
+
+    QList<QString> paths;
+    const auto names = dir.entryList({pattern}, QDir::Files, QDir::Name);
+    for (const auto& name : names) {
+        paths << dir.absoluteFilePath(name);
+    }
+
+    return paths;
+}
+
+// Read csv-files and pass their rows to the processor one by one
+// @input:
+// - filePaths - strings with absolute paths to csv-files
+// - processor - AbstractProcessor-based object. It is called by one thread
+// at a time.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - results - optional list for results of files in the order of paths
+// @output:
+// - bool - True if all files were read, False otherwise
+bool MultiReader::readToProcessor(
+    const QList<QString>& filePaths,
+    Reader::AbstractProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    QList<FileResult>* results)
+{
+    MultiReaderSerialized serialized(processor);
+    return d->read(FileSources(filePaths), SerializedDeliver(serialized),
+                   separator, textDelimiter, codec, results);
+}
+
+// Read csv-files and pass their rows to the processor concurrently
+// @input:
+// - filePaths - strings with absolute paths to csv-files
+// - processor - thread-safe processor
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - results - optional list for results of files in the order of paths
+// @output:
+// - bool - True if all files were read, False otherwise
+bool MultiReader::readToProcessor(
+    const QList<QString>& filePaths,
+    ConcurrentProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    QList<FileResult>* results)
+{
+    return d->read(FileSources(filePaths), ConcurrentDeliver(processor),
+                   separator, textDelimiter, codec, results);
+}
+
+// Read IO Devices and pass their rows to the processor one by one
+// @input:
+// - devices - IO Devices with csv-formatted data. Each device is read by
+// one thread.
+// - processor - AbstractProcessor-based object. It is called by one thread
+// at a time.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - results - optional list for results of devices in the order of devices
+// @output:
+// - bool - True if all devices were read, False otherwise
+bool MultiReader::readToProcessor(
+    const QList<QIODevice*>& devices,
+    Reader::AbstractProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    QList<FileResult>* results)
+{
+    MultiReaderSerialized serialized(processor);
+    return d->read(DeviceSources(devices), SerializedDeliver(serialized),
+                   separator, textDelimiter, codec, results);
+}
+
+// Read IO Devices and pass their rows to the processor concurrently
+// @input:
+// - devices - IO Devices with csv-formatted data. Each device is read by
+// one thread.
+// - processor - thread-safe processor
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// - results - optional list for results of devices in the order of devices
+// @output:
+// - bool - True if all devices were read, False otherwise
+bool MultiReader::readToProcessor(
+    const QList<QIODevice*>& devices,
+    ConcurrentProcessor& processor,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    QList<FileResult>* results)
+{
+    return d->read(DeviceSources(devices), ConcurrentDeliver(processor),
+                   separator, textDelimiter, codec, results);
+}
@@ -0,0 +1,312 @@
+#include "include/qtcsv/numberconverter.h"
+#include <QMetaType>
+#include <charconv>
+#include <limits>
+#include <system_error>
+
+using namespace QtCSV;
+
+class NumberConverterPrivate {
+public:
+    // Size of the buffer for string representation of a number. It is enough
+    // for any integer and for the shortest representation of any double.
+    static const qsizetype BUFFER_SIZE = 128;
+
+    // Copy string with a number to the buffer of Latin-1 symbols
+    static qsizetype toLatin1(
+        QStringView str,
+        char* buffer,
+        QChar decimalSeparator);
+
+    // Check if string contains only digits and optional sign
+    static bool isInteger(QStringView str);
+
+    // Convert Latin-1 symbols of the number to string
+    static QString fromLatin1(
+        const char* buffer,
+        qsizetype length,
+        QChar decimalSeparator);
+};
+
+// Copy string with a number to the buffer of Latin-1 symbols
+// @input:
+// - str - string with a number
+// - buffer - buffer of BUFFER_SIZE symbols
+// - decimalSeparator - symbol that separates integral and fractional parts.
+// It will be replaced with '.' symbol.
+// @output:
+// - qsizetype - number of symbols copied to the buffer or -1 if string
+// could not contain a number
+qsizetype NumberConverterPrivate::toLatin1(
+    QStringView str,
+    char* buffer,
+    const QChar decimalSeparator)
+{
+    str = str.trimmed();
+
+    // std::from_chars() does not accept plus sign
+    if (!str.isEmpty() && str.front() == QChar('+')) { str = str.mid(1); }
+    if (str.isEmpty() || BUFFER_SIZE <= str.size()) { return -1; }
+
+    for (qsizetype i = 0; i < str.size(); ++i) {
+        const auto symbol = str.at(i);
+        if (symbol == decimalSeparator) {
+            buffer[i] = '.';
+        }
+        else if (symbol.unicode() < 128 && symbol != QChar('.')) {
+            buffer[i] = symbol.toLatin1();
+        }
+        else {
+            return -1;
+        }
+    }
+
+    return str.size();
+}
+
+// Check if string contains only digits and optional sign
+// @input:
+// - str - string with a number
+// @output:
+// - bool - True if string looks like an integer, False otherwise
+bool NumberConverterPrivate::isInteger(QStringView str) {
+    str = str.trimmed();
+    if (!str.isEmpty() &&
+        (str.front() == QChar('+') || str.front() == QChar('-')))
+    {
+        str = str.mid(1);
+    }
+
+    if (str.isEmpty()) { return false; }
+
+    for (const auto& symbol : str) {
+        if (symbol < QChar('0') || QChar('9') < symbol) { return false; }
+    }
+
+    return true;
+}
+
+// Convert Latin-1 symbols of the number to string
+// @input:
+// - buffer - buffer with the number
+// - length - number of symbols in the buffer
+// - decimalSeparator - symbol that will be used instead of '.' symbol
+// @output:
+// - QString - string with the number
+QString NumberConverterPrivate::fromLatin1(
+    const char* buffer,
+    const qsizetype length,
+    const QChar decimalSeparator)
+{
+    auto result = QString::fromLatin1(buffer, length);
+    if (decimalSeparator != QChar('.')) {
+        result.replace(QChar('.'), decimalSeparator);
+    }
+
+    return result;
+}
+
+// Convert integer to string
+// @input:
+// - value - integer value
+// @output:
+// - QString - string with the value
+QString NumberConverter::toString(const qint64 value) {
+    char buffer[NumberConverterPrivate::BUFFER_SIZE];
+    const auto result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return QString::fromLatin1(buffer, result.ptr - buffer);
+}
+
+QString NumberConverter::toString(const quint64 value) {
+    char buffer[NumberConverterPrivate::BUFFER_SIZE];
+    const auto result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return QString::fromLatin1(buffer, result.ptr - buffer);
+}
+
+// Convert floating point number to string
+// @input:
+// - value - floating point value
+// - format - settings of conversion
+// @output:
+// - QString - string with the value
+QString NumberConverter::toString(
+    const double value, const NumberFormat& format)
+{
+    char buffer[NumberConverterPrivate::BUFFER_SIZE];
+    const auto result = format.precision < 0 ?
+        std::to_chars(buffer, buffer + sizeof(buffer), value) :
+        std::to_chars(buffer, buffer + sizeof(buffer), value,
+                      std::chars_format::fixed, format.precision);
+    if (result.ec != std::errc()) {
+        // Very big number with fixed precision does not fit into the buffer
+        auto str = QString::number(value, 'f', format.precision);
+        if (format.decimalSeparator != QChar('.')) {
+            str.replace(QChar('.'), format.decimalSeparator);
+        }
+
+        return str;
+    }
+
+    return NumberConverterPrivate::fromLatin1(
+        buffer, result.ptr - buffer, format.decimalSeparator);
+}
+
+// Convert numeric QVariant (integer or floating point number) to string
+// @input:
+// - value - QVariant with a value
+// - result - string for the result of conversion
+// - format - settings of conversion of floating point numbers
+// @output:
+// - bool - True if value holds a number and it was converted to string,
+// False otherwise
+bool NumberConverter::toString(
+    const QVariant& value, QString& result, const NumberFormat& format)
+{
+    switch (value.typeId()) {
+    case QMetaType::Short:
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+        result = toString(static_cast<qint64>(value.toLongLong()));
+        return true;
+    case QMetaType::UShort:
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+        result = toString(static_cast<quint64>(value.toULongLong()));
+        return true;
+    case QMetaType::Float:
+        if (format.precision < 0) {
+            // Use the shortest representation of float, not of double
+            char buffer[NumberConverterPrivate::BUFFER_SIZE];
+            const auto conv = std::to_chars(
+                buffer, buffer + sizeof(buffer), value.toFloat());
+            result = NumberConverterPrivate::fromLatin1(
+                buffer, conv.ptr - buffer, format.decimalSeparator);
+            return true;
+        }
+
+        result = toString(value.toDouble(), format);
+        return true;
+    case QMetaType::Double:
+        result = toString(value.toDouble(), format);
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+// Convert string to integer
+// @input:
+// - str - string with an integer
+// - ok - pointer to the flag that will be set to True if conversion was
+// successful
+// @output:
+// - qint64 - value of the integer or 0 in case of error
+qint64 NumberConverter::toLongLong(QStringView str, bool* ok) {
+    char buffer[NumberConverterPrivate::BUFFER_SIZE];
+    const auto length = NumberConverterPrivate::toLatin1(str, buffer, QChar());
+
+    if (length <= 0) {
+        if (ok != nullptr) { *ok = false; }
+
+        return 0;
+    }
+
+    qint64 value = 0;
+    const auto result = std::from_chars(buffer, buffer + length, value);
+    const auto success =
+        result.ec == std::errc() && result.ptr == buffer + length;
+    if (ok != nullptr) { *ok = success; }
+
+    return success ? value : 0;
+}
+
+quint64 NumberConverter::toULongLong(QStringView str, bool* ok) {
+    char buffer[NumberConverterPrivate::BUFFER_SIZE];
+    const auto length = NumberConverterPrivate::toLatin1(str, buffer, QChar());
+
+    if (length <= 0) {
+        if (ok != nullptr) { *ok = false; }
+
+        return 0;
+    }
+
+    quint64 value = 0;
+    const auto result = std::from_chars(buffer, buffer + length, value);
+    const auto success =
+        result.ec == std::errc() && result.ptr == buffer + length;
+    if (ok != nullptr) { *ok = success; }
+
+    return success ? value : 0;
+}
+
+// Convert string to floating point number
+// @input:
+// - str - string with a number
+// - ok - pointer to the flag that will be set to True if conversion was
+// successful
+// - decimalSeparator - symbol that separates integral and fractional parts
+// @output:
+// - double - value of the number or 0 in case of error
+double NumberConverter::toDouble(
+    QStringView str, bool* ok, const QChar decimalSeparator)
+{
+    char buffer[NumberConverterPrivate::BUFFER_SIZE];
+    const auto length =
+        NumberConverterPrivate::toLatin1(str, buffer, decimalSeparator);
+
+    if (length <= 0) {
+        if (ok != nullptr) { *ok = false; }
+
+        return 0;
+    }
+
+    double value = 0;
+    const auto result = std::from_chars(buffer, buffer + length, value);
+    const auto success =
+        result.ec == std::errc() && result.ptr == buffer + length;
+    if (ok != nullptr) { *ok = success; }
+
+    return success ? value : 0;
+}
+
+// Convert string to QVariant that holds a number
+// @input:
+// - str - string with a number
+// - decimalSeparator - symbol that separates integral and fractional parts
+// @output:
+// - QVariant - QVariant with qint64 value if string contains an integer,
+// QVariant with double value if string contains floating point number and
+// invalid QVariant otherwise. Integers that do not fit into qint64 are not
+// converted to keep their precision.
+QVariant NumberConverter::toNumber(
+    QStringView str, const QChar decimalSeparator)
+{
+    // Do not treat words like "nan" or "inf" as numbers
+    auto digits = str.trimmed();
+    if (!digits.isEmpty() &&
+        (digits.front() == QChar('+') || digits.front() == QChar('-')))
+    {
+        digits = digits.mid(1);
+    }
+
+    if (digits.isEmpty() ||
+        !(digits.front().isDigit() || digits.front() == decimalSeparator))
+    {
+        return QVariant();
+    }
+
+    auto ok = false;
+    if (NumberConverterPrivate::isInteger(str)) {
+        const auto value = toLongLong(str, &ok);
+        return ok ? QVariant(static_cast<qlonglong>(value)) : QVariant();
+    }
+
+    const auto value = toDouble(str, &ok, decimalSeparator);
+    return ok ? QVariant(value) : QVariant();
+}
@@ -0,0 +1,374 @@
+#include "include/qtcsv/partitionedwriter.h"
+#include "sources/contentiterator.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QStringEncoder>
+#include <QUrl>
+#include <list>
+#include <vector>
+
+using namespace QtCSV;
+
+// Partition holds state of the files of one key value
+struct Partition {
+    // Value of the key column
+    QString key;
+    // Part of the file name for the key
+    QString name;
+    // Number of the current file of the partition (starts from 1)
+    qsizetype number = 1;
+    // Number of data rows in the current file
+    qint64 rows = 0;
+    // Number of bytes in the current file
+    qint64 bytes = 0;
+    // True if the current file was already created by the writer. If it
+    // is closed, it should be reopened in append mode.
+    bool created = false;
+    // Open file or nullptr if file is closed
+    std::unique_ptr<QFile> file;
+    // Position of the partition in the list of open partitions
+    std::list<Partition*>::iterator position;
+};
+
+namespace QtCSV {
+
+class PartitionedWriterPrivate {
+public:
+    QString dirPath;
+    QString baseName;
+    QString separator;
+    QString textDelimiter;
+    QList<QString> header;
+    QStringEncoder encoder;
+    qsizetype keyColumn = -1;
+    qint64 maxRows = 0;
+    qint64 maxBytes = 0;
+    qsizetype maxOpenFiles = 16;
+    std::vector<std::unique_ptr<Partition>> partitions;
+    QHash<QString, Partition*> partitionsByKey;
+    // Partitions with open files, most recently used go first
+    std::list<Partition*> openPartitions;
+    // Number of keys for each name in lower case
+    QHash<QString, qsizetype> keyNames;
+    QList<QString> files;
+
+    // Get partition for the row
+    Partition& partition(const QList<QString>& values);
+    // Get part of the file name for the key
+    QString keyName(const QString& key);
+    // Get number of open files
+    qsizetype openFiles() const {
+        return static_cast<qsizetype>(openPartitions.size());
+    }
+
+    // Get path to the current file of the partition
+    QString filePath(const Partition& partition) const;
+    // Open current file of the partition
+    bool openFile(Partition& partition);
+    // Close current file of the partition
+    bool closeFile(Partition& partition);
+    // Close file of the least recently used partition
+    bool closeLeastRecentlyUsed();
+    // Write bytes to the current file of the partition
+    bool write(Partition& partition, const QByteArray& bytes);
+    // Write one row
+    bool writeRow(const QList<QString>& values);
+};
+
+}
+
+// Get partition for the row
+// @input:
+// - values - values of the row
+// @output:
+// - Partition - partition that corresponds to the value of the key column.
+// If key column is not set, all rows belong to one partition.
+Partition& PartitionedWriterPrivate::partition(const QList<QString>& values) {
+    const auto key = 0 <= keyColumn && keyColumn < values.size() ?
+        values.at(keyColumn) : QString();
+
+    const auto iter = partitionsByKey.constFind(key);
+    if (iter != partitionsByKey.constEnd()) { return *iter.value(); }
+
+    auto newPartition = std::make_unique<Partition>();
+    newPartition->key = key;
+    newPartition->name = keyName(key);
+    auto& result = *newPartition;
+    partitionsByKey.insert(key, newPartition.get());
+    partitions.push_back(std::move(newPartition));
+    return result;
+}
+
+// Get part of the file name for the key. Special symbols of the key are
+// percent-encoded. Keys that differ only in case would get the same file on
+// case-insensitive file systems, so each next such key gets a number
+// ("@2", "@3"...). Percent-encoded names never contain '@'.
+// @input:
+// - key - value of the key column
+// @output:
+// - QString - part of the file name
+QString PartitionedWriterPrivate::keyName(const QString& key) {
+    const auto name = QString::fromLatin1(QUrl::toPercentEncoding(key));
+    const auto number = ++keyNames[name.toLower()];
+    return number == 1 ? name : name + "@" + QString::number(number);
+}
+
+// Get path to the current file of the partition
+// @input:
+// - partition - partition of rows
+// @output:
+// - QString - absolute path to the file
+QString PartitionedWriterPrivate::filePath(const Partition& partition) const {
+    auto name = baseName;
+    if (0 <= keyColumn) { name += "_" + partition.name; }
+
+    if (0 < maxRows || 0 < maxBytes) {
+        name += "_" +
+            QString::number(partition.number).rightJustified(5, QChar('0'));
+    }
+
+    return QDir(dirPath).absoluteFilePath(name + ".csv");
+}
+
+// Open current file of the partition
+// @input:
+// - partition - partition of rows
+// @output:
+// - bool - True if file is open, False otherwise
+bool PartitionedWriterPrivate::openFile(Partition& partition) {
+    if (partition.file) { return true; }
+
+    while (maxOpenFiles <= openFiles() && closeLeastRecentlyUsed()) {}
+
+    const auto path = filePath(partition);
+    partition.file = std::make_unique<QFile>(path);
+    const auto mode = partition.created ?
+        QIODevice::Append | QIODevice::Text :
+        QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text;
+    if (!partition.file->open(mode)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << path;
+        partition.file.reset();
+        return false;
+    }
+
+    openPartitions.push_front(&partition);
+    partition.position = openPartitions.begin();
+    if (partition.created) { return true; }
+
+    partition.created = true;
+    partition.rows = 0;
+    partition.bytes = 0;
+    files << path;
+
+    return header.isEmpty() || write(partition, encoder.encode(
+        ContentIterator::composeRow(header, separator, textDelimiter)));
+}
+
+// Close current file of the partition
+// @input:
+// - partition - partition of rows
+// @output:
+// - bool - True if all data was written to the file, False otherwise
+bool PartitionedWriterPrivate::closeFile(Partition& partition) {
+    if (!partition.file) { return true; }
+
+    const auto result = partition.file->flush() &&
+        partition.file->error() == QFileDevice::NoError;
+    partition.file->close();
+    partition.file.reset();
+    openPartitions.erase(partition.position);
+
+    if (!result) {
+        qDebug() << __FUNCTION__ << "Error - failed to write file:" <<
+            filePath(partition);
+    }
+
+    return result;
+}
+
+// Close file of the least recently used partition
+// @output:
+// - bool - True if some file was closed, False otherwise
+bool PartitionedWriterPrivate::closeLeastRecentlyUsed() {
+    if (openPartitions.empty()) { return false; }
+
+    // Even if we failed to flush the file, it is closed now
+    closeFile(*openPartitions.back());
+    return true;
+}
+
+// Write bytes to the current file of the partition
+// @input:
+// - partition - partition with open file
+// - bytes - encoded data
+// @output:
+// - bool - True if data was written, False otherwise
+bool PartitionedWriterPrivate::write(
+    Partition& partition, const QByteArray& bytes)
+{
+    if (partition.file->write(bytes) != bytes.size()) {
+        qDebug() << __FUNCTION__ << "Error - failed to write to file:" <<
+            partition.file->fileName();
+        return false;
+    }
+
+    partition.bytes += bytes.size();
+    return true;
+}
+
+// Write one row
+// @input:
+// - values - values of the row
+// @output:
+// - bool - True if row was written, False otherwise
+bool PartitionedWriterPrivate::writeRow(const QList<QString>& values) {
+    auto& current = partition(values);
+    const QByteArray bytes = encoder.encode(
+        ContentIterator::composeRow(values, separator, textDelimiter));
+
+    // Move to the next file if the row doesn't fit into the current one.
+    // Row that is bigger than the limit is written to a separate file.
+    if (current.created && 0 < current.rows &&
+        ((0 < maxRows && maxRows <= current.rows) ||
+         (0 < maxBytes && maxBytes < current.bytes + bytes.size())))
+    {
+        if (!closeFile(current)) { return false; }
+
+        ++current.number;
+        current.created = false;
+    }
+
+    if (!openFile(current)) { return false; }
+
+    // Partition becomes the most recently used
+    if (current.position != openPartitions.begin()) {
+        openPartitions.splice(
+            openPartitions.begin(), openPartitions, current.position);
+    }
+
+    if (!write(current, bytes)) { return false; }
+
+    ++current.rows;
+    return true;
+}
+
+// Constructor of PartitionedWriter
+// @input:
+// - dirPath - path to the directory where files will be created
+// - baseName - common part of the names of files
+// - separator - string or character that would separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - header - strings that will be written at the beginning of each file
+// - codec - codec type that will be used to write files
+PartitionedWriter::PartitionedWriter(
+    const QString& dirPath,
+    const QString& baseName,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QList<QString>& header,
+    const QStringConverter::Encoding codec) :
+    d(std::make_unique<PartitionedWriterPrivate>())
+{
+    d->dirPath = dirPath;
+    d->baseName = baseName;
+    d->separator = separator;
+    d->textDelimiter = textDelimiter;
+    d->header = header;
+    d->encoder = QStringEncoder(codec);
+}
+
+PartitionedWriter::~PartitionedWriter() {
+    close();
+}
+
+// Set index of the key column
+// @input:
+// - column - index of the column which values define the file for the row.
+// Rows that do not have such column belong to the partition with empty key.
+// Negative value disables partitioning by key.
+void PartitionedWriter::setKeyColumn(const qsizetype column) {
+    d->keyColumn = column;
+}
+
+// Set max number of data rows in one file
+// @input:
+// - rows - max number of rows (without header). 0 means no limit.
+void PartitionedWriter::setMaxRowsPerFile(const qint64 rows) {
+    d->maxRows = qMax<qint64>(0, rows);
+}
+
+// Set max size of one file in bytes
+// @input:
+// - bytes - max size of the file. 0 means no limit.
+void PartitionedWriter::setMaxBytesPerFile(const qint64 bytes) {
+    d->maxBytes = qMax<qint64>(0, bytes);
+}
+
+// Set max number of simultaneously open files
+// @input:
+// - number - max number of open files. Must be positive.
+void PartitionedWriter::setMaxOpenFiles(const qsizetype number) {
+    d->maxOpenFiles = qMax<qsizetype>(1, number);
+    while (d->maxOpenFiles < d->openFiles()) { d->closeLeastRecentlyUsed(); }
+}
+
+// Write one row
+// @input:
+// - values - values of the row
+// @output:
+// - bool - True if row was written, False otherwise
+bool PartitionedWriter::writeRow(const QList<QString>& values) {
+    if (d->separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    return d->writeRow(values);
+}
+
+// Write all rows of the container
+// @input:
+// - data - AbstractData object
+// @output:
+// - bool - True if all rows were written, False otherwise
+bool PartitionedWriter::write(const AbstractData& data) {
+    DataRowSource source(data);
+    return write(source);
+}
+
+// Write all rows of the source
+// @input:
+// - source - AbstractRowSource object
+// @output:
+// - bool - True if all rows were written, False otherwise
+bool PartitionedWriter::write(AbstractRowSource& source) {
+    // Source gets empty list for each row
+    QList<QString> values;
+    for (values.clear(); source.nextRow(values); values.clear()) {
+        if (!writeRow(values)) { return false; }
+    }
+
+    return true;
+}
+
+// Flush and close all open files. Writer could be used after that, files
+// will be reopened in append mode.
+// @output:
+// - bool - True if all data was written to the files, False otherwise
+bool PartitionedWriter::close() {
+    auto result = true;
+    for (const auto& partition : d->partitions) {
+        result = d->closeFile(*partition) && result;
+    }
+
+    return result;
+}
+
+// Get paths of all files created by the writer
+// @output:
+// - QList<QString> - list of absolute paths in order of creation
+QList<QString> PartitionedWriter::files() const {
+    return d->files;
+}
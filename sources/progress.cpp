@@ -0,0 +1,59 @@
+#include "include/qtcsv/progress.h"
+
+using namespace QtCSV;
+
+// Constructor of Progress
+// @input:
+// - callback - function that will receive state of the operation. Could be
+// empty if only cancellation is needed.
+// - interval - number of rows between calls of the callback
+Progress::Progress(Callback callback, const qint64 interval) :
+    m_callback(std::move(callback)), m_interval(1), m_canceled(false)
+{
+    setInterval(interval);
+}
+
+// Set function that will receive state of the operation
+// @input:
+// - callback - callable object
+void Progress::setCallback(Callback callback) {
+    m_callback = std::move(callback);
+}
+
+// Get function that receives state of the operation
+// @output:
+// - Callback - callable object. Could be empty.
+const Progress::Callback& Progress::callback() const {
+    return m_callback;
+}
+
+// Set number of rows between calls of the callback
+// @input:
+// - rows - positive number of rows. Values less than 1 are replaced by 1.
+void Progress::setInterval(const qint64 rows) {
+    m_interval = rows < 1 ? 1 : rows;
+}
+
+// Get number of rows between calls of the callback
+// @output:
+// - qint64 - number of rows
+qint64 Progress::interval() const {
+    return m_interval;
+}
+
+// Ask operation to stop
+void Progress::cancel() {
+    m_canceled.store(true, std::memory_order_relaxed);
+}
+
+// Check if operation was asked to stop
+// @output:
+// - bool - True if cancel() was called, False otherwise
+bool Progress::isCanceled() const {
+    return m_canceled.load(std::memory_order_relaxed);
+}
+
+// Clear cancel flag
+void Progress::reset() {
+    m_canceled.store(false, std::memory_order_relaxed);
+}
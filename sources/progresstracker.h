@@ -0,0 +1,80 @@
+#ifndef QTCSVPROGRESSTRACKER_H
+#define QTCSVPROGRESSTRACKER_H
+
+#include "include/qtcsv/progress.h"
+#include "include/qtcsv/stats.h"
+
+namespace QtCSV {
+
+    // ProgressTracker passes counters of ReadStats or WriteStats object to
+    // Progress object. Counters are taken relative to their values at the
+    // moment of construction, because statistics could be accumulated over
+    // several operations. If Progress object is null, tracker does nothing.
+    class ProgressTracker {
+        Progress* m_progress;
+        const qint64* m_bytes;
+        const qint64* m_rows;
+        qint64 m_startBytes;
+        qint64 m_startRows;
+        qint64 m_nextReport;
+        Progress::State m_state;
+
+    public:
+        // Stats object must not be null if progress is not null
+        ProgressTracker(
+            Progress* progress, const ReadStats* stats, qint64 totalBytes) :
+            ProgressTracker(progress, stats != nullptr ? &stats->bytesRead :
+                nullptr, stats != nullptr ? &stats->rows : nullptr)
+        {
+            m_state.totalBytes = totalBytes;
+        }
+
+        ProgressTracker(Progress* progress, const WriteStats* stats) :
+            ProgressTracker(progress, stats != nullptr ? &stats->bytesWritten :
+                nullptr, stats != nullptr ? &stats->rows : nullptr)
+        {}
+
+        ProgressTracker(const ProgressTracker&) = delete;
+        ProgressTracker& operator=(const ProgressTracker&) = delete;
+
+        // Report progress if it is time to do it
+        // @output:
+        // - bool - False if operation was canceled, True otherwise
+        bool update() {
+            if (m_progress == nullptr) { return true; }
+
+            if (m_nextReport <= *m_rows - m_startRows) {
+                report();
+                m_nextReport += m_progress->interval();
+            }
+
+            return !m_progress->isCanceled();
+        }
+
+        // Report the final state of the operation
+        void finish() {
+            if (m_progress != nullptr) { report(); }
+        }
+
+    private:
+        ProgressTracker(
+            Progress* progress, const qint64* bytes, const qint64* rows) :
+            m_progress(bytes != nullptr && rows != nullptr ? progress :
+                nullptr),
+            m_bytes(bytes), m_rows(rows),
+            m_startBytes(bytes != nullptr ? *bytes : 0),
+            m_startRows(rows != nullptr ? *rows : 0),
+            m_nextReport(progress != nullptr ? progress->interval() : 0)
+        {}
+
+        void report() {
+            if (!m_progress->callback()) { return; }
+
+            m_state.bytes = *m_bytes - m_startBytes;
+            m_state.rows = *m_rows - m_startRows;
+            m_progress->callback()(m_state);
+        }
+    };
+}
+
+#endif // QTCSVPROGRESSTRACKER_H
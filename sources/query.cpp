@@ -0,0 +1,667 @@
+#include "include/qtcsv/query.h"
+#include "include/qtcsv/numberconverter.h"
+#include "sources/rowbatches.h"
+#include "sources/rowreader.h"
+#include <QBuffer>
+#include <QDebug>
+#include <QHash>
+#include <QSet>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace QtCSV;
+
+// Condition for the value of a column
+struct QueryCondition {
+    qsizetype column = 0;
+    Query::Op op = Query::Op::EQUAL;
+    QString value;
+    // Value of the condition as a number
+    double number = 0;
+    bool isNumber = false;
+    Query::Predicate predicate;
+
+    // Check if value of the row matches the condition
+    bool matches(const QString& rowValue) const;
+};
+
+// Check if value of the row matches the condition
+// @input:
+// - rowValue - value of the column of the row
+// @output:
+// - bool - True if value matches the condition
+bool QueryCondition::matches(const QString& rowValue) const {
+    if (predicate) { return predicate(rowValue); }
+
+    int result = 0;
+    switch (op) {
+    case Query::Op::EQUAL:
+        return rowValue == value;
+    case Query::Op::NOT_EQUAL:
+        return rowValue != value;
+    case Query::Op::CONTAINS:
+        return rowValue.contains(value);
+    case Query::Op::STARTS_WITH:
+        return rowValue.startsWith(value);
+    case Query::Op::ENDS_WITH:
+        return rowValue.endsWith(value);
+    case Query::Op::LESS:
+    case Query::Op::LESS_OR_EQUAL:
+    case Query::Op::GREATER:
+    case Query::Op::GREATER_OR_EQUAL:
+    {
+        auto isRowNumber = false;
+        const auto rowNumber = isNumber ?
+            NumberConverter::toDouble(rowValue, &isRowNumber) : 0.0;
+        if (isRowNumber) {
+            result = rowNumber < number ? -1 : (number < rowNumber ? 1 : 0);
+        }
+        else {
+            result = QString::compare(rowValue, value);
+        }
+
+        break;
+    }
+    }
+
+    switch (op) {
+    case Query::Op::LESS:
+        return result < 0;
+    case Query::Op::LESS_OR_EQUAL:
+        return result <= 0;
+    case Query::Op::GREATER:
+        return 0 < result;
+    case Query::Op::GREATER_OR_EQUAL:
+        return 0 <= result;
+    case Query::Op::EQUAL:
+    case Query::Op::NOT_EQUAL:
+    case Query::Op::CONTAINS:
+    case Query::Op::STARTS_WITH:
+    case Query::Op::ENDS_WITH:
+        break;
+    }
+
+    return false;
+}
+
+// State of an aggregate function of a group
+struct AggregateState {
+    qint64 count = 0;
+    qint64 numbers = 0;
+    double sum = 0;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+
+    // Add state of the same group from other batch
+    void merge(const AggregateState& other) {
+        count += other.count;
+        numbers += other.numbers;
+        sum += other.sum;
+        min = qMin(min, other.min);
+        max = qMax(max, other.max);
+    }
+};
+
+// Group of rows with equal values of group columns
+struct RowGroup {
+    QList<QString> key;
+    std::vector<AggregateState> states;
+};
+
+// Batch of rows and its result
+struct QueryBatch {
+    // Csv-data of the rows
+    const char* data = nullptr;
+    qint64 size = 0;
+    // Result rows or groups of the batch
+    QList<QList<QString>> rows;
+    QList<RowGroup> groups;
+    QHash<QList<QString>, qsizetype> groupIndexes;
+
+    // Remove rows and groups of the batch
+    void clear() {
+        data = nullptr;
+        size = 0;
+        rows.clear();
+        groups.clear();
+        groupIndexes.clear();
+    }
+};
+
+namespace QtCSV {
+
+class QueryPrivate {
+public:
+    struct AggregateInfo {
+        Query::Aggregate function = Query::Aggregate::COUNT;
+        qsizetype column = -1;
+    };
+
+    QList<QueryCondition> conditions;
+    QList<qsizetype> columns;
+    QList<qsizetype> groupColumns;
+    QList<AggregateInfo> aggregates;
+    bool distinct = false;
+    bool hasHeader = false;
+    int threadCount = QThread::idealThreadCount();
+    qint64 batchSize = 1024 * 1024;
+
+    // Check that the query is valid
+    bool isValid() const;
+    // Check if query returns groups of rows
+    bool isAggregating() const {
+        return !groupColumns.isEmpty() || !aggregates.isEmpty();
+    }
+
+    // Get mask of columns that are used by the query
+    QList<bool> columnMask() const;
+    // Run query and pass result rows to the function
+    bool run(
+        const QString& filePath,
+        const std::function<void(const QList<QString>&)>& addRow,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec) const;
+    // Process batch of rows
+    void processBatch(
+        QueryBatch& batch,
+        const QList<bool>& mask,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec) const;
+    // Add values of the row to the states of aggregates of the group
+    void aggregate(const QList<QString>& values, RowGroup& group) const;
+    // Pass result rows of the batch to the function or merge its groups
+    void mergeBatch(
+        const QueryBatch& batch,
+        QueryBatch& total,
+        QSet<QList<QString>>& uniqueRows,
+        const std::function<void(const QList<QString>&)>& addRow) const;
+    // Get values of aggregates of the group
+    QList<QString> aggregateValues(const RowGroup& group) const;
+    // Convert value of aggregate to string
+    static QString numberToString(double value);
+};
+
+}
+
+// Check that the query is valid
+// @output:
+// - bool - True if query could be run, False otherwise
+bool QueryPrivate::isValid() const {
+    if (!columns.isEmpty() && isAggregating()) {
+        qDebug() << __FUNCTION__ <<
+            "Error - selected columns could not be used with aggregates";
+        return false;
+    }
+
+    auto isNegative = [](const qsizetype column) { return column < 0; };
+    auto hasNegative = std::any_of(columns.cbegin(), columns.cend(),
+                                   isNegative) ||
+        std::any_of(groupColumns.cbegin(), groupColumns.cend(), isNegative);
+    for (const auto& condition : conditions) {
+        hasNegative = hasNegative || condition.column < 0;
+    }
+
+    for (const auto& info : aggregates) {
+        hasNegative = hasNegative ||
+            (info.column < 0 && info.function != Query::Aggregate::COUNT);
+    }
+
+    if (hasNegative) {
+        qDebug() << __FUNCTION__ << "Error - invalid column number";
+        return false;
+    }
+
+    return true;
+}
+
+// Get mask of columns that are used by the query
+// @output:
+// - QList<bool> - True for used columns. Empty list means all columns.
+QList<bool> QueryPrivate::columnMask() const {
+    if (!isAggregating() && columns.isEmpty()) { return {}; }
+
+    QList<bool> mask;
+    auto use = [&mask](const qsizetype column) {
+        if (column < 0) { return; }
+        if (mask.size() <= column) { mask.resize(column + 1, false); }
+
+        mask[column] = true;
+    };
+
+    for (const auto& condition : conditions) { use(condition.column); }
+    for (const auto column : columns) { use(column); }
+    for (const auto column : groupColumns) { use(column); }
+    for (const auto& info : aggregates) { use(info.column); }
+
+    // Mask of a query that uses no columns (for example, count of rows)
+    // should not be empty
+    if (mask.isEmpty()) { mask << false; }
+
+    return mask;
+}
+
+// Run query and pass result rows to the function
+// @input:
+// - filePath - string with absolute path to csv-file
+// - addRow - function that receives result rows
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if query was run, False otherwise
+bool QueryPrivate::run(
+    const QString& filePath,
+    const std::function<void(const QList<QString>&)>& addRow,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (!isValid()) { return false; }
+
+    MappedCsvFile file(filePath);
+    if (!file.open(codec, separator, textDelimiter, batchSize)) {
+        return false;
+    }
+
+    if (hasHeader) {
+        qint64 headerBegin = 0, headerEnd = 0;
+        file.nextRow(headerBegin, headerEnd);
+    }
+
+    // Rows of a batch are passed on as soon as the batch is processed, so
+    // only groups and distinct rows are kept for the whole file
+    const auto mask = columnMask();
+    const auto rowCodec = file.codec();
+    QueryBatch total;
+    QSet<QList<QString>> uniqueRows;
+    ProcessBatchesInOrder<QueryBatch>(
+        threadCount,
+        [&file](QueryBatch& batch) {
+            qint64 begin = 0, end = 0;
+            if (!file.nextBatch(begin, end)) { return false; }
+
+            batch.data = file.data() + begin;
+            batch.size = end - begin;
+            return true;
+        },
+        [&](QueryBatch& batch) {
+            processBatch(batch, mask, separator, textDelimiter, rowCodec);
+        },
+        [&](QueryBatch& batch) {
+            mergeBatch(batch, total, uniqueRows, addRow);
+            return true;
+        });
+
+    if (!isAggregating()) { return true; }
+
+    // Aggregates without groups return one row even if there are no rows
+    if (groupColumns.isEmpty() && total.groups.isEmpty()) {
+        total.groups << RowGroup{{}, std::vector<AggregateState>(
+            static_cast<size_t>(aggregates.size()))};
+    }
+
+    for (const auto& group : total.groups) {
+        addRow(group.key + aggregateValues(group));
+    }
+
+    return true;
+}
+
+// Process batch of rows. This function is called from threads of the pool.
+// @input:
+// - batch - batch of rows that gets result rows or groups
+// - mask - columns that are used by the query
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type with explicit byte order
+void QueryPrivate::processBatch(
+    QueryBatch& batch,
+    const QList<bool>& mask,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    auto bytes = QByteArray::fromRawData(
+        batch.data, static_cast<qsizetype>(batch.size));
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    RowReader reader(buffer, separator, textDelimiter, codec);
+    reader.setColumnMask(mask);
+
+    const auto isGrouping = isAggregating();
+    QList<QString> values, key;
+    while (reader.readRow(values)) {
+        auto isMatched = true;
+        for (const auto& condition : conditions) {
+            if (!condition.matches(values.value(condition.column))) {
+                isMatched = false;
+                break;
+            }
+        }
+
+        if (!isMatched) { continue; }
+
+        if (isGrouping) {
+            key.clear();
+            for (const auto column : groupColumns) {
+                key << values.value(column);
+            }
+
+            auto index = batch.groupIndexes.value(key, -1);
+            if (index < 0) {
+                index = batch.groups.size();
+                batch.groupIndexes.insert(key, index);
+                batch.groups.append(RowGroup{
+                    key, std::vector<AggregateState>(
+                        static_cast<size_t>(aggregates.size()))});
+            }
+
+            aggregate(values, batch.groups[index]);
+            continue;
+        }
+
+        if (!columns.isEmpty()) {
+            QList<QString> row;
+            row.reserve(columns.size());
+            for (const auto column : columns) { row << values.value(column); }
+
+            values = std::move(row);
+        }
+
+        batch.rows << values;
+    }
+}
+
+// Add values of the row to the states of aggregates of the group
+// @input:
+// - values - values of the row
+// - group - group of the row
+void QueryPrivate::aggregate(
+    const QList<QString>& values, RowGroup& group) const
+{
+    for (qsizetype i = 0; i < aggregates.size(); ++i) {
+        const auto& info = aggregates.at(i);
+        auto& state = group.states[static_cast<size_t>(i)];
+        if (info.column < 0) {
+            ++state.count;
+            continue;
+        }
+
+        const auto value = values.value(info.column);
+        if (value.isEmpty()) { continue; }
+
+        ++state.count;
+        if (info.function == Query::Aggregate::COUNT) { continue; }
+
+        auto isNumber = false;
+        const auto number = NumberConverter::toDouble(value, &isNumber);
+        if (!isNumber) { continue; }
+
+        ++state.numbers;
+        state.sum += number;
+        state.min = qMin(state.min, number);
+        state.max = qMax(state.max, number);
+    }
+}
+
+// Pass result rows of the batch to the function or merge groups of the
+// batch with groups of previous batches
+// @input:
+// - batch - processed batch. Batches are passed in order of rows in the
+// file.
+// - total - merged groups of previous batches
+// - uniqueRows - rows that were passed to the function if rows should be
+// distinct
+// - addRow - function that receives result rows
+void QueryPrivate::mergeBatch(
+    const QueryBatch& batch,
+    QueryBatch& total,
+    QSet<QList<QString>>& uniqueRows,
+    const std::function<void(const QList<QString>&)>& addRow) const
+{
+    for (const auto& row : batch.rows) {
+        if (distinct) {
+            if (uniqueRows.contains(row)) { continue; }
+
+            uniqueRows.insert(row);
+        }
+
+        addRow(row);
+    }
+
+    for (const auto& group : batch.groups) {
+        const auto index = total.groupIndexes.value(group.key, -1);
+        if (index < 0) {
+            total.groupIndexes.insert(group.key, total.groups.size());
+            total.groups << group;
+            continue;
+        }
+
+        auto& states = total.groups[index].states;
+        for (size_t i = 0; i < states.size(); ++i) {
+            states[i].merge(group.states[i]);
+        }
+    }
+}
+
+// Get values of aggregates of the group
+// @input:
+// - group - group of rows
+// @output:
+// - QList<QString> - values of aggregate functions. Numeric functions of
+// columns without numbers have empty values.
+QList<QString> QueryPrivate::aggregateValues(const RowGroup& group) const {
+    QList<QString> values;
+    for (qsizetype i = 0; i < aggregates.size(); ++i) {
+        const auto& state = group.states[static_cast<size_t>(i)];
+        const auto function = aggregates.at(i).function;
+        if (function == Query::Aggregate::COUNT) {
+            values << NumberConverter::toString(state.count);
+            continue;
+        }
+
+        if (state.numbers == 0) {
+            values << QString();
+            continue;
+        }
+
+        switch (function) {
+        case Query::Aggregate::SUM:
+            values << numberToString(state.sum);
+            break;
+        case Query::Aggregate::MIN:
+            values << numberToString(state.min);
+            break;
+        case Query::Aggregate::MAX:
+            values << numberToString(state.max);
+            break;
+        case Query::Aggregate::AVG:
+            values << numberToString(
+                state.sum / static_cast<double>(state.numbers));
+            break;
+        case Query::Aggregate::COUNT:
+            break;
+        }
+    }
+
+    return values;
+}
+
+// Convert value of aggregate to string. Integral values are written without
+// exponent (shortest representation of 100000 is "1e+05").
+// @input:
+// - value - value of aggregate
+// @output:
+// - QString - string with the value
+QString QueryPrivate::numberToString(const double value) {
+    // 2^63 is exactly representable as double, unlike the max of qint64
+    constexpr double limit = 9223372036854775808.0;
+    if (-limit <= value && value < limit && std::trunc(value) == value) {
+        return NumberConverter::toString(static_cast<qint64>(value));
+    }
+
+    return NumberConverter::toString(value);
+}
+
+Query::Query() : d(std::make_unique<QueryPrivate>()) {}
+
+Query::~Query() = default;
+
+// Add condition for the value of the column
+// @input:
+// - column - number of the column
+// - op - comparison operation
+// - value - value that the value of the column is compared with
+// @output:
+// - Query& - this query
+Query& Query::where(const qsizetype column, const Op op, const QString& value)
+{
+    QueryCondition condition;
+    condition.column = column;
+    condition.op = op;
+    condition.value = value;
+    condition.number = NumberConverter::toDouble(value, &condition.isNumber);
+    d->conditions << condition;
+    return *this;
+}
+
+// Add custom condition for the value of the column
+// @input:
+// - column - number of the column
+// - predicate - function that returns True if value matches the condition.
+// It should be thread-safe.
+// @output:
+// - Query& - this query
+Query& Query::where(const qsizetype column, const Predicate& predicate) {
+    QueryCondition condition;
+    condition.column = column;
+    condition.predicate = predicate;
+    d->conditions << condition;
+    return *this;
+}
+
+// Set columns of the result rows
+// @input:
+// - columns - numbers of columns in the order they should be returned.
+// Missing values are returned as empty strings.
+// @output:
+// - Query& - this query
+Query& Query::select(const QList<qsizetype>& columns) {
+    d->columns = columns;
+    return *this;
+}
+
+// Set columns which values define groups of rows
+// @input:
+// - columns - numbers of columns
+// @output:
+// - Query& - this query
+Query& Query::groupBy(const QList<qsizetype>& columns) {
+    d->groupColumns = columns;
+    return *this;
+}
+
+// Add aggregate function of the column
+// @input:
+// - function - aggregate function
+// - column - number of the column. -1 could be used only with COUNT and
+// means number of rows.
+// @output:
+// - Query& - this query
+Query& Query::aggregate(const Aggregate function, const qsizetype column) {
+    d->aggregates << QueryPrivate::AggregateInfo{function, column};
+    return *this;
+}
+
+// Remove duplicate result rows
+// @input:
+// - distinct - True to remove duplicates. The first of equal rows is kept.
+// @output:
+// - Query& - this query
+Query& Query::setDistinct(const bool distinct) {
+    d->distinct = distinct;
+    return *this;
+}
+
+// Remove all conditions, columns and aggregates
+void Query::clear() {
+    d->conditions.clear();
+    d->columns.clear();
+    d->groupColumns.clear();
+    d->aggregates.clear();
+    d->distinct = false;
+}
+
+// Set if the first row is a header
+void Query::setHasHeader(const bool hasHeader) {
+    d->hasHeader = hasHeader;
+}
+
+// Set number of threads
+// @input:
+// - count - number of threads. Must be positive.
+void Query::setThreadCount(const int count) {
+    d->threadCount = qMax(1, count);
+}
+
+// Set approximate size of a batch of rows
+// @input:
+// - bytes - size of the batch in bytes. Must be positive.
+void Query::setBatchSize(const qint64 bytes) {
+    d->batchSize = qMax<qint64>(1, bytes);
+}
+
+// Run query on the csv-file and add result rows to the container
+// @input:
+// - filePath - string with absolute path to csv-file
+// - result - AbstractData object for the result rows
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - bool - True if query was run, False otherwise
+bool Query::run(
+    const QString& filePath,
+    AbstractData& result,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    return d->run(
+        filePath,
+        [&result](const QList<QString>& row) { result.addRow(row); },
+        separator, textDelimiter, codec);
+}
+
+// Run query on the csv-file and return result rows
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading
+// @output:
+// - QList<QList<QString>> - result rows. On error returns empty list.
+QList<QList<QString>> Query::runToList(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec) const
+{
+    QList<QList<QString>> rows;
+    const auto isOk = d->run(
+        filePath,
+        [&rows](const QList<QString>& row) { rows << row; },
+        separator, textDelimiter, codec);
+    return isOk ? rows : QList<QList<QString>>();
+}
@@ -0,0 +1,118 @@
+#include "sources/rowbatches.h"
+#include "sources/filechecker.h"
+#include <QByteArrayView>
+#include <QDebug>
+
+using namespace QtCSV;
+
+// Constructor of MappedCsvFile
+// @input:
+// - filePath - string with absolute path to csv-file
+MappedCsvFile::MappedCsvFile(const QString& filePath) : m_file(filePath) {}
+
+// Open file and map it to memory
+// @input:
+// - codec - codec type of the file. Byte order mark at the beginning of the
+// file overrides it.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - scanSize - size of data that is scanned for row ends at once. Batch of
+// rows takes about this size.
+// @output:
+// - bool - True if file was opened and mapped, False otherwise
+bool MappedCsvFile::open(
+    const QStringConverter::Encoding codec,
+    const QString& separator,
+    const QString& textDelimiter,
+    const qint64 scanSize)
+{
+    const auto filePath = m_file.fileName();
+    if (!CheckFile(filePath, true) || !m_file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (0 < m_size) {
+        m_data = reinterpret_cast<const char*>(m_file.map(0, m_size));
+        if (m_data == nullptr) {
+            qDebug() << __FUNCTION__ << "Error - can't map file:" << filePath;
+            return false;
+        }
+    }
+
+    m_codec = RowIndexer::resolveCodec(
+        codec, QByteArrayView(m_data, qMin<qint64>(m_size, 4)), m_bomSize);
+    m_separator = separator;
+    m_textDelimiter = textDelimiter;
+    m_scanSize = qMax<qint64>(1, scanSize);
+    m_indexer = std::make_unique<RowIndexer>(
+        m_data, m_size, m_bomSize, m_codec, separator, textDelimiter);
+    m_rowEnds.clear();
+    m_next = 0;
+    m_rowStart = m_bomSize;
+    return true;
+}
+
+// Take the next row
+// @input:
+// - begin - position of the row
+// - end - end position of the row
+// @output:
+// - bool - True if row was taken, False if there are no more rows
+bool MappedCsvFile::nextRow(qint64& begin, qint64& end) {
+    if (!findRowEnds()) { return false; }
+
+    begin = m_rowStart;
+    end = m_rowEnds.at(m_next++);
+    m_rowStart = end;
+    return true;
+}
+
+// Take the next batch of whole rows. Row could be bigger than the scan
+// size, so batch takes at least one row.
+// @input:
+// - begin - position of the first row of the batch
+// - end - end position of the last row of the batch
+// @output:
+// - bool - True if batch was taken, False if there are no more rows
+bool MappedCsvFile::nextBatch(qint64& begin, qint64& end) {
+    if (!findRowEnds()) { return false; }
+
+    begin = m_rowStart;
+    end = m_rowEnds.last();
+    m_next = m_rowEnds.size();
+    m_rowStart = end;
+    return true;
+}
+
+// Parse row that is located between the positions
+// @input:
+// - begin - position of the row
+// - end - end position of the row
+// @output:
+// - QList<QString> - values of the row
+QList<QString> MappedCsvFile::parseRow(
+    const qint64 begin, const qint64 end) const
+{
+    return RowIndexer::parseRow(
+        m_data, begin, end, m_separator, m_textDelimiter, m_codec);
+}
+
+// Find ends of rows if all found rows were taken
+// @output:
+// - bool - True if there is a row that was not taken, False at the end of
+// data
+bool MappedCsvFile::findRowEnds() {
+    if (!m_indexer) { return false; }
+
+    while (m_next == m_rowEnds.size()) {
+        if (m_indexer->atEnd()) { return false; }
+
+        m_rowEnds.clear();
+        m_next = 0;
+        m_indexer->scan(m_scanSize, m_rowEnds);
+    }
+
+    return true;
+}
@@ -0,0 +1,149 @@
+#ifndef QTCSVROWBATCHES_H
+#define QTCSVROWBATCHES_H
+
+#include "sources/rowindexer.h"
+#include <QFile>
+#include <QList>
+#include <QSemaphore>
+#include <QString>
+#include <QStringConverter>
+#include <QThreadPool>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace QtCSV {
+
+    // MappedCsvFile is a csv-file that is mapped to memory and is taken by
+    // rows or by batches of whole rows without parsing values. Byte order
+    // mark at the beginning of the file overrides the codec, so rows are
+    // parsed with the codec with explicit byte order (see codec()).
+    class MappedCsvFile {
+        QFile m_file;
+        const char* m_data = nullptr;
+        qint64 m_size = 0;
+        qsizetype m_bomSize = 0;
+        QStringConverter::Encoding m_codec = QStringConverter::Utf8;
+        QString m_separator;
+        QString m_textDelimiter;
+        qint64 m_scanSize = 0;
+        std::unique_ptr<RowIndexer> m_indexer;
+        QList<qint64> m_rowEnds;
+        // Index of the end of the next row in m_rowEnds
+        qsizetype m_next = 0;
+        // Position of the next row
+        qint64 m_rowStart = 0;
+
+    public:
+        explicit MappedCsvFile(const QString& filePath);
+
+        MappedCsvFile(const MappedCsvFile&) = delete;
+        MappedCsvFile& operator=(const MappedCsvFile&) = delete;
+
+        // Open file and map it to memory
+        bool open(
+            QStringConverter::Encoding codec,
+            const QString& separator,
+            const QString& textDelimiter,
+            qint64 scanSize);
+
+        // Get opened file
+        QFile& file() { return m_file; }
+        // Get memory-mapped data of the file. It is null if file is empty.
+        const char* data() const { return m_data; }
+        // Get size of the file in bytes
+        qint64 size() const { return m_size; }
+        // Get size of byte order mark in bytes
+        qsizetype bomSize() const { return m_bomSize; }
+        // Get codec with explicit byte order
+        QStringConverter::Encoding codec() const { return m_codec; }
+
+        // Take the next row
+        bool nextRow(qint64& begin, qint64& end);
+        // Take the next batch of whole rows
+        bool nextBatch(qint64& begin, qint64& end);
+        // Parse row that is located between the positions
+        QList<QString> parseRow(qint64 begin, qint64 end) const;
+
+    private:
+        // Find ends of rows if all found rows were taken
+        bool findRowEnds();
+    };
+
+    // Process batches by threads of the pool and pass processed batches to
+    // the consumer in order they were taken from the source. Only two
+    // batches per thread are in memory, so memory usage doesn't depend on
+    // the size of the data. Batches are reused after they were consumed
+    // and cleared, so their buffers keep memory.
+    // @input:
+    // - threadCount - number of threads. Must be positive.
+    // - source - function that fills the next batch. It returns False if
+    // there are no more batches.
+    // - process - function that processes batch in a thread of the pool
+    // - consume - function that receives processed batches. It returns
+    // False to stop processing.
+    // @output:
+    // - bool - True if all batches were consumed, False otherwise
+    template <typename Batch, typename Source, typename Process,
+              typename Consume>
+    bool ProcessBatchesInOrder(
+        const int threadCount,
+        const Source& source,
+        const Process& process,
+        const Consume& consume)
+    {
+        struct QueuedBatch {
+            Batch batch;
+            // Released when the batch is processed
+            QSemaphore done;
+        };
+
+        const auto threads = qMax(1, threadCount);
+        std::deque<std::unique_ptr<QueuedBatch>> queue;
+        std::vector<std::unique_ptr<QueuedBatch>> spareBatches;
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+
+        auto consumeFirst = [&queue, &spareBatches, &consume]() {
+            auto queued = std::move(queue.front());
+            queue.pop_front();
+            queued->done.acquire();
+            const auto result = consume(queued->batch);
+            queued->batch.clear();
+            spareBatches.push_back(std::move(queued));
+            return result;
+        };
+
+        auto isOk = true;
+        while (isOk) {
+            std::unique_ptr<QueuedBatch> queued;
+            if (spareBatches.empty()) {
+                queued = std::make_unique<QueuedBatch>();
+            }
+            else {
+                queued = std::move(spareBatches.back());
+                spareBatches.pop_back();
+            }
+
+            if (!source(queued->batch)) { break; }
+
+            auto* queuedPtr = queued.get();
+            queue.push_back(std::move(queued));
+            pool.start([&process, queuedPtr]() {
+                process(queuedPtr->batch);
+                queuedPtr->done.release();
+            });
+
+            while (isOk && static_cast<size_t>(2 * threads) <= queue.size()) {
+                isOk = consumeFirst();
+            }
+        }
+
+        while (isOk && !queue.empty()) { isOk = consumeFirst(); }
+
+        pool.waitForDone();
+        return isOk;
+    }
+}
+
+#endif // QTCSVROWBATCHES_H
@@ -0,0 +1,226 @@
+#include "sources/rowindexer.h"
+#include "sources/rowreader.h"
+#include <QBuffer>
+#include <QStringEncoder>
+#include <QSysInfo>
+#include <cstring>
+
+using namespace QtCSV;
+
+// Constructor of RowIndexer
+// @input:
+// - data - pointer to csv-data
+// - size - size of data in bytes
+// - start - position of the first row (after byte order mark)
+// - codec - codec type with explicit byte order
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+RowIndexer::RowIndexer(
+    const char* data,
+    const qint64 size,
+    const qint64 start,
+    const QStringConverter::Encoding codec,
+    const QString& separator,
+    const QString& textDelimiter) :
+    m_data(data),
+    m_size(size),
+    m_unit(unitSize(codec)),
+    m_pos(start),
+    m_rowStart(start)
+{
+    QStringEncoder encoder(codec);
+    m_separator = encoder.encode(separator);
+    m_textDelimiter = encoder.encode(textDelimiter);
+    m_cr = encoder.encode(QString("\r"));
+    m_lf = encoder.encode(QString("\n"));
+}
+
+// Find ends of rows in the next part of data. Quoted value starts with text
+// delimiter at the beginning of a value and ends with odd number of text
+// delimiters followed by separator or line end.
+// @input:
+// - maxBytes - approximate number of bytes to scan
+// - rowEnds - list that will be appended with end positions of found rows.
+// End of the last row is added when the end of data is reached.
+void RowIndexer::scan(const qint64 maxBytes, QList<qint64>& rowEnds) {
+    const auto limit = qMin(m_size, m_pos + qMax<qint64>(1, maxBytes));
+    while (m_pos < limit) {
+        if (m_isQuoted) {
+            if (!matches(m_pos, m_textDelimiter)) {
+                m_pos += m_unit;
+                continue;
+            }
+
+            qint64 delimiters = 0;
+            while (matches(m_pos, m_textDelimiter)) {
+                m_pos += m_textDelimiter.size();
+                ++delimiters;
+            }
+
+            if (delimiters % 2 == 1 &&
+                (m_size <= m_pos || matches(m_pos, m_separator) ||
+                 0 < lineEnd(m_pos)))
+            {
+                m_isQuoted = false;
+            }
+
+            continue;
+        }
+
+        if (m_isValueStart && matches(m_pos, m_textDelimiter)) {
+            m_pos += m_textDelimiter.size();
+            m_isValueStart = false;
+            m_isQuoted = true;
+            continue;
+        }
+
+        if (matches(m_pos, m_separator)) {
+            m_pos += m_separator.size();
+            m_isValueStart = true;
+            continue;
+        }
+
+        const auto lineEndSize = lineEnd(m_pos);
+        if (0 < lineEndSize) {
+            m_pos += lineEndSize;
+            m_rowStart = m_pos;
+            rowEnds << m_pos;
+            m_isValueStart = true;
+            continue;
+        }
+
+        m_pos += m_unit;
+        m_isValueStart = false;
+    }
+
+    // Line end of the last row doesn't start a new row
+    if (atEnd() && m_rowStart < m_size) {
+        m_rowStart = m_size;
+        rowEnds << m_size;
+    }
+}
+
+// Get codec with explicit byte order
+// @input:
+// - codec - codec that was requested by user
+// - data - first bytes of csv-data
+// - bomSize - size of byte order mark in bytes
+// @output:
+// - QStringConverter::Encoding - codec of the byte order mark if data
+// starts with it, codec with native byte order if codec is UTF-16 or UTF-32
+// without explicit byte order, requested codec otherwise
+QStringConverter::Encoding RowIndexer::resolveCodec(
+    const QStringConverter::Encoding codec,
+    const QByteArrayView data,
+    qsizetype& bomSize)
+{
+    bomSize = 0;
+    const auto bomEncoding = QStringConverter::encodingForData(data);
+    if (bomEncoding) {
+        bomSize = *bomEncoding == QStringConverter::Utf8 ? 3 :
+            unitSize(*bomEncoding);
+        return *bomEncoding;
+    }
+
+    const auto isLittleEndian = QSysInfo::ByteOrder == QSysInfo::LittleEndian;
+    switch (codec) {
+    case QStringConverter::Utf16:
+        return isLittleEndian ?
+            QStringConverter::Utf16LE : QStringConverter::Utf16BE;
+    case QStringConverter::Utf32:
+        return isLittleEndian ?
+            QStringConverter::Utf32LE : QStringConverter::Utf32BE;
+    case QStringConverter::Utf8:
+    case QStringConverter::Utf16LE:
+    case QStringConverter::Utf16BE:
+    case QStringConverter::Utf32LE:
+    case QStringConverter::Utf32BE:
+    case QStringConverter::Latin1:
+    case QStringConverter::System:
+        break;
+    }
+
+    return codec;
+}
+
+// Get size of the code unit of the codec in bytes
+// @input:
+// - codec - codec type
+// @output:
+// - qsizetype - size of code unit. Symbols of the line end, separator and
+// text delimiter could start only at positions that are multiples of it.
+qsizetype RowIndexer::unitSize(const QStringConverter::Encoding codec) {
+    switch (codec) {
+    case QStringConverter::Utf16:
+    case QStringConverter::Utf16LE:
+    case QStringConverter::Utf16BE:
+        return 2;
+    case QStringConverter::Utf32:
+    case QStringConverter::Utf32LE:
+    case QStringConverter::Utf32BE:
+        return 4;
+    case QStringConverter::Utf8:
+    case QStringConverter::Latin1:
+    case QStringConverter::System:
+        return 1;
+    }
+
+    return 1;
+}
+
+// Parse row that is located between the positions
+// @input:
+// - data - pointer to csv-data
+// - begin - position of the row
+// - end - end position of the row
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type with explicit byte order
+// @output:
+// - QList<QString> - values of the row
+QList<QString> RowIndexer::parseRow(
+    const char* data,
+    const qint64 begin,
+    const qint64 end,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    auto bytes = QByteArray::fromRawData(
+        data + begin, static_cast<qsizetype>(end - begin));
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    RowReader reader(buffer, separator, textDelimiter, codec);
+    QList<QString> values;
+    reader.readRow(values);
+    return values;
+}
+
+// Check if data at the position starts with the symbols
+// @input:
+// - pos - position in data
+// - symbols - encoded symbols
+// @output:
+// - bool - True if symbols are not empty and data contains them at the
+// position
+bool RowIndexer::matches(const qint64 pos, const QByteArray& symbols) const {
+    return !symbols.isEmpty() && pos + symbols.size() <= m_size &&
+        m_data[pos] == symbols.at(0) &&
+        std::memcmp(m_data + pos, symbols.constData(),
+                    static_cast<size_t>(symbols.size())) == 0;
+}
+
+// Get size of the line end at the position
+// @input:
+// - pos - position in data
+// @output:
+// - qint64 - size of LF or CRLF symbols at the position in bytes or 0
+// if there is no line end. Lone CR is not a line end, the same as for
+// QTextStream::readLine() that is used by RowReader.
+qint64 RowIndexer::lineEnd(const qint64 pos) const {
+    if (matches(pos, m_lf)) { return m_lf.size(); }
+
+    return matches(pos, m_cr) && matches(pos + m_cr.size(), m_lf) ?
+        m_cr.size() + m_lf.size() : 0;
+}
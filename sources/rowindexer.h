@@ -0,0 +1,77 @@
+#ifndef QTCSVROWINDEXER_H
+#define QTCSVROWINDEXER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+
+namespace QtCSV {
+
+    // RowIndexer finds positions of rows in csv-data that is located in
+    // memory (usually memory-mapped file) without parsing values. Row ends
+    // at the line end that is not inside of a quoted value, the same way as
+    // RowReader reads it. Data could be scanned by parts.
+    //
+    // Codec should have explicit byte order (see resolveCodec()). Data
+    // should stay valid while indexer is used.
+    class RowIndexer {
+        const char* m_data;
+        const qint64 m_size;
+        const qsizetype m_unit;
+        QByteArray m_separator;
+        QByteArray m_textDelimiter;
+        QByteArray m_cr;
+        QByteArray m_lf;
+        qint64 m_pos;
+        qint64 m_rowStart;
+        bool m_isValueStart = true;
+        bool m_isQuoted = false;
+
+    public:
+        RowIndexer(
+            const char* data,
+            qint64 size,
+            qint64 start,
+            QStringConverter::Encoding codec,
+            const QString& separator,
+            const QString& textDelimiter);
+
+        // Find ends of rows in the next part of data
+        void scan(qint64 maxBytes, QList<qint64>& rowEnds);
+        // Check if all data was scanned
+        bool atEnd() const { return m_size <= m_pos; }
+        // Get number of scanned bytes
+        qint64 position() const { return m_pos; }
+        // Check if scan stopped inside of a quoted value
+        bool isQuoted() const { return m_isQuoted; }
+        // Get size of the line end (LF or CRLF) at the position or 0 if
+        // there is no line end
+        qint64 lineEnd(qint64 pos) const;
+
+        // Get codec with explicit byte order and size of byte order mark
+        static QStringConverter::Encoding resolveCodec(
+            QStringConverter::Encoding codec,
+            QByteArrayView data,
+            qsizetype& bomSize);
+
+        // Get size of the code unit of the codec in bytes
+        static qsizetype unitSize(QStringConverter::Encoding codec);
+
+        // Parse row that is located between the positions
+        static QList<QString> parseRow(
+            const char* data,
+            qint64 begin,
+            qint64 end,
+            const QString& separator,
+            const QString& textDelimiter,
+            QStringConverter::Encoding codec);
+
+    private:
+        // Check if data at the position starts with the symbols
+        bool matches(qint64 pos, const QByteArray& symbols) const;
+    };
+}
+
+#endif // QTCSVROWINDEXER_H
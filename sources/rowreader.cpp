@@ -0,0 +1,518 @@
+#include "sources/rowreader.h"
+#include "sources/rowindexer.h"
+#include "sources/symbols.h"
+#include <QStringView>
+
+using namespace QtCSV;
+
+// Constructor of RowReader
+// @input:
+// - ioDevice - IO Device containing the csv-formatted data
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose row elements
+// - codec - codec type that would be used for reading
+// - processor - optional AbstractProcessor-based object that will
+// preprocess raw lines
+// - stats - optional object for statistics of reading
+RowReader::RowReader(
+    QIODevice& ioDevice,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    Reader::AbstractProcessor* processor,
+    ReadStats* stats) :
+    m_separator(separator),
+    m_textDelimiter(textDelimiter),
+    m_processor(processor),
+    m_stats(stats),
+    m_rowLines(0),
+    m_rows(0),
+    m_startPos(ioDevice.isSequential() ? 0 : ioDevice.pos()),
+    m_codec(ioDevice.isSequential() ? codec : streamCodec(ioDevice, codec))
+{
+    if (m_stats != nullptr) {
+        m_device = std::make_unique<InstrumentedDevice>(
+            ioDevice, m_stats->bytesRead, timer(&ReadStats::ioNsecs));
+        m_stream.setDevice(m_device.get());
+    }
+    else {
+        m_stream.setDevice(&ioDevice);
+    }
+
+    m_stream.setEncoding(codec);
+}
+
+// Get codec that QTextStream uses for the data at the current position
+// of IO Device. Byte order mark is not repeated at the checkpoint, so
+// checkpoint keeps the codec with the byte order found by it.
+// @input:
+// - ioDevice - IO Device containing the csv-formatted data
+// - codec - codec type that was requested for reading
+// @output:
+// - QStringConverter::Encoding - codec with explicit byte order
+QStringConverter::Encoding RowReader::streamCodec(
+    QIODevice& ioDevice, const QStringConverter::Encoding codec)
+{
+    qsizetype bomSize = 0;
+    return RowIndexer::resolveCodec(codec, ioDevice.peek(4), bomSize);
+}
+
+// Read next row
+// @input:
+// - row - list that will be filled with elements of the next row. Empty
+// lines produce empty rows.
+// @output:
+// - bool - True if row was read, False if there are no more rows
+bool RowReader::readRow(QList<QString>& row) {
+    while (!m_stream.atEnd()) {
+        auto elements = split(readLine());
+        ++m_rowLines;
+        if (m_elemInfo.isEnded) {
+            // Current row ends on this line. Check if these elements are
+            // end elements of the long row
+            returnRow(row, elements);
+            return true;
+        }
+
+        // These elements constitute long row that lasts on several lines
+        if (!elements.isEmpty()) {
+            if (!m_row.isEmpty()) {
+                m_row.last().append(elements.takeFirst());
+            }
+
+            m_row << elements;
+        }
+    }
+
+    // Data ended in the middle of the row. Return what we have got.
+    if (!m_elemInfo.isEnded && !m_row.isEmpty()) {
+        m_elemInfo.isEnded = true;
+        QList<QString> elements;
+        returnRow(row, elements);
+        return true;
+    }
+
+    return false;
+}
+
+// Get checkpoint after the last returned row
+// @output:
+// - ReadCheckpoint - checkpoint with position of the next row. It is
+// invalid if IO Device is sequential.
+ReadCheckpoint RowReader::checkpoint() const {
+    ReadCheckpoint checkpoint;
+    const auto* device = m_stream.device();
+    if (device == nullptr || device->isSequential()) { return checkpoint; }
+
+    // QTextStream reads data by blocks, so it finds position of the device
+    // that corresponds to the decoded symbols by reading the block again.
+    // These bytes are not counted in statistics. Position of the wrapper of
+    // the device starts at zero.
+    if (m_device) { m_device->setCounting(false); }
+    const auto pos = m_stream.pos();
+    if (m_device) { m_device->setCounting(true); }
+    if (pos < 0) { return checkpoint; }
+
+    checkpoint.offset = (m_device ? m_startPos : 0) + pos;
+    checkpoint.rows = m_rows;
+    checkpoint.separator = m_separator;
+    checkpoint.textDelimiter = m_textDelimiter;
+    checkpoint.codec = m_codec;
+    return checkpoint;
+}
+
+// Read next line
+// @output:
+// - QString - line without line ending symbols
+QString RowReader::readLine() {
+    if (m_stats == nullptr) {
+        auto line = m_stream.readLine();
+        if (m_processor != nullptr) { m_processor->preProcessRawLine(line); }
+
+        return line;
+    }
+
+    // QTextStream reads bytes from IO Device while decoding them, so
+    // time of I/O is subtracted from the time of decoding
+    const auto ioNsecs = m_stats->ioNsecs;
+    QString line;
+    {
+        StageTimer stageTimer(timer(&ReadStats::decodeNsecs));
+        line = m_stream.readLine();
+    }
+
+    m_stats->decodeNsecs -= m_stats->ioNsecs - ioNsecs;
+    ++m_stats->lines;
+    ++m_stats->stringAllocations;
+    // Line ending symbols are decoded too
+    m_stats->symbolsDecoded += line.size() + 1;
+
+    if (m_processor != nullptr) { m_processor->preProcessRawLine(line); }
+
+    return line;
+}
+
+// Split line to elements and remove extra symbols from them
+// @input:
+// - line - line of csv-data
+// @output:
+// - QList<QString> - elements of the line
+QList<QString> RowReader::split(const QString& line) {
+    // The first element of a continuation line belongs to the last column
+    // of the current row
+    const auto firstColumn =
+        m_elemInfo.isEnded || m_row.isEmpty() ? 0 : m_row.size() - 1;
+    QList<QString> elements;
+    {
+        StageTimer stageTimer(timer(&ReadStats::splitNsecs));
+        elements = splitElements(
+            line, m_separator, m_textDelimiter, m_elemInfo);
+    }
+
+    if (!m_columnMask.isEmpty()) { dropUnusedColumns(elements, firstColumn); }
+
+    {
+        StageTimer stageTimer(timer(&ReadStats::unescapeNsecs));
+        removeExtraSymbols(elements, m_textDelimiter);
+    }
+
+    if (m_stats != nullptr) { m_stats->stringAllocations += elements.size(); }
+
+    return elements;
+}
+
+// Replace values of columns that are not in the mask with empty strings,
+// so they are not processed and don't hold memory
+// @input:
+// - elements - elements of the line
+// - firstColumn - column of the first element
+void RowReader::dropUnusedColumns(
+    QList<QString>& elements, const qsizetype firstColumn) const
+{
+    for (qsizetype i = 0; i < elements.size(); ++i) {
+        const auto column = firstColumn + i;
+        if (m_columnMask.size() <= column || !m_columnMask.at(column)) {
+            elements[i] = QString();
+        }
+    }
+}
+
+// Return the row to the client
+// @input:
+// - row - list for the elements of the row
+// - elements - elements of the last line of the row
+void RowReader::returnRow(QList<QString>& row, QList<QString>& elements) {
+    if (m_row.isEmpty()) {
+        // These elements constitute the entire row
+        row = std::move(elements);
+    }
+    else {
+        // These elements should be added to the long row
+        if (!elements.isEmpty()) {
+            m_row.last().append(elements.takeFirst());
+            m_row << elements;
+        }
+
+        row = std::move(m_row);
+        m_row.clear();
+    }
+
+    if (m_stats != nullptr) {
+        ++m_stats->rows;
+        m_stats->fields += row.size();
+        if (1 < m_rowLines) { ++m_stats->multiLineRows; }
+    }
+
+    m_rowLines = 0;
+    ++m_rows;
+}
+
+// Split string to elements
+// @input:
+// - line - string with data
+// - separator - string or character that separate elements
+// - textDelimiter - string that is used as text delimiter
+// @output:
+// - QList<QString> - list of elements
+QList<QString> RowReader::splitElements(
+    const QString& line,
+    const QString& separator,
+    const QString& textDelimiter,
+    ElementInfo& elemInfo)
+{
+    // If separator is empty, return whole line. Can't work in this
+    // conditions!
+    if (separator.isEmpty()) {
+        elemInfo.isEnded = true;
+        return (QList<QString>() << line);
+    }
+
+    if (line.isEmpty()) {
+        // If previous row was ended, then return empty QList<QString>.
+        // Otherwise return list that contains one element - new line symbols
+        return elemInfo.isEnded ? QList<QString>() : (QList<QString>() << LF);
+    }
+
+    QList<QString> result;
+    qsizetype pos = 0;
+    while (pos < line.size()) {
+        if (elemInfo.isEnded) {
+            // This line is a new line, not a continuation of the previous
+            // line.
+            // Check if element starts with the delimiter symbol
+            const auto delimiterPos = line.indexOf(textDelimiter, pos);
+            if (delimiterPos == pos) {
+                pos = delimiterPos + textDelimiter.size();
+
+                // Element starts with the delimiter symbol. It means that
+                // this element could contain any number of double
+                // delimiters and separator symbols. This element could:
+                // 1. Be the first or the middle element. Then it should end
+                // with delimiter and the seprator symbols standing next to each
+                // other.
+                const auto midElemEndPos = findMiddleElementPosition(
+                    line, pos, separator, textDelimiter);
+                if (midElemEndPos > 0) {
+                    const auto length = midElemEndPos - pos;
+                    result << line.mid(pos, length);
+                    pos =
+                        midElemEndPos + textDelimiter.size() + separator.size();
+                    continue;
+                }
+
+                // 2. Be The last element on the line. Then it should end with
+                // delimiter symbol.
+                if (isElementLast(line, pos, separator, textDelimiter)) {
+                    const auto length = line.size() - textDelimiter.size() - pos;
+                    result << line.mid(pos, length);
+                    break;
+                }
+
+                // 3. Not ends on this line
+                const auto length = line.size() - pos;
+                result << line.mid(pos, length);
+                elemInfo.isEnded = false;
+                break;
+            }
+            else {
+                // Element do not starts with the delimiter symbol. It means
+                // that this element do not contain double delimiters and it
+                // ends at the next separator symbol.
+                // Check if line contains separator symbol.
+                const auto separatorPos = line.indexOf(separator, pos);
+                if (separatorPos >= 0) {
+                    // If line contains separator symbol, then our element
+                    // located between current position and separator
+                    // position. Copy it into result list and move
+                    // current position over the separator position.
+                    result << line.mid(pos, separatorPos - pos);
+
+                    // Special case: if line ends with separator symbol,
+                    // then at the end of the line we have empty element.
+                    if (separatorPos == line.size() - separator.size()) {
+                        result << QString();
+                    }
+
+                    // Move the current position on to the next element
+                    pos = separatorPos + separator.size();
+                }
+                else {
+                    // If line do not contains separator symbol, then
+                    // this element ends at the end of the string.
+                    // Copy it into result list and exit the loop.
+                    result << line.mid(pos);
+                    break;
+                }
+            }
+        }
+        else
+        {
+            // This line is a continuation of the previous. Last element of the
+            // previous line did not end. It started with delimiter symbol.
+            // It means that this element could contain any number of double
+            // delimiters and separator symbols. This element could:
+            // 1. Ends somewhere in the middle of the line. Then it should ends
+            // with delimiter and the seprator symbols standing next to each
+            // other.
+            const auto midElemEndPos = findMiddleElementPosition(
+                line, pos, separator, textDelimiter);
+            if (midElemEndPos >= 0) {
+                result << (LF + line.mid(pos, midElemEndPos - pos));
+                pos = midElemEndPos + textDelimiter.size() + separator.size();
+                elemInfo.isEnded = true;
+                continue;
+            }
+
+            // 2. Ends at the end of the line. Then it should ends with
+            // delimiter symbol.
+            if (isElementLast(line, pos, separator, textDelimiter)) {
+                const auto length = line.size() - textDelimiter.size() - pos;
+                result << (LF + line.mid(pos, length));
+                elemInfo.isEnded = true;
+                break;
+            }
+
+            // 3. Not ends on this line
+            result << (LF + line);
+            break;
+        }
+    }
+
+    return result;
+}
+
+// Try to find end position of first or middle element
+// @input:
+// - str - string with data
+// - startPos - start position of the current element in the string
+// - separator - string or character that separate elements
+// - textDelimiter - string that is used as text delimiter
+// @output:
+// - qsizetype - end position of the element or -1 if this element is not first
+// or middle
+qsizetype RowReader::findMiddleElementPosition(
+    const QString& str,
+    const qsizetype& startPos,
+    const QString& separator,
+    const QString& txtDelim)
+{
+    const qsizetype ERROR = -1;
+    if (str.isEmpty() ||
+        startPos < 0 ||
+        separator.isEmpty() ||
+        txtDelim.isEmpty())
+    {
+        return ERROR;
+    }
+
+    const auto elemEndSymbols = txtDelim + separator;
+    auto elemEndPos = startPos;
+    while (elemEndPos < str.size()) {
+        // Find position of element end symbol
+        elemEndPos = str.indexOf(elemEndSymbols, elemEndPos);
+        if (elemEndPos < 0) {
+            // This element could not be the middle element, becaise string
+            // do not contains any end symbols
+            return ERROR;
+        }
+
+        // Check that this is really the end symbols of the
+        // element and we don't mix up it with double delimiter
+        // and separator. Calc number of delimiter symbols from elemEndPos
+        // to startPos that stands together.
+        qsizetype numOfDelimiters = 0;
+        for (auto pos = elemEndPos; startPos <= pos; --pos, ++numOfDelimiters) {
+            const auto strRef = str.mid(pos, txtDelim.size());
+            if (QString::compare(strRef, txtDelim) != 0) { break; }
+        }
+
+        // If we have odd number of delimiter symbols that stand together,
+        // then this is the even number of double delimiter symbols + last
+        // delimiter symbol. That means that we have found end position of
+        // the middle element.
+        if (numOfDelimiters % 2 == 1) {
+            return elemEndPos;
+        }
+        else {
+            // Otherwise this is not the end of the middle element and we
+            // should try again
+            elemEndPos += elemEndSymbols.size();
+        }
+    }
+
+    return ERROR;
+}
+
+// Check if current element is the last element
+// @input:
+// - str - string with data
+// - startPos - start position of the current element in the string
+// - separator - string or character that separate elements
+// - textDelimiter - string that is used as text delimiter
+// @output:
+// - bool - True if the current element is the last element of the string,
+// False otherwise
+bool RowReader::isElementLast(
+    const QString& str,
+    const qsizetype startPos,
+    const QString& separator,
+    const QString& txtDelim)
+{
+    if (str.isEmpty() ||
+        startPos < 0 ||
+        separator.isEmpty() ||
+        txtDelim.isEmpty())
+    {
+        return false;
+    }
+
+    // Check if string ends with text delimiter. If not, then this element
+    // do not ends on this line
+    if (!str.endsWith(txtDelim)) { return false; }
+
+    // Check that this is really the end symbols of the
+    // element and we don't mix up it with double delimiter.
+    // Calc number of delimiter symbols from end
+    // to startPos that stands together.
+    qsizetype numOfDelimiters = 0;
+    for (auto pos = str.size() - 1; startPos <= pos; --pos, ++numOfDelimiters) {
+        const auto strRef = str.mid(pos, txtDelim.size());
+        if (QString::compare(strRef, txtDelim) != 0) { break; }
+    }
+
+    // If we have odd number of delimiter symbols that stand together,
+    // then this is the even number of double delimiter symbols + last
+    // delimiter symbol. That means that this element is the last on the line.
+    return numOfDelimiters % 2 == 1;
+}
+
+// Remove extra symbols (spaces, text delimeters...)
+// @input:
+// - elements - list of row elements
+// - textDelimiter - string that is used as text delimiter
+void RowReader::removeExtraSymbols(
+    QList<QString>& elements, const QString& textDelimiter)
+{
+    if (elements.isEmpty()) { return; }
+
+    const auto doubleTextDelim = textDelimiter + textDelimiter;
+    for (auto i = 0; i < elements.size(); ++i) {
+        const auto str = QStringView{elements.at(i)};
+        if (str.isEmpty()) { continue; }
+
+        qsizetype startPos = 0, endPos = str.size() - 1;
+
+        // Find first non-space char
+        for (; startPos < str.size() &&
+               str.at(startPos).category() == QChar::Separator_Space;
+             ++startPos);
+
+        // Find last non-space char
+        for (;
+             endPos >= 0 && str.at(endPos).category() == QChar::Separator_Space;
+             --endPos);
+
+        if (!textDelimiter.isEmpty()) {
+            // Skip text delimiter symbol if element starts with it
+            const auto strStart = str.mid(startPos, textDelimiter.size());
+            if (strStart == textDelimiter) {
+                startPos += textDelimiter.size();
+            }
+
+            // Skip text delimiter symbol if element ends with it
+            const auto strEnd = str.mid(
+                endPos - textDelimiter.size() + 1, textDelimiter.size());
+            if (strEnd == textDelimiter) {
+                endPos -= textDelimiter.size();
+            }
+        }
+
+        if ((0 < startPos || endPos < str.size() - 1) &&
+            startPos <= endPos) {
+            elements[i] = elements[i].mid(startPos, endPos - startPos + 1);
+        }
+
+        // Also replace double text delimiter with one text delimiter symbol
+        elements[i].replace(doubleTextDelim, textDelimiter);
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef QTCSVROWREADER_H
+#define QTCSVROWREADER_H
+
+#include "include/qtcsv/reader.h"
+#include "include/qtcsv/stats.h"
+#include "sources/instrumenteddevice.h"
+#include <QIODevice>
+#include <QList>
+#include <QString>
+#include <QStringConverter>
+#include <QTextStream>
+#include <memory>
+
+namespace QtCSV {
+
+    // ElementInfo is a helper struct that is used as indicator of row end
+    struct ElementInfo {
+        bool isEnded = true;
+    };
+
+    // RowReader is a pull-based csv-parser. It reads csv-formatted data from
+    // IO Device line by line and returns it row by row. Rows that last on
+    // several lines are joined. Reader uses it to pass rows to
+    // AbstractProcessor-based objects, other classes of the library use it
+    // when they need to read rows on demand.
+    //
+    // IO Device should be open for reading. Separator should not be empty.
+    // If ReadStats object is passed, RowReader collects statistics of
+    // reading to it.
+    class RowReader {
+        std::unique_ptr<InstrumentedDevice> m_device;
+        QTextStream m_stream;
+        const QString m_separator;
+        const QString m_textDelimiter;
+        Reader::AbstractProcessor* m_processor;
+        ReadStats* m_stats;
+        ElementInfo m_elemInfo;
+        QList<QString> m_row;
+        // Number of lines of the current row
+        qint64 m_rowLines;
+        // Number of returned rows including rows before the start position
+        qint64 m_rows;
+        // Position of IO Device at the start of reading
+        const qint64 m_startPos;
+        // Codec of the data with explicit byte order
+        const QStringConverter::Encoding m_codec;
+        // Columns that are returned to the client. Empty list means all
+        // columns.
+        QList<bool> m_columnMask;
+
+    public:
+        RowReader(
+            QIODevice& ioDevice,
+            const QString& separator,
+            const QString& textDelimiter,
+            QStringConverter::Encoding codec,
+            Reader::AbstractProcessor* processor = nullptr,
+            ReadStats* stats = nullptr);
+
+        RowReader(const RowReader&) = delete;
+        RowReader& operator=(const RowReader&) = delete;
+
+        // Read next row
+        bool readRow(QList<QString>& row);
+        // Get checkpoint after the last returned row
+        ReadCheckpoint checkpoint() const;
+        // Set number of rows before the start position of IO Device
+        void setRowsBefore(qint64 rows) { m_rows = rows; }
+        // Set columns which values are returned. Values of other columns
+        // are returned as empty strings without processing.
+        void setColumnMask(const QList<bool>& mask) { m_columnMask = mask; }
+
+    private:
+        // Read next line
+        QString readLine();
+        // Split line to elements and remove extra symbols from them
+        QList<QString> split(const QString& line);
+        // Replace values of columns that are not in the mask with empty
+        // strings
+        void dropUnusedColumns(
+            QList<QString>& elements, qsizetype firstColumn) const;
+        // Return the row to the client
+        void returnRow(QList<QString>& row, QList<QString>& elements);
+        // Get pointer to the timer of the stage if timings are collected
+        qint64* timer(qint64 ReadStats::* stage) const {
+            return m_stats != nullptr && m_stats->timings ?
+                &(m_stats->*stage) : nullptr;
+        }
+
+        // Get codec with byte order that is used for the data
+        static QStringConverter::Encoding streamCodec(
+            QIODevice& ioDevice, QStringConverter::Encoding codec);
+
+        // Split string to elements
+        static QList<QString> splitElements(
+           const QString& line,
+           const QString& separator,
+           const QString& textDelimiter,
+           ElementInfo& elemInfo);
+
+        // Try to find end position of first or middle element
+        static qsizetype findMiddleElementPosition(
+            const QString& str,
+            const qsizetype& startPos,
+            const QString& separator,
+            const QString& txtDelim);
+
+        // Check if current element is the last element
+        static bool isElementLast(
+            const QString& str,
+            const qsizetype startPos,
+            const QString& separator,
+            const QString& txtDelim);
+
+        // Remove extra symbols (spaces, text delimeters...)
+        static void removeExtraSymbols(
+            QList<QString>& elements, const QString& textDelimiter);
+    };
+}
+
+#endif // QTCSVROWREADER_H
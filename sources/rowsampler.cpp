@@ -0,0 +1,386 @@
+#include "include/qtcsv/rowsampler.h"
+#include "sources/rowbatches.h"
+#include <QDebug>
+#include <QRandomGenerator>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+
+using namespace QtCSV;
+
+// Position of a sampled row in the file
+struct SampledRow {
+    qint64 begin = 0;
+    qint64 end = 0;
+};
+
+namespace QtCSV {
+
+class RowSamplerPrivate {
+public:
+    // Size of data that is scanned for row ends at once
+    static const qint64 SCAN_SIZE = 4 * 1024 * 1024;
+    // Max size of data after random position that is searched for a row
+    static const qint64 SYNC_SIZE = 1024 * 1024;
+    // Max number of line ends after random position that are checked
+    static const int SYNC_CANDIDATES = 64;
+    // Number of rows that should have the expected number of values after
+    // the line end to take it as a row end
+    static const int CHECK_ROWS = 2;
+    // Max number of random positions per sampled row
+    static const int MAX_ATTEMPTS = 10;
+    // Skip of rows that means that no more rows are sampled
+    static const qint64 MAX_SKIP = 1000000000000000000;
+
+    RowSampler::Method method = RowSampler::Method::RESERVOIR;
+    quint32 seed = QRandomGenerator::global()->generate();
+    bool hasHeader = false;
+    QList<QString> header;
+    qint64 rowCount = -1;
+
+    // Memory-mapped file that is sampled
+    const char* data = nullptr;
+    qint64 size = 0;
+    // Position of the first data row
+    qint64 dataStart = 0;
+    QStringConverter::Encoding codec = QStringConverter::Utf8;
+    QString separator;
+    QString textDelimiter;
+    // Number of values in the first row of the file
+    qsizetype columnCount = 0;
+
+    // Sample rows of the file and add them to the data
+    bool sampleFile(const QString& filePath, qint64 count, AbstractData& out);
+    // Sample rows in one pass over the file
+    void sampleReservoir(qint64 count, QList<SampledRow>& rows);
+    // Sample rows at random positions
+    void sampleOffsets(qint64 count, QList<SampledRow>& rows);
+    // Find row that starts after the position
+    bool syncRow(qint64 position, SampledRow& row) const;
+    // Find ends of rows that start at the position
+    QList<qint64> rowEnds(qint64 start, qint64 limit, int count) const;
+    // Parse row of the file
+    QList<QString> parseRow(qint64 begin, qint64 end) const;
+};
+
+}
+
+// Sample rows of the file and add them to the data
+// @input:
+// - filePath - string with absolute path to csv-file
+// - count - number of rows in the sample
+// - out - container for the sampled rows
+// @output:
+// - bool - True if file was sampled, False otherwise
+bool RowSamplerPrivate::sampleFile(
+    const QString& filePath, const qint64 count, AbstractData& out)
+{
+    MappedCsvFile file(filePath);
+    if (!file.open(codec, separator, textDelimiter, SCAN_SIZE)) {
+        return false;
+    }
+
+    size = file.size();
+    if (size == 0) {
+        rowCount = method == RowSampler::Method::RESERVOIR ? 0 : -1;
+        return true;
+    }
+
+    data = file.data();
+    codec = file.codec();
+
+    // The first row gives the number of values of rows
+    const auto bomSize = file.bomSize();
+    qint64 firstBegin = 0, firstEnd = size;
+    file.nextRow(firstBegin, firstEnd);
+    const auto values = parseRow(bomSize, firstEnd);
+    columnCount = values.size();
+    dataStart = bomSize;
+    if (hasHeader) {
+        header = values;
+        dataStart = firstEnd;
+    }
+
+    QList<SampledRow> rows;
+    switch (method) {
+        case RowSampler::Method::RESERVOIR:
+            sampleReservoir(count, rows);
+            break;
+        case RowSampler::Method::OFFSETS:
+            sampleOffsets(count, rows);
+            break;
+    }
+
+    std::sort(rows.begin(), rows.end(),
+              [](const SampledRow& a, const SampledRow& b) {
+                  return a.begin < b.begin;
+              });
+
+    for (const auto& row : rows) { out.addRow(parseRow(row.begin, row.end)); }
+
+    data = nullptr;
+    return true;
+}
+
+// Sample rows in one pass over the file. Rows are selected by reservoir
+// sampling with geometric skips (Li's "Algorithm L"), so random numbers
+// are generated only for rows that get into the sample.
+// @input:
+// - count - number of rows in the sample
+// - rows - list for the sampled rows
+void RowSamplerPrivate::sampleReservoir(
+    const qint64 count, QList<SampledRow>& rows)
+{
+    QRandomGenerator random(seed);
+    // Random number in (0, 1]
+    auto uniform = [&random]() { return 1.0 - random.generateDouble(); };
+    // Number of rows to skip before the next replaced row
+    auto skip = [&uniform](const double weight) -> qint64 {
+        const auto value =
+            std::floor(std::log(uniform()) / std::log(1.0 - weight));
+        // Value is infinite or not a number if weight is too small
+        return 0.0 <= value && value < static_cast<double>(MAX_SKIP) ?
+            static_cast<qint64>(value) : MAX_SKIP;
+    };
+
+    // Without sample rows are only counted
+    auto weight = 0 < count ? std::exp(std::log(uniform()) / count) : 0.0;
+    auto next = 0 < count ? count + skip(weight) : MAX_SKIP;
+
+    RowIndexer indexer(
+        data, size, dataStart, codec, separator, textDelimiter);
+    QList<qint64> ends;
+    qint64 row = 0;
+    qint64 rowStart = dataStart;
+    while (!indexer.atEnd()) {
+        ends.clear();
+        indexer.scan(SCAN_SIZE, ends);
+        for (const auto end : ends) {
+            if (row < count) {
+                rows << SampledRow{rowStart, end};
+            }
+            else if (row == next) {
+                const auto index = qMin<qint64>(
+                    count - 1,
+                    static_cast<qint64>(random.generateDouble() * count));
+                rows[index] = SampledRow{rowStart, end};
+                weight *= std::exp(std::log(uniform()) / count);
+                next += skip(weight) + 1;
+            }
+
+            rowStart = end;
+            ++row;
+        }
+    }
+
+    rowCount = row;
+}
+
+// Sample rows at random positions of the file. Row after the position is
+// sampled; if position is inside of the last row, the first row is
+// sampled. Same row is not sampled twice.
+// @input:
+// - count - number of rows in the sample
+// - rows - list for the sampled rows. It could have fewer rows than count
+// if file has not many more rows than count.
+void RowSamplerPrivate::sampleOffsets(
+    const qint64 count, QList<SampledRow>& rows)
+{
+    rowCount = -1;
+    const auto span = size - dataStart;
+    if (span <= 0) { return; }
+
+    QRandomGenerator random(seed);
+    QSet<qint64> starts;
+    for (qint64 attempt = 0;
+         rows.size() < count && attempt < count * MAX_ATTEMPTS; ++attempt)
+    {
+        const auto position = dataStart + qMin<qint64>(
+            span - 1, static_cast<qint64>(random.generateDouble() * span));
+        SampledRow row;
+        if (!syncRow(position, row) || starts.contains(row.begin)) {
+            continue;
+        }
+
+        starts.insert(row.begin);
+        rows << row;
+    }
+}
+
+// Find row that starts after the position. Line end could be inside of a
+// quoted value, so row after line end is taken only if it and the next
+// rows have the same number of values as the first row of the file. If
+// there is no such row, row after the first line end is taken.
+// @input:
+// - position - random position in the file
+// - row - found row
+// @output:
+// - bool - True if row was found, False otherwise
+bool RowSamplerPrivate::syncRow(const qint64 position, SampledRow& row) const
+{
+    // Symbols start at multiples of the code unit size
+    const auto unit = RowIndexer::unitSize(codec);
+    auto pos = dataStart + (position - dataStart) / unit * unit;
+    const auto limit = qMin(size, pos + SYNC_SIZE);
+    const RowIndexer lineEnds(
+        data, size, dataStart, codec, separator, textDelimiter);
+    qint64 first = -1;
+    for (auto candidates = 0; pos < limit && candidates < SYNC_CANDIDATES;) {
+        const auto lineEndSize = lineEnds.lineEnd(pos);
+        if (lineEndSize == 0) {
+            pos += unit;
+            continue;
+        }
+
+        pos += lineEndSize;
+        if (size <= pos) { break; }
+
+        ++candidates;
+        const auto checkLimit = qMin(size, pos + SYNC_SIZE);
+        const auto ends = rowEnds(pos, checkLimit, CHECK_ROWS);
+        auto isRowStart = !ends.isEmpty();
+        auto begin = pos;
+        for (const auto end : ends) {
+            if (parseRow(begin, end).size() != columnCount) {
+                isRowStart = false;
+                break;
+            }
+
+            begin = end;
+        }
+
+        if (isRowStart) {
+            row = SampledRow{pos, ends.first()};
+            return true;
+        }
+
+        if (first < 0) { first = pos; }
+    }
+
+    // Position is inside of the last row
+    const auto start = 0 <= first ? first : (size <= pos ? dataStart : -1);
+    if (start < 0) { return false; }
+
+    const auto ends = rowEnds(start, size, 1);
+    if (ends.isEmpty()) { return false; }
+
+    row = SampledRow{start, ends.first()};
+    return true;
+}
+
+// Find ends of rows that start at the position
+// @input:
+// - start - position of the first row
+// - limit - position where data is cut. Row that is cut is not returned.
+// - count - max number of rows
+// @output:
+// - QList<qint64> - end positions of the rows
+QList<qint64> RowSamplerPrivate::rowEnds(
+    const qint64 start, const qint64 limit, const int count) const
+{
+    RowIndexer indexer(data, limit, start, codec, separator, textDelimiter);
+    QList<qint64> ends;
+    while (ends.size() < count && !indexer.atEnd()) {
+        indexer.scan(64 * 1024, ends);
+    }
+
+    if (limit < size && !ends.isEmpty() && ends.last() == limit) {
+        ends.removeLast();
+    }
+
+    if (count < ends.size()) { ends.resize(count); }
+
+    return ends;
+}
+
+// Parse row of the file
+// @input:
+// - begin - position of the row
+// - end - end position of the row
+// @output:
+// - QList<QString> - values of the row
+QList<QString> RowSamplerPrivate::parseRow(
+    const qint64 begin, const qint64 end) const
+{
+    return RowIndexer::parseRow(
+        data, begin, end, separator, textDelimiter, codec);
+}
+
+RowSampler::RowSampler() : d(std::make_unique<RowSamplerPrivate>()) {}
+
+RowSampler::~RowSampler() = default;
+
+// Set method of sampling
+void RowSampler::setMethod(const Method method) {
+    d->method = method;
+}
+
+// Set seed of random numbers. Samples of the same file with the same seed
+// are equal.
+void RowSampler::setSeed(const quint32 seed) {
+    d->seed = seed;
+}
+
+// Get seed of random numbers
+quint32 RowSampler::seed() const {
+    return d->seed;
+}
+
+// Set if the first row of the file is a header
+void RowSampler::setHasHeader(const bool hasHeader) {
+    d->hasHeader = hasHeader;
+}
+
+// Add random sample of rows of the csv-file to the data
+// @input:
+// - filePath - string with absolute path to csv-file
+// - count - number of rows in the sample. Must not be negative.
+// - data - AbstractData object where sampled rows will be added in the
+// order of the file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of the file. Byte order mark at the beginning of the
+// file overrides it.
+// @output:
+// - bool - True if file was sampled, False otherwise
+bool RowSampler::sample(
+    const QString& filePath,
+    const qint64 count,
+    AbstractData& data,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    d->header.clear();
+    d->rowCount = -1;
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (count < 0) {
+        qDebug() << __FUNCTION__ << "Error - invalid number of rows:" <<
+            count;
+        return false;
+    }
+
+    d->separator = separator;
+    d->textDelimiter = textDelimiter;
+    d->codec = codec;
+    return d->sampleFile(filePath, count, data);
+}
+
+// Get values of the header read by the last sample
+// @output:
+// - QList<QString> - values of the header. List is empty if file has no
+// header.
+QList<QString> RowSampler::header() const {
+    return d->header;
+}
+
+// Get number of rows of the file that was counted by the last sample
+// @output:
+// - qint64 - number of rows without header or -1 if rows were not counted
+qint64 RowSampler::rowCount() const {
+    return d->rowCount;
+}
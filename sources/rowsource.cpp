@@ -0,0 +1,39 @@
+#include "include/qtcsv/rowsource.h"
+
+using namespace QtCSV;
+
+// Constructor of DataRowSource
+// @input:
+// - data - AbstractData object. It must be alive while the source is used.
+DataRowSource::DataRowSource(const AbstractData& data) :
+    m_data(data), m_row(0)
+{}
+
+// Get values of the next row of the container
+// @input:
+// - values - list for the values of the next row
+// @output:
+// - bool - True if values were returned, False if all rows were returned
+bool DataRowSource::nextRow(QList<QString>& values) {
+    if (m_data.rowCount() <= m_row) { return false; }
+
+    values = m_data.rowValues(m_row);
+    ++m_row;
+    return true;
+}
+
+// Constructor of FunctionRowSource
+// @input:
+// - function - callable object that returns rows
+FunctionRowSource::FunctionRowSource(Function function) :
+    m_function(std::move(function))
+{}
+
+// Get values of the next row from the function
+// @input:
+// - values - list for the values of the next row
+// @output:
+// - bool - True if values were returned, False if there are no more rows
+bool FunctionRowSource::nextRow(QList<QString>& values) {
+    return m_function ? m_function(values) : false;
+}
@@ -0,0 +1,251 @@
+#include "include/qtcsv/schema.h"
+#include "include/qtcsv/numberconverter.h"
+
+using namespace QtCSV;
+
+// Add column description
+// @input:
+// - name - name of the column in the header
+// - type - type of values
+// - nullable - if True, empty values are null, otherwise they are errors
+// - defaultValue - value that replaces empty values
+// @output:
+// - Schema& - reference to this schema
+Schema& Schema::addColumn(
+    const QString& name,
+    const Type type,
+    const bool nullable,
+    const QVariant& defaultValue)
+{
+    Column column;
+    column.name = name;
+    column.type = type;
+    column.nullable = nullable;
+    column.defaultValue = defaultValue;
+    m_columns << column;
+    return *this;
+}
+
+// Get descriptions of columns
+// @output:
+// - QList<Column> - columns in the order of adding
+const QList<Schema::Column>& Schema::columns() const {
+    return m_columns;
+}
+
+// Get number of columns
+// @output:
+// - qsizetype - number of columns
+qsizetype Schema::columnCount() const {
+    return m_columns.size();
+}
+
+// Check if schema has no columns
+// @output:
+// - bool - True if there are no columns, False otherwise
+bool Schema::isEmpty() const {
+    return m_columns.isEmpty();
+}
+
+// Set symbol that separates integral and fractional parts of numbers
+// @input:
+// - separator - decimal separator symbol
+void Schema::setDecimalSeparator(const QChar separator) {
+    m_decimalSeparator = separator;
+}
+
+// Get symbol that separates integral and fractional parts of numbers
+// @output:
+// - QChar - decimal separator symbol
+QChar Schema::decimalSeparator() const {
+    return m_decimalSeparator;
+}
+
+// Get number of values
+// @output:
+// - qsizetype - number of values
+qsizetype TypedRow::size() const {
+    return m_values.size();
+}
+
+// Get index of the column by its name
+// @input:
+// - name - name of the column
+// @output:
+// - qsizetype - index of the column or -1 if there is no such column
+qsizetype TypedRow::indexOf(const QString& name) const {
+    return m_indexes == nullptr ? -1 : m_indexes->value(name, -1);
+}
+
+// Get type of the value
+// @input:
+// - column - index of the value
+// @output:
+// - Schema::Type - type of the column. STRING for absent columns.
+Schema::Type TypedRow::type(const qsizetype column) const {
+    const auto value = at(column);
+    return value == nullptr ? Schema::Type::STRING : value->type;
+}
+
+// Check if value is null
+// @input:
+// - column - index of the value
+// @output:
+// - bool - True if value is empty or absent, False otherwise
+bool TypedRow::isNull(const qsizetype column) const {
+    const auto value = at(column);
+    return value == nullptr || value->isNull;
+}
+
+bool TypedRow::isNull(const QString& name) const {
+    return isNull(indexOf(name));
+}
+
+// Get value as integer
+// @input:
+// - column - index of the value
+// @output:
+// - qint64 - value. Floating point numbers are truncated, strings are
+// converted if they contain integers.
+qint64 TypedRow::toLongLong(const qsizetype column) const {
+    const auto value = at(column);
+    if (value == nullptr || value->isNull) { return 0; }
+
+    switch (value->type) {
+    case Schema::Type::INTEGER:
+    case Schema::Type::BOOL:
+        return value->integer;
+    case Schema::Type::DOUBLE:
+        return static_cast<qint64>(value->real);
+    case Schema::Type::STRING:
+        return NumberConverter::toLongLong(value->string);
+    }
+
+    return 0;
+}
+
+qint64 TypedRow::toLongLong(const QString& name) const {
+    return toLongLong(indexOf(name));
+}
+
+// Get value as floating point number
+// @input:
+// - column - index of the value
+// @output:
+// - double - value. Strings are converted if they contain numbers.
+double TypedRow::toDouble(const qsizetype column) const {
+    const auto value = at(column);
+    if (value == nullptr || value->isNull) { return 0.0; }
+
+    switch (value->type) {
+    case Schema::Type::INTEGER:
+    case Schema::Type::BOOL:
+        return static_cast<double>(value->integer);
+    case Schema::Type::DOUBLE:
+        return value->real;
+    case Schema::Type::STRING:
+        return NumberConverter::toDouble(value->string);
+    }
+
+    return 0.0;
+}
+
+double TypedRow::toDouble(const QString& name) const {
+    return toDouble(indexOf(name));
+}
+
+// Get value as boolean
+// @input:
+// - column - index of the value
+// @output:
+// - bool - value. Numbers are True if they are not zero, strings are True
+// if they are "true" or "1".
+bool TypedRow::toBool(const qsizetype column) const {
+    const auto value = at(column);
+    if (value == nullptr || value->isNull) { return false; }
+
+    switch (value->type) {
+    case Schema::Type::INTEGER:
+    case Schema::Type::BOOL:
+        return value->integer != 0;
+    case Schema::Type::DOUBLE:
+        return value->real != 0.0;
+    case Schema::Type::STRING:
+        return value->string == QLatin1String("1") ||
+            value->string.compare(
+                QLatin1String("true"), Qt::CaseInsensitive) == 0;
+    }
+
+    return false;
+}
+
+bool TypedRow::toBool(const QString& name) const {
+    return toBool(indexOf(name));
+}
+
+// Get value as string
+// @input:
+// - column - index of the value
+// @output:
+// - QString - value. Numbers are converted with NumberConverter, booleans
+// are "true" or "false".
+QString TypedRow::toString(const qsizetype column) const {
+    const auto value = at(column);
+    if (value == nullptr || value->isNull) { return QString(); }
+
+    switch (value->type) {
+    case Schema::Type::INTEGER:
+        return NumberConverter::toString(value->integer);
+    case Schema::Type::DOUBLE:
+        return NumberConverter::toString(value->real);
+    case Schema::Type::BOOL:
+        return value->integer != 0 ? QString("true") : QString("false");
+    case Schema::Type::STRING:
+        return value->string;
+    }
+
+    return QString();
+}
+
+QString TypedRow::toString(const QString& name) const {
+    return toString(indexOf(name));
+}
+
+// Get value as QVariant
+// @input:
+// - column - index of the value
+// @output:
+// - QVariant - qlonglong, double, bool or QString according to the type of
+// the column. Null and absent values are returned as invalid QVariant.
+QVariant TypedRow::value(const qsizetype column) const {
+    const auto value = at(column);
+    if (value == nullptr || value->isNull) { return QVariant(); }
+
+    switch (value->type) {
+    case Schema::Type::INTEGER:
+        return QVariant(static_cast<qlonglong>(value->integer));
+    case Schema::Type::DOUBLE:
+        return QVariant(value->real);
+    case Schema::Type::BOOL:
+        return QVariant(value->integer != 0);
+    case Schema::Type::STRING:
+        return QVariant(value->string);
+    }
+
+    return QVariant();
+}
+
+QVariant TypedRow::value(const QString& name) const {
+    return value(indexOf(name));
+}
+
+// Get value by index
+// @input:
+// - column - index of the value
+// @output:
+// - Value* - pointer to the value or nullptr if index is out of range
+const TypedRow::Value* TypedRow::at(const qsizetype column) const {
+    if (column < 0 || m_values.size() <= column) { return nullptr; }
+
+    return &m_values.at(column);
+}
@@ -0,0 +1,433 @@
+#include "include/qtcsv/sniffer.h"
+#include "include/qtcsv/numberconverter.h"
+#include "sources/filechecker.h"
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QStringDecoder>
+
+using namespace QtCSV;
+
+class SnifferPrivate {
+public:
+    // Candidates for separator in order of preference
+    static const QList<QChar> SEPARATORS;
+    // Number of bytes that are used to detect UTF-16 without BOM
+    static constexpr qsizetype UTF16_SAMPLE_SIZE = 1024;
+    // Maximum number of rows that are used to detect header
+    static constexpr qsizetype HEADER_SAMPLE_ROWS = 100;
+
+    // Detect encoding of the sample
+    static qsizetype detectEncoding(const QByteArray& sample, Dialect& dialect);
+    // Detect the most frequent line ending
+    static QString detectLineEnding(const QString& text);
+    // Detect text delimiter for the separator
+    static QString detectTextDelimiter(const QString& text, QChar separator);
+    // Split text to rows of values
+    static QList<QList<QString>> parse(
+        const QString& text,
+        QChar separator,
+        const QString& textDelimiter,
+        bool isComplete);
+    // Get consistency of number of values in rows
+    static double consistency(
+        const QList<QList<QString>>& rows, qsizetype& columns);
+    // Check if the first row looks like a header
+    static bool detectHeader(const QList<QList<QString>>& rows);
+};
+
+const QList<QChar> SnifferPrivate::SEPARATORS = {
+    QChar(','), QChar(';'), QChar('\t'), QChar('|')};
+
+// Detect encoding of the sample
+// @input:
+// - sample - bytes from the beginning of csv-data
+// - dialect - dialect which codec and hasBom fields will be set
+// @output:
+// - qsizetype - size of byte order mark in bytes
+qsizetype SnifferPrivate::detectEncoding(
+    const QByteArray& sample, Dialect& dialect)
+{
+    const auto bomEncoding = QStringConverter::encodingForData(sample);
+    if (bomEncoding) {
+        dialect.codec = *bomEncoding;
+        dialect.hasBom = true;
+        switch (dialect.codec) {
+        case QStringConverter::Utf8:
+            return 3;
+        case QStringConverter::Utf16:
+        case QStringConverter::Utf16LE:
+        case QStringConverter::Utf16BE:
+            return 2;
+        case QStringConverter::Utf32:
+        case QStringConverter::Utf32LE:
+        case QStringConverter::Utf32BE:
+            return 4;
+        case QStringConverter::Latin1:
+        case QStringConverter::System:
+            return 0;
+        }
+
+        return 0;
+    }
+
+    // Text of ASCII symbols in UTF-16 has zero byte in every pair of bytes
+    const auto pairs = qMin(sample.size(), UTF16_SAMPLE_SIZE) / 2;
+    qsizetype evenZeros = 0;
+    qsizetype oddZeros = 0;
+    for (qsizetype i = 0; i < pairs; ++i) {
+        if (sample.at(2 * i) == 0) { ++evenZeros; }
+        if (sample.at(2 * i + 1) == 0) { ++oddZeros; }
+    }
+
+    if (0 < pairs && pairs / 2 < oddZeros && evenZeros <= pairs / 10) {
+        dialect.codec = QStringConverter::Utf16LE;
+        return 0;
+    }
+
+    if (0 < pairs && pairs / 2 < evenZeros && oddZeros <= pairs / 10) {
+        dialect.codec = QStringConverter::Utf16BE;
+        return 0;
+    }
+
+    // Incomplete symbol at the end of the sample is not an error
+    QStringDecoder decoder(QStringConverter::Utf8);
+    decoder.decode(sample);
+    dialect.codec = decoder.hasError() ?
+        QStringConverter::Latin1 : QStringConverter::Utf8;
+    return 0;
+}
+
+// Detect the most frequent line ending
+// @input:
+// - text - decoded sample
+// @output:
+// - QString - "\n", "\r\n" or "\r"
+QString SnifferPrivate::detectLineEnding(const QString& text) {
+    qsizetype lf = 0;
+    qsizetype crlf = 0;
+    qsizetype cr = 0;
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        if (text.at(i) == QChar('\n')) {
+            ++lf;
+        }
+        else if (text.at(i) == QChar('\r')) {
+            if (i + 1 < text.size() && text.at(i + 1) == QChar('\n')) {
+                ++crlf;
+                ++i;
+            }
+            else {
+                ++cr;
+            }
+        }
+    }
+
+    if (lf < crlf && cr <= crlf) { return QString("\r\n"); }
+    if (lf < cr && crlf < cr) { return QString("\r"); }
+
+    return QString("\n");
+}
+
+// Detect text delimiter for the separator. Quote symbols are counted only
+// at the beginning and at the end of values.
+// @input:
+// - text - decoded sample
+// - separator - candidate for separator
+// @output:
+// - QString - double quote, quote or empty string if there are quote
+// symbols in the text but they don't enclose values
+QString SnifferPrivate::detectTextDelimiter(
+    const QString& text, const QChar separator)
+{
+    const auto isBoundary = [&text, separator](const qsizetype i) {
+        if (i < 0 || text.size() <= i) { return true; }
+
+        const auto symbol = text.at(i);
+        return symbol == separator || symbol == QChar('\n') ||
+            symbol == QChar('\r');
+    };
+
+    QString result("\"");
+    qsizetype bestCount = 0;
+    auto hasQuotes = false;
+    for (const auto quote : {QChar('"'), QChar('\'')}) {
+        qsizetype count = 0;
+        for (qsizetype i = 0; i < text.size(); ++i) {
+            if (text.at(i) != quote) { continue; }
+
+            if (quote == QChar('"')) { hasQuotes = true; }
+            if (isBoundary(i - 1) || isBoundary(i + 1)) { ++count; }
+        }
+
+        if (bestCount < count) {
+            bestCount = count;
+            result = QString(quote);
+        }
+    }
+
+    // Double quotes inside of values mean that values are not enclosed
+    if (0 == bestCount && hasQuotes) { return QString(); }
+
+    return result;
+}
+
+// Split text to rows of values. Empty lines are skipped.
+// @input:
+// - text - decoded sample
+// - separator - candidate for separator
+// - textDelimiter - candidate for text delimiter
+// - isComplete - if False, the last line is dropped
+// @output:
+// - QList<QList<QString>> - rows of values
+QList<QList<QString>> SnifferPrivate::parse(
+    const QString& text,
+    const QChar separator,
+    const QString& textDelimiter,
+    const bool isComplete)
+{
+    const auto quote = textDelimiter.isEmpty() ? QChar() : textDelimiter.at(0);
+    QList<QList<QString>> rows;
+    QList<QString> row;
+    QString value;
+    auto inQuotes = false;
+    const auto addRow = [&rows, &row, &value]() {
+        if (!row.isEmpty() || !value.isEmpty()) {
+            row << value;
+            rows << row;
+        }
+
+        row.clear();
+        value.clear();
+    };
+
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        const auto symbol = text.at(i);
+        if (inQuotes) {
+            if (symbol != quote) {
+                value.append(symbol);
+            }
+            else if (i + 1 < text.size() && text.at(i + 1) == quote) {
+                value.append(symbol);
+                ++i;
+            }
+            else {
+                inQuotes = false;
+            }
+        }
+        else if (!quote.isNull() && symbol == quote) {
+            inQuotes = true;
+        }
+        else if (symbol == separator) {
+            row << value;
+            value.clear();
+        }
+        else if (symbol == QChar('\n')) {
+            // Symbol CR of CRLF line ending is not a part of the value
+            if (0 < i && text.at(i - 1) == QChar('\r')) { value.chop(1); }
+
+            addRow();
+        }
+        else {
+            value.append(symbol);
+        }
+    }
+
+    if (isComplete) { addRow(); }
+
+    return rows;
+}
+
+// Get consistency of number of values in rows
+// @input:
+// - rows - rows of values
+// - columns - variable for the most frequent number of values
+// @output:
+// - double - part of rows that have the most frequent number of values
+double SnifferPrivate::consistency(
+    const QList<QList<QString>>& rows, qsizetype& columns)
+{
+    columns = 0;
+    if (rows.isEmpty()) { return 0.0; }
+
+    QHash<qsizetype, qsizetype> frequencies;
+    qsizetype maxFrequency = 0;
+    for (const auto& row : rows) {
+        const auto frequency = ++frequencies[row.size()];
+        if (maxFrequency < frequency ||
+            (maxFrequency == frequency && columns < row.size()))
+        {
+            maxFrequency = frequency;
+            columns = row.size();
+        }
+    }
+
+    return static_cast<double>(maxFrequency) / rows.size();
+}
+
+// Check if the first row looks like a header. Each column votes for the
+// header if its values in other rows are numbers or have the same length,
+// and the value in the first row is not a number or has other length.
+// @input:
+// - rows - rows of values
+// @output:
+// - bool - True if the first row looks like a header
+bool SnifferPrivate::detectHeader(const QList<QList<QString>>& rows) {
+    if (rows.size() < 2) { return false; }
+
+    const auto& header = rows.first();
+    const auto last = qMin(rows.size(), HEADER_SAMPLE_ROWS + 1);
+    qsizetype votes = 0;
+    for (qsizetype column = 0; column < header.size(); ++column) {
+        auto hasValues = false;
+        auto isNumeric = true;
+        qsizetype length = -1;
+        for (qsizetype i = 1; i < last; ++i) {
+            const auto& row = rows.at(i);
+            if (row.size() != header.size()) { continue; }
+
+            const auto& value = row.at(column);
+            if (!hasValues) { length = value.size(); }
+            if (length != value.size()) { length = -1; }
+
+            hasValues = true;
+            if (!value.isEmpty() && !NumberConverter::toNumber(value).isValid())
+            {
+                isNumeric = false;
+            }
+        }
+
+        if (!hasValues) { continue; }
+
+        const auto& name = header.at(column);
+        if (isNumeric) {
+            votes += NumberConverter::toNumber(name).isValid() ? -1 : 1;
+        }
+        else if (0 <= length) {
+            votes += name.size() != length ? 1 : -1;
+        }
+    }
+
+    return 0 < votes;
+}
+
+// Detect dialect of csv-file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - dialect - object for the detected dialect
+// - sampleSize - size (in bytes) of the sample from the beginning of the
+// file
+// @output:
+// - bool - True if dialect was detected, False if file could not be read
+// or is empty
+bool Sniffer::sniff(
+    const QString& filePath, Dialect& dialect, const qint64 sampleSize)
+{
+    if (!CheckFile(filePath, true)) {
+        qDebug() << __FUNCTION__ << "Error - wrong file path:" << filePath;
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    return sniff(file, dialect, sampleSize);
+}
+
+// Detect dialect of csv-data in IO Device. Data is not consumed.
+// @input:
+// - ioDevice - IO Device with csv-data
+// - dialect - object for the detected dialect
+// - sampleSize - size (in bytes) of the sample from the current position
+// of IO Device
+// @output:
+// - bool - True if dialect was detected, False if IO Device could not be
+// read or is empty
+bool Sniffer::sniff(
+    QIODevice& ioDevice, Dialect& dialect, const qint64 sampleSize)
+{
+    // Open IO Device if it was not opened
+    if (!ioDevice.isOpen() && !ioDevice.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
+        return false;
+    }
+
+    const auto sample = ioDevice.peek(sampleSize);
+    const auto isComplete = ioDevice.isSequential() ?
+        sample.size() < sampleSize :
+        ioDevice.size() - ioDevice.pos() <= sample.size();
+
+    return sniff(sample, dialect, isComplete);
+}
+
+// Detect dialect of the sample of csv-data
+// @input:
+// - sample - bytes from the beginning of csv-data
+// - dialect - object for the detected dialect
+// - isComplete - True if sample contains all data, False if the last line
+// of the sample could be incomplete
+// @output:
+// - bool - True if dialect was detected, False if sample is empty or has
+// unsupported line ending CR
+bool Sniffer::sniff(
+    const QByteArray& sample, Dialect& dialect, const bool isComplete)
+{
+    dialect = Dialect();
+    const auto bomSize = SnifferPrivate::detectEncoding(sample, dialect);
+    if (sample.size() <= bomSize) {
+        qDebug() << __FUNCTION__ << "Error - sample is empty";
+        return false;
+    }
+
+    QStringDecoder decoder(dialect.codec);
+    const auto text = decoder.decode(QByteArrayView(sample).mid(bomSize));
+    dialect.lineEnding = SnifferPrivate::detectLineEnding(text);
+    if (dialect.lineEnding == QString("\r")) {
+        qDebug() << __FUNCTION__ << "Error - line ending CR is not supported";
+        return false;
+    }
+
+    // Choose separator that gives the most consistent number of values
+    double bestConsistency = 0.0;
+    qsizetype bestColumns = 0;
+    QList<QList<QString>> bestRows;
+    for (const auto separator : SnifferPrivate::SEPARATORS) {
+        const auto textDelimiter =
+            SnifferPrivate::detectTextDelimiter(text, separator);
+        auto rows = SnifferPrivate::parse(
+            text, separator, textDelimiter, isComplete);
+
+        // Sample could contain only a part of the first line
+        if (rows.isEmpty()) {
+            rows = SnifferPrivate::parse(text, separator, textDelimiter, true);
+        }
+
+        qsizetype columns = 0;
+        const auto consistency = SnifferPrivate::consistency(rows, columns);
+        if (columns < 2) { continue; }
+
+        if (bestConsistency < consistency ||
+            (bestConsistency == consistency && bestColumns < columns))
+        {
+            bestConsistency = consistency;
+            bestColumns = columns;
+            bestRows = rows;
+            dialect.separator = QString(separator);
+            dialect.textDelimiter = textDelimiter;
+        }
+    }
+
+    // Data with one column is read as it is
+    if (bestRows.isEmpty()) {
+        dialect.textDelimiter =
+            SnifferPrivate::detectTextDelimiter(text, QChar());
+        bestRows = SnifferPrivate::parse(
+            text, QChar(), dialect.textDelimiter, true);
+    }
+
+    dialect.hasHeader = SnifferPrivate::detectHeader(bestRows);
+    return true;
+}
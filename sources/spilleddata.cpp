@@ -0,0 +1,353 @@
+#include "include/qtcsv/spilleddata.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QTemporaryFile>
+#include <list>
+#include <vector>
+
+using namespace QtCSV;
+
+namespace QtCSV {
+
+class SpilledDataPrivate {
+public:
+    // Block of rows. Block that was written to the temporary file is not
+    // changed anymore, so it is written only once and could be removed from
+    // memory at any time.
+    struct Block {
+        QList<QList<QString>> rows;
+        qsizetype rowCount = 0;
+        // Position of the block in the temporary file. Negative if block
+        // was not written yet.
+        qint64 offset = -1;
+        qint64 size = 0;
+        // Approximate size of rows in memory
+        qint64 memory = 0;
+        bool loaded = true;
+        // Position of the block in the list of loaded blocks
+        std::list<size_t>::iterator position;
+    };
+
+    qint64 memoryLimit = 256 * 1024 * 1024;
+    qsizetype blockSize = 1024;
+    QString tempDir;
+    std::vector<Block> blocks;
+    // Indexes of loaded blocks, most recently used go first
+    std::list<size_t> loadedBlocks;
+    std::unique_ptr<QTemporaryFile> file;
+    qsizetype rowCount = 0;
+    qint64 memoryUsage = 0;
+    bool spillFailed = false;
+
+    // Get approximate size of the row in memory
+    static qint64 rowSize(const QList<QString>& values);
+
+    // Add row to the last block
+    void addRow(const QList<QString>& values);
+    // Get loaded block that contains the row
+    const Block* block(qsizetype row);
+    // Mark block as the most recently used
+    void touch(size_t index);
+    // Remove least recently used blocks from memory while memory usage is
+    // above the limit. The last block and the 'protectedBlock' are kept.
+    void evict(size_t protectedBlock);
+    // Write block to the temporary file
+    bool write(Block& block);
+    // Read block from the temporary file
+    bool read(Block& block);
+    // Remove all rows and the temporary file
+    void clear();
+};
+
+}
+
+// Get approximate size of the row in memory
+// @input:
+// - values - values of the row
+// @output:
+// - qint64 - size of the row in bytes
+qint64 SpilledDataPrivate::rowSize(const QList<QString>& values) {
+    // Size of QString data header and of allocation overhead
+    const qint64 overhead = 32;
+    qint64 result = sizeof(QList<QString>) + overhead +
+        values.size() * (sizeof(QString) + overhead);
+    for (const auto& value : values) {
+        result += value.size() * sizeof(QChar);
+    }
+
+    return result;
+}
+
+// Add row to the last block
+// @input:
+// - values - values of the row
+void SpilledDataPrivate::addRow(const QList<QString>& values) {
+    if (blocks.empty() || blocks.back().rowCount == blockSize) {
+        blocks.emplace_back();
+        loadedBlocks.push_front(blocks.size() - 1);
+        blocks.back().position = loadedBlocks.begin();
+    }
+
+    auto& last = blocks.back();
+    const auto size = rowSize(values);
+    last.rows << values;
+    ++last.rowCount;
+    last.memory += size;
+    memoryUsage += size;
+    ++rowCount;
+
+    touch(blocks.size() - 1);
+    if (memoryLimit < memoryUsage) { evict(blocks.size() - 1); }
+}
+
+// Get loaded block that contains the row
+// @input:
+// - row - valid index of the row
+// @output:
+// - const Block* - block with the row or nullptr if block could not be read
+const SpilledDataPrivate::Block* SpilledDataPrivate::block(
+    const qsizetype row)
+{
+    const auto index = static_cast<size_t>(row / blockSize);
+    auto& result = blocks[index];
+    if (!result.loaded) {
+        if (!read(result)) { return nullptr; }
+
+        result.loaded = true;
+        loadedBlocks.push_front(index);
+        result.position = loadedBlocks.begin();
+        memoryUsage += result.memory;
+    }
+
+    touch(index);
+    if (memoryLimit < memoryUsage) { evict(index); }
+
+    return &result;
+}
+
+// Mark block as the most recently used
+// @input:
+// - index - index of the loaded block
+void SpilledDataPrivate::touch(const size_t index) {
+    auto& position = blocks[index].position;
+    if (position != loadedBlocks.begin()) {
+        loadedBlocks.splice(loadedBlocks.begin(), loadedBlocks, position);
+    }
+}
+
+// Remove least recently used blocks from memory while memory usage is
+// above the limit
+// @input:
+// - protectedBlock - index of the block that should be kept in memory
+void SpilledDataPrivate::evict(const size_t protectedBlock) {
+    if (spillFailed) { return; }
+
+    const auto lastBlock = blocks.size() - 1;
+    auto it = loadedBlocks.end();
+    while (memoryLimit < memoryUsage && it != loadedBlocks.begin()) {
+        --it;
+        const auto index = *it;
+        if (index == protectedBlock || index == lastBlock) { continue; }
+
+        auto& candidate = blocks[index];
+        if (candidate.offset < 0 && !write(candidate)) {
+            spillFailed = true;
+            return;
+        }
+
+        candidate.rows = QList<QList<QString>>();
+        candidate.loaded = false;
+        memoryUsage -= candidate.memory;
+        it = loadedBlocks.erase(it);
+    }
+}
+
+// Write block to the temporary file. Values are saved as UTF-8 strings.
+// @input:
+// - block - loaded block that was not written yet
+// @output:
+// - bool - True if block was written, False otherwise
+bool SpilledDataPrivate::write(Block& block) {
+    if (!file) {
+        file = std::make_unique<QTemporaryFile>(
+            QDir(tempDir.isEmpty() ? QDir::tempPath() : tempDir)
+                .filePath("qtcsv-spill-XXXXXX"));
+        if (!file->open()) {
+            qDebug() << __FUNCTION__ <<
+                "Error - can't create temporary file in" << tempDir;
+            file.reset();
+            return false;
+        }
+    }
+
+    QByteArray buffer;
+    QDataStream stream(&buffer, QIODevice::WriteOnly);
+    for (const auto& values : block.rows) {
+        stream << static_cast<quint32>(values.size());
+        for (const auto& value : values) { stream << value.toUtf8(); }
+    }
+
+    const auto offset = file->size();
+    if (!file->seek(offset) || file->write(buffer) != buffer.size()) {
+        qDebug() << __FUNCTION__ << "Error - failed to write file:" <<
+            file->fileName();
+        return false;
+    }
+
+    block.offset = offset;
+    block.size = buffer.size();
+    return true;
+}
+
+// Read block from the temporary file
+// @input:
+// - block - block that was written to the temporary file
+// @output:
+// - bool - True if block was read, False otherwise
+bool SpilledDataPrivate::read(Block& block) {
+    if (!file || !file->seek(block.offset)) {
+        qDebug() << __FUNCTION__ << "Error - failed to read temporary file";
+        return false;
+    }
+
+    const auto buffer = file->read(block.size);
+    QDataStream stream(buffer);
+    QList<QList<QString>> rows;
+    rows.reserve(block.rowCount);
+    QByteArray value;
+    for (qsizetype row = 0; row < block.rowCount; ++row) {
+        quint32 size = 0;
+        stream >> size;
+
+        QList<QString> values;
+        values.reserve(size);
+        for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok;
+             ++i)
+        {
+            stream >> value;
+            values << QString::fromUtf8(value);
+        }
+
+        rows << values;
+    }
+
+    if (buffer.size() != block.size || stream.status() != QDataStream::Ok) {
+        qDebug() << __FUNCTION__ << "Error - failed to read file:" <<
+            file->fileName();
+        return false;
+    }
+
+    block.rows = rows;
+    return true;
+}
+
+// Remove all rows and the temporary file
+void SpilledDataPrivate::clear() {
+    blocks.clear();
+    loadedBlocks.clear();
+    file.reset();
+    rowCount = 0;
+    memoryUsage = 0;
+    spillFailed = false;
+}
+
+SpilledData::SpilledData() : d(std::make_unique<SpilledDataPrivate>()) {}
+
+SpilledData::~SpilledData() = default;
+
+// Set approximate amount of memory that could be used for rows
+// @input:
+// - bytes - memory limit in bytes
+void SpilledData::setMemoryLimit(const qint64 bytes) {
+    d->memoryLimit = qMax<qint64>(1, bytes);
+    if (d->memoryLimit < d->memoryUsage && !d->blocks.empty()) {
+        d->evict(d->blocks.size() - 1);
+    }
+}
+
+// Set number of rows in a block
+// @input:
+// - rows - number of rows. Must be positive.
+// @output:
+// - bool - True if block size was set, False if container is not empty
+bool SpilledData::setBlockSize(const qsizetype rows) {
+    if (!isEmpty()) {
+        qDebug() << __FUNCTION__ <<
+            "Error - block size could not be changed in non-empty container";
+        return false;
+    }
+
+    d->blockSize = qMax<qsizetype>(1, rows);
+    return true;
+}
+
+// Set directory for the temporary file
+// @input:
+// - dirPath - path to existing directory. Empty string means system
+// temporary directory.
+void SpilledData::setTempDir(const QString& dirPath) {
+    d->tempDir = dirPath;
+}
+
+// Get approximate amount of memory used by rows
+// @output:
+// - qint64 - size of loaded rows in bytes
+qint64 SpilledData::memoryUsage() const {
+    return d->memoryUsage;
+}
+
+// Check if some blocks were written to the temporary file
+// @output:
+// - bool - True if temporary file was created
+bool SpilledData::isSpilled() const {
+    return static_cast<bool>(d->file);
+}
+
+// Add new empty row
+void SpilledData::addEmptyRow() {
+    d->addRow(QList<QString>());
+}
+
+// Add new row with specified values (as strings)
+// @input:
+// - values - list of strings. If list is empty, it will be interpreted
+// as empty line
+void SpilledData::addRow(const QList<QString>& values) {
+    d->addRow(values);
+}
+
+// Clear all data and remove the temporary file
+void SpilledData::clear() {
+    d->clear();
+}
+
+// Check if there are any rows
+// @output:
+// - bool - True if there are any rows, else False
+bool SpilledData::isEmpty() const {
+    return d->rowCount == 0;
+}
+
+// Get number of rows
+// @output:
+// - qsizetype - current number of rows
+qsizetype SpilledData::rowCount() const {
+    return d->rowCount;
+}
+
+// Get values (as list of strings) of specified row. If block with the row
+// was removed from memory, it is read from the temporary file.
+// @input:
+// - row - valid number of row
+// @output:
+// - QList<QString> - values of row. If row is invalid number or block could
+// not be read, function will return empty list.
+QList<QString> SpilledData::rowValues(const qsizetype row) const {
+    if (row < 0 || d->rowCount <= row) { return {}; }
+
+    const auto* block = d->block(row);
+    if (!block) { return {}; }
+
+    return block->rows.at(row % d->blockSize);
+}
@@ -0,0 +1,555 @@
+#include "include/qtcsv/sqlimporter.h"
+#include "sources/filechecker.h"
+#include "sources/rowreader.h"
+#include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QThreadPool>
+#include <QVariant>
+#include <QWaitCondition>
+#include <deque>
+#include <functional>
+#include <memory>
+
+using namespace QtCSV;
+
+// SqlRowQueue passes batches of rows from the parsing thread to the
+// inserting thread. Number of batches in the queue is limited, so memory
+// usage doesn't depend on the size of the data.
+class SqlRowQueue {
+    QMutex m_mutex;
+    QWaitCondition m_changed;
+    std::deque<QList<QList<QString>>> m_batches;
+    const size_t m_capacity;
+    // Parsing thread has no more batches
+    bool m_isClosed = false;
+    // Inserting thread doesn't need more batches
+    bool m_isStopped = false;
+
+public:
+    explicit SqlRowQueue(const size_t capacity) : m_capacity(capacity) {}
+
+    // Add batch to the queue. Returns False if inserting was stopped.
+    bool push(QList<QList<QString>>&& batch) {
+        QMutexLocker locker(&m_mutex);
+        while (!m_isStopped && m_capacity <= m_batches.size()) {
+            m_changed.wait(&m_mutex);
+        }
+
+        if (m_isStopped) { return false; }
+
+        m_batches.push_back(std::move(batch));
+        m_changed.wakeAll();
+        return true;
+    }
+
+    // Take the next batch from the queue. Returns False if there are no
+    // more batches.
+    bool pop(QList<QList<QString>>& batch) {
+        QMutexLocker locker(&m_mutex);
+        while (!m_isClosed && m_batches.empty()) {
+            m_changed.wait(&m_mutex);
+        }
+
+        if (m_batches.empty()) { return false; }
+
+        batch = std::move(m_batches.front());
+        m_batches.pop_front();
+        m_changed.wakeAll();
+        return true;
+    }
+
+    // Parsing thread finished
+    void close() {
+        QMutexLocker locker(&m_mutex);
+        m_isClosed = true;
+        m_changed.wakeAll();
+    }
+
+    // Inserting thread finished
+    void stop() {
+        QMutexLocker locker(&m_mutex);
+        m_isStopped = true;
+        m_batches.clear();
+        m_changed.wakeAll();
+    }
+};
+
+namespace QtCSV {
+
+class SqlImporterPrivate {
+public:
+    // Max number of parameters of one statement in SQLite before 3.32
+    static const int MAX_PARAMETERS = 999;
+    // Max number of batches that are parsed, but not inserted yet
+    static const size_t QUEUE_BATCHES = 16;
+
+    QSqlDatabase database;
+    QString table;
+    SqlImporter::Mode mode = SqlImporter::Mode::APPEND;
+    QList<QString> columns;
+    int statementRows = 500;
+    qint64 transactionRows = 0;
+    QString journalMode;
+    QString synchronous;
+    bool emptyAsNull = false;
+    qint64 importedRows = 0;
+    // Rows of committed transactions
+    qint64 committedRows = 0;
+
+    // Import rows of IO Device
+    bool import(
+        QIODevice& ioDevice,
+        const QString& separator,
+        const QString& textDelimiter,
+        QStringConverter::Encoding codec);
+    // Set pragmas of SQLite
+    bool setPragmas();
+    // Create table or check its columns
+    bool prepareTable(const QList<QString>& header);
+    // Insert batches of rows that are returned by the function
+    bool insertRows(
+        const std::function<bool(QList<QList<QString>>&)>& nextBatch,
+        const QList<QString>& header);
+    // Execute SQL statement
+    bool exec(const QString& statement);
+
+    // Get insert statement for the number of rows
+    QString insertStatement(
+        const QList<QString>& header, qsizetype rows) const;
+    // Read the next batch of rows
+    static bool readBatch(
+        RowReader& reader, qsizetype rows, QList<QList<QString>>& batch);
+    // Get escaped identifier
+    QString escape(const QString& name, QSqlDriver::IdentifierType type) const
+    {
+        return database.driver()->escapeIdentifier(name, type);
+    }
+};
+
+}
+
+// Import rows of IO Device. Header is read by the calling thread. If IO
+// Device is a file, the rest of the data is parsed by a thread of the pool
+// while rows are inserted. Other IO Devices (sockets, processes...) could
+// be used only by the thread that owns them, so they are read by the
+// calling thread between inserts.
+// @input:
+// - ioDevice - IO Device with csv-data. It should be open for reading.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of csv-data
+// @output:
+// - bool - True if all rows were imported, False otherwise
+bool SqlImporterPrivate::import(
+    QIODevice& ioDevice,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    importedRows = 0;
+    committedRows = 0;
+    if (!database.isOpen()) {
+        qDebug() << __FUNCTION__ << "Error - database is not open";
+        return false;
+    }
+
+    RowReader reader(ioDevice, separator, textDelimiter, codec);
+    auto header = columns;
+    if (header.isEmpty() && !reader.readRow(header)) {
+        // There is nothing to import
+        return true;
+    }
+
+    if (header.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - header has no columns";
+        return false;
+    }
+
+    if (!setPragmas()) { return false; }
+
+    if (!database.transaction()) {
+        qDebug() << __FUNCTION__ << "Error - can't start transaction:" <<
+            database.lastError().text();
+        return false;
+    }
+
+    if (!prepareTable(header)) {
+        database.rollback();
+        return false;
+    }
+
+    // Statement would have too many parameters with big rows
+    const auto rowsPerBatch = qMax<qsizetype>(
+        1, qMin<qsizetype>(statementRows, MAX_PARAMETERS / header.size()));
+    auto result = false;
+    if (qobject_cast<QFile*>(&ioDevice) != nullptr) {
+        SqlRowQueue queue(QUEUE_BATCHES);
+        QThreadPool pool;
+        pool.setMaxThreadCount(1);
+        pool.start([&reader, &queue, rowsPerBatch]() {
+            QList<QList<QString>> batch;
+            while (readBatch(reader, rowsPerBatch, batch) &&
+                   queue.push(std::move(batch))) {}
+
+            queue.close();
+        });
+
+        result = insertRows(
+            [&queue](QList<QList<QString>>& batch) {
+                return queue.pop(batch);
+            },
+            header);
+        queue.stop();
+        pool.waitForDone();
+    }
+    else {
+        result = insertRows(
+            [&reader, rowsPerBatch](QList<QList<QString>>& batch) {
+                return readBatch(reader, rowsPerBatch, batch);
+            },
+            header);
+    }
+
+    if (result && !database.commit()) {
+        qDebug() << __FUNCTION__ << "Error - can't commit transaction:" <<
+            database.lastError().text();
+        result = false;
+    }
+
+    if (!result) {
+        database.rollback();
+        importedRows = committedRows;
+    }
+
+    return result;
+}
+
+// Set pragmas of SQLite. Pragmas are set outside of the transaction and
+// stay set for the connection.
+// @output:
+// - bool - True if pragmas were set, False otherwise
+bool SqlImporterPrivate::setPragmas() {
+    if (journalMode.isEmpty() && synchronous.isEmpty()) { return true; }
+
+    if (!database.driverName().startsWith("QSQLITE")) {
+        qDebug() << __FUNCTION__ <<
+            "Error - pragmas are supported only by SQLite";
+        return false;
+    }
+
+    // Values are checked, because they are a part of the statement
+    static const QList<QString> journalModes = {
+        "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+    static const QList<QString> synchronousModes = {
+        "OFF", "NORMAL", "FULL", "EXTRA"};
+    if ((!journalMode.isEmpty() &&
+         !journalModes.contains(journalMode.toUpper())) ||
+        (!synchronous.isEmpty() &&
+         !synchronousModes.contains(synchronous.toUpper())))
+    {
+        qDebug() << __FUNCTION__ << "Error - invalid pragma value:" <<
+            journalMode << synchronous;
+        return false;
+    }
+
+    return (journalMode.isEmpty() ||
+            exec(QString("PRAGMA journal_mode = %1").arg(journalMode))) &&
+        (synchronous.isEmpty() ||
+         exec(QString("PRAGMA synchronous = %1").arg(synchronous)));
+}
+
+// Create table or check its columns
+// @input:
+// - header - names of columns
+// @output:
+// - bool - True if table is ready for insert, False otherwise
+bool SqlImporterPrivate::prepareTable(const QList<QString>& header) {
+    const auto tableName = escape(table, QSqlDriver::TableName);
+    switch (mode) {
+        case SqlImporter::Mode::REPLACE:
+            if (!exec(QString("DROP TABLE IF EXISTS %1").arg(tableName))) {
+                return false;
+            }
+
+            break;
+        case SqlImporter::Mode::APPEND:
+            if (database.tables().contains(table)) {
+                const auto record = database.record(table);
+                for (const auto& column : header) {
+                    if (!record.contains(column)) {
+                        qDebug() << __FUNCTION__ <<
+                            "Error - table has no column:" << column;
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            break;
+    }
+
+    QList<QString> definitions;
+    for (const auto& column : header) {
+        definitions << escape(column, QSqlDriver::FieldName) + " TEXT";
+    }
+
+    return exec(QString("CREATE TABLE %1 (%2)")
+                    .arg(tableName, definitions.join(", ")));
+}
+
+// Insert batches of rows. Full batches are inserted by one prepared
+// statement, the last batch could need another one.
+// @input:
+// - nextBatch - function that returns the next batch of rows. It returns
+// False if there are no more batches.
+// - header - names of columns
+// @output:
+// - bool - True if all rows were inserted, False otherwise
+bool SqlImporterPrivate::insertRows(
+    const std::function<bool(QList<QList<QString>>&)>& nextBatch,
+    const QList<QString>& header)
+{
+    const auto columnCount = header.size();
+    QSqlQuery query(database);
+    qsizetype preparedRows = 0;
+    QList<QList<QString>> batch;
+    while (nextBatch(batch)) {
+        if (batch.size() != preparedRows) {
+            preparedRows = batch.size();
+            if (!query.prepare(insertStatement(header, preparedRows))) {
+                qDebug() << __FUNCTION__ << "Error - can't prepare insert:" <<
+                    query.lastError().text();
+                return false;
+            }
+        }
+
+        int parameter = 0;
+        for (qsizetype rowIndex = 0; rowIndex < batch.size(); ++rowIndex) {
+            const auto& row = batch.at(rowIndex);
+            if (columnCount < row.size()) {
+                qDebug() << __FUNCTION__ <<
+                    "Error - row has more values than columns:" <<
+                    importedRows + rowIndex + 1;
+                return false;
+            }
+
+            for (qsizetype i = 0; i < columnCount; ++i) {
+                if (row.size() <= i ||
+                    (emptyAsNull && row.at(i).isEmpty()))
+                {
+                    query.bindValue(parameter++, QVariant());
+                }
+                else {
+                    query.bindValue(parameter++, row.at(i));
+                }
+            }
+        }
+
+        if (!query.exec()) {
+            qDebug() << __FUNCTION__ << "Error - can't insert rows:" <<
+                query.lastError().text();
+            return false;
+        }
+
+        importedRows += batch.size();
+        if (0 < transactionRows &&
+            transactionRows <= importedRows - committedRows)
+        {
+            // Query is reset, so the transaction could be committed
+            query.finish();
+            if (!database.commit() || !database.transaction()) {
+                qDebug() << __FUNCTION__ <<
+                    "Error - can't commit transaction:" <<
+                    database.lastError().text();
+                return false;
+            }
+
+            committedRows = importedRows;
+        }
+    }
+
+    return true;
+}
+
+// Execute SQL statement
+// @input:
+// - statement - SQL statement
+// @output:
+// - bool - True if statement was executed, False otherwise
+bool SqlImporterPrivate::exec(const QString& statement) {
+    QSqlQuery query(database);
+    if (query.exec(statement)) { return true; }
+
+    qDebug() << __FUNCTION__ << "Error - can't execute" << statement << ":" <<
+        query.lastError().text();
+    return false;
+}
+
+// Get insert statement for the number of rows
+// @input:
+// - header - names of columns
+// - rows - number of rows
+// @output:
+// - QString - multi-row insert statement with positional parameters
+QString SqlImporterPrivate::insertStatement(
+    const QList<QString>& header, const qsizetype rows) const
+{
+    QList<QString> names;
+    for (const auto& column : header) {
+        names << escape(column, QSqlDriver::FieldName);
+    }
+
+    const auto placeholders = "(" +
+        QList<QString>(header.size(), "?").join(", ") + ")";
+    return QString("INSERT INTO %1 (%2) VALUES %3")
+        .arg(escape(table, QSqlDriver::TableName), names.join(", "),
+             QList<QString>(rows, placeholders).join(", "));
+}
+
+// Read the next batch of rows
+// @input:
+// - reader - reader of csv-data
+// - rows - max number of rows in the batch
+// - batch - list that will be filled with rows
+// @output:
+// - bool - True if batch has rows, False if there are no more rows
+bool SqlImporterPrivate::readBatch(
+    RowReader& reader, const qsizetype rows, QList<QList<QString>>& batch)
+{
+    batch.clear();
+    QList<QString> row;
+    while (batch.size() < rows && reader.readRow(row)) { batch << row; }
+
+    return !batch.isEmpty();
+}
+
+// Create importer
+// @input:
+// - database - open database
+// - table - name of the table
+SqlImporter::SqlImporter(const QSqlDatabase& database, const QString& table)
+    : d(std::make_unique<SqlImporterPrivate>())
+{
+    d->database = database;
+    d->table = table;
+}
+
+SqlImporter::~SqlImporter() = default;
+
+// Set mode of the table
+void SqlImporter::setMode(const Mode mode) {
+    d->mode = mode;
+}
+
+// Set names of columns
+// @input:
+// - columns - names of columns. Empty list means that names are taken from
+// the first row of data.
+void SqlImporter::setColumns(const QList<QString>& columns) {
+    d->columns = columns;
+}
+
+// Set max number of rows in one insert statement
+// @input:
+// - rows - number of rows. Must be positive.
+void SqlImporter::setStatementRows(const int rows) {
+    d->statementRows = qMax(1, rows);
+}
+
+// Set number of rows in one transaction
+// @input:
+// - rows - number of rows. 0 means that all rows are imported in one
+// transaction.
+void SqlImporter::setTransactionRows(const qint64 rows) {
+    d->transactionRows = qMax<qint64>(0, rows);
+}
+
+// Set SQLite journal mode
+// @input:
+// - mode - value of "journal_mode" pragma
+void SqlImporter::setJournalMode(const QString& mode) {
+    d->journalMode = mode;
+}
+
+// Set SQLite synchronous mode
+// @input:
+// - mode - value of "synchronous" pragma
+void SqlImporter::setSynchronous(const QString& mode) {
+    d->synchronous = mode;
+}
+
+// Set if empty values are inserted as NULL
+void SqlImporter::setEmptyAsNull(const bool emptyAsNull) {
+    d->emptyAsNull = emptyAsNull;
+}
+
+// Import rows of csv-file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of the file
+// @output:
+// - bool - True if all rows were imported, False otherwise
+bool SqlImporter::import(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    d->importedRows = 0;
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!CheckFile(filePath, true) || !file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    return d->import(file, separator, textDelimiter, codec);
+}
+
+// Import rows of IO Device
+// @input:
+// - ioDevice - IO Device with csv-data. If it is not open, it will be
+// opened for reading. Only QFile is read by another thread.
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type of csv-data
+// @output:
+// - bool - True if all rows were imported, False otherwise
+bool SqlImporter::import(
+    QIODevice& ioDevice,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec)
+{
+    d->importedRows = 0;
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    if (!ioDevice.isOpen() && !ioDevice.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - failed to open IO Device";
+        return false;
+    }
+
+    return d->import(ioDevice, separator, textDelimiter, codec);
+}
+
+// Get number of rows that were imported by the last import. Rows of
+// committed transactions stay in the table even if import failed later.
+qint64 SqlImporter::importedRows() const {
+    return d->importedRows;
+}
@@ -2,10 +2,15 @@
 
 using namespace QtCSV;
 
-StringData::StringData(const StringData& other) : m_values(other.m_values) {}
+StringData::StringData(const StringData& other) :
+    m_values(other.m_values), m_interner(other.m_interner),
+    m_interning(other.m_interning)
+{}
 
 StringData& StringData::operator=(const StringData& other) {
     m_values = other.m_values;
+    m_interner = other.m_interner;
+    m_interning = other.m_interning;
     return *this;
 }
 
@@ -22,7 +27,7 @@ void StringData::addEmptyRow() {
 // @input:
 // - value - value that is supposed to be written to the new row
 void StringData::addRow(const QString& value) {
-    m_values << (QList<QString>() << value);
+    addRow(QList<QString>() << value);
 }
 
 // Add new row with specified values (as strings)
@@ -30,12 +35,20 @@ void StringData::addRow(const QString& value) {
 // - values - list of strings. If list is empty, it will be interpreted
 // as empty line
 void StringData::addRow(const QList<QString>& values) {
-    m_values << values;
+    if (!m_interning) {
+        m_values << values;
+        return;
+    }
+
+    auto row = values;
+    m_interner.intern(row);
+    m_values << row;
 }
 
 // Clear all data
 void StringData::clear() {
     m_values.clear();
+    m_interner.clear();
 }
 
 // Insert new row at index position 'row'.
@@ -53,7 +66,10 @@ void StringData::insertRow(const qsizetype row, const QString& value) {
 // If 'row' is >= rowCount(), the values will be added as new last row.
 // - values - list of strings
 void StringData::insertRow(const qsizetype row, const QList<QString>& values) {
-    m_values.insert(qBound(0, row, m_values.size()), values);
+    auto rowValues = values;
+    if (m_interning) { m_interner.intern(rowValues); }
+
+    m_values.insert(qBound(0, row, m_values.size()), rowValues);
 }
 
 // Check if there are any rows
@@ -89,7 +105,10 @@ void StringData::replaceRow(const qsizetype row, const QString& value) {
 // - values - list of strings that is supposed to be written instead of the
 // 'old' values
 void StringData::replaceRow(const qsizetype row, const QList<QString>& values) {
-    m_values.replace(row, values);
+    auto rowValues = values;
+    if (m_interning) { m_interner.intern(rowValues); }
+
+    m_values.replace(row, rowValues);
 }
 
 // Reserve space for 'size' rows.
@@ -119,6 +138,32 @@ QList<QString> StringData::rowValues(const qsizetype row) const {
     return m_values.at(row);
 }
 
+// Enable interning of values
+// @input:
+// - enable - True to intern values of new rows, False to store them as
+// they are
+// - maxCardinality - maximum number of distinct values of a column. Columns
+// with more distinct values are not interned.
+void StringData::setInterning(const bool enable, const qsizetype maxCardinality)
+{
+    m_interning = enable;
+    m_interner = Interner(maxCardinality);
+}
+
+// Check if interning of values is enabled
+// @output:
+// - bool - True if values of new rows are interned
+bool StringData::isInterning() const {
+    return m_interning;
+}
+
+// Get interner of values
+// @output:
+// - Interner - interner with tables of distinct values of columns
+const Interner& StringData::interner() const {
+    return m_interner;
+}
+
 // Add new row that would contain one value
 StringData& StringData::operator<<(const QString& value) {
     addRow(value);
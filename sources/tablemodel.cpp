@@ -0,0 +1,472 @@
+#include "include/qtcsv/tablemodel.h"
+#include "sources/filechecker.h"
+#include "sources/rowindexer.h"
+#include <QCache>
+#include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <atomic>
+#include <limits>
+
+using namespace QtCSV;
+
+namespace QtCSV {
+
+class TableModelPrivate {
+public:
+    // Number of bytes that are indexed between updates of the model
+    static const qint64 CHUNK_SIZE = 4 * 1024 * 1024;
+
+    TableModel& q;
+    QFile file;
+    uchar* map = nullptr;
+    qint64 size = 0;
+    // Position of the first row (after byte order mark)
+    qint64 start = 0;
+    QString separator;
+    QString textDelimiter;
+    // Codec with explicit byte order
+    QStringConverter::Encoding codec = QStringConverter::Utf8;
+    bool hasHeader = false;
+    int fetchSize = 1000;
+    qsizetype statsRowLimit = 10000;
+    QCache<qsizetype, QList<QString>> cache{1024};
+
+    // State that is shared with the indexing thread
+    mutable QMutex mutex;
+    // Positions of rows that were found. The last position is the end of
+    // the last row.
+    QList<qint64> offsets;
+    QList<TableModel::ColumnStats> indexedStats;
+    bool isStatsChanged = false;
+    std::atomic<bool> stop{false};
+    QThreadPool pool;
+
+    // State of the model
+    quint64 generation = 0;
+    bool indexing = false;
+    // Number of found rows without header
+    qsizetype indexedRows = 0;
+    int fetchedRows = 0;
+    int columns = 0;
+    QList<QString> header;
+    QList<TableModel::ColumnStats> stats;
+
+    explicit TableModelPrivate(TableModel& model) : q(model) {
+        pool.setMaxThreadCount(1);
+    }
+
+    // Find rows of the file and collect statistics of columns. Runs in the
+    // indexing thread.
+    void index(quint64 indexGeneration, qsizetype statsRows);
+    // Update statistics of columns with values of the row
+    static void updateStats(
+        QList<TableModel::ColumnStats>& columnStats,
+        const QList<QString>& values);
+    // Apply results of indexing to the model
+    void update(quint64 indexGeneration, qint64 bytes, bool finished);
+    // Parse row of the file
+    QList<QString> fileRow(qsizetype row) const;
+    // Increase number of columns of the model
+    void setColumnCount(qsizetype count);
+    // Stop indexing and close the file
+    void close();
+};
+
+}
+
+// Find rows of the file and collect statistics of columns. Results are
+// passed to the model thread after each chunk of the file.
+// @input:
+// - indexGeneration - number of the open() call that started indexing
+// - statsRows - max number of rows that are parsed to collect statistics.
+// Negative value means all rows.
+void TableModelPrivate::index(
+    const quint64 indexGeneration, const qsizetype statsRows)
+{
+    const auto* data = reinterpret_cast<const char*>(map);
+    RowIndexer indexer(data, size, start, codec, separator, textDelimiter);
+
+    // At least one row is parsed to get number of columns
+    const auto statsLimit = statsRows < 0 ?
+        std::numeric_limits<qsizetype>::max() : qMax<qsizetype>(1, statsRows);
+    const qsizetype firstDataRow = hasHeader ? 1 : 0;
+    QList<TableModel::ColumnStats> columnStats;
+    QList<qint64> rowEnds;
+    qsizetype rows = 0;
+    auto rowStart = start;
+    do {
+        rowEnds.clear();
+        indexer.scan(CHUNK_SIZE, rowEnds);
+
+        auto isChanged = false;
+        for (const auto rowEnd : rowEnds) {
+            if (firstDataRow <= rows && rows - firstDataRow < statsLimit) {
+                updateStats(columnStats, RowIndexer::parseRow(
+                    data, rowStart, rowEnd, separator, textDelimiter, codec));
+                isChanged = true;
+            }
+
+            rowStart = rowEnd;
+            ++rows;
+        }
+
+        {
+            QMutexLocker locker(&mutex);
+            offsets << rowEnds;
+            if (isChanged) {
+                indexedStats = columnStats;
+                isStatsChanged = true;
+            }
+        }
+
+        const auto bytes = indexer.position();
+        const auto finished = indexer.atEnd();
+        QMetaObject::invokeMethod(
+            &q,
+            [this, indexGeneration, bytes, finished]() {
+                update(indexGeneration, bytes, finished);
+            },
+            Qt::QueuedConnection);
+    } while (!stop && !indexer.atEnd());
+}
+
+// Update statistics of columns with values of the row
+// @input:
+// - columnStats - statistics of columns
+// - values - values of the row
+void TableModelPrivate::updateStats(
+    QList<TableModel::ColumnStats>& columnStats,
+    const QList<QString>& values)
+{
+    if (columnStats.size() < values.size()) {
+        columnStats.resize(values.size());
+    }
+
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        const auto& value = values.at(i);
+        auto& column = columnStats[i];
+        column.maxWidth = qMax(column.maxWidth, value.size());
+        if (value.isEmpty()) { continue; }
+
+        ++column.values;
+        auto isNumber = false;
+        value.toDouble(&isNumber);
+        if (isNumber) { ++column.numbers; }
+    }
+}
+
+// Apply results of indexing to the model
+// @input:
+// - indexGeneration - number of the open() call that started indexing.
+// Results of previous calls are ignored.
+// - bytes - number of indexed bytes
+// - finished - True if the whole file was indexed
+void TableModelPrivate::update(
+    const quint64 indexGeneration, const qint64 bytes, const bool finished)
+{
+    if (indexGeneration != generation || !indexing) { return; }
+
+    qsizetype fileRows = 0;
+    auto isChanged = false;
+    {
+        QMutexLocker locker(&mutex);
+        fileRows = offsets.size() - 1;
+        if (isStatsChanged) {
+            stats = indexedStats;
+            isStatsChanged = false;
+            isChanged = true;
+        }
+    }
+
+    if (hasHeader && header.isEmpty() && 0 < fileRows) {
+        header = fileRow(0);
+        setColumnCount(header.size());
+        if (0 < columns) {
+            emit q.headerDataChanged(Qt::Horizontal, 0, columns - 1);
+        }
+    }
+
+    indexedRows = qMax<qsizetype>(0, fileRows - (hasHeader ? 1 : 0));
+    if (isChanged) {
+        setColumnCount(stats.size());
+        emit q.columnStatsChanged();
+    }
+
+    // The first part of rows is shown without waiting for the view
+    if (fetchedRows < fetchSize) { q.fetchMore(QModelIndex()); }
+
+    if (finished) { indexing = false; }
+
+    emit q.indexingProgress(bytes, size, indexedRows);
+    if (finished) { emit q.indexingFinished(indexedRows); }
+}
+
+// Parse row of the file
+// @input:
+// - row - number of the indexed row of the file
+// @output:
+// - QList<QString> - values of the row
+QList<QString> TableModelPrivate::fileRow(const qsizetype row) const {
+    qint64 begin = 0, end = 0;
+    {
+        QMutexLocker locker(&mutex);
+        if (row < 0 || offsets.size() - 1 <= row) { return {}; }
+
+        begin = offsets.at(row);
+        end = offsets.at(row + 1);
+    }
+
+    return RowIndexer::parseRow(reinterpret_cast<const char*>(map), begin,
+                                end, separator, textDelimiter, codec);
+}
+
+// Increase number of columns of the model
+// @input:
+// - count - new number of columns. If it is not bigger than the current
+// number, function will do nothing.
+void TableModelPrivate::setColumnCount(const qsizetype count) {
+    const auto newColumns = static_cast<int>(
+        qMin<qsizetype>(count, std::numeric_limits<int>::max()));
+    if (newColumns <= columns) { return; }
+
+    q.beginInsertColumns(QModelIndex(), columns, newColumns - 1);
+    columns = newColumns;
+    q.endInsertColumns();
+}
+
+// Stop indexing and close the file
+void TableModelPrivate::close() {
+    stop = true;
+    pool.waitForDone();
+    stop = false;
+
+    if (map != nullptr) { file.unmap(map); }
+    if (file.isOpen()) { file.close(); }
+
+    map = nullptr;
+    size = 0;
+    start = 0;
+    offsets.clear();
+    indexedStats.clear();
+    isStatsChanged = false;
+    ++generation;
+    indexing = false;
+    indexedRows = 0;
+    fetchedRows = 0;
+    columns = 0;
+    header.clear();
+    stats.clear();
+    cache.clear();
+}
+
+TableModel::TableModel(QObject* parent) :
+    QAbstractTableModel(parent),
+    d(std::make_unique<TableModelPrivate>(*this))
+{}
+
+TableModel::~TableModel() {
+    d->close();
+}
+
+// Open csv-file and start indexing of its rows
+// @input:
+// - filePath - string with absolute path to csv-file
+// - separator - string or character that separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - codec - codec type that would be used for reading. Byte order mark at
+// the beginning of the file overrides it.
+// - hasHeader - True if the first row is a header
+// @output:
+// - bool - True if file was opened, False otherwise
+bool TableModel::open(
+    const QString& filePath,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QStringConverter::Encoding codec,
+    const bool hasHeader)
+{
+    close();
+
+    if (separator.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - separator could not be empty";
+        return false;
+    }
+
+    d->file.setFileName(filePath);
+    if (!CheckFile(filePath, true) || !d->file.open(QIODevice::ReadOnly)) {
+        qDebug() << __FUNCTION__ << "Error - can't open file:" << filePath;
+        return false;
+    }
+
+    d->size = d->file.size();
+    if (0 < d->size && (d->map = d->file.map(0, d->size)) == nullptr) {
+        qDebug() << __FUNCTION__ << "Error - can't map file:" << filePath;
+        d->close();
+        return false;
+    }
+
+    qsizetype bomSize = 0;
+    d->codec = RowIndexer::resolveCodec(
+        codec,
+        QByteArrayView(reinterpret_cast<const char*>(d->map),
+                       qMin<qint64>(d->size, 4)),
+        bomSize);
+    d->start = bomSize;
+    d->separator = separator;
+    d->textDelimiter = textDelimiter;
+    d->hasHeader = hasHeader;
+    d->offsets << d->start;
+    d->indexing = true;
+
+    const auto generation = d->generation;
+    const auto statsRows = d->statsRowLimit;
+    d->pool.start([this, generation, statsRows]() {
+        d->index(generation, statsRows);
+    });
+
+    return true;
+}
+
+// Stop indexing, close csv-file and remove all rows from the model
+void TableModel::close() {
+    beginResetModel();
+    d->close();
+    endResetModel();
+}
+
+// Check if rows of the file are still being indexed
+// @output:
+// - bool - True if indexing is not finished yet
+bool TableModel::isIndexing() const {
+    return d->indexing;
+}
+
+// Block until indexing is finished and apply its results to the model
+// @input:
+// - msecs - max time to wait in milliseconds. Negative value means no
+// time limit.
+// @output:
+// - bool - True if indexing is finished, False on timeout
+bool TableModel::waitForIndexing(const int msecs) {
+    if (!d->indexing) { return true; }
+    if (!d->pool.waitForDone(msecs)) { return false; }
+
+    d->update(d->generation, d->size, true);
+    return true;
+}
+
+// Get number of rows that were found so far
+// @output:
+// - qsizetype - number of indexed rows without header. Not all of them
+// could be fetched to the model yet.
+qsizetype TableModel::indexedRowCount() const {
+    return d->indexedRows;
+}
+
+// Set max number of parsed rows that are cached
+// @input:
+// - rows - number of rows. Zero disables cache.
+void TableModel::setCacheSize(const qsizetype rows) {
+    d->cache.setMaxCost(qMax<qsizetype>(0, rows));
+}
+
+// Set number of rows that are added by fetchMore()
+// @input:
+// - rows - number of rows. Must be positive.
+void TableModel::setFetchSize(const int rows) {
+    d->fetchSize = qMax(1, rows);
+}
+
+// Set number of rows that are parsed to collect statistics of columns
+// @input:
+// - rows - number of rows. Negative value means all rows.
+void TableModel::setStatsRowLimit(const qsizetype rows) {
+    d->statsRowLimit = rows;
+}
+
+// Get statistics of the column collected so far
+// @input:
+// - column - number of the column
+// @output:
+// - ColumnStats - statistics of the column. For invalid column it will
+// contain zeros.
+TableModel::ColumnStats TableModel::columnStats(const int column) const {
+    if (column < 0 || d->stats.size() <= column) { return ColumnStats(); }
+
+    return d->stats.at(column);
+}
+
+// Get values of the row. Row is parsed on the first request and is kept
+// in cache.
+// @input:
+// - row - number of the fetched row
+// @output:
+// - QList<QString> - values of the row. If row is invalid number, function
+// will return empty list.
+QList<QString> TableModel::rowValues(const int row) const {
+    if (row < 0 || d->fetchedRows <= row) { return {}; }
+
+    if (const auto* values = d->cache.object(row)) { return *values; }
+
+    auto values = d->fileRow(row + (d->hasHeader ? 1 : 0));
+    if (0 < d->cache.maxCost()) {
+        d->cache.insert(row, new QList<QString>(values));
+    }
+
+    return values;
+}
+
+int TableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : d->fetchedRows;
+}
+
+int TableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : d->columns;
+}
+
+QVariant TableModel::data(const QModelIndex& index, const int role) const {
+    if (!index.isValid() ||
+        (role != Qt::DisplayRole && role != Qt::EditRole))
+    {
+        return QVariant();
+    }
+
+    const auto values = rowValues(index.row());
+    if (values.size() <= index.column()) { return QVariant(); }
+
+    return values.at(index.column());
+}
+
+QVariant TableModel::headerData(
+    const int section, const Qt::Orientation orientation, const int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole &&
+        0 <= section && section < d->header.size())
+    {
+        return d->header.at(section);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+bool TableModel::canFetchMore(const QModelIndex& parent) const {
+    const auto available = qMin<qsizetype>(
+        d->indexedRows, std::numeric_limits<int>::max());
+    return !parent.isValid() && d->fetchedRows < available;
+}
+
+// Add next part of indexed rows to the model
+void TableModel::fetchMore(const QModelIndex& parent) {
+    if (!canFetchMore(parent)) { return; }
+
+    const auto available = qMin<qsizetype>(
+        d->indexedRows, std::numeric_limits<int>::max());
+    const auto count = static_cast<int>(
+        qMin<qsizetype>(d->fetchSize, available - d->fetchedRows));
+    beginInsertRows(QModelIndex(), d->fetchedRows, d->fetchedRows + count - 1);
+    d->fetchedRows += count;
+    endInsertRows();
+}
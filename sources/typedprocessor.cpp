@@ -0,0 +1,289 @@
+#include "include/qtcsv/typedprocessor.h"
+#include "include/qtcsv/numberconverter.h"
+#include <QDebug>
+
+using namespace QtCSV;
+
+namespace QtCSV {
+
+    class TypedProcessorPrivate {
+    public:
+        explicit TypedProcessorPrivate(const Schema& schema) :
+            m_schema(schema) {}
+
+        // Parse the header and match it with the schema
+        bool setHeader(const QList<QString>& elements);
+        // Convert elements of the row to typed values
+        bool convertRow(const QList<QString>& elements);
+        // Forget the header
+        void reset();
+
+        Schema m_schema;
+        QList<QString> m_header;
+        QHash<QString, qsizetype> m_indexes;
+        // Indexes of columns of the schema in csv-data (-1 if absent)
+        QList<qsizetype> m_positions;
+        // Converted default values of columns of the schema
+        QList<TypedRow::Value> m_defaults;
+        TypedRow m_row;
+        qint64 m_rowCount = 0;
+        bool m_hasHeader = false;
+
+    private:
+        // Convert text to value of the column
+        bool convert(const QString& text, TypedRow::Value& value) const;
+        // Convert default value to value of the column
+        bool convert(const QVariant& variant, TypedRow::Value& value) const;
+    };
+}
+
+// Parse the header and match it with the schema
+// @input:
+// - elements - names of columns
+// @output:
+// - bool - True if header contains all required columns of the schema
+bool TypedProcessorPrivate::setHeader(const QList<QString>& elements) {
+    m_header = elements;
+
+    // Without schema all columns of the header are strings
+    auto schema = m_schema;
+    if (schema.isEmpty()) {
+        for (const auto& name : elements) { schema.addColumn(name); }
+    }
+
+    QHash<QString, qsizetype> fileIndexes;
+    for (qsizetype i = 0; i < elements.size(); ++i) {
+        if (!fileIndexes.contains(elements.at(i))) {
+            fileIndexes.insert(elements.at(i), i);
+        }
+    }
+
+    const auto& columns = schema.columns();
+    m_indexes.clear();
+    m_positions.clear();
+    m_defaults.clear();
+    m_row.m_values.clear();
+    for (qsizetype i = 0; i < columns.size(); ++i) {
+        const auto& column = columns.at(i);
+        if (!m_indexes.contains(column.name)) {
+            m_indexes.insert(column.name, i);
+        }
+
+        TypedRow::Value defaultValue;
+        defaultValue.type = column.type;
+        if (column.defaultValue.isValid() &&
+            !convert(column.defaultValue, defaultValue))
+        {
+            qDebug() << __FUNCTION__ <<
+                "Error - invalid default value of column" << column.name;
+            return false;
+        }
+
+        const auto position = fileIndexes.value(column.name, -1);
+        if (position < 0 && !column.defaultValue.isValid()) {
+            qDebug() << __FUNCTION__ << "Error - header has no column" <<
+                column.name;
+            return false;
+        }
+
+        m_positions << position;
+        m_defaults << defaultValue;
+        m_row.m_values << defaultValue;
+    }
+
+    m_row.m_indexes = &m_indexes;
+    m_hasHeader = true;
+    return true;
+}
+
+// Convert elements of the row to typed values
+// @input:
+// - elements - values of the row
+// @output:
+// - bool - True if all values were converted
+bool TypedProcessorPrivate::convertRow(const QList<QString>& elements) {
+    for (qsizetype i = 0; i < m_positions.size(); ++i) {
+        const auto position = m_positions.at(i);
+        auto& value = m_row.m_values[i];
+        if (position < 0 || elements.size() <= position ||
+            elements.at(position).isEmpty())
+        {
+            value = m_defaults.at(i);
+            const auto required = !m_schema.isEmpty() &&
+                !m_schema.columns().at(i).nullable;
+            if (value.isNull && required) {
+                qDebug() << __FUNCTION__ << "Error - empty value in row" <<
+                    m_rowCount << "of not nullable column" <<
+                    m_schema.columns().at(i).name;
+                return false;
+            }
+
+            continue;
+        }
+
+        if (!convert(elements.at(position), value)) {
+            qDebug() << __FUNCTION__ << "Error - invalid value in row" <<
+                m_rowCount << "of column" << m_header.value(position) <<
+                ":" << elements.at(position);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Convert text to value of the column
+// @input:
+// - text - not empty text of the value
+// - value - value which type is already set
+// @output:
+// - bool - True if text was converted to the type of the value
+bool TypedProcessorPrivate::convert(
+    const QString& text, TypedRow::Value& value) const
+{
+    auto ok = true;
+    switch (value.type) {
+    case Schema::Type::INTEGER:
+        value.integer = NumberConverter::toLongLong(text, &ok);
+        break;
+    case Schema::Type::DOUBLE:
+        value.real = NumberConverter::toDouble(
+            text, &ok, m_schema.decimalSeparator());
+        break;
+    case Schema::Type::BOOL:
+        if (text == QLatin1String("1") ||
+            text.compare(QLatin1String("true"), Qt::CaseInsensitive) == 0)
+        {
+            value.integer = 1;
+        }
+        else if (text == QLatin1String("0") ||
+            text.compare(QLatin1String("false"), Qt::CaseInsensitive) == 0)
+        {
+            value.integer = 0;
+        }
+        else {
+            ok = false;
+        }
+
+        break;
+    case Schema::Type::STRING:
+        value.string = text;
+        break;
+    }
+
+    value.isNull = !ok;
+    return ok;
+}
+
+// Convert default value to value of the column
+// @input:
+// - variant - valid default value
+// - value - value which type is already set
+// @output:
+// - bool - True if default value was converted to the type of the value
+bool TypedProcessorPrivate::convert(
+    const QVariant& variant, TypedRow::Value& value) const
+{
+    // Strings are parsed the same way as values from csv-data
+    if (variant.typeId() == QMetaType::QString) {
+        return convert(variant.toString(), value);
+    }
+
+    auto ok = true;
+    switch (value.type) {
+    case Schema::Type::INTEGER:
+        value.integer = variant.toLongLong(&ok);
+        break;
+    case Schema::Type::DOUBLE:
+        value.real = variant.toDouble(&ok);
+        break;
+    case Schema::Type::BOOL:
+        ok = variant.canConvert<bool>();
+        value.integer = variant.toBool() ? 1 : 0;
+        break;
+    case Schema::Type::STRING:
+        value.string = variant.toString();
+        break;
+    }
+
+    value.isNull = !ok;
+    return ok;
+}
+
+// Forget the header
+void TypedProcessorPrivate::reset() {
+    m_header.clear();
+    m_indexes.clear();
+    m_positions.clear();
+    m_defaults.clear();
+    m_row = TypedRow();
+    m_rowCount = 0;
+    m_hasHeader = false;
+}
+
+// Constructor of TypedProcessor without schema. All columns of the header
+// will be strings.
+TypedProcessor::TypedProcessor() :
+    d(std::make_unique<TypedProcessorPrivate>(Schema()))
+{}
+
+// Constructor of TypedProcessor
+// @input:
+// - schema - description of columns
+TypedProcessor::TypedProcessor(const Schema& schema) :
+    d(std::make_unique<TypedProcessorPrivate>(schema))
+{}
+
+TypedProcessor::~TypedProcessor() = default;
+
+// Get names of columns from the header of csv-data
+// @output:
+// - QList<QString> - names of columns. Empty if header was not read yet.
+const QList<QString>& TypedProcessor::header() const {
+    return d->m_header;
+}
+
+// Get map of names of columns to their indexes in typed rows
+// @output:
+// - QHash<QString, qsizetype> - map of names to indexes
+const QHash<QString, qsizetype>& TypedProcessor::columnIndexes() const {
+    return d->m_indexes;
+}
+
+// Get index of the column in typed rows
+// @input:
+// - name - name of the column
+// @output:
+// - qsizetype - index of the column or -1 if there is no such column
+qsizetype TypedProcessor::columnIndex(const QString& name) const {
+    return d->m_indexes.value(name, -1);
+}
+
+// Get number of rows that were passed to processRow()
+// @output:
+// - qint64 - number of rows
+qint64 TypedProcessor::rowCount() const {
+    return d->m_rowCount;
+}
+
+// Forget the header to read another csv-data
+void TypedProcessor::reset() {
+    d->reset();
+}
+
+// Process one row of csv-data. The first row is the header, other rows are
+// converted and passed to processRow().
+// @input:
+// - elements - list of row elements
+// @output:
+// - bool - True if row was processed successfully, False otherwise
+bool TypedProcessor::processRowElements(const QList<QString>& elements) {
+    if (!d->m_hasHeader) { return d->setHeader(elements); }
+
+    if (elements.isEmpty()) { return true; }
+
+    if (!d->convertRow(elements)) { return false; }
+
+    ++d->m_rowCount;
+    return processRow(d->m_row);
+}
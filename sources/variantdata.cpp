@@ -18,21 +18,46 @@ bool isConvertableToString(const QList<QVariant>& values) {
 // Transform QList<QString> to QList<QVariant>
 // @input:
 // - values - list of strings
+// - format - pointer to the number format. If it is not null, strings that
+// contain numbers will be converted to numbers. Number is kept only if it
+// is written back as the same string, so values like "007" or "1.50" stay
+// strings.
 // @output:
 // - QList<QVariant> - list of the same strings, but converted to QVariants
-QList<QVariant> toListOfVariants(const QList<QString>& values) {
+QList<QVariant> toListOfVariants(
+    const QList<QString>& values, const NumberFormat* format = nullptr)
+{
     QList<QVariant> list;
+    list.reserve(values.size());
     for (auto iter = values.constBegin(); iter != values.constEnd(); ++iter) {
+        if (format != nullptr) {
+            auto number =
+                NumberConverter::toNumber(*iter, format->decimalSeparator);
+            QString str;
+            if (number.isValid() &&
+                NumberConverter::toString(number, str, *format) &&
+                str == *iter)
+            {
+                list << number;
+                continue;
+            }
+        }
+
         list << QVariant(*iter);
     }
 
     return list;
 }
 
-VariantData::VariantData(const VariantData& other) : m_values(other.m_values) {}
+VariantData::VariantData(const VariantData& other) :
+    m_values(other.m_values), m_numberFormat(other.m_numberFormat),
+    m_parseNumbers(other.m_parseNumbers)
+{}
 
 VariantData& VariantData::operator=(const VariantData& other) {
     m_values = other.m_values;
+    m_numberFormat = other.m_numberFormat;
+    m_parseNumbers = other.m_parseNumbers;
     return *this;
 }
 
@@ -75,8 +100,10 @@ bool VariantData::addRow(const QList<QVariant>& values) {
 // Add new row with specified values (as strings)
 // @input:
 // - values - list of strings. If list is empty, empty row will be added.
+// If numbers parsing is enabled, numeric strings will be saved as numbers.
 void VariantData::addRow(const QList<QString>& values) {
-    m_values << toListOfVariants(values);
+    m_values << toListOfVariants(
+        values, m_parseNumbers ? &m_numberFormat : nullptr);
 }
 
 // Clear all data
@@ -104,7 +131,8 @@ bool VariantData::insertRow(const qsizetype row, const QVariant& value) {
 // @output:
 // - bool - True if row was inserted, False otherwise
 bool VariantData::insertRow(const qsizetype row, const QList<QString>& values) {
-    return insertRow(row, toListOfVariants(values));
+    return insertRow(row, toListOfVariants(
+        values, m_parseNumbers ? &m_numberFormat : nullptr));
 }
 
 // Insert new row at index position 'row'.
@@ -160,7 +188,8 @@ bool VariantData::replaceRow(const qsizetype row, const QVariant& value) {
 // @output:
 // - bool - True if row was replaced, else False
 bool VariantData::replaceRow(const qsizetype row, const QList<QString>& values) {
-    return replaceRow(row, toListOfVariants(values));
+    return replaceRow(row, toListOfVariants(
+        values, m_parseNumbers ? &m_numberFormat : nullptr));
 }
 
 // Replace the row at index position 'row' with new row.
@@ -203,14 +232,54 @@ qsizetype VariantData::rowCount() const {
 QList<QString> VariantData::rowValues(const qsizetype row) const {
     if (row < 0 || rowCount() <= row) { return {}; }
 
+    const auto& rowVariants = m_values.at(row);
     QList<QString> values;
-    for (int i = 0; i < m_values.at(row).size(); ++i) {
-        values << m_values.at(row).at(i).toString();
+    values.reserve(rowVariants.size());
+    for (const auto& variant : rowVariants) {
+        // Numbers are converted without QVariant::toString() as it is
+        // much slower
+        QString value;
+        if (!NumberConverter::toString(variant, value, m_numberFormat)) {
+            value = variant.toString();
+        }
+
+        values << value;
     }
 
     return values;
 }
 
+// Set format of floating point numbers
+// @input:
+// - format - format that will be used to convert numbers to strings in
+// rowValues() and strings to numbers if numbers parsing is enabled
+void VariantData::setNumberFormat(const NumberFormat& format) {
+    m_numberFormat = format;
+}
+
+// Get format of floating point numbers
+// @output:
+// - NumberFormat - current number format
+NumberFormat VariantData::numberFormat() const {
+    return m_numberFormat;
+}
+
+// Enable conversion of numeric strings to numbers
+// @input:
+// - parse - if True, strings that contain numbers and are added to the
+// container as strings (for example, by Reader::readToData()) will be
+// saved as qint64 or double values
+void VariantData::setParseNumbers(const bool parse) {
+    m_parseNumbers = parse;
+}
+
+// Check if numeric strings are converted to numbers
+// @output:
+// - bool - True if numbers parsing is enabled, False otherwise
+bool VariantData::parseNumbers() const {
+    return m_parseNumbers;
+}
+
 // Add new row that would contain one value
 VariantData& VariantData::operator<<(const QVariant& value) {
     addRow(value);
@@ -1,6 +1,7 @@
 #include "include/qtcsv/writer.h"
 #include "sources/contentiterator.h"
 #include "sources/filechecker.h"
+#include "sources/instrumenteddevice.h"
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
@@ -32,19 +33,22 @@ public:
     static bool appendToFile(
         const QString& filePath,
         ContentIterator& content,
-        QStringConverter::Encoding codec);
+        QStringConverter::Encoding codec,
+        WriteStats* stats);
 
     // Overwrite file with new information
     static bool overwriteFile(
         const QString& filePath,
         ContentIterator& content,
-        QStringConverter::Encoding codec);
+        QStringConverter::Encoding codec,
+        WriteStats* stats);
 
     // Write to IO Device
     static bool writeToIODevice(
         QIODevice& ioDevice,
         ContentIterator& content,
-        QStringConverter::Encoding codec);
+        QStringConverter::Encoding codec,
+        WriteStats* stats);
 
     // Create unique name for the temporary file
     static QString getTempFileName();
@@ -55,12 +59,14 @@ public:
 // - filePath - string with absolute path to csv-file
 // - content - not empty handler of content for csv-file
 // - codec - pointer to codec object that would be used for file writing
+// - stats - optional object for statistics of writing
 // @output:
 // - bool - True if data was appended to the file, otherwise False
 bool WriterPrivate::appendToFile(
     const QString& filePath,
     ContentIterator& content,
-    const QStringConverter::Encoding codec)
+    const QStringConverter::Encoding codec,
+    WriteStats* stats)
 {
     if (filePath.isEmpty() || content.isEmpty()) {
         qDebug() << __FUNCTION__ << "Error - invalid arguments";
@@ -74,7 +80,7 @@ bool WriterPrivate::appendToFile(
         return false;
     }
 
-    const auto result = writeToIODevice(csvFile, content, codec);
+    const auto result = writeToIODevice(csvFile, content, codec, stats);
     csvFile.close();
 
     return result;
@@ -85,12 +91,14 @@ bool WriterPrivate::appendToFile(
 // - filePath - string with absolute path to csv-file
 // - content - not empty handler of content for csv-file
 // - codec - pointer to codec object that would be used for file writing
+// - stats - optional object for statistics of writing
 // @output:
 // - bool - True if file was overwritten with new data, otherwise False
 bool WriterPrivate::overwriteFile(
     const QString& filePath,
     ContentIterator& content,
-    const QStringConverter::Encoding codec)
+    const QStringConverter::Encoding codec,
+    WriteStats* stats)
 {
     // Create path to the unique temporary file
     const auto tempFileName = getTempFileName();
@@ -103,7 +111,7 @@ bool WriterPrivate::overwriteFile(
     TempFileHandler handler(tempFileName);
 
     // Write information to the temporary file
-    if (!appendToFile(tempFileName, content, codec)) { return false; }
+    if (!appendToFile(tempFileName, content, codec, stats)) { return false; }
 
     // Remove "old" file if it exists
     if (QFile::exists(filePath) && !QFile::remove(filePath)) {
@@ -127,12 +135,14 @@ bool WriterPrivate::overwriteFile(
 // - iodevice - IO Device to write data to
 // - content - not empty handler of content for csv-file
 // - codec - pointer to codec object that would be used for file writing
+// - stats - optional object for statistics of writing
 // @output:
 // - bool - True if data could be written to the IO Device
 bool WriterPrivate::writeToIODevice(
     QIODevice& ioDevice,
     ContentIterator& content,
-    const QStringConverter::Encoding codec)
+    const QStringConverter::Encoding codec,
+    WriteStats* stats)
 {
     if (content.isEmpty()) {
         qDebug() << __FUNCTION__ << "Error - invalid arguments";
@@ -147,11 +157,43 @@ bool WriterPrivate::writeToIODevice(
         return false;
     }
 
-    QTextStream stream(&ioDevice);
+    if (stats == nullptr) {
+        QTextStream stream(&ioDevice);
+        stream.setEncoding(codec);
+        while (content.hasNext()) { stream << content.getNext(); }
+
+        stream.flush();
+        return stream.status() == QTextStream::Ok;
+    }
+
+    // QTextStream writes bytes to IO Device while encoding them, so time of
+    // I/O is subtracted from the time of encoding
+    auto timer = [stats](qint64 WriteStats::* stage) {
+        return stats->timings ? &(stats->*stage) : nullptr;
+    };
+
+    StageTimer totalTimer(timer(&WriteStats::totalNsecs));
+    InstrumentedDevice device(
+        ioDevice, stats->bytesWritten, timer(&WriteStats::ioNsecs));
+    QTextStream stream(&device);
     stream.setEncoding(codec);
-    while (content.hasNext()) { stream << content.getNext(); }
+    const auto ioNsecs = stats->ioNsecs;
+    while (content.hasNext()) {
+        const auto chunk = content.getNext();
+        StageTimer encodeTimer(timer(&WriteStats::encodeNsecs));
+        stream << chunk;
+        stats->symbolsEncoded += chunk.size();
+    }
+
+    {
+        StageTimer encodeTimer(timer(&WriteStats::encodeNsecs));
+        stream.flush();
+    }
 
-    stream.flush();
+    stats->encodeNsecs -= stats->ioNsecs - ioNsecs;
+    if (content.isCanceled()) { return false; }
+
+    content.finish();
     return stream.status() == QTextStream::Ok;
 }
 
@@ -190,6 +232,8 @@ QString WriterPrivate::getTempFileName()
 // - footer - strings that will be written at the end of the file in
 // one line. separator will be used as delimiter character.
 // - codec - pointer to codec object that would be used for file writing
+// - stats - optional object for statistics of writing
+// - progress - optional object for progress reporting and cancellation
 // @output:
 // - bool - True if data was written to the file, otherwise False
 bool Writer::write(
@@ -200,7 +244,9 @@ bool Writer::write(
     const WriteMode mode,
     const QList<QString>& header,
     const QList<QString>& footer,
-    const QStringConverter::Encoding codec)
+    const QStringConverter::Encoding codec,
+    WriteStats* stats,
+    Progress* progress)
 {
     if (filePath.isEmpty()) {
         qDebug() << __FUNCTION__ << "Error - empty path to file";
@@ -212,20 +258,66 @@ bool Writer::write(
         return false;
     }
 
+    DataRowSource source(data);
+    return write(filePath, source, separator, textDelimiter, mode, header,
+                 footer, codec, stats, progress);
+}
+
+// Write rows from the source to csv-file
+// @input:
+// - filePath - string with absolute path to csv-file
+// - source - AbstractRowSource object that returns rows that should be
+// written to csv-file. Rows are requested one by one while they are written.
+// - separator - string or character that would separate values in a row
+// (line) in csv-file
+// - textDelimiter - string or character that enclose each element in a row
+// - mode - write mode of the file
+// - header - strings that will be written at the beginning of the file in
+// one line. separator will be used as delimiter character.
+// - footer - strings that will be written at the end of the file in
+// one line. separator will be used as delimiter character.
+// - codec - pointer to codec object that would be used for file writing
+// - stats - optional object for statistics of writing
+// - progress - optional object for progress reporting and cancellation
+// @output:
+// - bool - True if data was written to the file, otherwise False
+bool Writer::write(
+    const QString& filePath,
+    AbstractRowSource& source,
+    const QString& separator,
+    const QString& textDelimiter,
+    const WriteMode mode,
+    const QList<QString>& header,
+    const QList<QString>& footer,
+    const QStringConverter::Encoding codec,
+    WriteStats* stats,
+    Progress* progress)
+{
+    if (filePath.isEmpty()) {
+        qDebug() << __FUNCTION__ << "Error - empty path to file";
+        return false;
+    }
+
     if (false == CheckFile(filePath)) {
         qDebug() << __FUNCTION__ << "Error - wrong file path/name:" << filePath;
         return false;
     }
 
-    ContentIterator content(data, separator, textDelimiter, header, footer);
+    // Progress is calculated from the counters of statistics
+    WriteStats progressStats;
+    progressStats.timings = false;
+    if (progress != nullptr && stats == nullptr) { stats = &progressStats; }
+
+    ContentIterator content(
+        source, separator, textDelimiter, header, footer, stats, progress);
     switch (mode)
     {
     case WriteMode::APPEND:
-        return WriterPrivate::appendToFile(filePath, content, codec);
+        return WriterPrivate::appendToFile(filePath, content, codec, stats);
         break;
     case WriteMode::REWRITE:
     default:
-        return WriterPrivate::overwriteFile(filePath, content, codec);
+        return WriterPrivate::overwriteFile(filePath, content, codec, stats);
     }
 
     return false;
@@ -243,6 +335,8 @@ bool Writer::write(
 // - footer - strings that will be written at the end of the csv-data in
 // one line. separator will be used as delimiter character.
 // - codec - pointer to codec object that would be used for data writing
+// - stats - optional object for statistics of writing
+// - progress - optional object for progress reporting and cancellation
 // @output:
 // - bool - True if data was written to the IO Device, otherwise False
 bool Writer::write(
@@ -252,13 +346,54 @@ bool Writer::write(
     const QString& textDelimiter,
     const QList<QString>& header,
     const QList<QString>& footer,
-    const QStringConverter::Encoding codec)
+    const QStringConverter::Encoding codec,
+    WriteStats* stats,
+    Progress* progress)
 {
     if (data.isEmpty()) {
         qDebug() << __FUNCTION__ << "Error - empty data";
         return false;
     }
 
-    ContentIterator content(data, separator, textDelimiter, header, footer);
-    return WriterPrivate::writeToIODevice(ioDevice, content, codec);
+    DataRowSource source(data);
+    return write(
+        ioDevice, source, separator, textDelimiter, header, footer, codec,
+        stats, progress);
+}
+
+// Write rows from the source to IO Device
+// @input:
+// - ioDevice - IO Device
+// - source - AbstractRowSource object that returns rows that should be
+// written to IO Device. Rows are requested one by one while they are written.
+// - separator - string or character that would separate values in a row
+// - textDelimiter - string or character that enclose each element in a row
+// - header - strings that will be written at the beginning of the csv-data in
+// one line. separator will be used as delimiter character.
+// - footer - strings that will be written at the end of the csv-data in
+// one line. separator will be used as delimiter character.
+// - codec - pointer to codec object that would be used for data writing
+// - stats - optional object for statistics of writing
+// - progress - optional object for progress reporting and cancellation
+// @output:
+// - bool - True if data was written to the IO Device, otherwise False
+bool Writer::write(
+    QIODevice& ioDevice,
+    AbstractRowSource& source,
+    const QString& separator,
+    const QString& textDelimiter,
+    const QList<QString>& header,
+    const QList<QString>& footer,
+    const QStringConverter::Encoding codec,
+    WriteStats* stats,
+    Progress* progress)
+{
+    // Progress is calculated from the counters of statistics
+    WriteStats progressStats;
+    progressStats.timings = false;
+    if (progress != nullptr && stats == nullptr) { stats = &progressStats; }
+
+    ContentIterator content(
+        source, separator, textDelimiter, header, footer, stats, progress);
+    return WriterPrivate::writeToIODevice(ioDevice, content, codec, stats);
 }
@@ -0,0 +1,57 @@
+#include "tempdirtest.h"
+#include "qtcsv/stringdata.h"
+#include "qtcsv/writer.h"
+#include <QFile>
+
+void TempDirTest::init() {
+    QVERIFY2(createDir(), "Failed to create temporary directory");
+}
+
+void TempDirTest::cleanup() {
+    removeDir();
+}
+
+bool TempDirTest::createDir() {
+    m_dir = std::make_unique<QTemporaryDir>();
+    return m_dir->isValid();
+}
+
+void TempDirTest::removeDir() {
+    m_dir.reset();
+}
+
+QString TempDirTest::dirPath() const {
+    return m_dir->path();
+}
+
+QString TempDirTest::filePath(const QString& name) const {
+    return m_dir->filePath(name);
+}
+
+QString TempDirTest::writeTestFile(
+    const QString& name, const QByteArray& data) const
+{
+    const auto path = filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+        file.write(data) != data.size())
+    {
+        return QString();
+    }
+
+    return path;
+}
+
+QString TempDirTest::writeCsvFile(
+    const QString& name, const QList<QList<QString>>& rows) const
+{
+    QtCSV::StringData data;
+    for (const auto& row : rows) { data.addRow(row); }
+
+    const auto path = filePath(name);
+    return QtCSV::Writer::write(path, data) ? path : QString();
+}
+
+QString TempDirTest::writeCsvFile(const QList<QList<QString>>& rows) const {
+    return writeCsvFile("input.csv", rows);
+}
@@ -0,0 +1,49 @@
+#ifndef TEMPDIRTEST_H
+#define TEMPDIRTEST_H
+
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <memory>
+
+// TempDirTest is a base class of tests that work with files. Each test
+// function gets a new empty temporary directory that is removed after it.
+// Test class that has its own init() and cleanup() should call createDir()
+// and removeDir().
+class TempDirTest : public QObject {
+    Q_OBJECT
+
+public:
+    TempDirTest() = default;
+
+protected:
+    // Create new temporary directory
+    bool createDir();
+    // Remove temporary directory with all its files
+    void removeDir();
+
+    // Get path of the temporary directory
+    QString dirPath() const;
+    // Get path of the file in the temporary directory
+    QString filePath(const QString& name) const;
+
+    // Write data to the file in the temporary directory. Returns path to
+    // the file or empty string on error.
+    QString writeTestFile(const QString& name, const QByteArray& data) const;
+    // Write rows to the csv-file in the temporary directory. Returns path to
+    // the file or empty string on error.
+    QString writeCsvFile(
+        const QString& name, const QList<QList<QString>>& rows) const;
+    QString writeCsvFile(const QList<QList<QString>>& rows) const;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+private:
+    std::unique_ptr<QTemporaryDir> m_dir;
+};
+
+#endif // TEMPDIRTEST_H
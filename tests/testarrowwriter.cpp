@@ -0,0 +1,188 @@
+#include "testarrowwriter.h"
+#include "qtcsv/arrowwriter.h"
+#include "qtcsv/reader.h"
+#include <QBuffer>
+#include <QtEndian>
+
+namespace {
+    // Message of Arrow stream
+    struct ArrowMessage {
+        QByteArray metadata;
+        QByteArray body;
+    };
+
+    // Split Arrow stream into messages. Length of the body is read from
+    // the Message table of the metadata.
+    bool SplitStream(const QByteArray& stream, QList<ArrowMessage>& messages)
+    {
+        const auto* data = stream.constData();
+        qsizetype position = 0;
+        while (position + 8 <= stream.size()) {
+            if (qFromLittleEndian<quint32>(data + position) != 0xFFFFFFFF) {
+                return false;
+            }
+
+            const auto size = qFromLittleEndian<qint32>(data + position + 4);
+            position += 8;
+            if (size == 0) { return position == stream.size(); }
+
+            if (size % 8 != 0 || stream.size() < position + size) {
+                return false;
+            }
+
+            // Field 3 of the Message table is the length of the body
+            ArrowMessage message;
+            message.metadata = stream.mid(position, size);
+            const auto* metadata = message.metadata.constData();
+            const auto table = qFromLittleEndian<quint32>(metadata);
+            const auto vtable =
+                table - qFromLittleEndian<qint32>(metadata + table);
+            const auto field =
+                qFromLittleEndian<quint16>(metadata + vtable + 10);
+            const auto bodyLength =
+                qFromLittleEndian<qint64>(metadata + table + field);
+            position += size;
+            if (stream.size() < position + bodyLength) { return false; }
+
+            message.body = stream.mid(position, bodyLength);
+            position += bodyLength;
+            messages << message;
+        }
+
+        return false;
+    }
+
+    // Get little-endian bytes of numbers
+    template <typename T>
+    QByteArray Numbers(const QList<T>& values) {
+        QByteArray bytes;
+        for (const auto value : values) {
+            char buffer[sizeof(T)];
+            qToLittleEndian<T>(value, buffer);
+            bytes.append(buffer, sizeof(T));
+        }
+
+        return bytes;
+    }
+}
+
+void TestArrowWriter::testEmptyData() {
+    const auto path = writeTestFile("header.csv", "id,value\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QBuffer output;
+    QVERIFY2(output.open(QIODevice::WriteOnly), "Failed to open buffer");
+    QtCSV::ArrowWriter writer(output);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, writer),
+             "Failed to read file");
+    QVERIFY2(writer.finish(), "Failed to finish stream");
+    QVERIFY2(0 == writer.batchCount(), "Wrong number of batches");
+
+    // Only schema and the end of the stream
+    QList<ArrowMessage> messages;
+    QVERIFY2(SplitStream(output.data(), messages), "Wrong stream");
+    QVERIFY2(1 == messages.size(), "Wrong number of messages");
+    QVERIFY2(messages.first().body.isEmpty(), "Schema has body");
+    QVERIFY2(messages.first().metadata.contains("id") &&
+                 messages.first().metadata.contains("value"),
+             "Schema has no names of columns");
+}
+
+void TestArrowWriter::testBatches() {
+    const auto path = writeTestFile("data.csv", "n\n1\n2\n3\n4\n5\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Schema schema;
+    schema.addColumn("n", QtCSV::Schema::Type::INTEGER);
+
+    QBuffer output;
+    QVERIFY2(output.open(QIODevice::WriteOnly), "Failed to open buffer");
+    QtCSV::ArrowWriter writer(output, schema);
+    writer.setBatchRows(2);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, writer),
+             "Failed to read file");
+    QVERIFY2(writer.finish(), "Failed to finish stream");
+    QVERIFY2(3 == writer.batchCount(), "Wrong number of batches");
+
+    // Column without nulls has no validity bitmap
+    QList<ArrowMessage> messages;
+    QVERIFY2(SplitStream(output.data(), messages), "Wrong stream");
+    QVERIFY2(4 == messages.size(), "Wrong number of messages");
+    QVERIFY2(Numbers<qint64>({1, 2}) == messages.at(1).body,
+             "Wrong body of the first batch");
+    QVERIFY2(Numbers<qint64>({3, 4}) == messages.at(2).body,
+             "Wrong body of the second batch");
+    QVERIFY2(Numbers<qint64>({5}) == messages.at(3).body,
+             "Wrong body of the last batch");
+}
+
+void TestArrowWriter::testNullsAndTypes() {
+    const auto path = writeTestFile(
+        "data.csv", "flag,n,x\ntrue,1,0.5\nfalse,,1.5\n,3,2.5\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Schema schema;
+    schema.addColumn("n", QtCSV::Schema::Type::INTEGER)
+        .addColumn("flag", QtCSV::Schema::Type::BOOL)
+        .addColumn("x", QtCSV::Schema::Type::DOUBLE);
+
+    QBuffer output;
+    QVERIFY2(output.open(QIODevice::WriteOnly), "Failed to open buffer");
+    QtCSV::ArrowWriter writer(output, schema);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, writer),
+             "Failed to read file");
+    QVERIFY2(writer.finish(), "Failed to finish stream");
+
+    // Buffers are padded to 8 bytes. Bitmaps have a bit per row.
+    const auto padding = QByteArray(7, '\0');
+    const auto expected =
+        QByteArray(1, '\x05') + padding + Numbers<qint64>({1, 0, 3}) +
+        QByteArray(1, '\x03') + padding + QByteArray(1, '\x01') + padding +
+        Numbers<double>({0.5, 1.5, 2.5});
+
+    QList<ArrowMessage> messages;
+    QVERIFY2(SplitStream(output.data(), messages), "Wrong stream");
+    QVERIFY2(2 == messages.size(), "Wrong number of messages");
+    QVERIFY2(expected == messages.at(1).body, "Wrong body of the batch");
+}
+
+void TestArrowWriter::testStrings() {
+    const auto path = writeTestFile(
+        "data.csv", "name\nab\n\xD0\xBF\n\"c\nd\"\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QBuffer output;
+    QVERIFY2(output.open(QIODevice::WriteOnly), "Failed to open buffer");
+    QtCSV::ArrowWriter writer(output);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, writer),
+             "Failed to read file");
+    QVERIFY2(writer.finish(), "Failed to finish stream");
+
+    // Offsets of values and their UTF-8 bytes
+    const auto expected = Numbers<qint32>({0, 2, 4, 7}) +
+        QByteArray("ab\xD0\xBF" "c\nd") + QByteArray(1, '\0');
+
+    QList<ArrowMessage> messages;
+    QVERIFY2(SplitStream(output.data(), messages), "Wrong stream");
+    QVERIFY2(2 == messages.size(), "Wrong number of messages");
+    QVERIFY2(expected == messages.at(1).body, "Wrong body of the batch");
+}
+
+void TestArrowWriter::testFinish() {
+    const auto path = writeTestFile("data.csv", "id\n1\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QBuffer output;
+    QVERIFY2(output.open(QIODevice::WriteOnly), "Failed to open buffer");
+    QtCSV::ArrowWriter writer(output);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, writer),
+             "Failed to read file");
+    QVERIFY2(writer.finish(), "Failed to finish stream");
+
+    const auto stream = output.data();
+    QVERIFY2(!writer.finish(), "Stream was finished twice");
+    writer.reset();
+    QVERIFY2(!QtCSV::Reader::readToProcessor(path, writer),
+             "Rows were written after the end of the stream");
+    QVERIFY2(stream == output.data(), "Data was written after the end");
+}
@@ -0,0 +1,20 @@
+#ifndef TESTARROWWRITER_H
+#define TESTARROWWRITER_H
+
+#include "tempdirtest.h"
+
+class TestArrowWriter : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestArrowWriter() = default;
+
+private Q_SLOTS:
+    void testEmptyData();
+    void testBatches();
+    void testNullsAndTypes();
+    void testStrings();
+    void testFinish();
+};
+
+#endif // TESTARROWWRITER_H
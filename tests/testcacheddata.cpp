@@ -0,0 +1,150 @@
+#include "testcacheddata.h"
+#include "qtcsv/cacheddata.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/writer.h"
+#include <QFileInfo>
+
+QString TestCachedData::cachePath() const {
+    return filePath("input.qtcsvcache");
+}
+
+void TestCachedData::testLoadInvalidArgs() {
+    QtCSV::CachedData data;
+    QVERIFY2(!data.load(filePath("absent.csv"), cachePath()),
+             "Absent file was loaded");
+    QVERIFY2(!QFileInfo::exists(cachePath()), "Cache was created");
+
+    const auto path = writeCsvFile({{"a", "b"}});
+    QVERIFY2(!data.load(path, cachePath(), QString()),
+             "File was loaded with empty separator");
+}
+
+void TestCachedData::testLoadCreatesCache() {
+    const QList<QList<QString>> rows = {{"id", "name", "comment"},
+        {"1", "first", "text, with separator"}, {},
+        {"2", "second", "multi\nline"}, {"3", "first"}};
+    const auto path = writeCsvFile(rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::CachedData data;
+    QVERIFY2(!data.openCache(path, cachePath()), "Cache does not exist yet");
+    QVERIFY2(data.load(path, cachePath()), "Failed to load file");
+    QVERIFY2(QFileInfo::exists(cachePath()), "Cache was not created");
+
+    const auto expected = QtCSV::Reader::readToList(path);
+    QVERIFY2(expected.size() == data.rowCount(), "Wrong number of rows");
+    for (qsizetype i = 0; i < data.rowCount(); ++i) {
+        QVERIFY2(expected.at(i) == data.rowValues(i), "Wrong row values");
+    }
+
+    QtCSV::CachedData cached;
+    QVERIFY2(cached.openCache(path, cachePath()), "Failed to open cache");
+    QVERIFY2(expected.size() == cached.rowCount(), "Wrong number of rows");
+    for (qsizetype i = 0; i < cached.rowCount(); ++i) {
+        QVERIFY2(expected.at(i) == cached.rowValues(i), "Wrong row values");
+    }
+
+    QVERIFY2(3 == cached.columnCount(), "Wrong number of columns");
+    QVERIFY2(cached.rowValues(-1).isEmpty() &&
+                 cached.rowValues(cached.rowCount()).isEmpty(),
+             "Invalid row is not empty");
+}
+
+void TestCachedData::testColumnTypes() {
+    const auto path = writeCsvFile({{"10", "1.5", "007", "x"},
+        {"-3", "", "8", "1"}, {"", "2", "9"}, {"42", "1e+100", "1", "2"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::CachedData data;
+    QVERIFY2(data.load(path, cachePath()), "Failed to load file");
+
+    using Type = QtCSV::CachedData::ColumnType;
+    QVERIFY2(Type::INTEGER == data.columnType(0), "Wrong type of column 0");
+    QVERIFY2(Type::DOUBLE == data.columnType(1), "Wrong type of column 1");
+    QVERIFY2(Type::STRING == data.columnType(2), "Wrong type of column 2");
+    QVERIFY2(Type::STRING == data.columnType(3), "Wrong type of column 3");
+
+    QVERIFY2(QVariant(qlonglong(-3)) == data.value(1, 0), "Wrong integer");
+    QVERIFY2(!data.value(2, 0).isValid(), "Empty integer is not invalid");
+    QVERIFY2(QVariant(1.5) == data.value(0, 1), "Wrong double");
+    QVERIFY2(QVariant(QString("007")) == data.value(0, 2), "Wrong string");
+    QVERIFY2(!data.value(2, 3).isValid(), "Missing value is not invalid");
+
+    QVERIFY2(QList<QString>({"42", "1e+100", "1", "2"}) == data.rowValues(3),
+             "Numbers were not restored exactly");
+    QVERIFY2(QList<QString>({"", "2", "9"}) == data.rowValues(2),
+             "Short row was not restored exactly");
+}
+
+void TestCachedData::testCacheInvalidation() {
+    auto path = writeCsvFile({{"a", "b"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+    QVERIFY2(QtCSV::CachedData::writeCache(path, cachePath()),
+             "Failed to write cache");
+
+    QtCSV::CachedData data;
+    QVERIFY2(data.openCache(path, cachePath()), "Failed to open cache");
+    QVERIFY2(!data.openCache(path, cachePath(), ";"),
+             "Cache was opened with another separator");
+    QVERIFY2(!data.openCache(path, cachePath(), ",", "'"),
+             "Cache was opened with another text delimiter");
+
+    path = writeCsvFile({{"a", "b"}, {"c", "d"}});
+    QVERIFY2(!data.openCache(path, cachePath()),
+             "Cache of modified file was opened");
+
+    QVERIFY2(data.load(path, cachePath()), "Failed to load file");
+    QVERIFY2(2 == data.rowCount(), "Cache was not rebuilt");
+    QVERIFY2(data.openCache(path, cachePath()), "Failed to open new cache");
+
+    // Corrupted cache is ignored
+    QFile cache(cachePath());
+    QVERIFY2(cache.open(QIODevice::ReadWrite), "Failed to open cache file");
+    cache.resize(cache.size() / 2);
+    cache.close();
+    QVERIFY2(!data.openCache(path, cachePath()),
+             "Corrupted cache was opened");
+    QVERIFY2(data.load(path, cachePath()), "Failed to load file");
+    QVERIFY2(2 == data.rowCount(), "Wrong number of rows");
+
+    // Number of rows of the header that overflows size of the row index.
+    // It is located after 64 bytes of the header.
+    const quint64 rowCount = (quint64(1) << 62) + 1;
+    QVERIFY2(cache.open(QIODevice::ReadWrite) && cache.seek(64) &&
+                 cache.write(reinterpret_cast<const char*>(&rowCount),
+                             sizeof(rowCount)) == sizeof(rowCount),
+             "Failed to change cache file");
+    cache.close();
+    QVERIFY2(!data.openCache(path, cachePath()),
+             "Cache with huge number of rows was opened");
+}
+
+void TestCachedData::testAddRows() {
+    const auto path = writeCsvFile({{"a", "b"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::CachedData data;
+    QVERIFY2(data.load(path, cachePath()), "Failed to load file");
+    data.addRow({"c", "d"});
+    data.addEmptyRow();
+    QVERIFY2(3 == data.rowCount(), "Wrong number of rows");
+    QVERIFY2(QList<QString>({"c", "d"}) == data.rowValues(1),
+             "Wrong added row");
+    QVERIFY2(data.rowValues(2).isEmpty(), "Wrong empty row");
+
+    data.clear();
+    QVERIFY2(data.isEmpty(), "Data was not cleared");
+}
+
+void TestCachedData::testWriteCachedData() {
+    const QList<QList<QString>> rows = {{"1", "one"}, {"2", "two, three"}};
+    const auto path = writeCsvFile(rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::CachedData data;
+    QVERIFY2(data.load(path, cachePath()), "Failed to load file");
+
+    const auto output = filePath("output.csv");
+    QVERIFY2(QtCSV::Writer::write(output, data), "Failed to write data");
+    QVERIFY2(rows == QtCSV::Reader::readToList(output), "Wrong output");
+}
@@ -0,0 +1,24 @@
+#ifndef TESTCACHEDDATA_H
+#define TESTCACHEDDATA_H
+
+#include "tempdirtest.h"
+
+class TestCachedData : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestCachedData() = default;
+
+private Q_SLOTS:
+    void testLoadInvalidArgs();
+    void testLoadCreatesCache();
+    void testColumnTypes();
+    void testCacheInvalidation();
+    void testAddRows();
+    void testWriteCachedData();
+
+private:
+    QString cachePath() const;
+};
+
+#endif // TESTCACHEDDATA_H
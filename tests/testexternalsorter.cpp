@@ -0,0 +1,96 @@
+#include "testexternalsorter.h"
+#include "qtcsv/externalsorter.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/writer.h"
+#include <QRandomGenerator>
+
+void TestExternalSorter::testSortInvalidArgs() {
+    QtCSV::ExternalSorter sorter;
+    const auto output = filePath("output.csv");
+    QVERIFY2(!sorter.sort(filePath("absent.csv"), output),
+             "Absent file was sorted");
+
+    const auto input = writeCsvFile({{"b"}, {"a"}});
+    QVERIFY2(!input.isEmpty(), "Failed to write test file");
+    QVERIFY2(!sorter.sort(input, output, QString()),
+             "Data with empty separator was sorted");
+}
+
+void TestExternalSorter::testSortLexical() {
+    const auto input = writeCsvFile(
+        {{"name", "value"}, {"pear", "1"}, {"apple", "2"}, {"Zebra", "3"},
+         {"apple", "4"}});
+    QVERIFY2(!input.isEmpty(), "Failed to write test file");
+
+    QtCSV::ExternalSorter sorter;
+    sorter.setHasHeader(true);
+    const auto output = filePath("output.csv");
+    QVERIFY2(sorter.sort(input, output), "Failed to sort file");
+
+    const auto result = QtCSV::Reader::readToList(output);
+    QList<QList<QString>> expected = {{"name", "value"}, {"Zebra", "3"},
+        {"apple", "2"}, {"apple", "4"}, {"pear", "1"}};
+    QVERIFY2(expected == result, "Wrong order of rows");
+}
+
+void TestExternalSorter::testSortByNumericKeys() {
+    const auto input = writeCsvFile({{"10", "a"}, {"9", "b"}, {"n/a", "c"},
+        {"-1.5", "d"}, {"10", "e"}, {"", "f"}});
+    QVERIFY2(!input.isEmpty(), "Failed to write test file");
+
+    QtCSV::ExternalSorter sorter;
+    QtCSV::ExternalSorter::SortKey number;
+    number.type = QtCSV::ExternalSorter::KeyType::NUMERIC;
+    QtCSV::ExternalSorter::SortKey letter;
+    letter.column = 1;
+    letter.order = Qt::DescendingOrder;
+    sorter.setKeys({number, letter});
+
+    const auto output = filePath("output.csv");
+    QVERIFY2(sorter.sort(input, output), "Failed to sort file");
+
+    const auto result = QtCSV::Reader::readToList(output);
+    QList<QList<QString>> expected = {{"-1.5", "d"}, {"9", "b"},
+        {"10", "e"}, {"10", "a"}, {"", "f"}, {"n/a", "c"}};
+    QVERIFY2(expected == result, "Wrong order of rows");
+}
+
+void TestExternalSorter::testSortWithRuns() {
+    // Values with separators and line breaks must survive temporary files
+    QList<QList<QString>> rows;
+    const auto rowsNumber = 2000;
+    for (auto i = 0; i < rowsNumber; ++i) {
+        const auto key = QRandomGenerator::global()->bounded(100);
+        rows << QList<QString>{QString::number(key), QString::number(i),
+                               QString("text, with\nline break %1").arg(i)};
+    }
+
+    const auto input = writeCsvFile(rows);
+    QVERIFY2(!input.isEmpty(), "Failed to write test file");
+
+    QtCSV::ExternalSorter sorter;
+    QtCSV::ExternalSorter::SortKey key;
+    key.type = QtCSV::ExternalSorter::KeyType::NUMERIC;
+    sorter.setKeys({key});
+    sorter.setMemoryLimit(20000);
+    sorter.setThreadCount(2);
+    sorter.setMaxMergeFanIn(3);
+    sorter.setTempDir(dirPath());
+
+    const auto output = filePath("output.csv");
+    QVERIFY2(sorter.sort(input, output), "Failed to sort file");
+
+    std::stable_sort(rows.begin(), rows.end(),
+        [](const QList<QString>& first, const QList<QString>& second) {
+            return first.at(0).toInt() < second.at(0).toInt();
+        });
+
+    const auto result = QtCSV::Reader::readToList(output);
+    QVERIFY2(rows.size() == result.size(), "Wrong number of rows");
+    QVERIFY2(rows == result, "Wrong order of rows");
+
+    // All temporary files must be removed
+    const auto entries = QDir(dirPath()).entryList(
+        QDir::AllEntries | QDir::NoDotAndDotDot);
+    QVERIFY2(2 == entries.size(), "Temporary files were not removed");
+}
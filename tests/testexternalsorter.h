@@ -0,0 +1,19 @@
+#ifndef TESTEXTERNALSORTER_H
+#define TESTEXTERNALSORTER_H
+
+#include "tempdirtest.h"
+
+class TestExternalSorter : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestExternalSorter() = default;
+
+private Q_SLOTS:
+    void testSortInvalidArgs();
+    void testSortLexical();
+    void testSortByNumericKeys();
+    void testSortWithRuns();
+};
+
+#endif // TESTEXTERNALSORTER_H
@@ -0,0 +1,166 @@
+#include "testfilefollower.h"
+#include "qtcsv/filefollower.h"
+#include <QFile>
+
+void TestFileFollower::init() {
+    QVERIFY2(createDir(), "Failed to create temporary directory");
+    m_path = filePath("log.csv");
+}
+
+bool TestFileFollower::writeRaw(
+    const QByteArray& content, const bool append) const
+{
+    QFile file(m_path);
+    const auto mode = append ?
+        QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate;
+    return file.open(mode) && file.write(content) == content.size();
+}
+
+void TestFileFollower::testStartInvalidArgs() {
+    QtCSV::FileFollower follower;
+    QVERIFY2(!follower.start(filePath("absent.csv")),
+             "Absent file is followed");
+    QVERIFY2(writeRaw("a,b\n", false), "Failed to write test file");
+    QVERIFY2(!follower.start(m_path, QString()),
+             "File is followed with empty separator");
+    QVERIFY2(!follower.isFollowing() && !follower.poll(),
+             "Follower is active");
+}
+
+void TestFileFollower::testExistingRows() {
+    QVERIFY2(writeRaw("a,b\n1,2\n", false), "Failed to write test file");
+
+    QtCSV::FileFollower follower;
+    QList<QList<QString>> rows;
+    connect(&follower, &QtCSV::FileFollower::rowsAppended,
+            [&rows](const QList<QList<QString>>& newRows) { rows << newRows; });
+
+    QVERIFY2(follower.start(m_path), "Failed to start following");
+    QVERIFY2(follower.isFollowing(), "File is not followed");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    QList<QList<QString>> expected = {{"a", "b"}, {"1", "2"}};
+    QVERIFY2(expected == rows, "Wrong existing rows");
+    QVERIFY2(2 == follower.rowCount() && 8 == follower.position(),
+             "Wrong position");
+
+    // Nothing new
+    QVERIFY2(follower.poll() && expected == rows, "Rows were repeated");
+
+    QVERIFY2(writeRaw("3,4\n", true), "Failed to append to file");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    expected << QList<QString>{"3", "4"};
+    QVERIFY2(expected == rows, "Wrong appended rows");
+
+    follower.stop();
+    QVERIFY2(!follower.isFollowing(), "File is still followed");
+}
+
+void TestFileFollower::testSkipExistingRows() {
+    QVERIFY2(writeRaw("a,b\n1,", false), "Failed to write test file");
+
+    QtCSV::FileFollower follower;
+    QList<QList<QString>> rows;
+    connect(&follower, &QtCSV::FileFollower::rowsAppended,
+            [&rows](const QList<QList<QString>>& newRows) { rows << newRows; });
+
+    QVERIFY2(follower.start(m_path, ",", "\"", QStringConverter::Utf8, true),
+             "Failed to start following");
+    QVERIFY2(follower.poll() && rows.isEmpty(), "Existing rows were read");
+    QVERIFY2(0 == follower.rowCount(), "Wrong number of rows");
+
+    // Incomplete row is not skipped
+    QVERIFY2(writeRaw("2\n", true), "Failed to append to file");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    const QList<QList<QString>> expected = {{"1", "2"}};
+    QVERIFY2(expected == rows, "Wrong appended rows");
+}
+
+void TestFileFollower::testIncompleteRows() {
+    QVERIFY2(writeRaw("1,\"multi\n", false), "Failed to write test file");
+
+    QtCSV::FileFollower follower;
+    QList<QList<QString>> rows;
+    connect(&follower, &QtCSV::FileFollower::rowsAppended,
+            [&rows](const QList<QList<QString>>& newRows) { rows << newRows; });
+
+    QVERIFY2(follower.start(m_path), "Failed to start following");
+    QVERIFY2(follower.poll() && rows.isEmpty(),
+             "Row with open quoted value was read");
+
+    QVERIFY2(writeRaw("line\"", true), "Failed to append to file");
+    QVERIFY2(follower.poll() && rows.isEmpty(),
+             "Row without line end was read");
+    QVERIFY2(0 == follower.position(), "Wrong position");
+
+    QVERIFY2(writeRaw("\n2,\"x\"\"\n", true), "Failed to append to file");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    QList<QList<QString>> expected = {{"1", "multi\nline"}};
+    QVERIFY2(expected == rows, "Wrong complete rows");
+
+    QVERIFY2(writeRaw("y\"\n", true), "Failed to append to file");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    expected << QList<QString>{"2", "x\"\ny"};
+    QVERIFY2(expected == rows, "Wrong complete rows");
+}
+
+void TestFileFollower::testLineEndSplitBetweenAppends() {
+    QVERIFY2(writeRaw("a,b\r", false), "Failed to write test file");
+
+    QtCSV::FileFollower follower;
+    QList<QList<QString>> rows;
+    connect(&follower, &QtCSV::FileFollower::rowsAppended,
+            [&rows](const QList<QList<QString>>& newRows) { rows << newRows; });
+
+    QVERIFY2(follower.start(m_path), "Failed to start following");
+    QVERIFY2(follower.poll() && rows.isEmpty(), "Row was read before LF");
+
+    QVERIFY2(writeRaw("\nc,d\r\n", true), "Failed to append to file");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    const QList<QList<QString>> expected = {{"a", "b"}, {"c", "d"}};
+    QVERIFY2(expected == rows, "Wrong rows");
+}
+
+void TestFileFollower::testTruncatedFile() {
+    QVERIFY2(writeRaw("1,2\n3,4\n", false), "Failed to write test file");
+
+    QtCSV::FileFollower follower;
+    QList<QList<QString>> rows;
+    auto resets = 0;
+    connect(&follower, &QtCSV::FileFollower::rowsAppended,
+            [&rows](const QList<QList<QString>>& newRows) { rows << newRows; });
+    connect(&follower, &QtCSV::FileFollower::fileReset,
+            [&resets]() { ++resets; });
+
+    QVERIFY2(follower.start(m_path) && follower.poll(),
+             "Failed to read file");
+
+    rows.clear();
+    QVERIFY2(writeRaw("5,6\n", false), "Failed to truncate file");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    const QList<QList<QString>> expected = {{"5", "6"}};
+    QVERIFY2(1 == resets && expected == rows, "Truncation was not detected");
+    QVERIFY2(1 == follower.rowCount(), "Wrong number of rows");
+}
+
+void TestFileFollower::testReplacedFile() {
+    QVERIFY2(writeRaw("1,2\n", false), "Failed to write test file");
+
+    QtCSV::FileFollower follower;
+    QList<QList<QString>> rows;
+    auto resets = 0;
+    connect(&follower, &QtCSV::FileFollower::rowsAppended,
+            [&rows](const QList<QList<QString>>& newRows) { rows << newRows; });
+    connect(&follower, &QtCSV::FileFollower::fileReset,
+            [&resets]() { ++resets; });
+
+    QVERIFY2(follower.start(m_path) && follower.poll(),
+             "Failed to read file");
+
+    // New file is longer than the old one
+    rows.clear();
+    QVERIFY2(QFile::remove(m_path) && writeRaw("7,8\n9,0\n", false),
+             "Failed to replace file");
+    QVERIFY2(follower.poll(), "Failed to read file");
+    const QList<QList<QString>> expected = {{"7", "8"}, {"9", "0"}};
+    QVERIFY2(1 == resets && expected == rows, "Replacement was not detected");
+}
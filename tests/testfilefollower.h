@@ -0,0 +1,29 @@
+#ifndef TESTFILEFOLLOWER_H
+#define TESTFILEFOLLOWER_H
+
+#include "tempdirtest.h"
+
+class TestFileFollower : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestFileFollower() = default;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void testStartInvalidArgs();
+    void testExistingRows();
+    void testSkipExistingRows();
+    void testIncompleteRows();
+    void testLineEndSplitBetweenAppends();
+    void testTruncatedFile();
+    void testReplacedFile();
+
+private:
+    bool writeRaw(const QByteArray& content, bool append) const;
+
+    QString m_path;
+};
+
+#endif // TESTFILEFOLLOWER_H
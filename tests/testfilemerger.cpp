@@ -0,0 +1,168 @@
+#include "testfilemerger.h"
+#include "qtcsv/filemerger.h"
+#include "qtcsv/reader.h"
+#include <QFile>
+
+QByteArray TestFileMerger::readTestFile(const QString& path) const {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+void TestFileMerger::testMergeInvalidArgs() {
+    const auto path = writeTestFile("data.csv", "1,2\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    const auto outputPath = filePath("output.csv");
+    QVERIFY2(!QtCSV::FileMerger::merge(
+                 {path, filePath("absent.csv")}, outputPath),
+             "Absent file was merged");
+    QVERIFY2(!QFile::exists(outputPath), "Failed merge created file");
+    QVERIFY2(!QtCSV::FileMerger::merge({path}, outputPath, false,
+                                       QtCSV::Writer::WriteMode::REWRITE,
+                                       QString()),
+             "Files were merged with empty separator");
+    QVERIFY2(!QtCSV::FileMerger::merge({path}, path),
+             "File was merged into itself");
+    QVERIFY2("1,2\n" == readTestFile(path), "Merged file was changed");
+}
+
+void TestFileMerger::testMergeWithHeader() {
+    // Quoted value of the header contains line end, the second file has no
+    // line end at the end
+    const QByteArray header("id,\"multi\nline\"\r\n");
+    const auto first = writeTestFile("first.csv", header + "1,a\r\n");
+    const auto second = writeTestFile("second.csv", header + "2,\"b\nc\"");
+    const auto headerOnly = writeTestFile("header.csv", header);
+    const auto empty = writeTestFile("empty.csv", QByteArray());
+    const auto third = writeTestFile("third.csv", header + "3,d\r\n");
+    QVERIFY2(!first.isEmpty() && !second.isEmpty() &&
+                 !headerOnly.isEmpty() && !empty.isEmpty() &&
+                 !third.isEmpty(),
+             "Failed to write test files");
+
+    const auto outputPath = filePath("output.csv");
+    QVERIFY2(QtCSV::FileMerger::merge(
+                 {first, second, headerOnly, empty, third}, outputPath, true),
+             "Failed to merge files");
+    QVERIFY2(header + "1,a\r\n2,\"b\nc\"\r\n3,d\r\n" ==
+                 readTestFile(outputPath),
+             "Wrong content of merged file");
+
+    const QList<QList<QString>> expected = {
+        {"id", "multi\nline"}, {"1", "a"}, {"2", "b\nc"}, {"3", "d"}};
+    QVERIFY2(expected == QtCSV::Reader::readToList(outputPath),
+             "Wrong rows of merged file");
+}
+
+void TestFileMerger::testMergeWithoutHeader() {
+    const auto first = writeTestFile("first.csv", "1,a\n2,b");
+    const auto second = writeTestFile("second.csv", "3,c\n");
+    QVERIFY2(!first.isEmpty() && !second.isEmpty(),
+             "Failed to write test files");
+
+    const auto outputPath = filePath("output.csv");
+    QVERIFY2(writeTestFile("output.csv", "old data\n") == outputPath,
+             "Failed to write output file");
+    QVERIFY2(QtCSV::FileMerger::merge({first, second, first}, outputPath),
+             "Failed to merge files");
+    QVERIFY2("1,a\n2,b\n3,c\n1,a\n2,b\n" == readTestFile(outputPath),
+             "Wrong content of merged file");
+}
+
+void TestFileMerger::testMergeLoneCarriageReturn() {
+    // File ends with CR that is not a line end, so line end is added
+    // before the rows of the next file
+    const auto first = writeTestFile("first.csv", "1,a\r");
+    const auto second = writeTestFile("second.csv", "2,b\n");
+    QVERIFY2(!first.isEmpty() && !second.isEmpty(),
+             "Failed to write test files");
+
+    const auto outputPath = filePath("output.csv");
+    QVERIFY2(QtCSV::FileMerger::merge({first, second}, outputPath),
+             "Failed to merge files");
+    QVERIFY2("1,a\r\n2,b\n" == readTestFile(outputPath),
+             "Wrong content of merged file");
+
+    const QList<QList<QString>> expected = {{"1", "a"}, {"2", "b"}};
+    QVERIFY2(expected == QtCSV::Reader::readToList(outputPath),
+             "Wrong rows of merged file");
+}
+
+void TestFileMerger::testMergeDifferentHeaders() {
+    const auto first = writeTestFile("first.csv", "id,value\n1,a\n");
+    // Header values are compared, not bytes
+    const auto second = writeTestFile("second.csv", "\"id\",value\n2,b\n");
+    const auto third = writeTestFile("third.csv", "id,name\n3,c\n");
+    QVERIFY2(!first.isEmpty() && !second.isEmpty() && !third.isEmpty(),
+             "Failed to write test files");
+
+    const auto outputPath = filePath("output.csv");
+    QVERIFY2(QtCSV::FileMerger::merge({first, second}, outputPath, true),
+             "Failed to merge files with equal headers");
+    QVERIFY2("id,value\n1,a\n2,b\n" == readTestFile(outputPath),
+             "Wrong content of merged file");
+
+    QVERIFY2(!QtCSV::FileMerger::merge({first, third}, outputPath, true),
+             "Files with different headers were merged");
+    QVERIFY2("id,value\n1,a\n2,b\n" == readTestFile(outputPath),
+             "Failed merge changed output file");
+}
+
+void TestFileMerger::testMergeByteOrderMark() {
+    const QByteArray bom("\xEF\xBB\xBF");
+    const auto first = writeTestFile("first.csv", bom + "id\n1\n");
+    const auto second = writeTestFile("second.csv", bom + "id\n2\n");
+    const auto third = writeTestFile("third.csv", "id\n3\n");
+    QVERIFY2(!first.isEmpty() && !second.isEmpty() && !third.isEmpty(),
+             "Failed to write test files");
+
+    const auto outputPath = filePath("output.csv");
+    QVERIFY2(QtCSV::FileMerger::merge({first, second, third}, outputPath,
+                                      true),
+             "Failed to merge files");
+    QVERIFY2(bom + "id\n1\n2\n3\n" == readTestFile(outputPath),
+             "Wrong content of merged file");
+
+    const auto utf16 = writeTestFile(
+        "utf16.csv", QByteArray("\xFF\xFE" "i\0d\0\n\0", 8));
+    QVERIFY2(!utf16.isEmpty(), "Failed to write test file");
+    QVERIFY2(!QtCSV::FileMerger::merge({first, utf16}, outputPath, true),
+             "Files with different codecs were merged");
+}
+
+void TestFileMerger::testAppendToFile() {
+    const auto outputPath = writeTestFile("output.csv", "id,value\n1,a");
+    const auto first = writeTestFile("first.csv", "id,value\n2,b\n");
+    const auto second = writeTestFile("second.csv", "id,value\n3,c");
+    QVERIFY2(!outputPath.isEmpty() && !first.isEmpty() && !second.isEmpty(),
+             "Failed to write test files");
+
+    QVERIFY2(QtCSV::FileMerger::merge({first, second}, outputPath, true,
+                                      QtCSV::Writer::WriteMode::APPEND),
+             "Failed to append files");
+    QVERIFY2("id,value\n1,a\n2,b\n3,c\n" == readTestFile(outputPath),
+             "Wrong content of file after append");
+
+    // Absent file is created
+    const auto newPath = filePath("new.csv");
+    QVERIFY2(QtCSV::FileMerger::merge({second, first}, newPath, true,
+                                      QtCSV::Writer::WriteMode::APPEND),
+             "Failed to append files to absent file");
+    QVERIFY2("id,value\n3,c\n2,b\n" == readTestFile(newPath),
+             "Wrong content of created file");
+}
+
+void TestFileMerger::testAppendDifferentHeader() {
+    const QByteArray content("id,value\n1,a");
+    const auto outputPath = writeTestFile("output.csv", content);
+    const auto first = writeTestFile("first.csv", "id,value\n2,b\n");
+    const auto second = writeTestFile("second.csv", "id,name\n3,c\n");
+    QVERIFY2(!outputPath.isEmpty() && !first.isEmpty() && !second.isEmpty(),
+             "Failed to write test files");
+
+    QVERIFY2(!QtCSV::FileMerger::merge({first, second}, outputPath, true,
+                                       QtCSV::Writer::WriteMode::APPEND),
+             "File with different header was appended");
+    QVERIFY2(content == readTestFile(outputPath),
+             "Failed append changed output file");
+}
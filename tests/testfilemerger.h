@@ -0,0 +1,26 @@
+#ifndef TESTFILEMERGER_H
+#define TESTFILEMERGER_H
+
+#include "tempdirtest.h"
+
+class TestFileMerger : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestFileMerger() = default;
+
+private Q_SLOTS:
+    void testMergeInvalidArgs();
+    void testMergeWithHeader();
+    void testMergeWithoutHeader();
+    void testMergeLoneCarriageReturn();
+    void testMergeDifferentHeaders();
+    void testMergeByteOrderMark();
+    void testAppendToFile();
+    void testAppendDifferentHeader();
+
+private:
+    QByteArray readTestFile(const QString& path) const;
+};
+
+#endif // TESTFILEMERGER_H
@@ -0,0 +1,193 @@
+#include "testfilesplitter.h"
+#include "qtcsv/filesplitter.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/writer.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+QList<QList<QString>> TestFileSplitter::testRows(const int count) const {
+    QList<QList<QString>> rows;
+    for (int i = 0; i < count; ++i) {
+        // Multi-line values could be cut by naive split of lines
+        rows << QList<QString>{
+            QString::number(i),
+            i % 3 == 0 ? QString("first line\nsecond, \"line\"\n") :
+                QString("value %1").arg(i)};
+    }
+
+    return rows;
+}
+
+QList<QList<QString>> TestFileSplitter::readParts(
+    const QList<QString>& paths,
+    const QList<QString>& header) const
+{
+    QList<QList<QString>> rows;
+    for (const auto& path : paths) {
+        auto partRows = QtCSV::Reader::readToList(path);
+        if (!header.isEmpty()) {
+            if (partRows.isEmpty() || partRows.takeFirst() != header) {
+                return {};
+            }
+        }
+
+        // Part without data rows is useless
+        if (partRows.isEmpty()) { return {}; }
+
+        rows << partRows;
+    }
+
+    return rows;
+}
+
+void TestFileSplitter::testSplitInvalidArgs() {
+    const auto path = writeCsvFile("data.csv", testRows(10));
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::FileSplitter splitter(dirPath(), "part");
+    QVERIFY2(!splitter.split(filePath("absent.csv")),
+             "Absent file was split");
+    QVERIFY2(!splitter.split(path, QString()),
+             "File was split with empty separator");
+    QVERIFY2(splitter.files().isEmpty(), "Failed split created files");
+
+    QtCSV::FileSplitter absentDir(filePath("absent"), "part");
+    QVERIFY2(!absentDir.split(path), "File was split to absent directory");
+}
+
+void TestFileSplitter::testSplitByRows() {
+    const QList<QString> header = {"id", "value"};
+    const auto rows = testRows(10);
+    const auto path = writeCsvFile("data.csv", QList<QList<QString>>{header}
+                                    + rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::FileSplitter splitter(dirPath(), "part");
+    splitter.setSplit(QtCSV::FileSplitter::Split::ROWS, 3);
+    splitter.setHasHeader(true);
+    QVERIFY2(splitter.split(path), "Failed to split file");
+
+    const auto files = splitter.files();
+    QVERIFY2(4 == files.size(), "Wrong number of parts");
+    QVERIFY2(filePath("part_00001.csv") == files.first() &&
+                 filePath("part_00004.csv") == files.last(),
+             "Wrong names of parts");
+    QVERIFY2(rows == readParts(files, header), "Wrong rows of parts");
+    for (qsizetype i = 0; i < files.size(); ++i) {
+        const auto partRows = QtCSV::Reader::readToList(files.at(i));
+        QVERIFY2(partRows.size() == (i < 3 ? 4 : 2),
+                 "Wrong number of rows in part");
+    }
+}
+
+void TestFileSplitter::testSplitByBytes() {
+    const auto rows = testRows(100);
+    const auto path = writeCsvFile("data.csv", rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::FileSplitter splitter(dirPath(), "part");
+    splitter.setSplit(QtCSV::FileSplitter::Split::BYTES, 200);
+    QVERIFY2(splitter.split(path), "Failed to split file");
+
+    const auto files = splitter.files();
+    QVERIFY2(QFileInfo(path).size() / 200 <= files.size(),
+             "Wrong number of parts");
+    QVERIFY2(rows == readParts(files), "Wrong rows of parts");
+
+    qint64 totalSize = 0;
+    for (const auto& file : files) {
+        const auto size = QFileInfo(file).size();
+        QVERIFY2(size <= 200, "Part is bigger than the limit");
+        totalSize += size;
+    }
+
+    QVERIFY2(QFileInfo(path).size() == totalSize, "Wrong size of parts");
+
+    // Row that is bigger than the limit gets its own part
+    splitter.setSplit(QtCSV::FileSplitter::Split::BYTES, 1);
+    QVERIFY2(splitter.split(path), "Failed to split file");
+    QVERIFY2(rows.size() == splitter.files().size(),
+             "Wrong number of parts with big rows");
+    QVERIFY2(rows == readParts(splitter.files()),
+             "Wrong rows of parts with big rows");
+}
+
+void TestFileSplitter::testSplitToParts_data() {
+    QTest::addColumn<int>("parts");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 part") << 1 << 1;
+    QTest::newRow("4 parts") << 4 << 1;
+    QTest::newRow("7 parts, 4 threads") << 7 << 4;
+}
+
+void TestFileSplitter::testSplitToParts() {
+    QFETCH(int, parts);
+    QFETCH(int, threads);
+
+    const QList<QString> header = {"id", "value"};
+    const auto rows = testRows(1000);
+    const auto path = writeCsvFile("data.csv", QList<QList<QString>>{header}
+                                    + rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::FileSplitter splitter(dirPath(), "part");
+    splitter.setSplit(QtCSV::FileSplitter::Split::PARTS, parts);
+    splitter.setHasHeader(true);
+    splitter.setThreadCount(threads);
+    QVERIFY2(splitter.split(path), "Failed to split file");
+
+    const auto files = splitter.files();
+    QVERIFY2(parts == files.size(), "Wrong number of parts");
+    QVERIFY2(rows == readParts(files, header), "Wrong rows of parts");
+
+    // Parts have about the same size
+    const auto partSize = QFileInfo(path).size() / parts;
+    for (const auto& file : files) {
+        QVERIFY2(qAbs(QFileInfo(file).size() - partSize) < 200,
+                 "Wrong size of part");
+    }
+}
+
+void TestFileSplitter::testSplitWithByteOrderMark() {
+    const QList<QString> header = {"id", "value"};
+    const auto rows = testRows(10);
+    const auto path = writeCsvFile("data.csv", QList<QList<QString>>{header}
+                                    + rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::ReadOnly), "Failed to open test file");
+    const QByteArray bom("\xEF\xBB\xBF");
+    const auto content = bom + file.readAll();
+    file.close();
+    QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+                 content.size() == file.write(content),
+             "Failed to write byte order mark");
+    file.close();
+
+    QtCSV::FileSplitter splitter(dirPath(), "part");
+    splitter.setSplit(QtCSV::FileSplitter::Split::ROWS, 5);
+    splitter.setHasHeader(true);
+    QVERIFY2(splitter.split(path), "Failed to split file");
+    QVERIFY2(2 == splitter.files().size(), "Wrong number of parts");
+    QVERIFY2(rows == readParts(splitter.files(), header),
+             "Wrong rows of parts");
+
+    for (const auto& partPath : splitter.files()) {
+        QFile part(partPath);
+        QVERIFY2(part.open(QIODevice::ReadOnly) && part.read(3) == bom,
+                 "Part has no byte order mark");
+    }
+}
+
+void TestFileSplitter::testSplitEmptyFile() {
+    const auto path = writeCsvFile("header.csv", {{"id", "value"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::FileSplitter splitter(dirPath(), "part");
+    splitter.setHasHeader(true);
+    QVERIFY2(splitter.split(path), "Failed to split file without rows");
+    QVERIFY2(splitter.files().isEmpty(), "File without rows created parts");
+}
@@ -0,0 +1,28 @@
+#ifndef TESTFILESPLITTER_H
+#define TESTFILESPLITTER_H
+
+#include "tempdirtest.h"
+
+class TestFileSplitter : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestFileSplitter() = default;
+
+private Q_SLOTS:
+    void testSplitInvalidArgs();
+    void testSplitByRows();
+    void testSplitByBytes();
+    void testSplitToParts_data();
+    void testSplitToParts();
+    void testSplitWithByteOrderMark();
+    void testSplitEmptyFile();
+
+private:
+    QList<QList<QString>> testRows(int count) const;
+    QList<QList<QString>> readParts(
+        const QList<QString>& paths,
+        const QList<QString>& header = {}) const;
+};
+
+#endif // TESTFILESPLITTER_H
@@ -0,0 +1,244 @@
+#include "testhashjoin.h"
+#include "qtcsv/hashjoin.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/writer.h"
+#include <QDir>
+#include <algorithm>
+
+// Processor that collects rows and could stop the join
+class JoinRowsProcessor : public QtCSV::Reader::AbstractProcessor {
+public:
+    QList<QList<QString>> rows;
+    qsizetype maxRows = -1;
+
+    bool processRowElements(const QList<QString>& elements) override {
+        if (0 <= maxRows && maxRows <= rows.size()) { return false; }
+
+        rows << elements;
+        return true;
+    }
+};
+
+QList<QList<QString>> TestHashJoin::join(
+    const QtCSV::HashJoin& hashJoin,
+    const QString& leftPath,
+    const QString& rightPath) const
+{
+    JoinRowsProcessor processor;
+    if (!hashJoin.join(leftPath, rightPath, processor)) { return {}; }
+
+    return processor.rows;
+}
+
+void TestHashJoin::testJoinInvalidArgs() {
+    const auto path = writeCsvFile("left.csv", {{"1", "a"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::HashJoin hashJoin;
+    JoinRowsProcessor processor;
+    QVERIFY2(!hashJoin.join(path, filePath("absent.csv"), processor),
+             "Absent file was joined");
+    QVERIFY2(!hashJoin.join(path, path, processor, QString()),
+             "Files were joined with empty separator");
+
+    hashJoin.setKeys({0, 1}, {0});
+    QVERIFY2(!hashJoin.join(path, path, processor),
+             "Files were joined with different number of keys");
+
+    hashJoin.setKeys({-1}, {0});
+    QVERIFY2(!hashJoin.join(path, path, processor),
+             "Files were joined with invalid key column");
+    QVERIFY2(processor.rows.isEmpty(), "Failed join returned rows");
+}
+
+void TestHashJoin::testInnerJoin() {
+    const auto leftPath = writeCsvFile("left.csv", {
+        {"1", "order1", "c2"},
+        {"2", "order2", "c1"},
+        {"3", "order3", "c9"},
+        {"4", "order4", "c1"}});
+    const auto rightPath = writeCsvFile("right.csv", {
+        {"Alice", "c1", "London"},
+        {"Bob", "c2", "Paris"},
+        {"Alice2", "c1", "Berlin"}});
+    QVERIFY2(!leftPath.isEmpty() && !rightPath.isEmpty(),
+             "Failed to write test files");
+
+    QtCSV::HashJoin hashJoin;
+    hashJoin.setKeys({2}, {1});
+    hashJoin.setBatchSize(16);
+    hashJoin.setThreadCount(4);
+
+    const QList<QList<QString>> expected = {
+        {"1", "order1", "c2", "Bob", "Paris"},
+        {"2", "order2", "c1", "Alice", "London"},
+        {"2", "order2", "c1", "Alice2", "Berlin"},
+        {"4", "order4", "c1", "Alice", "London"},
+        {"4", "order4", "c1", "Alice2", "Berlin"}};
+    QVERIFY2(expected == join(hashJoin, leftPath, rightPath),
+             "Wrong joined rows");
+}
+
+void TestHashJoin::testLeftJoin() {
+    const auto leftPath = writeCsvFile("left.csv", {
+        {"a", "1"}, {"b", "2"}, {"c", "3"}});
+    const auto rightPath = writeCsvFile("right.csv", {
+        {"b", "x", "y"}, {"d", "z"}});
+    QVERIFY2(!leftPath.isEmpty() && !rightPath.isEmpty(),
+             "Failed to write test files");
+
+    QtCSV::HashJoin hashJoin;
+    hashJoin.setType(QtCSV::HashJoin::Type::LEFT);
+
+    const QList<QList<QString>> expected = {
+        {"a", "1", "", ""},
+        {"b", "2", "x", "y"},
+        {"c", "3", "", ""}};
+    QVERIFY2(expected == join(hashJoin, leftPath, rightPath),
+             "Wrong joined rows");
+}
+
+void TestHashJoin::testSeveralKeyColumns() {
+    const auto leftPath = writeCsvFile("left.csv", {
+        {"ab", "c", "1"}, {"a", "bc", "2"}, {"a", "b", "3"}});
+    const auto rightPath = writeCsvFile("right.csv", {
+        {"b", "a", "first"}, {"bc", "a", "second"}});
+    QVERIFY2(!leftPath.isEmpty() && !rightPath.isEmpty(),
+             "Failed to write test files");
+
+    QtCSV::HashJoin hashJoin;
+    hashJoin.setKeys({0, 1}, {1, 0});
+
+    const QList<QList<QString>> expected = {
+        {"a", "bc", "2", "second"},
+        {"a", "b", "3", "first"}};
+    QVERIFY2(expected == join(hashJoin, leftPath, rightPath),
+             "Wrong joined rows");
+}
+
+void TestHashJoin::testHeader() {
+    const auto leftPath = writeCsvFile("left.csv", {
+        {"id", "customer"}, {"1", "c1"}});
+    const auto rightPath = writeCsvFile("right.csv", {
+        {"customer", "name"}, {"c1", "Alice"}});
+    QVERIFY2(!leftPath.isEmpty() && !rightPath.isEmpty(),
+             "Failed to write test files");
+
+    QtCSV::HashJoin hashJoin;
+    hashJoin.setKeys({1}, {0});
+    hashJoin.setHasHeader(true);
+
+    const QList<QList<QString>> expected = {
+        {"id", "customer", "name"},
+        {"1", "c1", "Alice"}};
+    QVERIFY2(expected == join(hashJoin, leftPath, rightPath),
+             "Wrong joined rows");
+}
+
+void TestHashJoin::testJoinToFile() {
+    const auto leftPath = writeCsvFile("left.csv", {
+        {"1", "multi\nline, \"quoted\""}, {"2", "plain"}});
+    const auto rightPath = writeCsvFile("right.csv", {
+        {"1", "one, \"first\""}, {"2", "two"}});
+    QVERIFY2(!leftPath.isEmpty() && !rightPath.isEmpty(),
+             "Failed to write test files");
+
+    const auto outputPath = filePath("output.csv");
+    QtCSV::HashJoin hashJoin;
+    QVERIFY2(hashJoin.join(leftPath, rightPath, outputPath),
+             "Failed to join files");
+
+    const QList<QList<QString>> expected = {
+        {"1", "multi\nline, \"quoted\"", "one, \"first\""},
+        {"2", "plain", "two"}};
+    QVERIFY2(expected == QtCSV::Reader::readToList(outputPath),
+             "Wrong joined rows in the file");
+}
+
+void TestHashJoin::testSpilledJoin_data() {
+    QTest::addColumn<int>("type");
+    QTest::addColumn<qint64>("memoryLimit");
+
+    QTest::newRow("inner, in memory") <<
+        static_cast<int>(QtCSV::HashJoin::Type::INNER) << qint64(1 << 30);
+    QTest::newRow("inner, spilled") <<
+        static_cast<int>(QtCSV::HashJoin::Type::INNER) << qint64(1024);
+    QTest::newRow("left, spilled") <<
+        static_cast<int>(QtCSV::HashJoin::Type::LEFT) << qint64(1024);
+    QTest::newRow("left, all levels spilled") <<
+        static_cast<int>(QtCSV::HashJoin::Type::LEFT) << qint64(1);
+}
+
+void TestHashJoin::testSpilledJoin() {
+    QFETCH(int, type);
+    QFETCH(qint64, memoryLimit);
+
+    QList<QList<QString>> leftRows, rightRows;
+    for (int i = 0; i < 500; ++i) {
+        leftRows << QList<QString>{
+            QString::number(i), "key" + QString::number(i % 70)};
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        // Keys repeat, so some left rows match several right rows
+        rightRows << QList<QString>{
+            "key" + QString::number(i % 60), "value" + QString::number(i)};
+    }
+
+    const auto leftPath = writeCsvFile("left.csv", leftRows);
+    const auto rightPath = writeCsvFile("right.csv", rightRows);
+    QVERIFY2(!leftPath.isEmpty() && !rightPath.isEmpty(),
+             "Failed to write test files");
+
+    const auto joinType = static_cast<QtCSV::HashJoin::Type>(type);
+    QList<QList<QString>> expected;
+    for (const auto& left : leftRows) {
+        auto isMatched = false;
+        for (const auto& right : rightRows) {
+            if (left.at(1) == right.at(0)) {
+                expected << left + QList<QString>{right.at(1)};
+                isMatched = true;
+            }
+        }
+
+        if (!isMatched && joinType == QtCSV::HashJoin::Type::LEFT) {
+            expected << left + QList<QString>{QString()};
+        }
+    }
+
+    QtCSV::HashJoin hashJoin;
+    hashJoin.setType(joinType);
+    hashJoin.setKeys({1}, {0});
+    hashJoin.setMemoryLimit(memoryLimit);
+    hashJoin.setTempDir(dirPath());
+    hashJoin.setPartitionCount(4);
+    hashJoin.setBatchSize(256);
+
+    // Partitions change order of rows
+    auto result = join(hashJoin, leftPath, rightPath);
+    std::sort(result.begin(), result.end());
+    std::sort(expected.begin(), expected.end());
+    QVERIFY2(expected == result, "Wrong joined rows");
+
+    const auto tempFiles = QDir(dirPath()).entryList(
+        {"qtcsv-join-*"}, QDir::AllEntries);
+    QVERIFY2(tempFiles.isEmpty(), "Temporary files were not removed");
+}
+
+void TestHashJoin::testProcessorStopsJoin() {
+    QList<QList<QString>> rows;
+    for (int i = 0; i < 100; ++i) {
+        rows << QList<QString>{QString::number(i)};
+    }
+
+    const auto path = writeCsvFile("data.csv", rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::HashJoin hashJoin;
+    hashJoin.setBatchSize(32);
+    JoinRowsProcessor processor;
+    processor.maxRows = 10;
+    QVERIFY2(!hashJoin.join(path, path, processor),
+             "Join was not stopped by processor");
+    QVERIFY2(rows.mid(0, 10) == processor.rows, "Wrong joined rows");
+}
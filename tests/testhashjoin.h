@@ -0,0 +1,34 @@
+#ifndef TESTHASHJOIN_H
+#define TESTHASHJOIN_H
+
+#include "tempdirtest.h"
+
+namespace QtCSV {
+    class HashJoin;
+}
+
+class TestHashJoin : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestHashJoin() = default;
+
+private Q_SLOTS:
+    void testJoinInvalidArgs();
+    void testInnerJoin();
+    void testLeftJoin();
+    void testSeveralKeyColumns();
+    void testHeader();
+    void testJoinToFile();
+    void testSpilledJoin_data();
+    void testSpilledJoin();
+    void testProcessorStopsJoin();
+
+private:
+    QList<QList<QString>> join(
+        const QtCSV::HashJoin& hashJoin,
+        const QString& leftPath,
+        const QString& rightPath) const;
+};
+
+#endif // TESTHASHJOIN_H
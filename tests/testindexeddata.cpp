@@ -0,0 +1,148 @@
+#include "testindexeddata.h"
+#include "qtcsv/indexeddata.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/stringdata.h"
+#include "qtcsv/writer.h"
+
+void TestIndexedData::testOpenInvalidArgs() {
+    QtCSV::IndexedData data;
+    QVERIFY2(!data.open(filePath("absent.csv")),
+             "Absent file was opened");
+    QVERIFY2(!data.isOpen() && data.isEmpty(), "Data is not empty");
+
+    const auto path = writeTestFile("input.csv", "a,b\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+    QVERIFY2(!data.open(path, QString()),
+             "File was opened with empty separator");
+}
+
+void TestIndexedData::testOpenEmptyFile() {
+    const auto path = writeTestFile("input.csv", QByteArray());
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::IndexedData data;
+    QVERIFY2(data.open(path), "Failed to open empty file");
+    QVERIFY2(data.isOpen() && data.isEmpty(), "Empty file has rows");
+    QVERIFY2(data.rowValues(0).isEmpty(), "Invalid row has values");
+}
+
+void TestIndexedData::testRowsMatchReader_data() {
+    QTest::addColumn<QByteArray>("content");
+    QTest::addColumn<QString>("separator");
+    QTest::addColumn<QString>("textDelimiter");
+
+    QTest::newRow("simple") << QByteArray("a,b,c\n1,2,3\n") << "," << "\"";
+    QTest::newRow("no last line end") <<
+        QByteArray("a,b\n1,2") << "," << "\"";
+    QTest::newRow("empty lines") <<
+        QByteArray("a,b\n\n1,2\n\n") << "," << "\"";
+    QTest::newRow("CRLF") <<
+        QByteArray("a,b\r\n\"x\r\ny\",2\r\n") << "," << "\"";
+    QTest::newRow("lone CR") <<
+        QByteArray("a,b\rc,d\n\"x\ry\",2\r\n") << "," << "\"";
+    QTest::newRow("quoted values") << QByteArray(
+        "id,comment\n"
+        "1,\"text, with separator\"\n"
+        "2,\"multi\nline \"\"quoted\"\"\nvalue\"\n"
+        "3,\"\"\"\"\n"
+        "4,\"ends with line end\n\"\n") << "," << "\"";
+    QTest::newRow("quotes inside of unquoted value") <<
+        QByteArray("5\" screen,7\" screen\n1,2\n") << "," << "\"";
+    QTest::newRow("long separator") <<
+        QByteArray("a::b\n'c::d'::'e\nf'\n") << "::" << "'";
+    QTest::newRow("BOM") <<
+        QByteArray("\xEF\xBB\xBFname,city\n\xD0\x90,\xD0\x91\n") << "," <<
+        "\"";
+}
+
+void TestIndexedData::testRowsMatchReader() {
+    QFETCH(QByteArray, content);
+    QFETCH(QString, separator);
+    QFETCH(QString, textDelimiter);
+
+    const auto path = writeTestFile("input.csv", content);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::IndexedData data;
+    QVERIFY2(data.open(path, separator, textDelimiter), "Failed to open file");
+
+    const auto expected =
+        QtCSV::Reader::readToList(path, separator, textDelimiter);
+    QVERIFY2(expected.size() == data.rowCount(), "Wrong number of rows");
+
+    // Rows are parsed in reverse order to check that each row is parsed
+    // independently
+    for (auto i = data.rowCount() - 1; 0 <= i; --i) {
+        QVERIFY2(expected.at(i) == data.rowValues(i), "Wrong row values");
+    }
+}
+
+void TestIndexedData::testUtf16File() {
+    QtCSV::StringData source;
+    source.addRow({QString::fromUtf8("имя"), "text, \"quoted\""});
+    source.addRow({"1", "multi\nline"});
+
+    const auto path = filePath("utf16.csv");
+    QVERIFY2(QtCSV::Writer::write(path, source, ",", "\"",
+                                  QtCSV::Writer::WriteMode::REWRITE, {}, {},
+                                  QStringConverter::Utf16LE),
+             "Failed to write test file");
+
+    QtCSV::IndexedData data;
+    QVERIFY2(data.open(path, ",", "\"", QStringConverter::Utf16LE),
+             "Failed to open file");
+    QVERIFY2(source.rowCount() == data.rowCount(), "Wrong number of rows");
+    for (qsizetype i = 0; i < data.rowCount(); ++i) {
+        QVERIFY2(source.rowValues(i) == data.rowValues(i), "Wrong row values");
+    }
+}
+
+void TestIndexedData::testCacheSize() {
+    QByteArray content;
+    for (auto i = 0; i < 100; ++i) {
+        content += QByteArray::number(i) + ",\"value\n" +
+            QByteArray::number(i) + "\"\n";
+    }
+
+    const auto path = writeTestFile("input.csv", content);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::IndexedData data;
+    QVERIFY2(data.open(path), "Failed to open file");
+    QVERIFY2(100 == data.rowCount(), "Wrong number of rows");
+
+    for (const auto cacheSize : {0, 1, 10}) {
+        data.setCacheSize(cacheSize);
+        for (qsizetype i = 0; i < 300; ++i) {
+            const auto row = (i * 37) % data.rowCount();
+            const QList<QString> expected = {QString::number(row),
+                QString("value\n%1").arg(row)};
+            QVERIFY2(expected == data.rowValues(row), "Wrong row values");
+        }
+    }
+}
+
+void TestIndexedData::testAddRowsAndWrite() {
+    const auto path = writeTestFile("input.csv", "a,b\n\"1,5\",2\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::IndexedData data;
+    QVERIFY2(data.open(path), "Failed to open file");
+    data.addRow({"3", "4"});
+    data.addEmptyRow();
+    QVERIFY2(4 == data.rowCount(), "Wrong number of rows");
+    QVERIFY2((QList<QString>{"3", "4"}) == data.rowValues(2),
+             "Wrong values of the added row");
+
+    const auto outputPath = filePath("output.csv");
+    QVERIFY2(QtCSV::Writer::write(outputPath, data, ";"),
+             "Failed to write data");
+
+    const auto rows = QtCSV::Reader::readToList(outputPath, ";");
+    const QList<QList<QString>> expected =
+        {{"a", "b"}, {"1,5", "2"}, {"3", "4"}, {}};
+    QVERIFY2(expected == rows, "Wrong written rows");
+
+    data.clear();
+    QVERIFY2(!data.isOpen() && data.isEmpty(), "Data was not cleared");
+}
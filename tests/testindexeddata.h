@@ -0,0 +1,22 @@
+#ifndef TESTINDEXEDDATA_H
+#define TESTINDEXEDDATA_H
+
+#include "tempdirtest.h"
+
+class TestIndexedData : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestIndexedData() = default;
+
+private Q_SLOTS:
+    void testOpenInvalidArgs();
+    void testOpenEmptyFile();
+    void testRowsMatchReader_data();
+    void testRowsMatchReader();
+    void testUtf16File();
+    void testCacheSize();
+    void testAddRowsAndWrite();
+};
+
+#endif // TESTINDEXEDDATA_H
@@ -0,0 +1,188 @@
+#include "testjsonconverter.h"
+#include "qtcsv/jsonconverter.h"
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+void TestJsonConverter::testConvertInvalidArgs() {
+    const auto path = writeTestFile("data.csv", "id\n1\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::JsonConverter converter;
+    QBuffer output;
+    QVERIFY2(!converter.convert(filePath("absent.csv"), output),
+             "Absent file was converted");
+    QVERIFY2(!converter.convert(path, output, QString()),
+             "File was converted with empty separator");
+    QVERIFY2(output.data().isEmpty(), "Failed conversion wrote data");
+}
+
+void TestJsonConverter::testConvertToNdjson() {
+    const auto path = writeTestFile(
+        "data.csv",
+        "id,text\n"
+        "1,\"say \"\"hi\"\" \\ now\"\n"
+        "2,\"multi\nline\ttab\x01\"\n"
+        "3,\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::JsonConverter converter;
+    QBuffer output;
+    QVERIFY2(converter.convert(path, output), "Failed to convert file");
+
+    const QByteArray expected(
+        "{\"id\":\"1\",\"text\":\"say \\\"hi\\\" \\\\ now\"}\n"
+        "{\"id\":\"2\",\"text\":\"multi\\nline\\ttab\\u0001\"}\n"
+        "{\"id\":\"3\",\"text\":\"\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5"
+        "\xD1\x82\"}\n");
+    QVERIFY2(expected == output.data(), "Wrong NDJSON");
+
+    // Each line is a valid JSON object
+    const auto lines = output.data().split('\n');
+    QVERIFY2(4 == lines.size() && lines.last().isEmpty(),
+             "Wrong number of lines");
+    const auto object = QJsonDocument::fromJson(lines.at(1)).object();
+    QVERIFY2(QString("multi\nline\ttab\x01") == object.value("text")
+                 .toString(),
+             "Wrong value of parsed object");
+}
+
+void TestJsonConverter::testConvertToArray() {
+    const auto path = writeTestFile("data.csv", "id,value\n1,a\n2,b\n");
+    const auto headerOnly = writeTestFile("header.csv", "id,value\n");
+    const auto empty = writeTestFile("empty.csv", QByteArray());
+    QVERIFY2(!path.isEmpty() && !headerOnly.isEmpty() && !empty.isEmpty(),
+             "Failed to write test files");
+
+    QtCSV::JsonConverter converter;
+    converter.setFormat(QtCSV::JsonConverter::Format::ARRAY);
+    QBuffer output;
+    QVERIFY2(converter.convert(path, output), "Failed to convert file");
+    QVERIFY2("[\n{\"id\":\"1\",\"value\":\"a\"},\n"
+             "{\"id\":\"2\",\"value\":\"b\"}\n]\n" == output.data(),
+             "Wrong JSON array");
+
+    QJsonParseError error;
+    const auto document = QJsonDocument::fromJson(output.data(), &error);
+    QVERIFY2(QJsonParseError::NoError == error.error && document.isArray() &&
+                 2 == document.array().size(),
+             "Invalid JSON array");
+
+    for (const auto& emptyPath : {headerOnly, empty}) {
+        QBuffer emptyOutput;
+        QVERIFY2(converter.convert(emptyPath, emptyOutput),
+                 "Failed to convert file without rows");
+        QVERIFY2("[]\n" == emptyOutput.data(), "Wrong empty JSON array");
+    }
+}
+
+void TestJsonConverter::testTypeInference() {
+    const auto path = writeTestFile(
+        "data.csv",
+        "a,b,c,d,e,f,g,h,i\n"
+        "12,-1.5e3,007,true,FALSE,,null,1.,0.25\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::JsonConverter converter;
+    converter.setTypeInference(true);
+    QBuffer output;
+    QVERIFY2(converter.convert(path, output), "Failed to convert file");
+    QVERIFY2("{\"a\":12,\"b\":-1.5e3,\"c\":\"007\",\"d\":true,"
+             "\"e\":\"FALSE\",\"f\":null,\"g\":\"null\",\"h\":\"1.\","
+             "\"i\":0.25}\n" == output.data(),
+             "Wrong types of values");
+
+    // Without type inference all values are strings
+    converter.setTypeInference(false);
+    QBuffer stringOutput;
+    QVERIFY2(converter.convert(path, stringOutput), "Failed to convert file");
+    QVERIFY2("{\"a\":\"12\",\"b\":\"-1.5e3\",\"c\":\"007\",\"d\":\"true\","
+             "\"e\":\"FALSE\",\"f\":\"\",\"g\":\"null\",\"h\":\"1.\","
+             "\"i\":\"0.25\"}\n" == stringOutput.data(),
+             "Values are not strings");
+}
+
+void TestJsonConverter::testMissingAndExtraValues() {
+    const auto path = writeTestFile("data.csv", "a,b\n1\n1,2,3\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::JsonConverter converter;
+    QBuffer output;
+    QVERIFY2(converter.convert(path, output), "Failed to convert file");
+    QVERIFY2("{\"a\":\"1\",\"b\":null}\n"
+             "{\"a\":\"1\",\"b\":\"2\",\"2\":\"3\"}\n" == output.data(),
+             "Wrong objects of rows with missing and extra values");
+
+    // First row is data if keys are set
+    converter.setKeys({"x", "y"});
+    QBuffer keysOutput;
+    QVERIFY2(converter.convert(path, keysOutput), "Failed to convert file");
+    QVERIFY2("{\"x\":\"a\",\"y\":\"b\"}\n"
+             "{\"x\":\"1\",\"y\":null}\n"
+             "{\"x\":\"1\",\"y\":\"2\",\"2\":\"3\"}\n" == keysOutput.data(),
+             "Wrong objects with custom keys");
+}
+
+void TestJsonConverter::testByteOrderMark() {
+    const auto path = writeTestFile("data.csv", "\xEF\xBB\xBFid\n1\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::JsonConverter converter;
+    QBuffer output;
+    QVERIFY2(converter.convert(path, output), "Failed to convert file");
+    QVERIFY2("{\"id\":\"1\"}\n" == output.data(),
+             "Byte order mark is a part of the key");
+}
+
+void TestJsonConverter::testConvertOrder_data() {
+    QTest::addColumn<bool>("isDevice");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("file, 1 thread") << false << 1;
+    QTest::newRow("file, 4 threads") << false << 4;
+    QTest::newRow("device, 1 thread") << true << 1;
+    QTest::newRow("device, 4 threads") << true << 4;
+}
+
+void TestJsonConverter::testConvertOrder() {
+    QFETCH(bool, isDevice);
+    QFETCH(int, threads);
+
+    const int rowsCount = 2000;
+    QByteArray data("id,value\n");
+    for (int i = 0; i < rowsCount; ++i) {
+        // Multi-line values could be cut by naive split of batches
+        data += QByteArray::number(i) +
+            (i % 3 == 0 ? ",\"first\nsecond\"\n" : ",value\n");
+    }
+
+    const auto path = writeTestFile("data.csv", data);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::JsonConverter converter;
+    converter.setFormat(QtCSV::JsonConverter::Format::ARRAY);
+    converter.setTypeInference(true);
+    converter.setThreadCount(threads);
+    converter.setBatchSize(256);
+
+    QBuffer output;
+    if (isDevice) {
+        QBuffer input(&data);
+        QVERIFY2(converter.convert(input, output),
+                 "Failed to convert IO Device");
+    }
+    else {
+        QVERIFY2(converter.convert(path, output), "Failed to convert file");
+    }
+
+    const auto array = QJsonDocument::fromJson(output.data()).array();
+    QVERIFY2(rowsCount == array.size(), "Wrong number of objects");
+    for (int i = 0; i < rowsCount; ++i) {
+        const auto object = array.at(i).toObject();
+        QVERIFY2(i == object.value("id").toInteger(), "Wrong order of rows");
+        QVERIFY2((i % 3 == 0 ? QString("first\nsecond") : QString("value")) ==
+                     object.value("value").toString(),
+                 "Wrong value of object");
+    }
+}
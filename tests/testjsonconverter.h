@@ -0,0 +1,23 @@
+#ifndef TESTJSONCONVERTER_H
+#define TESTJSONCONVERTER_H
+
+#include "tempdirtest.h"
+
+class TestJsonConverter : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestJsonConverter() = default;
+
+private Q_SLOTS:
+    void testConvertInvalidArgs();
+    void testConvertToNdjson();
+    void testConvertToArray();
+    void testTypeInference();
+    void testMissingAndExtraValues();
+    void testByteOrderMark();
+    void testConvertOrder_data();
+    void testConvertOrder();
+};
+
+#endif // TESTJSONCONVERTER_H
@@ -0,0 +1,255 @@
+#include "testmultireader.h"
+#include "qtcsv/multireader.h"
+#include "qtcsv/writer.h"
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <algorithm>
+#include <atomic>
+
+// Processor that collects rows and could stop reading
+class MultiRowsProcessor : public QtCSV::Reader::AbstractProcessor {
+public:
+    QList<QList<QString>> rows;
+    qsizetype maxRows = -1;
+
+    bool processRowElements(const QList<QString>& elements) override {
+        rows << elements;
+        return maxRows < 0 || rows.size() < maxRows;
+    }
+};
+
+// Thread-safe processor that counts rows of each source
+class MultiCountProcessor : public QtCSV::MultiReader::ConcurrentProcessor {
+public:
+    QMutex mutex;
+    QHash<qsizetype, qint64> rows;
+    std::atomic<qint64> total{0};
+
+    bool processRowElements(
+        const qsizetype source, const QList<QString>& /*elements*/) override
+    {
+        ++total;
+        QMutexLocker locker(&mutex);
+        ++rows[source];
+        return true;
+    }
+};
+
+QList<QString> TestMultiReader::writeTestFiles(
+    const int files, const int rowsPerFile, const QList<QString>& header) const
+{
+    QList<QString> paths;
+    for (int i = 0; i < files; ++i) {
+        QList<QList<QString>> rows;
+        if (!header.isEmpty()) { rows << header; }
+
+        for (int j = 0; j < rowsPerFile; ++j) {
+            rows << QList<QString>{QString("file%1").arg(i),
+                                   QString::number(j), "multi\nline"};
+        }
+
+        paths << writeCsvFile(QString("data%1.csv").arg(i, 3, 10,
+                                                         QChar('0')), rows);
+    }
+
+    return paths;
+}
+
+void TestMultiReader::testFindFiles() {
+    const auto paths = writeTestFiles(3, 1);
+    QVERIFY2(!writeCsvFile("other.txt", {{"1"}}).isEmpty(),
+             "Failed to write test file");
+
+    QVERIFY2(paths == QtCSV::MultiReader::findFiles(dirPath()),
+             "Wrong list of csv-files");
+    QVERIFY2(1 == QtCSV::MultiReader::findFiles(dirPath(),
+                                                "*.txt").size(),
+             "Wrong list of files with pattern");
+    QVERIFY2(QtCSV::MultiReader::findFiles(
+                 filePath("absent")).isEmpty(),
+             "Files were found in absent directory");
+}
+
+void TestMultiReader::testReadFiles_data() {
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void TestMultiReader::testReadFiles() {
+    QFETCH(int, threads);
+
+    const auto paths = writeTestFiles(20, 300);
+    QtCSV::MultiReader reader;
+    reader.setThreadCount(threads);
+
+    MultiRowsProcessor processor;
+    QList<QtCSV::MultiReader::FileResult> results;
+    QVERIFY2(reader.readToProcessor(paths, processor, ",", "\"",
+                                    QStringConverter::Utf8, &results),
+             "Failed to read files");
+    QVERIFY2(20 * 300 == processor.rows.size(), "Wrong number of rows");
+    QVERIFY2(paths.size() == results.size(), "Wrong number of results");
+    for (qsizetype i = 0; i < results.size(); ++i) {
+        QVERIFY2(paths.at(i) == results.at(i).filePath &&
+                     results.at(i).isRead && 300 == results.at(i).rows &&
+                     results.at(i).error.isEmpty(),
+                 "Wrong result of file");
+    }
+
+    // Rows of one file keep their order
+    QHash<QString, int> lastRows;
+    for (const auto& row : processor.rows) {
+        QVERIFY2(3 == row.size() && "multi\nline" == row.at(2),
+                 "Wrong values of row");
+        const auto number = row.at(1).toInt();
+        QVERIFY2(lastRows.value(row.at(0), -1) + 1 == number,
+                 "Wrong order of rows of file");
+        lastRows[row.at(0)] = number;
+    }
+}
+
+void TestMultiReader::testReadFilesConcurrently() {
+    const auto paths = writeTestFiles(10, 1000);
+    QtCSV::MultiReader reader;
+    reader.setThreadCount(4);
+
+    MultiCountProcessor processor;
+    QVERIFY2(reader.readToProcessor(paths, processor),
+             "Failed to read files");
+    QVERIFY2(10 * 1000 == processor.total, "Wrong number of rows");
+    for (qsizetype i = 0; i < paths.size(); ++i) {
+        QVERIFY2(1000 == processor.rows.value(i),
+                 "Wrong number of rows of file");
+    }
+}
+
+void TestMultiReader::testReadDevices() {
+    QByteArray first("id,value\n1,a\n2,b\n");
+    QByteArray second("id,value\n3,\"c\nd\"\n");
+    QBuffer firstBuffer(&first);
+    QBuffer secondBuffer(&second);
+
+    QtCSV::MultiReader reader;
+    reader.setHeader(QtCSV::MultiReader::Header::VERIFY);
+
+    MultiRowsProcessor processor;
+    QList<QtCSV::MultiReader::FileResult> results;
+    QVERIFY2(reader.readToProcessor(
+                 QList<QIODevice*>{&firstBuffer, &secondBuffer}, processor,
+                 ",", "\"", QStringConverter::Utf8, &results),
+             "Failed to read devices");
+    QVERIFY2((QList<QString>{"id", "value"}) == reader.header(),
+             "Wrong header of devices");
+
+    std::sort(processor.rows.begin(), processor.rows.end());
+    const QList<QList<QString>> expected = {
+        {"1", "a"}, {"2", "b"}, {"3", "c\nd"}};
+    QVERIFY2(expected == processor.rows, "Wrong rows of devices");
+    QVERIFY2(2 == results.size() && 2 == results.at(0).rows &&
+                 1 == results.at(1).rows && results.at(0).filePath.isEmpty(),
+             "Wrong results of devices");
+
+    QList<QtCSV::MultiReader::FileResult> nullResults;
+    QVERIFY2(!reader.readToProcessor(
+                 QList<QIODevice*>{nullptr}, processor, ",", "\"",
+                 QStringConverter::Utf8, &nullResults),
+             "Null device was read");
+    QVERIFY2(1 == nullResults.size() && !nullResults.at(0).isRead &&
+                 !nullResults.at(0).error.isEmpty(),
+             "Wrong result of null device");
+}
+
+void TestMultiReader::testSkipHeader() {
+    auto paths = writeTestFiles(5, 10, {"name", "number", "text"});
+    QFile emptyFile(filePath("empty.csv"));
+    QVERIFY2(emptyFile.open(QIODevice::WriteOnly),
+             "Failed to create empty file");
+    emptyFile.close();
+    paths << emptyFile.fileName();
+
+    QtCSV::MultiReader reader;
+    reader.setHeader(QtCSV::MultiReader::Header::SKIP);
+
+    MultiRowsProcessor processor;
+    QVERIFY2(reader.readToProcessor(paths, processor),
+             "Failed to read files with header");
+    QVERIFY2(5 * 10 == processor.rows.size(), "Wrong number of rows");
+    QVERIFY2((QList<QString>{"name", "number", "text"}) == reader.header(),
+             "Wrong header of files");
+    for (const auto& row : processor.rows) {
+        QVERIFY2("name" != row.at(0), "Header was passed to processor");
+    }
+}
+
+void TestMultiReader::testVerifyHeader() {
+    auto paths = writeTestFiles(4, 10, {"name", "number", "text"});
+    paths.insert(2, writeCsvFile("other.csv", {{"a", "b"}, {"1", "2"}}));
+
+    QtCSV::MultiReader reader;
+    reader.setHeader(QtCSV::MultiReader::Header::VERIFY);
+
+    MultiRowsProcessor processor;
+    QList<QtCSV::MultiReader::FileResult> results;
+    QVERIFY2(!reader.readToProcessor(paths, processor, ",", "\"",
+                                     QStringConverter::Utf8, &results),
+             "Files with different headers were read without error");
+    QVERIFY2(4 * 10 == processor.rows.size(),
+             "File with wrong header stopped reading of other files");
+    QVERIFY2(5 == results.size() && !results.at(2).isRead &&
+                 0 == results.at(2).rows && !results.at(2).error.isEmpty(),
+             "Wrong result of file with wrong header");
+
+    // Expected header is set explicitly
+    reader.setExpectedHeader({"a", "b"});
+    processor.rows.clear();
+    QVERIFY2(!reader.readToProcessor(paths, processor, ",", "\"",
+                                     QStringConverter::Utf8, &results),
+             "Files with different headers were read without error");
+    QVERIFY2((QList<QList<QString>>{{"1", "2"}}) == processor.rows &&
+                 results.at(2).isRead,
+             "Wrong rows of file with expected header");
+}
+
+void TestMultiReader::testFileErrors() {
+    auto paths = writeTestFiles(3, 10);
+    paths.insert(1, filePath("absent.csv"));
+
+    QtCSV::MultiReader reader;
+    MultiRowsProcessor processor;
+    QList<QtCSV::MultiReader::FileResult> results;
+    QVERIFY2(!reader.readToProcessor(paths, processor, ",", "\"",
+                                     QStringConverter::Utf8, &results),
+             "Absent file was read without error");
+    QVERIFY2(3 * 10 == processor.rows.size(),
+             "Absent file stopped reading of other files");
+    QVERIFY2(4 == results.size() && !results.at(1).isRead &&
+                 !results.at(1).error.isEmpty() && results.at(3).isRead,
+             "Wrong result of absent file");
+
+    QVERIFY2(!reader.readToProcessor(paths, processor, QString()),
+             "Files were read with empty separator");
+}
+
+void TestMultiReader::testProcessorStopsReading() {
+    const auto paths = writeTestFiles(10, 1000);
+    QtCSV::MultiReader reader;
+    reader.setThreadCount(4);
+
+    MultiRowsProcessor processor;
+    processor.maxRows = 1500;
+    QList<QtCSV::MultiReader::FileResult> results;
+    QVERIFY2(!reader.readToProcessor(paths, processor, ",", "\"",
+                                     QStringConverter::Utf8, &results),
+             "Stopped reading returned success");
+    QVERIFY2(1500 == processor.rows.size(),
+             "Rows were passed after processor stopped reading");
+
+    qint64 rows = 0;
+    for (const auto& result : results) { rows += result.rows; }
+
+    QVERIFY2(1500 == rows, "Wrong number of rows in results");
+}
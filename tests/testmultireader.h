@@ -0,0 +1,28 @@
+#ifndef TESTMULTIREADER_H
+#define TESTMULTIREADER_H
+
+#include "tempdirtest.h"
+
+class TestMultiReader : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestMultiReader() = default;
+
+private Q_SLOTS:
+    void testFindFiles();
+    void testReadFiles_data();
+    void testReadFiles();
+    void testReadFilesConcurrently();
+    void testReadDevices();
+    void testSkipHeader();
+    void testVerifyHeader();
+    void testFileErrors();
+    void testProcessorStopsReading();
+
+private:
+    QList<QString> writeTestFiles(
+        int files, int rowsPerFile, const QList<QString>& header = {}) const;
+};
+
+#endif // TESTMULTIREADER_H
@@ -0,0 +1,147 @@
+#include "testnumberconverter.h"
+#include "qtcsv/numberconverter.h"
+#include <limits>
+
+void TestNumberConverter::testIntegerToString() {
+    QVERIFY2("0" == QtCSV::NumberConverter::toString(qint64(0)),
+             "Wrong string for zero");
+    QVERIFY2("-771" == QtCSV::NumberConverter::toString(qint64(-771)),
+             "Wrong string for negative integer");
+    QVERIFY2("9223372036854775807" == QtCSV::NumberConverter::toString(
+                 std::numeric_limits<qint64>::max()),
+             "Wrong string for max qint64");
+    QVERIFY2("18446744073709551615" == QtCSV::NumberConverter::toString(
+                 std::numeric_limits<quint64>::max()),
+             "Wrong string for max quint64");
+}
+
+void TestNumberConverter::testDoubleToString() {
+    QVERIFY2("3.14" == QtCSV::NumberConverter::toString(3.14),
+             "Wrong string for 3.14");
+    QVERIFY2("42.12309" == QtCSV::NumberConverter::toString(42.12309),
+             "Wrong string for 42.12309");
+    QVERIFY2("-0.5" == QtCSV::NumberConverter::toString(-0.5),
+             "Wrong string for -0.5");
+
+    // Shortest representation must be converted back to the same value
+    const auto value = 0.1 + 0.2;
+    const auto str = QtCSV::NumberConverter::toString(value);
+    QVERIFY2(value == QtCSV::NumberConverter::toDouble(str),
+             "Shortest representation is not round-trip");
+}
+
+void TestNumberConverter::testDoubleWithPrecision() {
+    QtCSV::NumberFormat format;
+    format.precision = 2;
+    QVERIFY2("3.14" == QtCSV::NumberConverter::toString(3.14159, format),
+             "Wrong string with precision 2");
+    QVERIFY2("2.00" == QtCSV::NumberConverter::toString(2.0, format),
+             "Wrong string with trailing zeros");
+
+    format.precision = 0;
+    QVERIFY2("3" == QtCSV::NumberConverter::toString(3.14159, format),
+             "Wrong string with precision 0");
+
+    format.precision = 3;
+    const auto bigValue = 1e200;
+    QVERIFY2(bigValue == QtCSV::NumberConverter::toString(bigValue, format)
+                 .toDouble(),
+             "Wrong string for very big number");
+}
+
+void TestNumberConverter::testDecimalSeparator() {
+    QtCSV::NumberFormat format;
+    format.decimalSeparator = QChar(',');
+    QVERIFY2("3,14" == QtCSV::NumberConverter::toString(3.14, format),
+             "Wrong decimal separator");
+
+    bool ok = false;
+    QVERIFY2(3.14 == QtCSV::NumberConverter::toDouble(
+                 QString("3,14"), &ok, QChar(',')) && ok,
+             "Failed to parse number with custom decimal separator");
+
+    QtCSV::NumberConverter::toDouble(QString("3.14"), &ok, QChar(','));
+    QVERIFY2(!ok, "Number with wrong decimal separator was accepted");
+}
+
+void TestNumberConverter::testVariantToString() {
+    QString result;
+    QVERIFY2(QtCSV::NumberConverter::toString(QVariant(771), result) &&
+                 "771" == result,
+             "Failed to convert int");
+    QVERIFY2(QtCSV::NumberConverter::toString(
+                 QVariant(qlonglong(-12345678901)), result) &&
+                 "-12345678901" == result,
+             "Failed to convert qlonglong");
+    QVERIFY2(QtCSV::NumberConverter::toString(QVariant(3.14), result) &&
+                 "3.14" == result,
+             "Failed to convert double");
+    QVERIFY2(QtCSV::NumberConverter::toString(QVariant(0.1f), result) &&
+                 "0.1" == result,
+             "Failed to convert float");
+
+    QVERIFY2(!QtCSV::NumberConverter::toString(QVariant("3.14"), result),
+             "String was treated as a number");
+    QVERIFY2(!QtCSV::NumberConverter::toString(QVariant(true), result),
+             "Boolean was treated as a number");
+}
+
+void TestNumberConverter::testStringToInteger() {
+    bool ok = false;
+    QVERIFY2(42 == QtCSV::NumberConverter::toLongLong(QString("42"), &ok) &&
+                 ok,
+             "Failed to parse integer");
+    QVERIFY2(-42 == QtCSV::NumberConverter::toLongLong(QString(" -42 "), &ok)
+                 && ok,
+             "Failed to parse integer with spaces");
+    QVERIFY2(42 == QtCSV::NumberConverter::toLongLong(QString("+42"), &ok) &&
+                 ok,
+             "Failed to parse integer with plus sign");
+
+    QtCSV::NumberConverter::toLongLong(QString("42abc"), &ok);
+    QVERIFY2(!ok, "Invalid integer was accepted");
+    QtCSV::NumberConverter::toLongLong(QString("4.2"), &ok);
+    QVERIFY2(!ok, "Floating point number was accepted as integer");
+    QtCSV::NumberConverter::toLongLong(QString(), &ok);
+    QVERIFY2(!ok, "Empty string was accepted");
+    QtCSV::NumberConverter::toLongLong(
+        QString("99999999999999999999"), &ok);
+    QVERIFY2(!ok, "Too big integer was accepted");
+
+    QtCSV::NumberConverter::toULongLong(QString("-1"), &ok);
+    QVERIFY2(!ok, "Negative unsigned integer was accepted");
+}
+
+void TestNumberConverter::testStringToDouble() {
+    bool ok = false;
+    QVERIFY2(3.14 == QtCSV::NumberConverter::toDouble(QString("3.14"), &ok) &&
+                 ok,
+             "Failed to parse double");
+    QVERIFY2(-1.5e-7 == QtCSV::NumberConverter::toDouble(
+                 QString("-1.5e-7"), &ok) && ok,
+             "Failed to parse double in scientific notation");
+
+    QtCSV::NumberConverter::toDouble(QString("3.14.15"), &ok);
+    QVERIFY2(!ok, "Invalid double was accepted");
+    QtCSV::NumberConverter::toDouble(QString("three"), &ok);
+    QVERIFY2(!ok, "Text was accepted as double");
+}
+
+void TestNumberConverter::testStringToNumber() {
+    const auto integer = QtCSV::NumberConverter::toNumber(QString("771"));
+    QVERIFY2(QMetaType::LongLong == integer.typeId() &&
+                 771 == integer.toLongLong(),
+             "Wrong conversion of integer");
+
+    const auto real = QtCSV::NumberConverter::toNumber(QString("3.14"));
+    QVERIFY2(QMetaType::Double == real.typeId() && 3.14 == real.toDouble(),
+             "Wrong conversion of double");
+
+    QVERIFY2(!QtCSV::NumberConverter::toNumber(QString("kkoo")).isValid(),
+             "Text was converted to number");
+    QVERIFY2(!QtCSV::NumberConverter::toNumber(QString("nan")).isValid(),
+             "Word nan was converted to number");
+    QVERIFY2(!QtCSV::NumberConverter::toNumber(
+                 QString("99999999999999999999")).isValid(),
+             "Too big integer was converted with loss of precision");
+}
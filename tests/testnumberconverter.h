@@ -0,0 +1,24 @@
+#ifndef TESTNUMBERCONVERTER_H
+#define TESTNUMBERCONVERTER_H
+
+#include <QObject>
+#include <QtTest>
+
+class TestNumberConverter : public QObject {
+    Q_OBJECT
+
+public:
+    TestNumberConverter() = default;
+
+private Q_SLOTS:
+    void testIntegerToString();
+    void testDoubleToString();
+    void testDoubleWithPrecision();
+    void testDecimalSeparator();
+    void testVariantToString();
+    void testStringToInteger();
+    void testStringToDouble();
+    void testStringToNumber();
+};
+
+#endif // TESTNUMBERCONVERTER_H
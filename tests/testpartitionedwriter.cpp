@@ -0,0 +1,152 @@
+#include "testpartitionedwriter.h"
+#include "qtcsv/partitionedwriter.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/stringdata.h"
+#include <QFileInfo>
+
+void TestPartitionedWriter::testWriteToOneFile() {
+    QtCSV::StringData data;
+    data << (QList<QString>() << "one" << "two, three");
+    data << (QList<QString>() << "four" << "five");
+
+    QtCSV::PartitionedWriter writer(dirPath(), "data");
+    QVERIFY2(writer.write(data), "Failed to write data");
+    QVERIFY2(writer.close(), "Failed to close files");
+
+    const auto files = writer.files();
+    QVERIFY2(1 == files.size(), "Wrong number of files");
+    QVERIFY2("data.csv" == QFileInfo(files.at(0)).fileName(),
+             "Wrong file name");
+
+    const auto result = QtCSV::Reader::readToList(files.at(0));
+    QVERIFY2(2 == result.size(), "Wrong number of rows");
+    QVERIFY2(data.rowValues(0) == result.at(0), "Wrong first row");
+    QVERIFY2(data.rowValues(1) == result.at(1), "Wrong second row");
+}
+
+void TestPartitionedWriter::testPartitionByKey() {
+    QList<QString> header;
+    header << "customer" << "amount";
+
+    QtCSV::PartitionedWriter writer(dirPath(), "orders", ",", "\"", header);
+    writer.setKeyColumn(0);
+    QVERIFY2(writer.writeRow(QList<QString>() << "alice" << "1"),
+             "Failed to write row");
+    QVERIFY2(writer.writeRow(QList<QString>() << "bob/smith" << "2"),
+             "Failed to write row");
+    QVERIFY2(writer.writeRow(QList<QString>() << "alice" << "3"),
+             "Failed to write row");
+    QVERIFY2(writer.close(), "Failed to close files");
+
+    const auto files = writer.files();
+    QVERIFY2(2 == files.size(), "Wrong number of files");
+    QVERIFY2("orders_alice.csv" == QFileInfo(files.at(0)).fileName(),
+             "Wrong name of the first file");
+    QVERIFY2("orders_bob%2Fsmith.csv" == QFileInfo(files.at(1)).fileName(),
+             "Wrong name of the second file");
+
+    const auto alice = QtCSV::Reader::readToList(files.at(0));
+    QVERIFY2(3 == alice.size(), "Wrong number of rows in the first file");
+    QVERIFY2(header == alice.at(0), "Wrong header in the first file");
+    QVERIFY2("3" == alice.at(2).at(1), "Wrong data in the first file");
+
+    const auto bob = QtCSV::Reader::readToList(files.at(1));
+    QVERIFY2(2 == bob.size(), "Wrong number of rows in the second file");
+    QVERIFY2(header == bob.at(0), "Wrong header in the second file");
+}
+
+void TestPartitionedWriter::testKeysDifferentInCase() {
+    QtCSV::PartitionedWriter writer(dirPath(), "orders");
+    writer.setKeyColumn(0);
+    for (const auto& key : QList<QString>() << "a" << "A" << "b" << "a") {
+        QVERIFY2(writer.writeRow(QList<QString>() << key << "1"),
+                 "Failed to write row");
+    }
+
+    QVERIFY2(writer.close(), "Failed to close files");
+
+    const auto files = writer.files();
+    QVERIFY2(3 == files.size(), "Wrong number of files");
+    QVERIFY2("orders_a.csv" == QFileInfo(files.at(0)).fileName() &&
+                 "orders_A@2.csv" == QFileInfo(files.at(1)).fileName() &&
+                 "orders_b.csv" == QFileInfo(files.at(2)).fileName(),
+             "Wrong names of files");
+    QVERIFY2(2 == QtCSV::Reader::readToList(files.at(0)).size() &&
+                 1 == QtCSV::Reader::readToList(files.at(1)).size(),
+             "Wrong rows of files");
+}
+
+void TestPartitionedWriter::testRotateByRows() {
+    QList<QString> header;
+    header << "number";
+
+    QtCSV::PartitionedWriter writer(dirPath(), "log", ",", "\"", header);
+    writer.setMaxRowsPerFile(2);
+    for (auto i = 0; i < 5; ++i) {
+        QVERIFY2(writer.writeRow(QList<QString>() << QString::number(i)),
+                 "Failed to write row");
+    }
+
+    QVERIFY2(writer.close(), "Failed to close files");
+
+    const auto files = writer.files();
+    QVERIFY2(3 == files.size(), "Wrong number of files");
+    QVERIFY2("log_00001.csv" == QFileInfo(files.at(0)).fileName(),
+             "Wrong name of the first file");
+    QVERIFY2("log_00003.csv" == QFileInfo(files.at(2)).fileName(),
+             "Wrong name of the last file");
+
+    const auto last = QtCSV::Reader::readToList(files.at(2));
+    QVERIFY2(2 == last.size(), "Wrong number of rows in the last file");
+    QVERIFY2(header == last.at(0), "Wrong header in the last file");
+    QVERIFY2("4" == last.at(1).at(0), "Wrong data in the last file");
+}
+
+void TestPartitionedWriter::testRotateBySize() {
+    QtCSV::PartitionedWriter writer(dirPath(), "log", ",", QString());
+    // Each row is "0123456789\n" - 11 bytes
+    writer.setMaxBytesPerFile(25);
+    for (auto i = 0; i < 5; ++i) {
+        QVERIFY2(writer.writeRow(QList<QString>() << "0123456789"),
+                 "Failed to write row");
+    }
+
+    QVERIFY2(writer.close(), "Failed to close files");
+
+    const auto files = writer.files();
+    QVERIFY2(3 == files.size(), "Wrong number of files");
+    for (const auto& file : files) {
+        QVERIFY2(QFileInfo(file).size() <= 25 + 2, "File is too big");
+    }
+}
+
+void TestPartitionedWriter::testLimitOfOpenFiles() {
+    QList<QString> header;
+    header << "key" << "value";
+
+    QtCSV::PartitionedWriter writer(dirPath(), "part", ",", "\"", header);
+    writer.setKeyColumn(0);
+    writer.setMaxOpenFiles(1);
+
+    const auto rowsPerKey = 10;
+    for (auto i = 0; i < rowsPerKey; ++i) {
+        for (const auto& key : QList<QString>() << "a" << "b" << "c") {
+            QVERIFY2(writer.writeRow(
+                         QList<QString>() << key << QString::number(i)),
+                     "Failed to write row");
+        }
+    }
+
+    QVERIFY2(writer.close(), "Failed to close files");
+    QVERIFY2(3 == writer.files().size(), "Wrong number of files");
+
+    for (const auto& file : writer.files()) {
+        const auto rows = QtCSV::Reader::readToList(file);
+        QVERIFY2(rowsPerKey + 1 == rows.size(), "Wrong number of rows");
+        QVERIFY2(header == rows.at(0), "Wrong header");
+        for (auto i = 0; i < rowsPerKey; ++i) {
+            QVERIFY2(QString::number(i) == rows.at(i + 1).at(1),
+                     "Wrong order of rows");
+        }
+    }
+}
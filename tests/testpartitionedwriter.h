@@ -0,0 +1,21 @@
+#ifndef TESTPARTITIONEDWRITER_H
+#define TESTPARTITIONEDWRITER_H
+
+#include "tempdirtest.h"
+
+class TestPartitionedWriter : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestPartitionedWriter() = default;
+
+private Q_SLOTS:
+    void testWriteToOneFile();
+    void testPartitionByKey();
+    void testKeysDifferentInCase();
+    void testRotateByRows();
+    void testRotateBySize();
+    void testLimitOfOpenFiles();
+};
+
+#endif // TESTPARTITIONEDWRITER_H
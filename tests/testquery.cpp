@@ -0,0 +1,222 @@
+#include "testquery.h"
+#include "qtcsv/query.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/stringdata.h"
+#include "qtcsv/writer.h"
+
+// Rows of orders: id, customer, status, amount
+QList<QList<QString>> TestQuery::testRows() const {
+    QList<QList<QString>> rows;
+    const QList<QString> customers = {"alice", "bob", "carol"};
+    for (int i = 0; i < 300; ++i) {
+        rows << QList<QString>{
+            QString::number(i),
+            customers.at(i % customers.size()),
+            i % 2 == 0 ? "paid" : "open",
+            QString::number(i % 10)};
+    }
+
+    return rows;
+}
+
+void TestQuery::testRunInvalidArgs() {
+    QtCSV::Query query;
+    QtCSV::StringData result;
+    QVERIFY2(!query.run(filePath("absent.csv"), result),
+             "Query was run on absent file");
+
+    const auto path = writeCsvFile({{"1", "2"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+    QVERIFY2(!query.run(path, result, QString()),
+             "Query was run with empty separator");
+
+    query.select({0}).aggregate(QtCSV::Query::Aggregate::COUNT);
+    QVERIFY2(!query.run(path, result),
+             "Query with selected columns and aggregates was run");
+
+    query.clear();
+    query.aggregate(QtCSV::Query::Aggregate::SUM);
+    QVERIFY2(!query.run(path, result), "Sum of invalid column was run");
+    QVERIFY2(result.isEmpty(), "Failed query added rows");
+}
+
+void TestQuery::testFilterAndSelect() {
+    const auto rows = testRows();
+    const auto path = writeCsvFile(rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QList<QList<QString>> expected;
+    for (const auto& row : rows) {
+        if (row.at(1) == "bob" && row.at(2) == "paid") {
+            expected << QList<QString>{row.at(3), row.at(0)};
+        }
+    }
+
+    // Small batches and several threads to check order of merged rows
+    QtCSV::Query query;
+    query.setBatchSize(64);
+    query.setThreadCount(4);
+    query.where(1, QtCSV::Query::Op::EQUAL, "bob")
+        .where(2, QtCSV::Query::Op::NOT_EQUAL, "open")
+        .select({3, 0});
+    QVERIFY2(expected == query.runToList(path), "Wrong filtered rows");
+
+    query.clear();
+    QVERIFY2(rows == query.runToList(path),
+             "Query without conditions does not return all rows");
+}
+
+void TestQuery::testNumericConditions() {
+    const auto path = writeCsvFile(
+        {{"9", "apple"}, {"10", "banana"}, {"100", "cherry"}, {"x", "date"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Query query;
+    query.where(0, QtCSV::Query::Op::GREATER_OR_EQUAL, "10").select({1});
+    QList<QList<QString>> expected = {{"banana"}, {"cherry"}, {"date"}};
+    QVERIFY2(expected == query.runToList(path),
+             "Numbers are not compared as numbers");
+
+    query.clear();
+    query.where(0, QtCSV::Query::Op::LESS, "10")
+        .where(1, QtCSV::Query::Op::STARTS_WITH, "ap")
+        .where(1, QtCSV::Query::Op::ENDS_WITH, "le")
+        .where(1, QtCSV::Query::Op::CONTAINS, "ppl")
+        .select({1});
+    expected = {{"apple"}};
+    QVERIFY2(expected == query.runToList(path), "Wrong filtered rows");
+}
+
+void TestQuery::testCustomPredicate() {
+    const auto rows = testRows();
+    const auto path = writeCsvFile(rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Query query;
+    query.setBatchSize(128);
+    query.where(0, [](const QString& value) {
+        return value.endsWith(QChar('7'));
+    });
+
+    QList<QList<QString>> expected;
+    for (const auto& row : rows) {
+        if (row.at(0).endsWith(QChar('7'))) { expected << row; }
+    }
+
+    QVERIFY2(expected == query.runToList(path), "Wrong filtered rows");
+}
+
+void TestQuery::testGroupAggregates() {
+    const auto path = writeCsvFile({
+        {"alice", "10"},
+        {"bob", "1.5"},
+        {"alice", "x"},
+        {"bob", "2.5"},
+        {"alice", "20"},
+        {"carol", ""}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Query query;
+    query.setBatchSize(16);
+    query.setThreadCount(3);
+    query.groupBy({0})
+        .aggregate(QtCSV::Query::Aggregate::COUNT)
+        .aggregate(QtCSV::Query::Aggregate::COUNT, 1)
+        .aggregate(QtCSV::Query::Aggregate::SUM, 1)
+        .aggregate(QtCSV::Query::Aggregate::MIN, 1)
+        .aggregate(QtCSV::Query::Aggregate::MAX, 1)
+        .aggregate(QtCSV::Query::Aggregate::AVG, 1);
+
+    const QList<QList<QString>> expected = {
+        {"alice", "3", "3", "30", "10", "20", "15"},
+        {"bob", "2", "2", "4", "1.5", "2.5", "2"},
+        {"carol", "1", "0", "", "", "", ""}};
+    QVERIFY2(expected == query.runToList(path), "Wrong aggregated values");
+}
+
+void TestQuery::testAggregatesOfLargeNumbers() {
+    const auto path = writeCsvFile({{"40000"}, {"60000"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Query query;
+    query.aggregate(QtCSV::Query::Aggregate::SUM, 0)
+        .aggregate(QtCSV::Query::Aggregate::MAX, 0)
+        .aggregate(QtCSV::Query::Aggregate::AVG, 0);
+    const QList<QList<QString>> expected = {{"100000", "60000", "50000"}};
+    QVERIFY2(expected == query.runToList(path),
+             "Integral aggregates are written with exponent");
+}
+
+void TestQuery::testAggregatesOfNoRows() {
+    const auto path = writeCsvFile({{"1"}, {"2"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Query query;
+    query.where(0, QtCSV::Query::Op::EQUAL, "3")
+        .aggregate(QtCSV::Query::Aggregate::COUNT)
+        .aggregate(QtCSV::Query::Aggregate::SUM, 0);
+    const QList<QList<QString>> expected = {{"0", ""}};
+    QVERIFY2(expected == query.runToList(path),
+             "Aggregates of no rows are wrong");
+
+    query.groupBy({0});
+    QVERIFY2(query.runToList(path).isEmpty(), "Query returned empty groups");
+}
+
+void TestQuery::testDistinct() {
+    const auto path = writeCsvFile(testRows());
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Query query;
+    query.setBatchSize(100);
+    query.setThreadCount(4);
+    query.select({1, 2}).setDistinct(true);
+    const QList<QList<QString>> expected = {
+        {"alice", "paid"},
+        {"bob", "open"},
+        {"carol", "paid"},
+        {"alice", "open"},
+        {"bob", "paid"},
+        {"carol", "open"}};
+    QVERIFY2(expected == query.runToList(path), "Wrong distinct rows");
+}
+
+void TestQuery::testHeaderAndQuotedValues() {
+    const QList<QList<QString>> rows = {
+        {"name", "comment"},
+        {"a", "multi\nline, \"quoted\"\nvalue"},
+        {"b", "plain"},
+        {"a", "second"}};
+    const auto path = writeCsvFile(rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Query query;
+    query.setHasHeader(true);
+    query.setBatchSize(8);
+    query.where(0, QtCSV::Query::Op::EQUAL, "a").select({1});
+    const QList<QList<QString>> expected = {
+        {"multi\nline, \"quoted\"\nvalue"}, {"second"}};
+    QVERIFY2(expected == query.runToList(path),
+             "Quoted values or header are processed wrong");
+
+    query.clear();
+    query.aggregate(QtCSV::Query::Aggregate::COUNT);
+    QVERIFY2(QList<QList<QString>>{{"3"}} == query.runToList(path),
+             "Header row was counted");
+}
+
+void TestQuery::testRunToContainer() {
+    const auto path = writeCsvFile({{"1", "a"}, {"2", "b"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::StringData result;
+    result.addRow(QString("existing"));
+
+    QtCSV::Query query;
+    query.where(0, QtCSV::Query::Op::GREATER, "1");
+    QVERIFY2(query.run(path, result), "Failed to run query");
+    QVERIFY2(2 == result.rowCount(), "Wrong number of rows");
+    QVERIFY2(QList<QString>({"existing"}) == result.rowValues(0) &&
+                 QList<QString>({"2", "b"}) == result.rowValues(1),
+             "Wrong rows in container");
+}
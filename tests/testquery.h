@@ -0,0 +1,28 @@
+#ifndef TESTQUERY_H
+#define TESTQUERY_H
+
+#include "tempdirtest.h"
+
+class TestQuery : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestQuery() = default;
+
+private Q_SLOTS:
+    void testRunInvalidArgs();
+    void testFilterAndSelect();
+    void testNumericConditions();
+    void testCustomPredicate();
+    void testGroupAggregates();
+    void testAggregatesOfLargeNumbers();
+    void testAggregatesOfNoRows();
+    void testDistinct();
+    void testHeaderAndQuotedValues();
+    void testRunToContainer();
+
+private:
+    QList<QList<QString>> testRows() const;
+};
+
+#endif // TESTQUERY_H
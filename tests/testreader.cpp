@@ -2,9 +2,13 @@
 #include "qtcsv/reader.h"
 #include "qtcsv/stringdata.h"
 #include "qtcsv/variantdata.h"
+#include "qtcsv/writer.h"
+#include <QBuffer>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QElapsedTimer>
+#include <QSysInfo>
 
 void TestReader::testReadToListInvalidArgs() {
     QVERIFY2(QtCSV::Reader::readToList(QString(), QString()).empty(),
@@ -426,6 +430,303 @@ void TestReader::testReadByProcessorWithBreak() {
     }
 }
 
+void TestReader::testReadStats() {
+    const auto path = getPathToFileMultirowData();
+    QtCSV::ReadStats stats;
+    const auto data = QtCSV::Reader::readToList(
+        path, ",", "\"", QStringConverter::Utf8, &stats);
+    QVERIFY2(4 == data.size(), "Wrong number of rows");
+
+    QVERIFY2(QFileInfo(path).size() == stats.bytesRead,
+             "Wrong number of read bytes");
+    QVERIFY2(stats.bytesRead <= stats.symbolsDecoded,
+             "Wrong number of decoded symbols");
+    QVERIFY2(5 == stats.lines, "Wrong number of lines");
+    QVERIFY2(4 == stats.rows, "Wrong number of rows in stats");
+    QVERIFY2(1 == stats.multiLineRows, "Wrong number of multi-line rows");
+    QVERIFY2(16 == stats.fields, "Wrong number of fields");
+    QVERIFY2(stats.lines + stats.fields <= stats.stringAllocations,
+             "Wrong number of string allocations");
+    QVERIFY2(0 < stats.totalNsecs, "Total time was not measured");
+    QVERIFY2(stats.ioNsecs + stats.splitNsecs + stats.unescapeNsecs +
+                 stats.processNsecs <= stats.totalNsecs,
+             "Time of stages is greater than total time");
+
+    // Statistics of the second read are added to the first one
+    stats.timings = false;
+    const auto totalNsecs = stats.totalNsecs;
+    QVERIFY2(QtCSV::Reader::readToList(
+                 path, ",", "\"", QStringConverter::Utf8, &stats) == data,
+             "Statistics changed result of reading");
+    QVERIFY2(8 == stats.rows && 32 == stats.fields,
+             "Statistics were not accumulated");
+    QVERIFY2(totalNsecs == stats.totalNsecs,
+             "Time was measured with disabled timings");
+}
+
+void TestReader::testReadProgress() {
+    QList<QtCSV::Progress::State> states;
+    QtCSV::Progress progress(
+        [&states](const QtCSV::Progress::State& state) { states << state; },
+        2);
+
+    const auto path = getPathToFileMultirowData();
+    const auto data = QtCSV::Reader::readToList(
+        path, ",", "\"", QStringConverter::Utf8, nullptr, &progress);
+    QVERIFY2(4 == data.size(), "Wrong number of rows");
+
+    // Two intermediate states and the final one
+    QVERIFY2(3 == states.size(), "Wrong number of callback calls");
+    QVERIFY2(2 == states.at(0).rows && 4 == states.at(1).rows,
+             "Wrong number of rows in intermediate states");
+
+    const auto size = QFileInfo(path).size();
+    const auto& last = states.last();
+    QVERIFY2(4 == last.rows && size == last.bytes && size == last.totalBytes,
+             "Wrong final state");
+}
+
+void TestReader::testReadCancel() {
+    QtCSV::Progress progress;
+    class CancelProcessor : public QtCSV::Reader::AbstractProcessor {
+    public:
+        QtCSV::Progress& progress;
+        qsizetype rows = 0;
+
+        explicit CancelProcessor(QtCSV::Progress& p) : progress(p) {}
+
+        bool processRowElements(const QList<QString>& /*elements*/) override {
+            if (2 == ++rows) { progress.cancel(); }
+
+            return true;
+        }
+    };
+
+    const auto path = getPathToFileMultirowData();
+    CancelProcessor processor(progress);
+    QVERIFY2(!QtCSV::Reader::readToProcessor(
+                 path, processor, ",", "\"", QStringConverter::Utf8, nullptr,
+                 &progress),
+             "Canceled reading was successful");
+    QVERIFY2(2 == processor.rows, "Reading was not stopped after cancel");
+
+    // Canceled reading doesn't transfer data to the container
+    QtCSV::StringData data;
+    QVERIFY2(!QtCSV::Reader::readToData(
+                 path, data, ",", "\"", QStringConverter::Utf8, nullptr,
+                 &progress),
+             "Canceled reading was successful");
+    QVERIFY2(data.isEmpty(), "Data of canceled reading was saved");
+    QVERIFY2(QtCSV::Reader::readToList(
+                 path, ",", "\"", QStringConverter::Utf8, nullptr,
+                 &progress).isEmpty(),
+             "Canceled reading returned rows");
+
+    progress.reset();
+    QVERIFY2(QtCSV::Reader::readToData(
+                 path, data, ",", "\"", QStringConverter::Utf8, nullptr,
+                 &progress),
+             "Failed to read file after reset");
+    QVERIFY2(4 == data.rowCount(), "Wrong number of rows");
+}
+
+void TestReader::testReadToDataInterning() {
+    const auto path = getPathToFileMultirowData();
+    const auto expected = QtCSV::Reader::readToList(path);
+
+    QtCSV::StringData data;
+    data.setInterning(true);
+    QVERIFY2(QtCSV::Reader::readToData(path, data), "Failed to read file");
+    QVERIFY2(expected.size() == data.rowCount(), "Wrong number of rows");
+    for (auto i = 0; i < data.rowCount(); ++i) {
+        QVERIFY2(expected.at(i) == data.rowValues(i), "Wrong row values");
+    }
+
+    // Rows are added to the container that already has rows
+    QVERIFY2(QtCSV::Reader::readToData(path, data), "Failed to read file");
+    QVERIFY2(2 * expected.size() == data.rowCount(), "Wrong number of rows");
+}
+
+void TestReader::testResumeFromCheckpoint_data() {
+    QTest::addColumn<int>("codec");
+    QTest::addColumn<bool>("withStats");
+    QTest::addColumn<bool>("withBom");
+
+    QTest::newRow("UTF-8") << static_cast<int>(QStringConverter::Utf8) <<
+        false << false;
+    QTest::newRow("UTF-8 with stats") <<
+        static_cast<int>(QStringConverter::Utf8) << true << false;
+    QTest::newRow("UTF-16") << static_cast<int>(QStringConverter::Utf16) <<
+        false << false;
+    QTest::newRow("UTF-16 with BOM") <<
+        static_cast<int>(QStringConverter::Utf16) << false << true;
+}
+
+void TestReader::testResumeFromCheckpoint() {
+    QFETCH(int, codec);
+    QFETCH(bool, withStats);
+    QFETCH(bool, withBom);
+    const auto encoding = static_cast<QStringConverter::Encoding>(codec);
+
+    // Data with byte order mark has byte order that is not native, so
+    // resumed reading must use the byte order of the mark
+    const auto isLittleEndian = QSysInfo::ByteOrder == QSysInfo::LittleEndian;
+    auto dataEncoding = encoding;
+    if (QStringConverter::Utf16 == encoding) {
+        dataEncoding = isLittleEndian == withBom ?
+            QStringConverter::Utf16BE : QStringConverter::Utf16LE;
+    }
+
+    // Processor that saves checkpoint after each row and stops after the
+    // limit of rows
+    class CheckpointProcessor : public QtCSV::Reader::AbstractProcessor {
+    public:
+        QList<QList<QString>> rows;
+        QByteArray saved;
+        qsizetype maxRows = -1;
+
+        bool processRowElements(const QList<QString>& elements) override {
+            rows << elements;
+            saved = checkpoint().toByteArray();
+            return maxRows < 0 || rows.size() < maxRows;
+        }
+    };
+
+    // Multi-line values and multibyte symbols in rows that take several
+    // blocks of QTextStream
+    QtCSV::StringData data;
+    for (int i = 0; i < 3000; ++i) {
+        data.addRow(QList<QString>{
+            QString::number(i),
+            i % 7 == 0 ? QString("multi\nline, \"%1\"").arg(i) :
+                QString("\u00E9t\u00E9 %1").arg(i)});
+    }
+
+    QBuffer buffer;
+    QVERIFY2(QtCSV::Writer::write(
+                 buffer, data, ";", "'", {}, {}, dataEncoding),
+             "Failed to write test data");
+    buffer.close();
+    if (withBom) {
+        const auto bom = QStringConverter::Utf16BE == dataEncoding ?
+            QByteArray("\xFE\xFF") : QByteArray("\xFF\xFE");
+        buffer.setData(bom + buffer.data());
+    }
+
+    const auto expected = QtCSV::Reader::readToList(buffer, ";", "'",
+                                                    encoding);
+    QVERIFY2(data.rowCount() == expected.size(), "Wrong test data");
+
+    QtCSV::ReadStats stats;
+    auto* statsPtr = withStats ? &stats : nullptr;
+    CheckpointProcessor first;
+    first.maxRows = 1234;
+    buffer.close();
+    QVERIFY2(!QtCSV::Reader::readToProcessor(
+                 buffer, first, ";", "'", encoding, statsPtr),
+             "Reading was not stopped");
+
+    const auto checkpoint =
+        QtCSV::ReadCheckpoint::fromByteArray(first.saved);
+    QVERIFY2(checkpoint.isValid() && 1234 == checkpoint.rows &&
+                 ";" == checkpoint.separator &&
+                 "'" == checkpoint.textDelimiter &&
+                 dataEncoding == checkpoint.codec,
+             "Wrong checkpoint");
+
+    // Resumed reading continues numbering of rows
+    CheckpointProcessor second;
+    buffer.close();
+    QVERIFY2(QtCSV::Reader::resumeToProcessor(
+                 buffer, second, checkpoint, statsPtr),
+             "Failed to resume reading");
+    QVERIFY2(expected == first.rows + second.rows,
+             "Wrong rows after resume");
+    QVERIFY2(expected.size() == QtCSV::ReadCheckpoint::fromByteArray(
+                                    second.saved).rows,
+             "Wrong number of rows in the last checkpoint");
+    QVERIFY2(buffer.size() == QtCSV::ReadCheckpoint::fromByteArray(
+                                  second.saved).offset,
+             "Wrong offset of the last checkpoint");
+}
+
+void TestReader::testResumeInvalidCheckpoint() {
+    class RowsProcessor : public QtCSV::Reader::AbstractProcessor {
+    public:
+        bool processRowElements(const QList<QString>& /*elements*/) override {
+            return true;
+        }
+    };
+
+    RowsProcessor processor;
+    QVERIFY2(!processor.checkpoint().isValid(),
+             "Processor returned checkpoint outside of reading");
+    QVERIFY2(!QtCSV::ReadCheckpoint::fromByteArray("garbage").isValid(),
+             "Checkpoint was restored from invalid data");
+
+    const auto path = getPathToFileMultirowData();
+    QVERIFY2(!QtCSV::Reader::resumeToProcessor(
+                 path, processor, QtCSV::ReadCheckpoint()),
+             "Reading was resumed from invalid checkpoint");
+
+    QtCSV::ReadCheckpoint checkpoint;
+    checkpoint.offset = QFileInfo(path).size() + 1;
+    QVERIFY2(!QtCSV::Reader::resumeToProcessor(path, processor, checkpoint),
+             "Reading was resumed from position after the end of file");
+
+    // Checkpoint at the end of file means there are no more rows
+    checkpoint.offset = QFileInfo(path).size();
+    QVERIFY2(QtCSV::Reader::resumeToProcessor(path, processor, checkpoint),
+             "Failed to resume reading at the end of file");
+}
+
+void TestReader::testCheckpointKeepsStats() {
+    // Processor that takes checkpoint after each row. Processing of one row
+    // reads other csv-data.
+    class CheckpointProcessor : public QtCSV::Reader::AbstractProcessor {
+    public:
+        QIODevice* nested = nullptr;
+        qint64 rows = 0;
+        QtCSV::ReadCheckpoint last;
+
+        bool processRowElements(const QList<QString>& /*elements*/) override {
+            if (++rows == 10) {
+                QtCSV::Reader::readToList(*nested);
+                if (!checkpoint().isValid()) { return false; }
+            }
+
+            last = checkpoint();
+            return last.isValid();
+        }
+    };
+
+    QtCSV::StringData data;
+    for (int i = 0; i < 3000; ++i) {
+        data.addRow(QList<QString>{QString::number(i), "text"});
+    }
+
+    QBuffer buffer;
+    QVERIFY2(QtCSV::Writer::write(buffer, data), "Failed to write test data");
+    buffer.close();
+
+    QBuffer nested;
+    nested.setData("a,b\n");
+
+    // Checkpoint reads the block of data again, but it is not counted
+    QtCSV::ReadStats stats;
+    CheckpointProcessor processor;
+    processor.nested = &nested;
+    QVERIFY2(QtCSV::Reader::readToProcessor(
+                 buffer, processor, ",", "\"", QStringConverter::Utf8,
+                 &stats),
+             "Failed to read data");
+    QVERIFY2(data.rowCount() == processor.last.rows &&
+                 buffer.size() == processor.last.offset,
+             "Wrong last checkpoint");
+    QVERIFY2(buffer.size() == stats.bytesRead,
+             "Checkpoints changed number of read bytes");
+}
+
 QString TestReader::getPathToFolderWithTestFiles() const {
     return QDir::currentPath() + "/data/";
 }
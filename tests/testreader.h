@@ -34,6 +34,14 @@ private Q_SLOTS:
     void testReadFileWithEmptyFieldsComplexSeparator();
     void testReadFileWithMultirowData();
     void testReadByProcessorWithBreak();
+    void testReadStats();
+    void testReadProgress();
+    void testReadCancel();
+    void testReadToDataInterning();
+    void testResumeFromCheckpoint_data();
+    void testResumeFromCheckpoint();
+    void testResumeInvalidCheckpoint();
+    void testCheckpointKeepsStats();
 
 private:
     QString getPathToFolderWithTestFiles() const;
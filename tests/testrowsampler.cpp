@@ -0,0 +1,206 @@
+#include "testrowsampler.h"
+#include "qtcsv/rowsampler.h"
+#include "qtcsv/stringdata.h"
+#include <QSet>
+
+// Write file with header "id,text,end" and rows with ids from 0. Texts of
+// rows have different lengths, with hasMultiLineValues each third text is
+// a quoted value with line ends.
+QString TestRowSampler::writeRowsFile(
+    const QString& name, const int rows, const bool hasMultiLineValues) const
+{
+    QByteArray data("id,text,end\n");
+    for (auto i = 0; i < rows; ++i) {
+        const auto text = QByteArray(1 + i % 7, 'a');
+        data += QByteArray::number(i) + ",";
+        data += hasMultiLineValues && i % 3 == 0 ?
+            "\"" + text + "\nline\r\nline\"" : text;
+        data += ",z\n";
+    }
+
+    return writeTestFile(name, data);
+}
+
+void TestRowSampler::testSampleInvalidArgs() {
+    const auto path = writeTestFile("data.csv", "id\n1\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::RowSampler sampler;
+    QtCSV::StringData data;
+    QVERIFY2(!sampler.sample(filePath("absent.csv"), 1, data),
+             "Absent file was sampled");
+    QVERIFY2(!sampler.sample(path, 1, data, QString()),
+             "File was sampled with empty separator");
+    QVERIFY2(!sampler.sample(path, -1, data),
+             "File was sampled with negative number of rows");
+    QVERIFY2(data.isEmpty(), "Failed sample added rows");
+
+    QVERIFY2(sampler.sample(path, 0, data), "Failed to sample no rows");
+    QVERIFY2(data.isEmpty(), "Rows were added to empty sample");
+    QVERIFY2(2 == sampler.rowCount(), "Wrong number of rows");
+}
+
+void TestRowSampler::testReservoirSmallFile() {
+    const auto path = writeRowsFile("data.csv", 5, true);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::RowSampler sampler;
+    sampler.setHasHeader(true);
+    QtCSV::StringData data;
+    QVERIFY2(sampler.sample(path, 10, data), "Failed to sample file");
+    QVERIFY2(5 == sampler.rowCount(), "Wrong number of rows");
+    QVERIFY2((QList<QString>{"id", "text", "end"}) == sampler.header(),
+             "Wrong header");
+
+    // All rows in the order of the file
+    QVERIFY2(5 == data.rowCount(), "Wrong number of sampled rows");
+    for (auto i = 0; i < data.rowCount(); ++i) {
+        const auto values = data.rowValues(i);
+        QVERIFY2(3 == values.size() && QString::number(i) == values.at(0),
+                 "Wrong sampled row");
+    }
+
+    QVERIFY2(QString("a\nline\r\nline") == data.rowValues(0).at(1),
+             "Wrong multi-line value");
+}
+
+void TestRowSampler::testReservoirSeed() {
+    const auto path = writeRowsFile("data.csv", 1000, true);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::RowSampler sampler;
+    sampler.setHasHeader(true);
+    sampler.setSeed(42);
+    QtCSV::StringData first;
+    QtCSV::StringData second;
+    QVERIFY2(sampler.sample(path, 20, first) &&
+                 sampler.sample(path, 20, second),
+             "Failed to sample file");
+    QVERIFY2(42 == sampler.seed(), "Wrong seed");
+    QVERIFY2(1000 == sampler.rowCount(), "Wrong number of rows");
+    QVERIFY2(20 == first.rowCount() && first == second,
+             "Samples with the same seed are different");
+
+    // Distinct rows in the order of the file
+    auto previous = -1;
+    for (auto i = 0; i < first.rowCount(); ++i) {
+        const auto values = first.rowValues(i);
+        QVERIFY2(3 == values.size() && QString("z") == values.at(2),
+                 "Wrong sampled row");
+        QVERIFY2(previous < values.at(0).toInt(), "Wrong order of rows");
+        previous = values.at(0).toInt();
+    }
+
+    sampler.setSeed(43);
+    QtCSV::StringData third;
+    QVERIFY2(sampler.sample(path, 20, third), "Failed to sample file");
+    QVERIFY2(20 == third.rowCount() && !(first == third),
+             "Samples with different seeds are equal");
+}
+
+void TestRowSampler::testReservoirUniform() {
+    const auto path = writeRowsFile("data.csv", 10, false);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    // Each row is sampled about 1000 * 3 / 10 times
+    QtCSV::RowSampler sampler;
+    sampler.setHasHeader(true);
+    QList<int> counts(10, 0);
+    for (quint32 seed = 0; seed < 1000; ++seed) {
+        sampler.setSeed(seed);
+        QtCSV::StringData data;
+        QVERIFY2(sampler.sample(path, 3, data) && 3 == data.rowCount(),
+                 "Failed to sample file");
+        for (auto i = 0; i < data.rowCount(); ++i) {
+            ++counts[data.rowValues(i).at(0).toInt()];
+        }
+    }
+
+    for (const auto count : counts) {
+        QVERIFY2(200 < count && count < 400, "Sample is not uniform");
+    }
+}
+
+void TestRowSampler::testOffsetsSeed() {
+    const auto path = writeRowsFile("data.csv", 1000, false);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::RowSampler sampler;
+    sampler.setMethod(QtCSV::RowSampler::Method::OFFSETS);
+    sampler.setHasHeader(true);
+    sampler.setSeed(7);
+    QtCSV::StringData first;
+    QtCSV::StringData second;
+    QVERIFY2(sampler.sample(path, 20, first) &&
+                 sampler.sample(path, 20, second),
+             "Failed to sample file");
+    QVERIFY2(-1 == sampler.rowCount(), "Rows were counted");
+    QVERIFY2(20 == first.rowCount() && first == second,
+             "Samples with the same seed are different");
+
+    auto previous = -1;
+    for (auto i = 0; i < first.rowCount(); ++i) {
+        const auto values = first.rowValues(i);
+        QVERIFY2(3 == values.size() && QString("z") == values.at(2),
+                 "Wrong sampled row");
+        QVERIFY2(previous < values.at(0).toInt(), "Wrong order of rows");
+        previous = values.at(0).toInt();
+    }
+}
+
+void TestRowSampler::testOffsetsMultiLineValues() {
+    const auto path = writeRowsFile("data.csv", 300, true);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    // Random positions inside of quoted values are synchronized with the
+    // next row
+    QtCSV::RowSampler sampler;
+    sampler.setMethod(QtCSV::RowSampler::Method::OFFSETS);
+    sampler.setHasHeader(true);
+    QSet<QString> ids;
+    for (quint32 seed = 0; seed < 10; ++seed) {
+        sampler.setSeed(seed);
+        QtCSV::StringData data;
+        QVERIFY2(sampler.sample(path, 30, data) && 30 == data.rowCount(),
+                 "Failed to sample file");
+        for (auto i = 0; i < data.rowCount(); ++i) {
+            const auto values = data.rowValues(i);
+            QVERIFY2(3 == values.size() && QString("z") == values.at(2),
+                     "Sampled row is not a row of the file");
+
+            const auto id = values.at(0).toInt();
+            const auto text = QString(1 + id % 7, QChar('a'));
+            QVERIFY2(values.at(1) == (id % 3 == 0 ?
+                         text + QString("\nline\r\nline") : text),
+                     "Wrong value of sampled row");
+            ids.insert(values.at(0));
+        }
+    }
+
+    QVERIFY2(100 < ids.size(), "Sample covers too few rows");
+}
+
+void TestRowSampler::testOffsetsSmallFile() {
+    const auto path = writeTestFile("data.csv", "id,text\n1,a\n2,b");
+    const auto headerOnly = writeTestFile("header.csv", "id,text\n");
+    QVERIFY2(!path.isEmpty() && !headerOnly.isEmpty(),
+             "Failed to write test files");
+
+    // The first row is sampled for positions inside of the last row
+    QtCSV::RowSampler sampler;
+    sampler.setMethod(QtCSV::RowSampler::Method::OFFSETS);
+    sampler.setHasHeader(true);
+    sampler.setSeed(1);
+    QtCSV::StringData data;
+    QVERIFY2(sampler.sample(path, 2, data), "Failed to sample file");
+    QVERIFY2(2 == data.rowCount() &&
+                 (QList<QString>{"1", "a"}) == data.rowValues(0) &&
+                 (QList<QString>{"2", "b"}) == data.rowValues(1),
+             "Wrong sampled rows");
+
+    data.clear();
+    QVERIFY2(sampler.sample(headerOnly, 2, data), "Failed to sample file");
+    QVERIFY2(data.isEmpty(), "Rows were sampled from header");
+    QVERIFY2((QList<QString>{"id", "text"}) == sampler.header(),
+             "Wrong header");
+}
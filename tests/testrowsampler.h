@@ -0,0 +1,26 @@
+#ifndef TESTROWSAMPLER_H
+#define TESTROWSAMPLER_H
+
+#include "tempdirtest.h"
+
+class TestRowSampler : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestRowSampler() = default;
+
+private Q_SLOTS:
+    void testSampleInvalidArgs();
+    void testReservoirSmallFile();
+    void testReservoirSeed();
+    void testReservoirUniform();
+    void testOffsetsSeed();
+    void testOffsetsMultiLineValues();
+    void testOffsetsSmallFile();
+
+private:
+    QString writeRowsFile(
+        const QString& name, int rows, bool hasMultiLineValues) const;
+};
+
+#endif // TESTROWSAMPLER_H
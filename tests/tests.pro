@@ -29,16 +29,64 @@ INCLUDEPATH += $$PWD/../include
 
 SOURCES += \
     tst_testmain.cpp \
+    tempdirtest.cpp \
     teststringdata.cpp \
     testvariantdata.cpp \
     testreader.cpp \
-    testwriter.cpp
+    testwriter.cpp \
+    testnumberconverter.cpp \
+    testpartitionedwriter.cpp \
+    testexternalsorter.cpp \
+    testcacheddata.cpp \
+    testtypedprocessor.cpp \
+    testsniffer.cpp \
+    testspilleddata.cpp \
+    testindexeddata.cpp \
+    testtablemodel.cpp \
+    testquery.cpp \
+    testhashjoin.cpp \
+    testfilefollower.cpp \
+    testmultireader.cpp \
+    testfilesplitter.cpp \
+    testfilemerger.cpp \
+    testjsonconverter.cpp \
+    testarrowwriter.cpp \
+    testrowsampler.cpp
 
 HEADERS += \
+    tempdirtest.h \
     teststringdata.h \
     testvariantdata.h \
     testreader.h \
-    testwriter.h
+    testwriter.h \
+    testnumberconverter.h \
+    testpartitionedwriter.h \
+    testexternalsorter.h \
+    testcacheddata.h \
+    testtypedprocessor.h \
+    testsniffer.h \
+    testspilleddata.h \
+    testindexeddata.h \
+    testtablemodel.h \
+    testquery.h \
+    testhashjoin.h \
+    testfilefollower.h \
+    testmultireader.h \
+    testfilesplitter.h \
+    testfilemerger.h \
+    testjsonconverter.h \
+    testarrowwriter.h \
+    testrowsampler.h
+
+# Tests of SqlImporter are built if library is built with it:
+# qmake CONFIG+=qtcsv_sql
+qtcsv_sql {
+    QT += sql
+    DEFINES += QTCSV_SQL
+
+    SOURCES += testsqlimporter.cpp
+    HEADERS += testsqlimporter.h
+}
 
 DISTFILES += \
     CMakeLists.txt
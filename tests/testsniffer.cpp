@@ -0,0 +1,196 @@
+#include "testsniffer.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/sniffer.h"
+#include <QFile>
+#include <QStringEncoder>
+#include <cstring>
+
+namespace {
+    // SequentialDevice returns data once, like a socket or a pipe
+    class SequentialDevice : public QIODevice {
+        QByteArray m_data;
+
+    public:
+        explicit SequentialDevice(const QByteArray& data) : m_data(data) {
+            open(QIODevice::ReadOnly);
+        }
+
+        bool isSequential() const override { return true; }
+
+        qint64 bytesAvailable() const override {
+            return m_data.size() + QIODevice::bytesAvailable();
+        }
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize) override {
+            const auto size = qMin(maxSize, static_cast<qint64>(m_data.size()));
+            std::memcpy(data, m_data.constData(), static_cast<size_t>(size));
+            m_data.remove(0, size);
+            return size;
+        }
+
+        qint64 writeData(const char* /*data*/, qint64 /*maxSize*/) override {
+            return -1;
+        }
+    };
+}
+
+void TestSniffer::testSniffInvalidArgs() {
+    QtCSV::Dialect dialect;
+    QVERIFY2(!QtCSV::Sniffer::sniff(filePath("absent.csv"), dialect),
+             "Absent file was sniffed");
+    QVERIFY2(!QtCSV::Sniffer::sniff(QByteArray(), dialect, true),
+             "Empty sample was sniffed");
+    QVERIFY2(!QtCSV::Sniffer::sniff(QByteArray("\xEF\xBB\xBF"), dialect, true),
+             "Sample with only BOM was sniffed");
+}
+
+void TestSniffer::testSniffSeparators_data() {
+    QTest::addColumn<QByteArray>("sample");
+    QTest::addColumn<QString>("separator");
+
+    QTest::newRow("comma") << QByteArray("a,b,c\n1,2,3\n4,5,6\n") << ",";
+    QTest::newRow("semicolon with decimal commas") <<
+        QByteArray("name;price\napple;1,5\npear;2\nplum;0,75\n") << ";";
+    QTest::newRow("tab") << QByteArray("a b\tc d\n1 2\t3\n") << "\t";
+    QTest::newRow("pipe") << QByteArray("a|b|c\n\"x|y\"|2|3\n4|5|6\n") << "|";
+    QTest::newRow("comma with quoted separators") <<
+        QByteArray("a,b\n\"x;y;z\",1\n\"u;v;w\",2\n") << ",";
+}
+
+void TestSniffer::testSniffSeparators() {
+    QFETCH(QByteArray, sample);
+    QFETCH(QString, separator);
+
+    QtCSV::Dialect dialect;
+    QVERIFY2(QtCSV::Sniffer::sniff(sample, dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2(separator == dialect.separator, "Wrong separator");
+}
+
+void TestSniffer::testSniffTextDelimiter() {
+    QtCSV::Dialect dialect;
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("a,b\n'x, y',1\n'z',2\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2("'" == dialect.textDelimiter, "Wrong quote delimiter");
+
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("a,b\n\"x, y\",1\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2("\"" == dialect.textDelimiter, "Wrong double quote delimiter");
+
+    // Double quotes inside of values
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("size,name\n5,5\" screen\n7,7\" screen\n"),
+                 dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2(dialect.textDelimiter.isEmpty(), "Wrong empty delimiter");
+
+    // Without quotes default delimiter is kept
+    QVERIFY2(QtCSV::Sniffer::sniff(QByteArray("a,b\n1,2\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2("\"" == dialect.textDelimiter, "Wrong default delimiter");
+}
+
+void TestSniffer::testSniffEncoding() {
+    const QString text = QString::fromUtf8("имя;город\nАнна;Москва\n");
+    QtCSV::Dialect dialect;
+
+    QVERIFY2(QtCSV::Sniffer::sniff(text.toUtf8(), dialect, true),
+             "Failed to sniff UTF-8");
+    QVERIFY2(QStringConverter::Utf8 == dialect.codec && !dialect.hasBom,
+             "Wrong UTF-8 encoding");
+    QVERIFY2(";" == dialect.separator, "Wrong separator in UTF-8");
+
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("\xEF\xBB\xBF") + text.toUtf8(), dialect, true),
+             "Failed to sniff UTF-8 with BOM");
+    QVERIFY2(QStringConverter::Utf8 == dialect.codec && dialect.hasBom,
+             "Wrong UTF-8 encoding with BOM");
+
+    QStringEncoder utf16(QStringConverter::Utf16LE);
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray(utf16.encode(QString("a;b\n1;2\n"))), dialect,
+                 true),
+             "Failed to sniff UTF-16");
+    QVERIFY2(QStringConverter::Utf16LE == dialect.codec && !dialect.hasBom,
+             "Wrong UTF-16 encoding");
+    QVERIFY2(";" == dialect.separator, "Wrong separator in UTF-16");
+
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("caf\xE9,na\xEFve\n1,2\n"), dialect, true),
+             "Failed to sniff Latin-1");
+    QVERIFY2(QStringConverter::Latin1 == dialect.codec,
+             "Wrong Latin-1 encoding");
+}
+
+void TestSniffer::testSniffLineEnding() {
+    QtCSV::Dialect dialect;
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("a,b\r\n1,2\r\n3,4\r\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2("\r\n" == dialect.lineEnding, "Wrong CRLF line ending");
+
+    // Reader doesn't end rows at CR
+    QVERIFY2(!QtCSV::Sniffer::sniff(QByteArray("a,b\r1,2\r"), dialect, true),
+             "Sample with CR line endings was sniffed");
+    QVERIFY2("\r" == dialect.lineEnding, "Wrong CR line ending");
+
+    // Lone CR inside of a value doesn't split the row
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("a;b\n1\r2;3\n4;5\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2("\n" == dialect.lineEnding && ";" == dialect.separator,
+             "Wrong dialect with lone CR");
+}
+
+void TestSniffer::testSniffHeader() {
+    QtCSV::Dialect dialect;
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("id,price\n1,0.5\n2,1.5\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2(dialect.hasHeader, "Header was not detected by numbers");
+
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("key,country\nAB12,RU\nCD34,US\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2(dialect.hasHeader, "Header was not detected by lengths");
+
+    QVERIFY2(QtCSV::Sniffer::sniff(
+                 QByteArray("1,0.5\n2,1.5\n3,2.5\n"), dialect, true),
+             "Failed to sniff sample");
+    QVERIFY2(!dialect.hasHeader, "Header was detected in numbers");
+}
+
+void TestSniffer::testSniffTruncatedSample() {
+    const auto path = filePath("input.csv");
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::WriteOnly), "Failed to open file");
+
+    // The last line of the sample is cut in the middle
+    file.write("a;b;c\n");
+    for (auto i = 0; i < 1000; ++i) { file.write("1;2;3\n"); }
+
+    file.close();
+
+    QtCSV::Dialect dialect;
+    QVERIFY2(QtCSV::Sniffer::sniff(path, dialect, 1000),
+             "Failed to sniff file");
+    QVERIFY2(";" == dialect.separator, "Wrong separator");
+}
+
+void TestSniffer::testSniffSequentialDevice() {
+    const QByteArray data("a|b\n1|2\n3|4\n");
+    SequentialDevice device(data);
+
+    QtCSV::Dialect dialect;
+    QVERIFY2(QtCSV::Sniffer::sniff(device, dialect), "Failed to sniff device");
+    QVERIFY2("|" == dialect.separator, "Wrong separator");
+
+    // Data was not consumed
+    const auto rows = QtCSV::Reader::readToList(
+        device, dialect.separator, dialect.textDelimiter, dialect.codec);
+    QVERIFY2(3 == rows.size(), "Data was consumed by sniffing");
+    QVERIFY2((QList<QString>{"3", "4"}) == rows.last(), "Wrong values");
+}
@@ -0,0 +1,24 @@
+#ifndef TESTSNIFFER_H
+#define TESTSNIFFER_H
+
+#include "tempdirtest.h"
+
+class TestSniffer : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestSniffer() = default;
+
+private Q_SLOTS:
+    void testSniffInvalidArgs();
+    void testSniffSeparators_data();
+    void testSniffSeparators();
+    void testSniffTextDelimiter();
+    void testSniffEncoding();
+    void testSniffLineEnding();
+    void testSniffHeader();
+    void testSniffTruncatedSample();
+    void testSniffSequentialDevice();
+};
+
+#endif // TESTSNIFFER_H
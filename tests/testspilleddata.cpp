@@ -0,0 +1,121 @@
+#include "testspilleddata.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/spilleddata.h"
+#include "qtcsv/writer.h"
+#include <QDir>
+
+QList<QString> TestSpilledData::testRow(const qsizetype index) const {
+    if (index % 10 == 9) { return {}; }
+
+    return {QString::number(index), QString("value, %1").arg(index),
+            QString::fromUtf8("значение\n%1").arg(index)};
+}
+
+void TestSpilledData::testAddRowsInMemory() {
+    QtCSV::SpilledData data;
+    data.setTempDir(dirPath());
+    QVERIFY2(data.isEmpty(), "New container is not empty");
+
+    data.addRow({"a", "b"});
+    data.addEmptyRow();
+    QVERIFY2(!data.isEmpty() && 2 == data.rowCount(), "Wrong number of rows");
+    QVERIFY2((QList<QString>{"a", "b"}) == data.rowValues(0),
+             "Wrong values of the first row");
+    QVERIFY2(data.rowValues(1).isEmpty(), "Wrong values of empty row");
+    QVERIFY2(data.rowValues(2).isEmpty() && data.rowValues(-1).isEmpty(),
+             "Values of invalid rows are not empty");
+    QVERIFY2(!data.isSpilled(), "Small data was spilled");
+    QVERIFY2(QDir(dirPath()).isEmpty(), "Temporary file was created");
+}
+
+void TestSpilledData::testSpillAndLoadBlocks() {
+    const qint64 limit = 16 * 1024;
+    const qsizetype rowsNumber = 5000;
+
+    QtCSV::SpilledData data;
+    data.setTempDir(dirPath());
+    data.setMemoryLimit(limit);
+    QVERIFY2(data.setBlockSize(50), "Failed to set block size");
+    for (qsizetype i = 0; i < rowsNumber; ++i) { data.addRow(testRow(i)); }
+
+    QVERIFY2(rowsNumber == data.rowCount(), "Wrong number of rows");
+    QVERIFY2(data.isSpilled(), "Data was not spilled");
+    QVERIFY2(!QDir(dirPath()).isEmpty(), "Temporary file was not created");
+    QVERIFY2(data.memoryUsage() <= 2 * limit, "Memory limit was exceeded");
+
+    // Sequential access
+    for (qsizetype i = 0; i < rowsNumber; ++i) {
+        QVERIFY2(testRow(i) == data.rowValues(i), "Wrong row values");
+    }
+
+    // Random access loads blocks back
+    for (qsizetype i = 0; i < 2000; ++i) {
+        const auto row = (i * 7919) % rowsNumber;
+        QVERIFY2(testRow(row) == data.rowValues(row),
+                 "Wrong row values on random access");
+    }
+
+    QVERIFY2(data.memoryUsage() <= 2 * limit, "Memory limit was exceeded");
+
+    // Rows could be added after blocks were loaded
+    data.addRow({"last"});
+    QVERIFY2((QList<QString>{"last"}) == data.rowValues(rowsNumber),
+             "Wrong values of the added row");
+    QVERIFY2(testRow(0) == data.rowValues(0), "Wrong values of the first row");
+}
+
+void TestSpilledData::testBlockSize() {
+    QtCSV::SpilledData data;
+    QVERIFY2(data.setBlockSize(10), "Failed to set block size");
+
+    data.addRow({"a"});
+    QVERIFY2(!data.setBlockSize(20),
+             "Block size was changed in non-empty container");
+
+    data.clear();
+    QVERIFY2(data.setBlockSize(20), "Failed to set block size after clear");
+}
+
+void TestSpilledData::testClear() {
+    QtCSV::SpilledData data;
+    data.setTempDir(dirPath());
+    data.setMemoryLimit(1024);
+    data.setBlockSize(10);
+    for (qsizetype i = 0; i < 500; ++i) { data.addRow(testRow(i)); }
+
+    QVERIFY2(data.isSpilled(), "Data was not spilled");
+
+    data.clear();
+    QVERIFY2(data.isEmpty() && 0 == data.rowCount(), "Data was not cleared");
+    QVERIFY2(0 == data.memoryUsage(), "Memory was not released");
+    QVERIFY2(!data.isSpilled(), "Temporary file was not removed");
+    QVERIFY2(QDir(dirPath()).isEmpty(), "Temporary file still exists");
+
+    data.addRow({"a", "b"});
+    QVERIFY2((QList<QString>{"a", "b"}) == data.rowValues(0),
+             "Wrong values after clear");
+}
+
+void TestSpilledData::testReadAndWriteSpilledData() {
+    const qsizetype rowsNumber = 3000;
+
+    QtCSV::SpilledData source;
+    source.setTempDir(dirPath());
+    source.setMemoryLimit(8 * 1024);
+    source.setBlockSize(100);
+    for (qsizetype i = 0; i < rowsNumber; ++i) { source.addRow(testRow(i)); }
+
+    const auto path = filePath("output.csv");
+    QVERIFY2(QtCSV::Writer::write(path, source), "Failed to write data");
+
+    QtCSV::SpilledData data;
+    data.setTempDir(dirPath());
+    data.setMemoryLimit(8 * 1024);
+    data.setBlockSize(100);
+    QVERIFY2(QtCSV::Reader::readToData(path, data), "Failed to read data");
+    QVERIFY2(data.isSpilled(), "Read data was not spilled");
+    QVERIFY2(rowsNumber == data.rowCount(), "Wrong number of rows");
+    for (qsizetype i = rowsNumber - 1; 0 <= i; --i) {
+        QVERIFY2(testRow(i) == data.rowValues(i), "Wrong row values");
+    }
+}
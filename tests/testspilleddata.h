@@ -0,0 +1,23 @@
+#ifndef TESTSPILLEDDATA_H
+#define TESTSPILLEDDATA_H
+
+#include "tempdirtest.h"
+
+class TestSpilledData : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestSpilledData() = default;
+
+private Q_SLOTS:
+    void testAddRowsInMemory();
+    void testSpillAndLoadBlocks();
+    void testBlockSize();
+    void testClear();
+    void testReadAndWriteSpilledData();
+
+private:
+    QList<QString> testRow(qsizetype index) const;
+};
+
+#endif // TESTSPILLEDDATA_H
@@ -0,0 +1,253 @@
+#include "testsqlimporter.h"
+#include "qtcsv/sqlimporter.h"
+#include <QBuffer>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+namespace {
+    const QString CONNECTION_NAME("qtcsv_tests");
+}
+
+void TestSqlImporter::init() {
+    QVERIFY2(createDir(), "Failed to create temporary directory");
+
+    m_database = QSqlDatabase::addDatabase("QSQLITE", CONNECTION_NAME);
+    m_database.setDatabaseName(filePath("test.sqlite"));
+    QVERIFY2(m_database.open(), "Failed to open database");
+}
+
+void TestSqlImporter::cleanup() {
+    m_database.close();
+    m_database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(CONNECTION_NAME);
+    removeDir();
+}
+
+// Get rows of the select statement. Null values are returned as "<null>".
+QList<QList<QString>> TestSqlImporter::selectRows(
+    const QString& statement) const
+{
+    QList<QList<QString>> rows;
+    QSqlQuery query(m_database);
+    if (!query.exec(statement)) { return rows; }
+
+    while (query.next()) {
+        QList<QString> row;
+        for (int i = 0; i < query.record().count(); ++i) {
+            const auto value = query.value(i);
+            row << (value.isNull() ? QString("<null>") : value.toString());
+        }
+
+        rows << row;
+    }
+
+    return rows;
+}
+
+void TestSqlImporter::testImportInvalidArgs() {
+    const auto path = writeTestFile("data.csv", "id\n1\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::SqlImporter importer(m_database, "data");
+    QVERIFY2(!importer.import(filePath("absent.csv")),
+             "Absent file was imported");
+    QVERIFY2(!importer.import(path, QString()),
+             "File was imported with empty separator");
+
+    importer.setJournalMode("WAL; DROP TABLE data");
+    QVERIFY2(!importer.import(path), "File was imported with wrong pragma");
+    QVERIFY2(!m_database.tables().contains("data"),
+             "Failed import created table");
+
+    QtCSV::SqlImporter closedImporter(QSqlDatabase(), "data");
+    QVERIFY2(!closedImporter.import(path),
+             "File was imported to invalid database");
+
+    // Header is an empty line
+    const auto noHeaderPath = writeTestFile("no-header.csv", "\n1\n");
+    QVERIFY2(!noHeaderPath.isEmpty(), "Failed to write test file");
+    QtCSV::SqlImporter noHeaderImporter(m_database, "data");
+    QVERIFY2(!noHeaderImporter.import(noHeaderPath),
+             "File without columns was imported");
+    QVERIFY2(!m_database.tables().contains("data"),
+             "Failed import created table");
+
+    QSqlQuery query(m_database);
+    QVERIFY2(query.exec("CREATE TABLE data (id TEXT)"),
+             "Failed to create table");
+    QVERIFY2(!noHeaderImporter.import(noHeaderPath),
+             "File without columns was appended to table");
+}
+
+void TestSqlImporter::testImportCreatesTable() {
+    const auto path = writeTestFile(
+        "data.csv",
+        "id,\"full name\"\n"
+        "1,\"Smith, John\"\n"
+        "2,\"multi\nline\"\n"
+        "3,\"say \"\"hi\"\"\"\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    // The last batch needs a statement with fewer rows
+    QtCSV::SqlImporter importer(m_database, "data");
+    importer.setStatementRows(2);
+    QVERIFY2(importer.import(path), "Failed to import file");
+    QVERIFY2(3 == importer.importedRows(), "Wrong number of imported rows");
+
+    const QList<QList<QString>> expected = {
+        {"1", "Smith, John"}, {"2", "multi\nline"}, {"3", "say \"hi\""}};
+    QVERIFY2(expected == selectRows(
+                 "SELECT id, \"full name\" FROM data ORDER BY rowid"),
+             "Wrong rows of table");
+    QVERIFY2(QList<QList<QString>>{{"text"}} ==
+                 selectRows("SELECT DISTINCT typeof(id) FROM data"),
+             "Columns of created table are not text");
+}
+
+void TestSqlImporter::testImportToExistingTable() {
+    QSqlQuery query(m_database);
+    QVERIFY2(query.exec("CREATE TABLE data (id INTEGER, name TEXT, "
+                        "note TEXT DEFAULT 'none')") &&
+                 query.exec("INSERT INTO data VALUES (1, 'a', 'old')"),
+             "Failed to create table");
+
+    // Order of columns could differ from the table
+    QByteArray data("name,id\nb,2\nc,3\n");
+    QBuffer buffer(&data);
+    QtCSV::SqlImporter importer(m_database, "data");
+    QVERIFY2(importer.import(buffer), "Failed to import IO Device");
+
+    const QList<QList<QString>> expected = {
+        {"1", "a", "old"}, {"2", "b", "none"}, {"3", "c", "none"}};
+    QVERIFY2(expected == selectRows("SELECT * FROM data ORDER BY rowid"),
+             "Wrong rows of table");
+    QVERIFY2(QList<QList<QString>>{{"integer"}} ==
+                 selectRows("SELECT DISTINCT typeof(id) FROM data"),
+             "Values are not converted to types of columns");
+
+    const auto path = writeTestFile("other.csv", "id,absent\n4,d\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+    QVERIFY2(!importer.import(path), "File with unknown column was imported");
+    QVERIFY2(expected == selectRows("SELECT * FROM data ORDER BY rowid"),
+             "Failed import changed table");
+}
+
+void TestSqlImporter::testImportReplacesTable() {
+    QSqlQuery query(m_database);
+    QVERIFY2(query.exec("CREATE TABLE data (old)") &&
+                 query.exec("INSERT INTO data VALUES (1)"),
+             "Failed to create table");
+
+    const auto path = writeTestFile("data.csv", "id,value\n1,a\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::SqlImporter importer(m_database, "data");
+    importer.setMode(QtCSV::SqlImporter::Mode::REPLACE);
+    QVERIFY2(importer.import(path), "Failed to import file");
+    QVERIFY2((QList<QList<QString>>{{"1", "a"}}) ==
+                 selectRows("SELECT * FROM data"),
+             "Table was not replaced");
+}
+
+void TestSqlImporter::testMissingAndExtraValues() {
+    const auto path = writeTestFile("data.csv", "a,b\n1\n2,3\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::SqlImporter importer(m_database, "data");
+    QVERIFY2(importer.import(path), "Failed to import file");
+    QVERIFY2((QList<QList<QString>>{{"1", "<null>"}, {"2", "3"}}) ==
+                 selectRows("SELECT a, b FROM data ORDER BY rowid"),
+             "Missing values are not null");
+
+    // Rows of failed import are rolled back
+    const auto extraPath = writeTestFile("extra.csv", "a,b\n4,5\n6,7,8\n");
+    QVERIFY2(!extraPath.isEmpty(), "Failed to write test file");
+    QVERIFY2(!importer.import(extraPath),
+             "Row with extra values was imported");
+    QVERIFY2(0 == importer.importedRows(), "Wrong number of imported rows");
+    QVERIFY2(2 == selectRows("SELECT * FROM data").size(),
+             "Failed import changed table");
+
+    // The first row is data if columns are set
+    importer.setColumns({"a", "b"});
+    QVERIFY2(importer.import(path), "Failed to import file with columns");
+    QVERIFY2(5 == selectRows("SELECT * FROM data").size(),
+             "Header was not imported as data");
+}
+
+void TestSqlImporter::testTransactionRows() {
+    QByteArray data("id\n");
+    for (int i = 1; i <= 10; ++i) {
+        data += QByteArray::number(i) + (i == 8 ? ",extra\n" : "\n");
+    }
+
+    const auto path = writeTestFile("data.csv", data);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    // Transaction is committed after each 2 statements, the fourth
+    // statement fails
+    QtCSV::SqlImporter importer(m_database, "data");
+    importer.setStatementRows(2);
+    importer.setTransactionRows(3);
+    QVERIFY2(!importer.import(path), "Row with extra values was imported");
+    QVERIFY2(4 == importer.importedRows(), "Wrong number of imported rows");
+    QVERIFY2((QList<QList<QString>>{{"1"}, {"2"}, {"3"}, {"4"}}) ==
+                 selectRows("SELECT id FROM data ORDER BY rowid"),
+             "Committed rows were not kept");
+}
+
+void TestSqlImporter::testEmptyAsNullAndPragmas() {
+    const auto path = writeTestFile("data.csv", "a,b\n,x\n,\n");
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::SqlImporter importer(m_database, "data");
+    importer.setEmptyAsNull(true);
+    importer.setJournalMode("wal");
+    importer.setSynchronous("OFF");
+    QVERIFY2(importer.import(path), "Failed to import file");
+    QVERIFY2((QList<QList<QString>>{{"<null>", "x"}, {"<null>", "<null>"}}) ==
+                 selectRows("SELECT a, b FROM data ORDER BY rowid"),
+             "Empty values are not null");
+    QVERIFY2((QList<QList<QString>>{{"wal"}}) ==
+                 selectRows("PRAGMA journal_mode"),
+             "Journal mode was not set");
+    QVERIFY2((QList<QList<QString>>{{"0"}}) ==
+                 selectRows("PRAGMA synchronous"),
+             "Synchronous mode was not set");
+}
+
+void TestSqlImporter::testImportManyRows() {
+    const int rowsCount = 10000;
+    QByteArray data("id,value\n");
+    for (int i = 0; i < rowsCount; ++i) {
+        data += QByteArray::number(i) + ",\"value\n" +
+            QByteArray::number(i) + "\"\n";
+    }
+
+    const auto path = writeTestFile("data.csv", data);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    // Rows are parsed faster than inserted, so the queue is full
+    QtCSV::SqlImporter importer(m_database, "data");
+    importer.setStatementRows(7);
+    QVERIFY2(importer.import(path), "Failed to import file");
+    QVERIFY2(rowsCount == importer.importedRows(),
+             "Wrong number of imported rows");
+
+    auto rows = selectRows("SELECT id, value FROM data ORDER BY rowid");
+    QVERIFY2(rowsCount == rows.size(), "Wrong number of rows of table");
+    for (int i = 0; i < rowsCount; ++i) {
+        QVERIFY2((QList<QString>{QString::number(i),
+                                 QString("value\n%1").arg(i)}) == rows.at(i),
+                 "Wrong order of rows");
+    }
+
+    // IO Device that is not a file is read by the calling thread
+    QBuffer buffer(&data);
+    importer.setMode(QtCSV::SqlImporter::Mode::REPLACE);
+    QVERIFY2(importer.import(buffer), "Failed to import IO Device");
+    QVERIFY2(rowsCount == importer.importedRows(),
+             "Wrong number of imported rows of IO Device");
+    QVERIFY2(rows == selectRows("SELECT id, value FROM data ORDER BY rowid"),
+             "Wrong rows of IO Device");
+}
@@ -0,0 +1,31 @@
+#ifndef TESTSQLIMPORTER_H
+#define TESTSQLIMPORTER_H
+
+#include "tempdirtest.h"
+#include <QSqlDatabase>
+
+class TestSqlImporter : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestSqlImporter() = default;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void testImportInvalidArgs();
+    void testImportCreatesTable();
+    void testImportToExistingTable();
+    void testImportReplacesTable();
+    void testMissingAndExtraValues();
+    void testTransactionRows();
+    void testEmptyAsNullAndPragmas();
+    void testImportManyRows();
+
+private:
+    QList<QList<QString>> selectRows(const QString& statement) const;
+
+    QSqlDatabase m_database;
+};
+
+#endif // TESTSQLIMPORTER_H
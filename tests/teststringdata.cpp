@@ -264,3 +264,56 @@ void TestStringData::testReplaceRow() {
     strData.replaceRow(1, valuesFirst);
     QVERIFY2(valuesFirst == strData.rowValues(1), "Wrong data for second row");
 }
+
+void TestStringData::testInterning() {
+    QtCSV::StringData strData;
+    strData.setInterning(true);
+    QVERIFY2(strData.isInterning(), "Interning was not enabled");
+
+    // Values are created separately, as reader does it
+    for (auto i = 0; i < 10; ++i) {
+        strData << (QList<QString>() << QString("RU") << QString::number(i));
+    }
+
+    QVERIFY2(10 == strData.rowCount(), "Wrong number of rows");
+    QVERIFY2((QList<QString>() << "RU" << "3") == strData.rowValues(3),
+             "Wrong data of interned row");
+    QVERIFY2(strData.rowValues(0).at(0).constData() ==
+                 strData.rowValues(9).at(0).constData(),
+             "Equal values don't share data");
+    QVERIFY2(1 == strData.interner().cardinality(0) &&
+                 10 == strData.interner().cardinality(1),
+             "Wrong cardinality of columns");
+
+    strData.insertRow(0, QList<QString>() << QString("RU"));
+    strData.replaceRow(1, QList<QString>() << QString("RU"));
+    QVERIFY2(strData.rowValues(0).at(0).constData() ==
+                 strData.rowValues(1).at(0).constData(),
+             "Inserted and replaced values don't share data");
+
+    strData.clear();
+    QVERIFY2(strData.isInterning() && 0 == strData.interner().cardinality(0),
+             "Interner was not cleared");
+}
+
+void TestStringData::testInterningCardinalityLimit() {
+    QtCSV::StringData strData;
+    strData.setInterning(true, 2);
+    strData << (QList<QString>() << "a" << "x")
+            << (QList<QString>() << "b" << "x")
+            << (QList<QString>() << "c" << "x")
+            << (QList<QString>() << "a" << "x");
+
+    QVERIFY2(!strData.interner().isInterned(0),
+             "Column with many distinct values is still interned");
+    QVERIFY2(0 == strData.interner().cardinality(0),
+             "Table of column was not freed");
+    QVERIFY2(strData.interner().isInterned(1) &&
+                 1 == strData.interner().cardinality(1),
+             "Column with one value is not interned");
+    QVERIFY2((QList<QString>() << "c" << "x") == strData.rowValues(2),
+             "Wrong data");
+
+    QtCSV::StringData plain;
+    QVERIFY2(!plain.isInterning(), "Interning is enabled by default");
+}
@@ -24,6 +24,8 @@ private Q_SLOTS:
     void testOperatorInput();
     void testRemoveRow();
     void testReplaceRow();
+    void testInterning();
+    void testInterningCardinalityLimit();
 };
 
 #endif // TESTSTRINGDATA_H
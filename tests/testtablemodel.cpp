@@ -0,0 +1,138 @@
+#include "testtablemodel.h"
+#include "qtcsv/tablemodel.h"
+#include "qtcsv/writer.h"
+
+void TestTableModel::testOpenInvalidArgs() {
+    QtCSV::TableModel model;
+    QVERIFY2(!model.open(filePath("absent.csv")),
+             "Absent file was opened");
+    QVERIFY2(!model.isIndexing(), "Indexing was started");
+
+    const auto path = writeCsvFile({{"a", "b"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+    QVERIFY2(!model.open(path, QString()),
+             "File was opened with empty separator");
+    QVERIFY2(0 == model.rowCount() && 0 == model.columnCount(),
+             "Model is not empty");
+}
+
+void TestTableModel::testFetchRows() {
+    QList<QList<QString>> rows;
+    for (auto i = 0; i < 2500; ++i) {
+        rows << QList<QString>{QString::number(i), QString("line\n%1").arg(i),
+                               "x, y"};
+    }
+
+    const auto path = writeCsvFile(rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::TableModel model;
+    model.setFetchSize(1000);
+    auto finishedSignals = 0;
+    QObject::connect(&model, &QtCSV::TableModel::indexingFinished,
+                     [&finishedSignals](qsizetype) { ++finishedSignals; });
+
+    QVERIFY2(model.open(path), "Failed to open file");
+    QVERIFY2(model.waitForIndexing(), "Indexing was not finished");
+    QVERIFY2(!model.isIndexing(), "Model is still indexing");
+    QVERIFY2(1 == finishedSignals, "Wrong number of finish signals");
+    QVERIFY2(2500 == model.indexedRowCount(), "Wrong number of indexed rows");
+    QVERIFY2(3 == model.columnCount(), "Wrong number of columns");
+
+    // The first part of rows is fetched automatically
+    QVERIFY2(1000 == model.rowCount(), "Wrong number of fetched rows");
+    QVERIFY2(model.canFetchMore(QModelIndex()), "No more rows to fetch");
+    model.fetchMore(QModelIndex());
+    model.fetchMore(QModelIndex());
+    QVERIFY2(2500 == model.rowCount(), "Not all rows were fetched");
+    QVERIFY2(!model.canFetchMore(QModelIndex()), "Extra rows to fetch");
+
+    for (const auto row : {2499, 0, 1234, 1}) {
+        QVERIFY2(rows.at(row) == model.rowValues(row), "Wrong row values");
+        QVERIFY2(rows.at(row).at(1) ==
+                     model.data(model.index(row, 1)).toString(),
+                 "Wrong data of the cell");
+    }
+
+    QVERIFY2(!model.data(model.index(0, 1), Qt::ToolTipRole).isValid(),
+             "Data for unsupported role");
+    QVERIFY2(model.rowValues(2500).isEmpty(), "Values of invalid row");
+}
+
+void TestTableModel::testHeader() {
+    const auto path = writeCsvFile({{"id", "name"}, {"1", "first"},
+                                     {"2", "second", "extra"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::TableModel model;
+    QVERIFY2(model.open(path, ",", "\"", QStringConverter::Utf8, true),
+             "Failed to open file");
+    QVERIFY2(model.waitForIndexing(), "Indexing was not finished");
+    QVERIFY2(2 == model.rowCount(), "Header was counted as a row");
+    QVERIFY2(3 == model.columnCount(), "Wrong number of columns");
+    QVERIFY2("name" == model.headerData(1, Qt::Horizontal).toString(),
+             "Wrong header value");
+    QVERIFY2("first" == model.data(model.index(0, 1)).toString(),
+             "Wrong value of the first row");
+    QVERIFY2("extra" == model.data(model.index(1, 2)).toString(),
+             "Wrong value of the extra column");
+    QVERIFY2(!model.data(model.index(0, 2)).isValid(),
+             "Missing value is valid");
+
+    model.close();
+    QVERIFY2(0 == model.rowCount() && 0 == model.columnCount(),
+             "Model was not cleared");
+    QVERIFY2(!model.headerData(1, Qt::Horizontal).toString().contains("name"),
+             "Header was not cleared");
+}
+
+void TestTableModel::testColumnStats() {
+    const auto path = writeCsvFile({{"1", "short", ""}, {"22.5", "", ""},
+                                     {"abc", "very long value", "x"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::TableModel model;
+    QVERIFY2(model.open(path), "Failed to open file");
+    QVERIFY2(model.waitForIndexing(), "Indexing was not finished");
+
+    const auto first = model.columnStats(0);
+    QVERIFY2(4 == first.maxWidth && 3 == first.values && 2 == first.numbers,
+             "Wrong statistics of the first column");
+    const auto second = model.columnStats(1);
+    QVERIFY2(15 == second.maxWidth && 2 == second.values &&
+                 0 == second.numbers,
+             "Wrong statistics of the second column");
+    QVERIFY2(0 == model.columnStats(3).values,
+             "Statistics of invalid column");
+
+    model.setStatsRowLimit(1);
+    QVERIFY2(model.open(path), "Failed to reopen file");
+    QVERIFY2(model.waitForIndexing(), "Indexing was not finished");
+    QVERIFY2(1 == model.columnStats(0).values &&
+                 5 == model.columnStats(1).maxWidth,
+             "Statistics were collected from extra rows");
+}
+
+void TestTableModel::testCloseWhileIndexing() {
+    QList<QList<QString>> rows;
+    for (auto i = 0; i < 200000; ++i) {
+        rows << QList<QString>{QString::number(i), "value"};
+    }
+
+    const auto path = writeCsvFile(rows);
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    auto model = std::make_unique<QtCSV::TableModel>();
+    QVERIFY2(model->open(path), "Failed to open file");
+    model->close();
+    QVERIFY2(!model->isIndexing() && 0 == model->rowCount(),
+             "Model was not closed");
+
+    QVERIFY2(model->open(path), "Failed to reopen file");
+    QVERIFY2(model->waitForIndexing(), "Indexing was not finished");
+    QVERIFY2(200000 == model->indexedRowCount(), "Wrong number of rows");
+
+    // Model could be destroyed while indexing
+    QVERIFY2(model->open(path), "Failed to reopen file");
+    model.reset();
+}
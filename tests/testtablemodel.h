@@ -0,0 +1,20 @@
+#ifndef TESTTABLEMODEL_H
+#define TESTTABLEMODEL_H
+
+#include "tempdirtest.h"
+
+class TestTableModel : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestTableModel() = default;
+
+private Q_SLOTS:
+    void testOpenInvalidArgs();
+    void testFetchRows();
+    void testHeader();
+    void testColumnStats();
+    void testCloseWhileIndexing();
+};
+
+#endif // TESTTABLEMODEL_H
@@ -0,0 +1,190 @@
+#include "testtypedprocessor.h"
+#include "qtcsv/reader.h"
+#include "qtcsv/typedprocessor.h"
+#include "qtcsv/writer.h"
+
+namespace {
+    // CollectProcessor saves values of typed rows as QVariants
+    class CollectProcessor : public QtCSV::TypedProcessor {
+    public:
+        QList<QList<QVariant>> rows;
+
+        CollectProcessor() = default;
+        explicit CollectProcessor(const QtCSV::Schema& schema) :
+            QtCSV::TypedProcessor(schema) {}
+
+        bool processRow(const QtCSV::TypedRow& row) override {
+            QList<QVariant> values;
+            for (qsizetype i = 0; i < row.size(); ++i) {
+                values << row.value(i);
+            }
+
+            rows << values;
+            return true;
+        }
+    };
+}
+
+void TestTypedProcessor::testHeaderOnly() {
+    const auto path = writeCsvFile(
+        {{"id", "name", "id"}, {"1", "first", "x"}, {}, {"2", "", "y"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    CollectProcessor processor;
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor),
+             "Failed to read file");
+
+    const QList<QString> header = {"id", "name", "id"};
+    QVERIFY2(header == processor.header(), "Wrong header");
+    QVERIFY2(0 == processor.columnIndex("id") &&
+                 1 == processor.columnIndex("name") &&
+                 -1 == processor.columnIndex("absent"),
+             "Wrong indexes of columns");
+
+    // Empty row is skipped, empty value is null
+    QVERIFY2(2 == processor.rowCount() && 2 == processor.rows.size(),
+             "Wrong number of rows");
+    QVERIFY2(QVariant("first") == processor.rows.at(0).at(1),
+             "Wrong string value");
+    QVERIFY2(!processor.rows.at(1).at(1).isValid(), "Empty value is not null");
+    QVERIFY2(QVariant("y") == processor.rows.at(1).at(2),
+             "Wrong value of duplicate column");
+}
+
+void TestTypedProcessor::testSchemaTypes() {
+    const auto path = writeCsvFile({{"name", "count", "price", "active"},
+        {"apple", "12", "0.5", "true"},
+        {"pear", "-3", "1e3", "0"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    class SumProcessor : public QtCSV::TypedProcessor {
+    public:
+        qint64 count = 0;
+        double price = 0.0;
+        qsizetype active = 0;
+        QList<QString> names;
+
+        explicit SumProcessor(const QtCSV::Schema& schema) :
+            QtCSV::TypedProcessor(schema) {}
+
+        bool processRow(const QtCSV::TypedRow& row) override {
+            count += row.toLongLong("count");
+            price += row.toDouble("price");
+            if (row.toBool("active")) { ++active; }
+
+            names << row.toString("name");
+            return true;
+        }
+    };
+
+    QtCSV::Schema schema;
+    schema.addColumn("name")
+        .addColumn("count", QtCSV::Schema::Type::INTEGER)
+        .addColumn("price", QtCSV::Schema::Type::DOUBLE)
+        .addColumn("active", QtCSV::Schema::Type::BOOL);
+
+    SumProcessor processor(schema);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor),
+             "Failed to read file");
+    QVERIFY2(9 == processor.count, "Wrong sum of integers");
+    QVERIFY2(qFuzzyCompare(1000.5, processor.price),
+             "Wrong sum of floating point numbers");
+    QVERIFY2(1 == processor.active, "Wrong booleans");
+    QVERIFY2((QList<QString>{"apple", "pear"}) == processor.names,
+             "Wrong strings");
+}
+
+void TestTypedProcessor::testSchemaColumnOrder() {
+    const auto path = writeCsvFile(
+        {{"extra", "b", "a"}, {"x", "2", "1"}, {"y", "4", "3"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Schema schema;
+    schema.addColumn("a", QtCSV::Schema::Type::INTEGER)
+        .addColumn("b", QtCSV::Schema::Type::INTEGER);
+
+    CollectProcessor processor(schema);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor),
+             "Failed to read file");
+    QVERIFY2(0 == processor.columnIndex("a") &&
+                 1 == processor.columnIndex("b") &&
+                 -1 == processor.columnIndex("extra"),
+             "Wrong indexes of columns");
+
+    const QList<QList<QVariant>> expected = {
+        {QVariant(1LL), QVariant(2LL)}, {QVariant(3LL), QVariant(4LL)}};
+    QVERIFY2(expected == processor.rows, "Wrong values");
+}
+
+void TestTypedProcessor::testNullsAndDefaults() {
+    const auto path = writeCsvFile(
+        {{"a", "b"}, {"1", ""}, {"", "2,5"}, {"3"}});
+    QVERIFY2(!path.isEmpty(), "Failed to write test file");
+
+    QtCSV::Schema schema;
+    schema.addColumn("a", QtCSV::Schema::Type::INTEGER, true)
+        .addColumn("b", QtCSV::Schema::Type::DOUBLE, false, 0.5)
+        .addColumn("c", QtCSV::Schema::Type::STRING, false, "none");
+    schema.setDecimalSeparator(QChar(','));
+
+    CollectProcessor processor(schema);
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor),
+             "Failed to read file");
+
+    const QList<QList<QVariant>> expected = {
+        {QVariant(1LL), QVariant(0.5), QVariant("none")},
+        {QVariant(), QVariant(2.5), QVariant("none")},
+        {QVariant(3LL), QVariant(0.5), QVariant("none")}};
+    QVERIFY2(expected == processor.rows, "Wrong values");
+}
+
+void TestTypedProcessor::testConversionErrors() {
+    QtCSV::Schema schema;
+    schema.addColumn("a", QtCSV::Schema::Type::INTEGER, false);
+
+    // Column is absent in the header
+    auto path = writeCsvFile({{"b"}, {"1"}});
+    CollectProcessor absent(schema);
+    QVERIFY2(!QtCSV::Reader::readToProcessor(path, absent),
+             "Absent column was accepted");
+
+    // Value is not a number
+    path = writeCsvFile({{"a"}, {"1"}, {"x"}, {"3"}});
+    CollectProcessor invalid(schema);
+    QVERIFY2(!QtCSV::Reader::readToProcessor(path, invalid),
+             "Invalid value was accepted");
+    QVERIFY2(1 == invalid.rows.size(), "Reading was not stopped");
+
+    // Empty value of not nullable column
+    path = writeCsvFile({{"a", "b"}, {"", "1"}});
+    CollectProcessor empty(schema);
+    QVERIFY2(!QtCSV::Reader::readToProcessor(path, empty),
+             "Empty value was accepted");
+
+    // Default value that could not be converted
+    QtCSV::Schema wrongDefault;
+    wrongDefault.addColumn("a", QtCSV::Schema::Type::BOOL, true, "maybe");
+    path = writeCsvFile({{"a"}, {"1"}});
+    CollectProcessor wrong(wrongDefault);
+    QVERIFY2(!QtCSV::Reader::readToProcessor(path, wrong),
+             "Invalid default value was accepted");
+}
+
+void TestTypedProcessor::testReset() {
+    auto path = writeCsvFile({{"a"}, {"1"}});
+    CollectProcessor processor;
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor),
+             "Failed to read file");
+
+    path = writeCsvFile({{"b", "c"}, {"2", "3"}});
+    processor.reset();
+    QVERIFY2(QtCSV::Reader::readToProcessor(path, processor),
+             "Failed to read file");
+    QVERIFY2((QList<QString>{"b", "c"}) == processor.header(),
+             "Header was not reset");
+    QVERIFY2(1 == processor.rowCount() && 2 == processor.rows.size(),
+             "Wrong number of rows");
+    QVERIFY2((QList<QVariant>{QVariant("2"), QVariant("3")}) ==
+                 processor.rows.last(),
+             "Wrong values");
+}
@@ -0,0 +1,21 @@
+#ifndef TESTTYPEDPROCESSOR_H
+#define TESTTYPEDPROCESSOR_H
+
+#include "tempdirtest.h"
+
+class TestTypedProcessor : public TempDirTest {
+    Q_OBJECT
+
+public:
+    TestTypedProcessor() = default;
+
+private Q_SLOTS:
+    void testHeaderOnly();
+    void testSchemaTypes();
+    void testSchemaColumnOrder();
+    void testNullsAndDefaults();
+    void testConversionErrors();
+    void testReset();
+};
+
+#endif // TESTTYPEDPROCESSOR_H
@@ -319,3 +319,61 @@ void TestVariantData::testReplaceRow() {
     data.replaceRow(1, valuesFirst);
     QVERIFY2(valuesFirst == data.rowValues(1), "Wrong data for second row");
 }
+
+void TestVariantData::testNumberFormat() {
+    QtCSV::VariantData data;
+    data << (QList<QVariant>() << QVariant(3.14159) << QVariant(42) <<
+             QVariant("text"));
+
+    QVERIFY2((QStringList() << "3.14159" << "42" << "text") ==
+                 data.rowValues(0),
+             "Wrong values with default number format");
+
+    QtCSV::NumberFormat format;
+    format.precision = 2;
+    format.decimalSeparator = QChar(',');
+    data.setNumberFormat(format);
+
+    QVERIFY2((QStringList() << "3,14" << "42" << "text") == data.rowValues(0),
+             "Wrong values with custom number format");
+}
+
+void TestVariantData::testParseNumbers() {
+    QStringList values;
+    values << "771" << "3.14" << "kkoo" << "";
+
+    QtCSV::VariantData data;
+    data.setParseNumbers(true);
+    data.addRow(values);
+
+    QList<QVariant> expected;
+    expected << QVariant(qlonglong(771)) << QVariant(3.14) <<
+        QVariant(QString("kkoo")) << QVariant(QString());
+
+    QtCSV::VariantData expectedData;
+    expectedData.addRow(expected);
+
+    QVERIFY2(expectedData == data, "Numbers were not parsed");
+    QVERIFY2(values == data.rowValues(0), "Wrong values of the row");
+}
+
+void TestVariantData::testParseNumbersKeepsText() {
+    QStringList values;
+    values << "007" << "+5" << " 5 " << "1.50" << "1e3" << "-0" << "-12" <<
+        "0.25";
+
+    QtCSV::VariantData data;
+    data.setParseNumbers(true);
+    data.addRow(values);
+
+    // Only numbers that are written back as the same text are converted
+    QList<QVariant> expected;
+    for (qsizetype i = 0; i < 6; ++i) { expected << QVariant(values.at(i)); }
+    expected << QVariant(qlonglong(-12)) << QVariant(0.25);
+
+    QtCSV::VariantData expectedData;
+    expectedData.addRow(expected);
+
+    QVERIFY2(expectedData == data, "Wrong conversion of numeric strings");
+    QVERIFY2(values == data.rowValues(0), "Values were changed");
+}
@@ -25,6 +25,9 @@ private Q_SLOTS:
     void testOperatorInput();
     void testRemoveRow();
     void testReplaceRow();
+    void testNumberFormat();
+    void testParseNumbers();
+    void testParseNumbersKeepsText();
 };
 
 #endif // TESTVARIANTDATA_H
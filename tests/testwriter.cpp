@@ -6,6 +6,7 @@
 #include <QDir>
 #include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
 #include <exception>
 
 void TestWriter::cleanup() {
@@ -383,3 +384,184 @@ void TestWriter::testWriteDataContainCRLF() {
     QVERIFY2(firstLine == data.at(0), "Wrong data at first row");
     QVERIFY2(secondLine == data.at(1), "Wrong data at second row");
 }
+
+void TestWriter::testWriteFromRowSource() {
+    QList<QString> firstRow;
+    firstRow << "one" << "two" << "three";
+
+    QList<QString> secondRow;
+    secondRow << "four" << "five, six";
+
+    QtCSV::StringData strData;
+    strData << firstRow << secondRow;
+
+    QtCSV::DataRowSource source(strData);
+    const auto writeResult = QtCSV::Writer::write(getFilePath(), source);
+    QVERIFY2(writeResult, "Failed to write to file");
+
+    const auto data = QtCSV::Reader::readToList(getFilePath());
+    QVERIFY2(2 == data.size(), "Wrong number of rows");
+    QVERIFY2(firstRow == data.at(0), "Wrong data at first row");
+    QVERIFY2(secondRow == data.at(1), "Wrong data at second row");
+}
+
+void TestWriter::testWriteFromFunctionRowSource() {
+    // Generate more rows than fit into one chunk of ContentIterator
+    const auto rowsNumber = 2500;
+    auto row = 0;
+    QtCSV::FunctionRowSource source([&row](QList<QString>& values) {
+        if (rowsNumber <= row) { return false; }
+
+        values = QList<QString>() << QString::number(row) << "value";
+        ++row;
+        return true;
+    });
+
+    QList<QString> header;
+    header << "number" << "text";
+
+    QList<QString> footer;
+    footer << "end";
+
+    const auto writeResult = QtCSV::Writer::write(
+        getFilePath(), source, ",", "\"", QtCSV::Writer::WriteMode::REWRITE,
+        header, footer);
+    QVERIFY2(writeResult, "Failed to write to file");
+
+    const auto data = QtCSV::Reader::readToList(getFilePath());
+    QVERIFY2(rowsNumber + 2 == data.size(), "Wrong number of rows");
+    QVERIFY2(header == data.first(), "Wrong header");
+    QVERIFY2(footer == data.last(), "Wrong footer");
+    for (auto i = 0; i < rowsNumber; ++i) {
+        QVERIFY2(QString::number(i) == data.at(i + 1).at(0),
+                 "Wrong order of rows");
+    }
+}
+
+void TestWriter::testWriteFromAppendingRowSource() {
+    // Source appends values, so it relies on empty list for each row
+    auto row = 0;
+    QtCSV::FunctionRowSource source([&row](QList<QString>& values) {
+        if (3 <= row) { return false; }
+
+        values << QString::number(row) << "value";
+        ++row;
+        return true;
+    });
+
+    QVERIFY2(QtCSV::Writer::write(getFilePath(), source),
+             "Failed to write to file");
+
+    const auto data = QtCSV::Reader::readToList(getFilePath());
+    QVERIFY2(3 == data.size(), "Wrong number of rows");
+    for (auto i = 0; i < data.size(); ++i) {
+        QVERIFY2((QList<QString>() << QString::number(i) << "value") ==
+                     data.at(i),
+                 "Values of previous rows were written");
+    }
+}
+
+void TestWriter::testWriteEmptyRowSource() {
+    QtCSV::FunctionRowSource source([](QList<QString>&) { return false; });
+    QVERIFY2(!QtCSV::Writer::write(getFilePath(), source),
+             "Empty row source was accepted");
+
+    QtCSV::FunctionRowSource secondSource([](QList<QString>&) {
+        return false;
+    });
+
+    QList<QString> header;
+    header << "one" << "two";
+    QVERIFY2(QtCSV::Writer::write(
+                 getFilePath(), secondSource, ",", "\"",
+                 QtCSV::Writer::WriteMode::REWRITE, header),
+             "Failed to write header only");
+
+    const auto data = QtCSV::Reader::readToList(getFilePath());
+    QVERIFY2(1 == data.size() && header == data.at(0), "Wrong data");
+}
+
+void TestWriter::testWriteStats() {
+    QtCSV::StringData data;
+    data.addRow(QList<QString>{"one", "two"});
+    data.addRow(QList<QString>{"three", "four,five"});
+    data.addRow(QList<QString>{"six", "seven"});
+
+    QList<QString> header;
+    header << "first" << "second";
+
+    QtCSV::WriteStats stats;
+    QVERIFY2(QtCSV::Writer::write(
+                 getFilePath(), data, ",", QString(),
+                 QtCSV::Writer::WriteMode::APPEND, header, {},
+                 QStringConverter::Utf8, &stats),
+             "Failed to write to file");
+
+    QVERIFY2(4 == stats.rows, "Wrong number of rows");
+    QVERIFY2(8 == stats.fields, "Wrong number of fields");
+    QVERIFY2(QFileInfo(getFilePath()).size() == stats.bytesWritten,
+             "Wrong number of written bytes");
+    QVERIFY2(stats.bytesWritten == stats.symbolsEncoded,
+             "Wrong number of encoded symbols");
+    QVERIFY2(0 < stats.totalNsecs, "Total time was not measured");
+    QVERIFY2(stats.composeNsecs + stats.ioNsecs <= stats.totalNsecs,
+             "Time of stages is greater than total time");
+
+    const auto result = QtCSV::Reader::readToList(getFilePath());
+    QVERIFY2(4 == result.size() && header == result.at(0) &&
+                 data.rowValues(1) == result.at(2),
+             "Statistics changed result of writing");
+}
+
+void TestWriter::testWriteProgress() {
+    const auto data = getTestStringData(10, 2500);
+    QList<QtCSV::Progress::State> states;
+    QtCSV::Progress progress(
+        [&states](const QtCSV::Progress::State& state) { states << state; });
+
+    QVERIFY2(QtCSV::Writer::write(
+                 getFilePath(), data, ",", "\"",
+                 QtCSV::Writer::WriteMode::REWRITE, {}, {},
+                 QStringConverter::Utf8, nullptr, &progress),
+             "Failed to write to file");
+
+    // Two intermediate states and the final one
+    QVERIFY2(3 == states.size(), "Wrong number of callback calls");
+    QVERIFY2(1000 == states.at(0).rows && 2000 == states.at(1).rows,
+             "Wrong number of rows in intermediate states");
+    QVERIFY2(2500 == states.last().rows, "Wrong number of rows");
+    QVERIFY2(-1 == states.last().totalBytes, "Wrong total number of bytes");
+    QVERIFY2(QFileInfo(getFilePath()).size() == states.last().bytes,
+             "Wrong number of bytes");
+}
+
+void TestWriter::testWriteCancel() {
+    QtCSV::StringData data;
+    data.addRow(QList<QString>{"old", "data"});
+    QVERIFY2(QtCSV::Writer::write(getFilePath(), data),
+             "Failed to write to file");
+
+    // Source returns rows endlessly, so writing could only be canceled
+    QtCSV::Progress progress;
+    progress.setInterval(100);
+    progress.setCallback([&progress](const QtCSV::Progress::State& state) {
+        if (500 <= state.rows) { progress.cancel(); }
+    });
+
+    qint64 rows = 0;
+    QtCSV::FunctionRowSource source([&rows](QList<QString>& values) {
+        values = QList<QString>{"new", QString::number(++rows)};
+        return true;
+    });
+
+    QVERIFY2(!QtCSV::Writer::write(
+                 getFilePath(), source, ",", "\"",
+                 QtCSV::Writer::WriteMode::REWRITE, {}, {},
+                 QStringConverter::Utf8, nullptr, &progress),
+             "Canceled writing was successful");
+    QVERIFY2(rows <= 501, "Writing was not stopped after cancel");
+
+    const auto result = QtCSV::Reader::readToList(getFilePath());
+    QVERIFY2(1 == result.size() && data.rowValues(0) == result.at(0),
+             "Canceled writing changed the file");
+}
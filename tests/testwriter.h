@@ -26,6 +26,13 @@ private Q_SLOTS:
     void testWriterDataContainSeparators();
     void testWriteDifferentDataAmount();
     void testWriteDataContainCRLF();
+    void testWriteFromRowSource();
+    void testWriteFromFunctionRowSource();
+    void testWriteFromAppendingRowSource();
+    void testWriteEmptyRowSource();
+    void testWriteStats();
+    void testWriteProgress();
+    void testWriteCancel();
 
 private:
     QString getFilePath() const;
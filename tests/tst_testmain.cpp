@@ -1,5 +1,26 @@
 #include <QtTest>
 
+#include "testnumberconverter.h"
+#include "testpartitionedwriter.h"
+#include "testexternalsorter.h"
+#include "testcacheddata.h"
+#include "testtypedprocessor.h"
+#include "testsniffer.h"
+#include "testspilleddata.h"
+#include "testindexeddata.h"
+#include "testtablemodel.h"
+#include "testquery.h"
+#include "testhashjoin.h"
+#include "testfilefollower.h"
+#include "testmultireader.h"
+#include "testfilesplitter.h"
+#include "testfilemerger.h"
+#include "testjsonconverter.h"
+#include "testarrowwriter.h"
+#include "testrowsampler.h"
+#ifdef QTCSV_SQL
+#include "testsqlimporter.h"
+#endif
 #include "testreader.h"
 #include "teststringdata.h"
 #include "testvariantdata.h"
@@ -18,6 +39,27 @@ int main() {
     status |= AssertTest(new TestVariantData());
     status |= AssertTest(new TestReader());
     status |= AssertTest(new TestWriter());
+    status |= AssertTest(new TestNumberConverter());
+    status |= AssertTest(new TestPartitionedWriter());
+    status |= AssertTest(new TestExternalSorter());
+    status |= AssertTest(new TestCachedData());
+    status |= AssertTest(new TestTypedProcessor());
+    status |= AssertTest(new TestSniffer());
+    status |= AssertTest(new TestSpilledData());
+    status |= AssertTest(new TestIndexedData());
+    status |= AssertTest(new TestTableModel());
+    status |= AssertTest(new TestQuery());
+    status |= AssertTest(new TestHashJoin());
+    status |= AssertTest(new TestFileFollower());
+    status |= AssertTest(new TestMultiReader());
+    status |= AssertTest(new TestFileSplitter());
+    status |= AssertTest(new TestFileMerger());
+    status |= AssertTest(new TestJsonConverter());
+    status |= AssertTest(new TestArrowWriter());
+    status |= AssertTest(new TestRowSampler());
+#ifdef QTCSV_SQL
+    status |= AssertTest(new TestSqlImporter());
+#endif
 
     return status;
 }